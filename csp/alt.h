@@ -7,18 +7,24 @@
 
 #include <memory>
 #include <mutex>
-#include <condition_variable>
 #include <vector>
 #include <initializer_list>
 #include <chrono>
 #include <type_traits>
 #include <cassert>
+#include <functional>
+#include <tuple>
+#include <algorithm>
 #include "guard.h"
+#include "fiber_scheduler.h"
+#include "wait_strategy.h"
+#include "coroutine.h"
 
 namespace csp
 {
     // Forward declaration of alting barrier
     class alting_barrier;
+    class alting_barrier_coordinate;
 
     /*! \class multiway_sync
      * \brief An interface class that defines an object as being a multiway sync.
@@ -35,6 +41,13 @@ namespace csp
          * type checking.
          */
         virtual ~multiway_sync() { }
+
+        /*!
+         * \brief Gets the coordinator of the group the multiway sync belongs to.
+         *
+         * \return The coordinator of the group.
+         */
+        virtual std::shared_ptr<alting_barrier_coordinate> coordinate() const noexcept = 0;
     };
 
     /*! \class alt
@@ -53,6 +66,7 @@ namespace csp
     class alt
     {
         friend class guard;
+        friend class ready_alt;
     private:
         /*!
          * \class alt_internal
@@ -67,7 +81,9 @@ namespace csp
         private:
             std::mutex _mut; //!< Mutex used to control access to the alt
 
-            std::condition_variable _cond; //!< Condition variable used to coordinate the mutex
+            condition _cond; //!< Condition variable used to coordinate the mutex
+
+            wait_policy _policy; //!< How the alt waits for a guard to become ready
 
             /*! \enum STATE
              * \brief Defines the possible states that the alt can be in
@@ -92,6 +108,8 @@ namespace csp
 
             bool _barrier_present = false; //<! Flag to indicate if an alting barrier is present
 
+            std::shared_ptr<alting_barrier_coordinate> _coordinate = nullptr; //<! Coordinator of the group of alting barriers in the alt
+
             bool _barrier_trigger = false; //<! Flag to indicate successful enable / disable of alting barrier
 
             int _barrier_selected = NONE_SELECTED; //<! Index of the selected alting barrier
@@ -104,6 +122,71 @@ namespace csp
 
             int _timer_index = -1; //<! Index of the timer with the earliest timeout
 
+            /*! \enum GUARD_STATE
+             * \brief The states of a guard in an alt with a ready queue.
+             */
+            enum GUARD_STATE : unsigned char
+            {
+                UNREGISTERED    = 0,    //!< Guard must be enabled before it can be selected
+                REGISTERED      = 1,    //!< Guard is enabled and will schedule the alt when ready
+                QUEUED          = 2,    //!< Guard is ready and on the ready queue
+            };
+
+            bool _ready_queue = false; //<! Flag set if guards register once and queue themselves when ready
+
+            std::vector<unsigned char> _guard_state; //<! State of each guard.  Only used with a ready queue.
+
+            std::vector<int> _ready; //<! Indices of the guards on the ready queue
+
+            std::vector<int> _unregistered; //<! Indices of the persistent guards that must be enabled again
+
+            std::vector<int> _polled; //<! Indices of the guards that must be enabled for every selection
+
+            /*!
+             * \brief Joins the groups of the alting barriers in the alt.
+             *
+             * \param[in] coordinators The coordinators of the alting barriers in the alt.
+             *
+             * \return The coordinator of the joined group.
+             */
+            static std::shared_ptr<alting_barrier_coordinate> join_barriers(const std::vector<std::shared_ptr<alting_barrier_coordinate>> &coordinators) noexcept;
+
+            /*!
+             * \brief Determines how the alt selects.  Called on construction.
+             *
+             * \param[in] ready_queue Flag to indicate that a ready queue should be used.
+             */
+            void init(bool ready_queue) noexcept
+            {
+                // Determine if we have a multiway sync, and which groups they belong to
+                std::vector<std::shared_ptr<alting_barrier_coordinate>> coordinators;
+                for (auto &g : _guards)
+                {
+                    auto sync = dynamic_cast<multiway_sync*>(g._internal.get());
+                    if (sync)
+                        coordinators.push_back(sync->coordinate());
+                }
+                // Barriers in one alt must be coordinated together
+                if (!coordinators.empty())
+                {
+                    _barrier_present = true;
+                    _coordinate = join_barriers(coordinators);
+                }
+                // Alting barriers coordinate enable sequences across alts, so always enable every guard with them
+                _ready_queue = ready_queue && !_barrier_present;
+                if (!_ready_queue)
+                    return;
+                // Persistent guards are enabled once.  The rest are enabled for every selection.
+                _guard_state.assign(_guards.size(), UNREGISTERED);
+                for (int i = 0; i < int(_guards.size()); ++i)
+                {
+                    if (_guards[i].persistent())
+                        _unregistered.push_back(i);
+                    else
+                        _polled.push_back(i);
+                }
+            }
+
             /*!
              * \brief Internal operation to perform the selection of guards
              *
@@ -121,6 +204,16 @@ namespace csp
              */
             int do_select(const std::vector<bool> &pre_conditions) noexcept;
 
+            /*!
+             * \brief Internal operation to perform the next step of a selection for a process that cannot block.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             *
+             * \return True if the selection has completed, false if the operation is waiting.
+             */
+            bool do_select_async(async_op &op, const std::vector<bool> *pre_conditions) noexcept;
+
             /*!
              * \brief Internal operation used to enable guards for selection
              */
@@ -146,43 +239,105 @@ namespace csp
              */
             void disable_guards(const std::vector<bool> &pre_conditions) noexcept(false);
 
+            /*!
+             * \brief Puts a registered guard on the ready queue.  The alt must be locked.
+             *
+             * \param[in] index The index of the guard.
+             */
+            void queue(int index) noexcept
+            {
+                if (_guard_state[index] != REGISTERED)
+                    return;
+                _guard_state[index] = QUEUED;
+                _ready.push_back(index);
+            }
+
+            /*!
+             * \brief Enables a guard of a ready-queue alt, queueing it if it is ready.
+             *
+             * \param[in] index The index of the guard.
+             */
+            void enable_queued(int index) noexcept;
+
+            /*!
+             * \brief Enables the guards of a ready-queue alt that are not registered, and the guards
+             * that must be enabled for every selection.
+             *
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             */
+            void ready_enable(const std::vector<bool> *pre_conditions) noexcept;
+
+            /*!
+             * \brief Picks the guard to select from the ready queue.  The alt must be locked.
+             *
+             * \param[in] priority Flag to indicate a priority rather than a fair selection.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             *
+             * \return The index of the guard to select, or NONE_SELECTED if no eligible guard is ready.
+             */
+            int ready_choose(bool priority, const std::vector<bool> *pre_conditions) const noexcept;
+
+            /*!
+             * \brief Disables the guards enabled for this selection only, and takes them off the ready queue.
+             *
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             */
+            void ready_disable(const std::vector<bool> *pre_conditions) noexcept;
+
+            /*!
+             * \brief Completes the selection of a guard, which must be enabled again before its next selection.
+             *
+             * \param[in] selected The index of the selected guard.
+             *
+             * \return True if the guard is still ready, false if it has withdrawn.
+             */
+            bool ready_take(int selected) noexcept;
+
+            /*!
+             * \brief Performs a selection using the ready queue.
+             *
+             * \param[in] priority Flag to indicate a priority rather than a fair selection.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             *
+             * \return The index of the selected guard.
+             */
+            int do_ready_select(bool priority, const std::vector<bool> *pre_conditions) noexcept;
+
+            /*!
+             * \brief Performs the next step of a selection using the ready queue.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] priority Flag to indicate a priority rather than a fair selection.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             * \param[out] selected Set to the index of the selected guard once complete.
+             *
+             * \return True if the selection has completed, false if the operation is waiting.
+             */
+            bool do_ready_select_async(async_op &op, bool priority, const std::vector<bool> *pre_conditions, int &selected) noexcept;
+
         public:
             /*!
              * \brief Creates a new alt_internal with the given vector of guards
              *
              * \param[in] guards The list of guards that the alt will select on.
+             * \param[in] ready_queue Flag to indicate that guards register once and queue themselves when ready.
              */
-            alt_internal(const std::vector<guard> &guards) noexcept
+            alt_internal(const std::vector<guard> &guards, bool ready_queue = false) noexcept
             : _guards(guards)
             {
-                // Determine if we have a multiway sync
-                for (auto &g : _guards)
-                {
-                    if (dynamic_cast<multiway_sync*>(g._internal.get()))
-                    {
-                        _barrier_present = true;
-                        return;
-                    }
-                }
+                init(ready_queue);
             }
 
             /*!
              * \brief Creates a new alt_iternal with the given vector of guards, using move semantics
              *
              * \param[in] guards The list of guards that thw alt will select on.
+             * \param[in] ready_queue Flag to indicate that guards register once and queue themselves when ready.
              */
-            alt_internal(std::vector<guard> &&guards) noexcept
+            alt_internal(std::vector<guard> &&guards, bool ready_queue = false) noexcept
             : _guards(guards)
             {
-                // Determine if we have a multiway sync
-                for (auto &g : _guards)
-                {
-                    if (dynamic_cast<multiway_sync*>(g._internal.get()))
-                    {
-                        _barrier_present = true;
-                        return;
-                    }
-                }
+                init(ready_queue);
             }
 
             /*!
@@ -233,10 +388,32 @@ namespace csp
              */
             int fair_select(const std::vector<bool> &pre_conditions) noexcept;
 
+            /*!
+             * \brief Performs the next step of a priority selection for a process that cannot block.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             * \param[out] selected Set to the index of the selected guard once complete.
+             *
+             * \return True if the selection has completed, false if the operation is waiting.
+             */
+            bool pri_select_async(async_op &op, const std::vector<bool> *pre_conditions, int &selected) noexcept;
+
+            /*!
+             * \brief Performs the next step of a fair selection for a process that cannot block.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] pre_conditions The list of pre-conditions, or nullptr if there are none.
+             * \param[out] selected Set to the index of the selected guard once complete.
+             *
+             * \return True if the selection has completed, false if the operation is waiting.
+             */
+            bool fair_select_async(async_op &op, const std::vector<bool> *pre_conditions, int &selected) noexcept;
+
             /*!
              * \brief Sets the _barrier_trigger_flag.
              */
-            void set_barrier_trigger() noexcept { _barrier_trigger = 0; }
+            void set_barrier_trigger() noexcept { _barrier_trigger = true; }
 
             /*!
              * \brief Called by the timer when it is enabled as a guard
@@ -267,8 +444,23 @@ namespace csp
 
             /*!
              * \brief Called by a guard to indicate that it has become ready.
+             *
+             * \param[in] index The index of the guard, or -1 if not known.  Used to queue the guard
+             * when the alt has a ready queue.
+             */
+            void schedule(int index) noexcept;
+
+            /*!
+             * \brief Disables every guard still registered with a ready-queue alt.  Called once the alt is finished with.
+             */
+            void release() noexcept;
+
+            /*!
+             * \brief Sets how the alt waits for a guard to become ready.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
              */
-            void schedule() noexcept;
+            void set_wait_strategy(wait_strategy strategy) noexcept { _policy.set(strategy); }
 
             /*!
              * \brief Destroys the alt_internal.
@@ -278,6 +470,8 @@ namespace csp
 
         std::shared_ptr<alt_internal> _internal = nullptr; //<! Pointer to the internal representaiton of the alt.
 
+        int _index = -1; //<! Index of the guard this alt was given to when enabling it, or -1.
+
         /*!
          * \brief Sets the barrier trigger.  This is called by a barrier when it has become ready.
          */
@@ -295,15 +489,16 @@ namespace csp
          * external to the alt.
          */
 
-        void schedule() const noexcept { _internal->schedule(); }
+        void schedule() const noexcept { _internal->schedule(_index); }
 
         /*!
          * \brief Private constructor used by alt_internal
          *
          * \param[in] internal Shared pointer to the alt_internal
+         * \param[in] index The index of the guard being enabled, or -1.
          */
-        alt(std::shared_ptr<alt_internal> internal)
-        : _internal(internal)
+        alt(std::shared_ptr<alt_internal> internal, int index = -1)
+        : _internal(internal), _index(index)
         {
         }
 
@@ -381,6 +576,13 @@ namespace csp
          */
         alt& operator=(alt &&rhs) noexcept = default;
 
+        /*!
+         * \brief Sets how the alt waits for a guard to become ready.  Timed selections always park.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _internal->set_wait_strategy(strategy); }
+
         /*!
          * \brief Performs a select operation on the guards.  Will use fair selection semantics.
          *
@@ -452,12 +654,205 @@ namespace csp
          * \return The index of the selected guard.
          */
         int operator()(const std::vector<bool> &pre_conditions) const noexcept { return select(pre_conditions); }
+
+#if defined(__cpp_impl_coroutine)
+        /*! \class select_op
+         * \brief Awaitable selection operation.  The result of the co_await is the index of the selected guard.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class select_op : public co_op
+        {
+        private:
+            std::shared_ptr<alt_internal> _alt; //!< The alt performing the selection.
+
+            bool _priority; //!< Flag to indicate a priority rather than a fair selection.
+
+            bool _has_pre_conditions; //!< Flag to indicate that pre-conditions are used.
+
+            std::vector<bool> _pre_conditions; //!< The pre-conditions on the guards.
+
+            int _selected = -1; //!< The index of the selected guard.
+
+        protected:
+            bool step() noexcept(false) override final
+            {
+                auto pre_conditions = _has_pre_conditions ? &_pre_conditions : nullptr;
+                return _priority ? _alt->pri_select_async(*this, pre_conditions, _selected)
+                                 : _alt->fair_select_async(*this, pre_conditions, _selected);
+            }
+
+        public:
+            select_op(const std::shared_ptr<alt_internal> &a, bool priority) noexcept
+            : _alt(a), _priority(priority), _has_pre_conditions(false)
+            {
+            }
+
+            select_op(const std::shared_ptr<alt_internal> &a, bool priority, const std::vector<bool> &pre_conditions) noexcept
+            : _alt(a), _priority(priority), _has_pre_conditions(true), _pre_conditions(pre_conditions)
+            {
+            }
+
+            int await_resume() const noexcept(false)
+            {
+                this->rethrow();
+                return _selected;
+            }
+        };
+
+        /*!
+         * \brief Performs a select operation within a coroutine, suspending the coroutine rather than
+         * blocking.  Will use fair selection semantics.  Use as co_await a.co_select().
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_select() const noexcept { return select_op(_internal, false); }
+
+        /*!
+         * \brief Performs a select operation within a coroutine using the given pre-conditions.  Will use
+         * fair selection semantics.
+         *
+         * \param[in] pre_conditions List of pre-conditions to use with the guards.
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_select(const std::vector<bool> &pre_conditions) const noexcept { return select_op(_internal, false, pre_conditions); }
+
+        /*!
+         * \brief Performs a priority selection operation within a coroutine.
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_pri_select() const noexcept { return select_op(_internal, true); }
+
+        /*!
+         * \brief Performs a priority selection operation within a coroutine using the given pre-conditions.
+         *
+         * \param[in] pre_conditions List of pre-conditions to use with the guards.
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_pri_select(const std::vector<bool> &pre_conditions) const noexcept { return select_op(_internal, true, pre_conditions); }
+
+        /*!
+         * \brief Performs a fair selection operation within a coroutine.
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_fair_select() const noexcept { return select_op(_internal, false); }
+
+        /*!
+         * \brief Performs a fair selection operation within a coroutine using the given pre-conditions.
+         *
+         * \param[in] pre_conditions List of pre-conditions to use with the guards.
+         *
+         * \return The awaitable selection operation.
+         */
+        select_op co_fair_select(const std::vector<bool> &pre_conditions) const noexcept { return select_op(_internal, false, pre_conditions); }
+#endif
+    };
+
+    /*! \class ready_alt
+     * \brief An alt whose selections cost in proportion to the number of ready guards rather than
+     * the number of guards.
+     *
+     * Channel guards are enabled once, and queue themselves on the alt when they become ready.  A
+     * selection enables again only the guard it last selected, and any guard that cannot stay
+     * enabled (timers, skips), then picks from the queue using the usual priority or fair rule.
+     * Guards stay enabled between selections until the ready_alt is destroyed, so its channels
+     * should be read only once selected, and not be used in another alt meanwhile.  An alt with an
+     * alting barrier enables every guard for each selection, as a normal alt does.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class ready_alt : public alt
+    {
+    public:
+        /*!
+         * \brief Creates a new ready_alt with the given list of guards.
+         *
+         * \param[in] guards The guards that the alt will operate on.
+         */
+        ready_alt(const std::initializer_list<guard> &guards) noexcept
+        : alt(std::shared_ptr<alt_internal>(new alt_internal(std::vector<guard>(guards), true)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new ready_alt with the given list of guards.
+         *
+         * \param[in] guards The guards that the alt will operate on.
+         */
+        ready_alt(const std::vector<guard> &guards) noexcept
+        : alt(std::shared_ptr<alt_internal>(new alt_internal(guards, true)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new ready_alt, generating the guard list from the given iterator.
+         *
+         * \tparam _Iter The iterator type used for list generation.  This must work across guards.
+         *
+         * \param[in] begin The start of the iterator.
+         * \param[in] end The end of the iterator.
+         */
+        template<typename _Iter>
+        ready_alt(const _Iter &begin, const _Iter &end) noexcept
+        : alt(std::shared_ptr<alt_internal>(new alt_internal(std::vector<guard>(begin, end), true)))
+        {
+        }
+
+        ready_alt(const ready_alt &other) = delete;
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The ready_alt to move.
+         */
+        ready_alt(ready_alt &&rhs) noexcept = default;
+
+        ready_alt& operator=(const ready_alt &other) = delete;
+
+        /*!
+         * \brief Move assignment operator.  Releases the guards of this alt first.
+         *
+         * \param[in] rhs The ready_alt to move.
+         *
+         * \return This ready_alt.
+         */
+        ready_alt& operator=(ready_alt &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (_internal)
+                    _internal->release();
+                _internal = std::move(rhs._internal);
+            }
+            return *this;
+        }
+
+        /*!
+         * \brief Destroys the ready_alt, disabling the guards still enabled.
+         */
+        ~ready_alt() noexcept
+        {
+            if (_internal)
+                _internal->release();
+        }
     };
 
     /*! \class alting_barrier_coordinate
-     * \brief A static helper class used to coordinate alting barriers
+     * \brief A helper class used to coordinate alting barriers.
      * Used internally by the framework.
      *
+     * Each group of alting barriers that share a process has its own coordinator, so only alts
+     * that could complete the same barriers serialise their enable sequences.  Alts that bring
+     * barriers from separate groups together join the groups into one.
+     *
      * \author Kevin Chalmers
      *
      * \date 8/4/2016
@@ -467,97 +862,187 @@ namespace csp
         friend class alt;
         friend class alting_barrier;
     private:
-        static int _active; //!< The number of processes active in the alt.
+        int _active = 0; //!< The number of processes active in the group.
+
+        std::mutex _mut; //!< Mutex for coordinating enable / disable sequences.
 
-        static std::unique_ptr<std::mutex> _active_lock; //!< Mutex for coordinating enable / disable sequences.
+        condition _cond; //!< Condition variable for coordinating enable / disable sequences.
 
-        static std::unique_ptr<std::condition_variable> _cond; //!< Condition varianle for coordinate enable / disable sequences.
+        std::shared_ptr<alting_barrier_coordinate> _parent = nullptr; //!< The coordinator this one has been joined into, if any.
+
+        static std::unique_ptr<std::mutex> _join_lock; //!< Mutex ensuring only one join of groups happens at a time.
 
         /*!
-         * \brief Starts an enable sequence on an alting_barrier.
+         * \brief Finds the coordinator currently in charge of the group.
+         *
+         * \param[in] c The coordinator to start from.
+         *
+         * \return The coordinator that has not been joined into another.
          */
-        static void start_enable() noexcept(false)
+        static std::shared_ptr<alting_barrier_coordinate> root(std::shared_ptr<alting_barrier_coordinate> c) noexcept
         {
-            // Ensure only one enable sequence is in effect.
-            std::unique_lock<std::mutex> lock(*_active_lock);
+            while (true)
+            {
+                std::lock_guard<std::mutex> lock(c->_mut);
+                if (!c->_parent)
+                    return c;
+                c = c->_parent;
+            }
+        }
+
+        /*!
+         * \brief Starts an enable sequence on the group.
+         *
+         * \param[in] c A coordinator of the group.
+         */
+        static void start_enable(std::shared_ptr<alting_barrier_coordinate> c) noexcept(false)
+        {
+            while (true)
+            {
+                c = root(c);
+                // Ensure only one enable sequence is in effect.
+                std::unique_lock<std::mutex> lock(c->_mut);
+
+                // Ensure we haven't woken up when we shouldn't
+                while (c->_active > 0 && !c->_parent)
+                    c->_cond.wait(lock);
 
-            // Ensure we haven't woken up when we shouldn't
-            while (_active > 0)
-                _cond->wait(lock);
+                // The group may have been joined into another while we waited
+                if (c->_parent)
+                    continue;
 
-            // Sanity check
-            if (_active != 0)
-                throw std::runtime_error("alting_barrier enable sequence starting with active count not equal to zero: " + std::to_string(_active));
+                // Sanity check
+                if (c->_active != 0)
+                    throw std::runtime_error("alting_barrier enable sequence starting with active count not equal to zero: " + std::to_string(c->_active));
 
-            // Set active to one to ensure we are the only active enable
-            _active = 1;
+                // Set active to one to ensure we are the only active enable
+                c->_active = 1;
+                return;
+            }
         }
 
         /*!
-         * \brief Ends an enable sequence on an alting_barrier.
+         * \brief Ends an enable sequence on the group.
+         *
+         * \param[in] c A coordinator of the group.
          */
-        static void finish_enable() noexcept(false)
+        static void finish_enable(std::shared_ptr<alting_barrier_coordinate> c) noexcept(false)
         {
+            c = root(c);
             // Ensure only one enable sequence is in effect.
-            std::unique_lock<std::mutex> lock(*_active_lock);
+            std::unique_lock<std::mutex> lock(c->_mut);
 
             // Sanity check.  Ensure that we are the only enable in effect.
-            if (_active != 1)
-                throw std::runtime_error("alting barrier enable sequence finished with active count not equal to zero: " + std::to_string(_active));
+            if (c->_active != 1)
+                throw std::runtime_error("alting barrier enable sequence finished with active count not equal to one: " + std::to_string(c->_active));
 
             // Set active to 0 to indicate enable has completed.
-            _active = 0;
+            c->_active = 0;
 
             // Signal the next waiting process (if any) so that they can start an enable.
-            _cond->notify_one();
+            c->_cond.notify_one();
         }
 
         /*!
-         * \brief Starts a disable sequence on an alting barrier.
+         * \brief Starts a disable sequence on the group.
          *
+         * \param[in] c A coordinator of the group.
          * \param[in] n Number of front ends to disable
          */
-        static void start_disable(int n) noexcept(false)
+        static void start_disable(std::shared_ptr<alting_barrier_coordinate> c, int n) noexcept(false)
         {
             // Assert n is > 0
             assert(n > 0);
 
+            c = root(c);
             // Ensure that only one process is in operation
-            std::unique_lock<std::mutex> lock(*_active_lock);
+            std::unique_lock<std::mutex> lock(c->_mut);
 
             // Sanity check.  Ensure that no other process is disabling
-            if (_active != 1)
-                throw std::runtime_error("Completed alting barrier found in alt sequence with active count not equal to one: " + std::to_string(_active));
+            if (c->_active != 1)
+                throw std::runtime_error("Completed alting barrier found in alt sequence with active count not equal to one: " + std::to_string(c->_active));
 
             // Set active value to number of front-ends to disable
-            _active = n;
+            c->_active = n;
         }
 
         /*!
-         * \brief Completes a disable sequence.
+         * \brief Completes a disable sequence on the group.
+         *
+         * \param[in] c A coordinator of the group.
          */
-        static void finish_disable() noexcept(false)
+        static void finish_disable(std::shared_ptr<alting_barrier_coordinate> c) noexcept(false)
         {
+            c = root(c);
             // Ensure that we are the only process in operation
-            std::unique_lock<std::mutex> lock(*_active_lock);
+            std::unique_lock<std::mutex> lock(c->_mut);
 
             // Ensure that we aren't disabling too many front ends.
-            if (_active < 1)
-                throw std::runtime_error("alting barrier disable sequence finished with active count less than one: " + std::to_string(_active));
+            if (c->_active < 1)
+                throw std::runtime_error("alting barrier disable sequence finished with active count less than one: " + std::to_string(c->_active));
 
             // Decrement active count
-            --_active;
+            --c->_active;
 
             // If active count has hit 0 then inform the next waiting process
-            if (_active == 0)
-                _cond->notify_one();
+            if (c->_active == 0)
+                c->_cond.notify_one();
         }
+
+        /*!
+         * \brief Joins the groups of the given coordinators into one.  Called when an alt is
+         * created with alting barriers from more than one group.
+         *
+         * \param[in] coordinators The coordinators of the barriers in the alt.
+         *
+         * \return The coordinator of the joined group.
+         */
+        static std::shared_ptr<alting_barrier_coordinate> join(const std::vector<std::shared_ptr<alting_barrier_coordinate>> &coordinators) noexcept(false)
+        {
+            // Only one join at a time, so the roots found here cannot change underneath us
+            std::lock_guard<std::mutex> join_lock(*_join_lock);
+            std::vector<std::shared_ptr<alting_barrier_coordinate>> roots;
+            for (auto &c : coordinators)
+                roots.push_back(root(c));
+            std::sort(roots.begin(), roots.end());
+            roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+            if (roots.size() == 1)
+                return roots[0];
+
+            // Wait for each group to be idle.  Always in address order.
+            for (auto &c : roots)
+                start_enable(c);
+
+            // Point the other groups at the first.  Anyone waiting on them moves across.
+            for (unsigned int i = 1; i < roots.size(); ++i)
+            {
+                std::lock_guard<std::mutex> lock(roots[i]->_mut);
+                roots[i]->_parent = roots[0];
+                roots[i]->_active = 0;
+                roots[i]->_cond.notify_all();
+            }
+            finish_enable(roots[0]);
+            return roots[0];
+        }
+
+    public:
+        /*!
+         * \brief Creates a new coordinator for a new group of alting barriers.
+         */
+        alting_barrier_coordinate() = default;
+
+        alting_barrier_coordinate(const alting_barrier_coordinate&) = delete;
+
+        alting_barrier_coordinate& operator=(const alting_barrier_coordinate&) = delete;
     };
 
     // Initialise static values
-    int alting_barrier_coordinate::_active = 0;
-    std::unique_ptr<std::mutex> alting_barrier_coordinate::_active_lock = std::unique_ptr<std::mutex>(new std::mutex());
-    std::unique_ptr<std::condition_variable> alting_barrier_coordinate::_cond = std::unique_ptr<std::condition_variable>(new std::condition_variable());
+    std::unique_ptr<std::mutex> alting_barrier_coordinate::_join_lock = std::unique_ptr<std::mutex>(new std::mutex());
+
+    std::shared_ptr<alting_barrier_coordinate> alt::alt_internal::join_barriers(const std::vector<std::shared_ptr<alting_barrier_coordinate>> &coordinators) noexcept
+    {
+        return alting_barrier_coordinate::join(coordinators);
+    }
 
     int alt::alt_internal::do_select() noexcept
     {
@@ -586,7 +1071,7 @@ namespace csp
                 else
                 {
                     // No timeout.  Wait until ready guard.
-                    _cond.wait(lock);
+                    _policy.wait(lock, _cond, [this]() { return _state != STATE::WAITING; });
                 }
 
                 // Set state to READY
@@ -634,7 +1119,7 @@ namespace csp
                 else
                 {
                     // No timeout.  Wait until ready guard.
-                    _cond.wait(lock);
+                    _policy.wait(lock, _cond, [this]() { return _state != STATE::WAITING; });
                 }
 
                 // Set state to READY
@@ -654,11 +1139,62 @@ namespace csp
         return _selected;
     }
 
+    bool alt::alt_internal::do_select_async(async_op &op, const std::vector<bool> *pre_conditions) noexcept
+    {
+        if (op._phase == 0)
+        {
+            // Set state to ENABLING
+            _state = STATE::ENABLING;
+
+            // Enable all guards
+            if (pre_conditions)
+                enable_guards(*pre_conditions);
+            else
+                enable_guards();
+
+            // Lock the alt
+            std::unique_lock<std::mutex> lock(_mut);
+
+            // Check if we are still enabling
+            if (_state == STATE::ENABLING)
+            {
+                // Set state to waiting, and wait until time or guard becomes ready
+                _state = STATE::WAITING;
+                op._phase = 1;
+                if (_timeout)
+                    _cond.wait_async_until(lock, op, _time);
+                else
+                    _cond.wait_async(lock, op);
+                return false;
+            }
+        }
+        else
+        {
+            // Woken by a guard or the timeout
+            _cond.finish_async(op);
+
+            // Lock the alt and set state to READY
+            std::lock_guard<std::mutex> lock(_mut);
+            _state = STATE::READY;
+        }
+
+        // Disable the guards
+        if (pre_conditions)
+            disable_guards(*pre_conditions);
+        else
+            disable_guards();
+
+        // Set state to inactive
+        _state = STATE::INACTIVE;
+        _timeout = false;
+        return true;
+    }
+
     void alt::alt_internal::enable_guards() noexcept
     {
         // If alting barrier exists then coordinate
         if (_barrier_present)
-            alting_barrier_coordinate::start_enable();
+            alting_barrier_coordinate::start_enable(_coordinate);
 
         // Set the currently selected barrier
         _barrier_selected = NONE_SELECTED;
@@ -682,7 +1218,7 @@ namespace csp
                 }
                 // Else if barrier is present finish enable
                 else if (_barrier_present)
-                    alting_barrier_coordinate::finish_enable();
+                    alting_barrier_coordinate::finish_enable(_coordinate);
                 return;
             }
         }
@@ -704,7 +1240,7 @@ namespace csp
                 }
                     // Else if barrier is present finish enable
                 else if (_barrier_present)
-                    alting_barrier_coordinate::finish_enable();
+                    alting_barrier_coordinate::finish_enable(_coordinate);
                 return;
             }
         }
@@ -714,14 +1250,14 @@ namespace csp
 
         // If alting barrier present finish enable
         if (_barrier_present)
-            alting_barrier_coordinate::finish_enable();
+            alting_barrier_coordinate::finish_enable(_coordinate);
     }
 
     void alt::alt_internal::enable_guards(const std::vector<bool> &pre_conditions) noexcept
     {
         // If alting barrier exists then coordinate
         if (_barrier_present)
-            alting_barrier_coordinate::start_enable();
+            alting_barrier_coordinate::start_enable(_coordinate);
 
         // Set the currently selected barrier
         _barrier_selected = NONE_SELECTED;
@@ -745,7 +1281,7 @@ namespace csp
                 }
                     // Else if barrier is present finish enable
                 else if (_barrier_present)
-                    alting_barrier_coordinate::finish_enable();
+                    alting_barrier_coordinate::finish_enable(_coordinate);
                 return;
             }
         }
@@ -767,7 +1303,7 @@ namespace csp
                 }
                     // Else if barrier is present finish enable
                 else if (_barrier_present)
-                    alting_barrier_coordinate::finish_enable();
+                    alting_barrier_coordinate::finish_enable(_coordinate);
                 return;
             }
         }
@@ -777,7 +1313,7 @@ namespace csp
 
         // If alting barrier present finish enable
         if (_barrier_present)
-            alting_barrier_coordinate::finish_enable();
+            alting_barrier_coordinate::finish_enable(_coordinate);
     }
 
     void alt::alt_internal::disable_guards() noexcept(false)
@@ -849,7 +1385,7 @@ namespace csp
         if (_barrier_selected != NONE_SELECTED)
         {
             _selected = _barrier_selected;
-            alting_barrier_coordinate::finish_enable();
+            alting_barrier_coordinate::finish_disable(_coordinate);
         }
     }
 
@@ -922,7 +1458,7 @@ namespace csp
         if (_barrier_selected != NONE_SELECTED)
         {
             _selected = _barrier_selected;
-            alting_barrier_coordinate::finish_enable();
+            alting_barrier_coordinate::finish_disable(_coordinate);
         }
     }
 
@@ -939,6 +1475,9 @@ namespace csp
 
     int alt::alt_internal::pri_select() noexcept
     {
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select(true, nullptr);
         // Ensure that first guard gains priority
         _next = 0;
         // Perform select operation
@@ -948,6 +1487,9 @@ namespace csp
     int alt::alt_internal::pri_select(const std::vector<bool> &pre_conditions) noexcept
     {
         assert(pre_conditions.size() == _guards.size());
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select(true, &pre_conditions);
         // Ensure that tthat first guard gains priority
         _next = 0;
         // Perform select operation
@@ -956,6 +1498,9 @@ namespace csp
 
     int alt::alt_internal::fair_select() noexcept
     {
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select(false, nullptr);
         // Perform select operation
         int to_return = do_select();
         // Set next priority guard
@@ -966,6 +1511,9 @@ namespace csp
     int alt::alt_internal::fair_select(const std::vector<bool> &pre_conditions) noexcept
     {
         assert(pre_conditions.size() == _guards.size());
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select(false, &pre_conditions);
         // Perform select operation
         int to_return = do_select(pre_conditions);
         // Set next priority guard
@@ -973,11 +1521,270 @@ namespace csp
         return to_return;
     }
 
-    void alt::alt_internal::schedule() noexcept
+    bool alt::alt_internal::pri_select_async(async_op &op, const std::vector<bool> *pre_conditions, int &selected) noexcept
+    {
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select_async(op, true, pre_conditions, selected);
+        // Ensure that first guard gains priority
+        if (op._phase == 0)
+            _next = 0;
+        // Perform select operation
+        if (!do_select_async(op, pre_conditions))
+            return false;
+        selected = _selected;
+        return true;
+    }
+
+    bool alt::alt_internal::fair_select_async(async_op &op, const std::vector<bool> *pre_conditions, int &selected) noexcept
+    {
+        // Select from the ready queue if there is one
+        if (_ready_queue)
+            return do_ready_select_async(op, false, pre_conditions, selected);
+        // Perform select operation
+        if (!do_select_async(op, pre_conditions))
+            return false;
+        selected = _selected;
+        // Set next priority guard
+        _next = (_next == static_cast<int>(_guards.size())) ? 0 : (pre_conditions ? selected : selected + 1);
+        return true;
+    }
+
+    void alt::alt_internal::enable_queued(int index) noexcept
+    {
+        // Mark the guard as registered first, as it may schedule the alt as soon as it is enabled
+        {
+            std::lock_guard<std::mutex> lock(_mut);
+            _guard_state[index] = REGISTERED;
+        }
+        // Enable the guard, queueing it if it is already ready
+        _enable_index = index;
+        if (_guards[index].enable(alt(shared_from_this(), index)))
+        {
+            std::lock_guard<std::mutex> lock(_mut);
+            queue(index);
+        }
+    }
+
+    void alt::alt_internal::ready_enable(const std::vector<bool> *pre_conditions) noexcept
+    {
+        // Register the persistent guards selected since they were last enabled
+        for (size_t i = 0; i < _unregistered.size(); )
+        {
+            auto index = _unregistered[i];
+            if (pre_conditions && !(*pre_conditions)[index])
+            {
+                ++i;
+                continue;
+            }
+            _unregistered[i] = _unregistered.back();
+            _unregistered.pop_back();
+            enable_queued(index);
+        }
+        // Enable the guards that cannot stay registered
+        for (auto index : _polled)
+            if (!pre_conditions || (*pre_conditions)[index])
+                enable_queued(index);
+    }
+
+    int alt::alt_internal::ready_choose(bool priority, const std::vector<bool> *pre_conditions) const noexcept
+    {
+        // Pick the eligible queued guard closest to the guard with the highest priority
+        int n = int(_guards.size());
+        int start = priority ? 0 : _next % n;
+        int selected = NONE_SELECTED;
+        int best = n;
+        for (auto index : _ready)
+        {
+            if (pre_conditions && !(*pre_conditions)[index])
+                continue;
+            int distance = (index - start + n) % n;
+            if (distance < best)
+            {
+                best = distance;
+                selected = index;
+            }
+        }
+        return selected;
+    }
+
+    void alt::alt_internal::ready_disable(const std::vector<bool> *pre_conditions) noexcept
+    {
+        // Disable the guards enabled for this selection only
+        for (auto index : _polled)
+            if (!pre_conditions || (*pre_conditions)[index])
+                _guards[index].disable();
+        // Take them off the ready queue
+        std::lock_guard<std::mutex> lock(_mut);
+        for (auto index : _polled)
+        {
+            if (_guard_state[index] == QUEUED)
+                _ready.erase(std::find(_ready.begin(), _ready.end(), index));
+            _guard_state[index] = UNREGISTERED;
+        }
+    }
+
+    bool alt::alt_internal::ready_take(int selected) noexcept
+    {
+        // A guard enabled for this selection only has already been disabled
+        if (_guard_state[selected] != QUEUED)
+            return true;
+        // Disable the guard, checking that it has not withdrawn since it was queued
+        auto ready = _guards[selected].disable();
+        // Take it off the ready queue.  It is enabled again on the next selection.
+        std::lock_guard<std::mutex> lock(_mut);
+        _ready.erase(std::find(_ready.begin(), _ready.end(), selected));
+        _guard_state[selected] = UNREGISTERED;
+        _unregistered.push_back(selected);
+        return ready;
+    }
+
+    int alt::alt_internal::do_ready_select(bool priority, const std::vector<bool> *pre_conditions) noexcept
+    {
+        while (true)
+        {
+            // Set state to ENABLING
+            _state = STATE::ENABLING;
+
+            // Enable the guards that are not registered
+            ready_enable(pre_conditions);
+
+            {
+                // Lock the alt
+                std::unique_lock<std::mutex> lock(_mut);
+
+                // Wait until an eligible guard is queued, or the timeout is reached
+                while ((_selected = ready_choose(priority, pre_conditions)) == NONE_SELECTED)
+                {
+                    if (_timeout && std::chrono::steady_clock::now() >= _time)
+                    {
+                        _selected = _timer_index;
+                        break;
+                    }
+                    _state = STATE::WAITING;
+                    if (_timeout)
+                        _cond.wait_until(lock, _time);
+                    else
+                        _policy.wait(lock, _cond, [this]() { return _state != STATE::WAITING; });
+                }
+
+                // Set state to READY
+                _state = STATE::READY;
+            }
+
+            // Disable the guards enabled for this selection only
+            ready_disable(pre_conditions);
+
+            // Set state to inactive
+            _state = STATE::INACTIVE;
+            _timeout = false;
+
+            // Take the selected guard.  If it has withdrawn, select again.
+            if (ready_take(_selected))
+                break;
+        }
+
+        // Set next priority guard
+        if (!priority)
+            _next = (_selected + 1) % int(_guards.size());
+        return _selected;
+    }
+
+    bool alt::alt_internal::do_ready_select_async(async_op &op, bool priority, const std::vector<bool> *pre_conditions, int &selected) noexcept
+    {
+        while (true)
+        {
+            if (op._phase == 0)
+            {
+                // Set state to ENABLING
+                _state = STATE::ENABLING;
+
+                // Enable the guards that are not registered
+                ready_enable(pre_conditions);
+            }
+            else
+                // Woken by a guard or the timeout
+                _cond.finish_async(op);
+
+            {
+                // Lock the alt
+                std::unique_lock<std::mutex> lock(_mut);
+
+                // Pick a queued guard, or the timer if the timeout has been reached
+                _selected = ready_choose(priority, pre_conditions);
+                if (_selected == NONE_SELECTED && _timeout && std::chrono::steady_clock::now() >= _time)
+                    _selected = _timer_index;
+
+                // If nothing is ready, wait until time or guard becomes ready
+                if (_selected == NONE_SELECTED)
+                {
+                    _state = STATE::WAITING;
+                    op._phase = 1;
+                    if (_timeout)
+                        _cond.wait_async_until(lock, op, _time);
+                    else
+                        _cond.wait_async(lock, op);
+                    return false;
+                }
+
+                // Set state to READY
+                _state = STATE::READY;
+            }
+            op._phase = 0;
+
+            // Disable the guards enabled for this selection only
+            ready_disable(pre_conditions);
+
+            // Set state to inactive
+            _state = STATE::INACTIVE;
+            _timeout = false;
+
+            // Take the selected guard.  If it has withdrawn, select again.
+            if (ready_take(_selected))
+                break;
+        }
+
+        // Set next priority guard
+        selected = _selected;
+        if (!priority)
+            _next = (_selected + 1) % int(_guards.size());
+        return true;
+    }
+
+    void alt::alt_internal::release() noexcept
+    {
+        if (!_ready_queue)
+            return;
+        // Disable every guard that is still enabled
+        for (int i = 0; i < int(_guards.size()); ++i)
+        {
+            unsigned char state;
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                state = _guard_state[i];
+                _guard_state[i] = UNREGISTERED;
+            }
+            if (state != UNREGISTERED)
+                _guards[i].disable();
+        }
+        // Any later selection registers the persistent guards again
+        std::lock_guard<std::mutex> lock(_mut);
+        _ready.clear();
+        _unregistered.clear();
+        for (int i = 0; i < int(_guards.size()); ++i)
+            if (std::find(_polled.begin(), _polled.end(), i) == _polled.end())
+                _unregistered.push_back(i);
+    }
+
+    void alt::alt_internal::schedule(int index) noexcept
     {
         // Lock the mutex
         std::unique_lock<std::mutex> lock(_mut);
 
+        // Queue the guard if the alt has a ready queue
+        if (_ready_queue && index >= 0)
+            queue(index);
+
         // Depending on state of the alt set state to ready
         switch (_state)
         {
@@ -993,7 +1800,7 @@ namespace csp
         }
     }
 
-    void guard::guard_internal::schedule(const alt &a) const noexcept { a._internal->schedule(); }
+    void guard::guard_internal::schedule(const alt &a) const noexcept { a._internal->schedule(a._index); }
 
     void guard::guard_internal::set_timeout(const alt &a, const std::chrono::steady_clock::time_point &time) const noexcept { a._internal->set_timeout(time); }
 
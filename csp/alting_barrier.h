@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include "alt.h"
@@ -54,6 +55,8 @@ namespace csp
 
                 unsigned int _countdown = 0; //<! Number of processes yet to sync on the barrier
 
+                std::shared_ptr<alting_barrier_coordinate> _coordinate = std::make_shared<alting_barrier_coordinate>(); //<! Coordinator of the group the alting barrier belongs to
+
                 /*!
                  * \brief Creates a new alting barrier front end associated with the base.
                  *
@@ -113,7 +116,7 @@ namespace csp
                     {
                         // Signal all waiting front ends
                         _countdown = _enrolled;
-                        alting_barrier_coordinate::start_disable(_enrolled);
+                        alting_barrier_coordinate::start_disable(_coordinate, _enrolled);
                         for (auto &ab : _front_ends)
                             ab->schedule();
 
@@ -170,6 +173,21 @@ namespace csp
 
             timer _poll_time; //<! Used to support the poll method.
 
+            std::unique_ptr<alt> _single_alt = nullptr; //<! The alt sync selects with.  Made on first use.
+
+            std::unique_ptr<alt> _poll_alt = nullptr; //<! The alt poll selects with.  Made on first use.
+
+            /*!
+             * \brief Gets a front end to this alting barrier that does not own it, for the alts it
+             * keeps itself.  An owning one would keep the front end alive through its own alt.
+             *
+             * \return The front end.
+             */
+            alting_barrier unowned() noexcept
+            {
+                return alting_barrier(std::shared_ptr<alting_barrier_internal>(std::shared_ptr<alting_barrier_internal>(), this));
+            }
+
             /*!
              * \brief Creates a new alting barrier front end.  Used internally by the framework.
              *
@@ -282,9 +300,11 @@ namespace csp
              */
             void sync() noexcept override final
             {
-                static alt _single_alt = alt{alting_barrier(shared_from_this())};
+                // Each front end has its own alt, as front ends are owned by different processes
+                if (!_single_alt)
+                    _single_alt.reset(new alt{unowned()});
                 // Perform a priority select on the single alt
-                _single_alt.pri_select();
+                _single_alt->pri_select();
             }
 
             /*!
@@ -296,11 +316,22 @@ namespace csp
              */
             bool poll(const std::chrono::steady_clock::duration &offer_time) noexcept
             {
-                static alt _poll_alt = alt{alting_barrier(shared_from_this()), _poll_time};
+                if (!_poll_alt)
+                    _poll_alt.reset(new alt{unowned(), _poll_time});
                 // Set the time to wait for the poll
                 _poll_time += offer_time;
                 // Return whether alting barrier became ready in this time.
-                return (_poll_alt.pri_select() == 0);
+                return (_poll_alt->pri_select() == 0);
+            }
+
+            /*!
+             * \brief Gets the coordinator of the group the alting barrier belongs to.
+             *
+             * \return The coordinator of the group.
+             */
+            std::shared_ptr<alting_barrier_coordinate> coordinate() const noexcept override final
+            {
+                return _base->_coordinate;
             }
 
             /*!
@@ -331,7 +362,7 @@ namespace csp
                 }
                 else if (_thread != std::this_thread::get_id())
                     throw std::runtime_error("alting barrier not owned by this thread");
-                if (_enrolled)
+                if (!_enrolled)
                     throw std::runtime_error("alting barrier not enrolled");
 
                 // Check to make sure the alting barrier is only enabled once
@@ -459,7 +490,7 @@ namespace csp
             auto base = std::shared_ptr<alting_barrier_internal::alting_barrier_base>(new alting_barrier_internal::alting_barrier_base());
             // Create new vector of internals
             std::vector<std::shared_ptr<alting_barrier_internal>> ab(n);
-            for (unsigned int i = 0; i < n; ++n)
+            for (unsigned int i = 0; i < n; ++i)
                 ab[i] = std::shared_ptr<alting_barrier_internal>(new alting_barrier_internal(base));
             // Exapand base with new front ends
             base->expand(ab);
@@ -540,7 +571,7 @@ namespace csp
             if (_internal->_thread != std::this_thread::get_id())
                 throw std::runtime_error("alting barrier not owned by thread");
             // Ensure that alting barrier is enrolled
-            if (_internal->_enrolled)
+            if (!_internal->_enrolled)
                 throw std::runtime_error("alting barrier not enrolled");
             // Contract the base
             _internal->_base->contract(_internal);
@@ -561,7 +592,7 @@ namespace csp
             if (_internal->_thread != std::this_thread::get_id())
                 throw std::runtime_error("alting barrier not owned by thread");
             // Ensure that alting barrier is enrolled
-            if (_internal->_enrolled)
+            if (!_internal->_enrolled)
                 throw std::runtime_error("alting barrier not enrolled");
             // Extract the internal objects
             std::vector<std::shared_ptr<alting_barrier_internal>> internals;
@@ -596,6 +627,7 @@ namespace csp
 
         // Set alting barrier base pointed to by alting barrier
         ab->_base = nullptr;
+        _front_ends.erase(found);
 
         // Decrement enrolled and countdown if necessary
         if (ab->_enrolled)
@@ -612,8 +644,8 @@ namespace csp
             // If there are processes enrolled then signal them
             if (_enrolled > 0)
             {
-                alting_barrier_coordinate::start_enable();
-                alting_barrier_coordinate::start_disable(_enrolled);
+                alting_barrier_coordinate::start_enable(_coordinate);
+                alting_barrier_coordinate::start_disable(_coordinate, _enrolled);
 
                 for (auto &b : _front_ends)
                     b->schedule();
@@ -627,12 +659,12 @@ namespace csp
         for (auto &b : ab)
         {
             // Find front end
-            auto found = std::find(_front_ends.begin(), _front_ends.end(), b);
-            if (found != _front_ends.end())
+            auto front_end = std::find(_front_ends.begin(), _front_ends.end(), b);
+            if (front_end != _front_ends.end())
             {
                 // Front end found.  Erase and increment found.
                 b->_base = nullptr;
-                _front_ends.erase(found);
+                _front_ends.erase(front_end);
                 ++found;
                 // Increment discarded if required
                 if (b->_enrolled)
@@ -654,8 +686,8 @@ namespace csp
             _countdown = _enrolled;
             if (_enrolled > 0)
             {
-                alting_barrier_coordinate::start_enable();
-                alting_barrier_coordinate::start_disable(_enrolled);
+                alting_barrier_coordinate::start_enable(_coordinate);
+                alting_barrier_coordinate::start_disable(_coordinate, _enrolled);
                 for (auto &b : _front_ends)
                     b->schedule();
             }
@@ -669,15 +701,15 @@ namespace csp
         --_countdown;
 
         // Check if alting barrier has now become ready
-        if (_countdown)
+        if (_countdown == 0)
         {
             _countdown = _enrolled;
 
             // If enrolled > 0 then signal waiting front ends
             if (_enrolled > 0)
             {
-                alting_barrier_coordinate::start_enable();
-                alting_barrier_coordinate::start_disable(_enrolled);
+                alting_barrier_coordinate::start_enable(_coordinate);
+                alting_barrier_coordinate::start_disable(_coordinate, _enrolled);
                 for (auto &ab : _front_ends)
                     ab->schedule();
             }
@@ -6,11 +6,28 @@
 #define CPP_CSP_BARRIER_H
 
 #include <mutex>
-#include <condition_variable>
 #include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include "fiber_scheduler.h"
+#include "wait_strategy.h"
+#include "chan_waiter.h"
 
 namespace csp
 {
+    /*! \enum barrier_kind
+     * \brief The ways a barrier can be implemented.
+     */
+    enum class barrier_kind : unsigned char
+    {
+        CENTRAL         = 0,    //!< A count behind a lock.  Processes can enrol and resign at any time.
+        SENSE_REVERSING = 1,    //!< A count updated atomically, with processes waiting for the phase to change
+        COMBINING_TREE  = 2,    //!< Arrivals combined up a tree.  Fixed size.
+        DISSEMINATION   = 3,    //!< Processes signal each other in log2(n) rounds.  Fixed size.
+    };
+
     /*! \class barrier
      * \brief Allows synchronization between a set of processes.
      *
@@ -35,7 +52,11 @@ namespace csp
 
             std::mutex _mut; //<! Mutex used to control access to the barrier
 
-            std::condition_variable _cond; //<! Condition variable used to control synchronized communication within the barrier
+            condition _cond; //<! Condition variable used to control synchronized communication within the barrier
+
+            unsigned int _phase = 0; //<! Number of synchronizations completed.  Waiting processes watch for it to change.
+
+            wait_policy _policy; //<! How processes wait for the rest to synchronize
 
         public:
             /*!
@@ -73,10 +94,15 @@ namespace csp
 
                 // Check if last process has synchronized
                 if (_count_down > 0)
-                    _cond.wait(lock);
+                {
+                    // Wait for the phase to complete
+                    auto phase = _phase;
+                    _policy.wait(lock, _cond, [&]() { return _phase != phase; });
+                }
                 else
                 {
                     _count_down = _enrolled;
+                    ++_phase;
                     _cond.notify_all();
                 }
             }
@@ -107,6 +133,7 @@ namespace csp
                 if (_count_down == 0)
                 {
                     _count_down = _enrolled;
+                    ++_phase;
                     _cond.notify_all();
                 }
             }
@@ -124,6 +151,440 @@ namespace csp
                 _enrolled = enrolled;
                 _count_down = enrolled;
             }
+
+            /*!
+             * \brief Sets how processes wait on the barrier
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            virtual void set_wait_strategy(wait_strategy strategy) noexcept { _policy.set(strategy); }
+        };
+
+        /*! \class sense_barrier_internal
+         * \brief A centralised sense-reversing barrier.  Arriving is a single atomic update, and
+         * processes wait for the sense to change rather than for a lock.
+         *
+         * The sense is a count of completed phases.  A process reads it before arriving and waits
+         * for it to move on, so a fast process starting the next phase cannot be confused with one
+         * still leaving the last.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class sense_barrier_internal : public barrier_internal
+        {
+        private:
+            std::atomic<std::uint64_t> _state; //!< Number enrolled in the high word, number still to arrive in the low word.
+
+            std::atomic<unsigned int> _sense; //!< Number of phases completed.
+
+            chan_waiter _waiter; //!< Used to wait for the sense to change.
+
+            /*!
+             * \brief Arrives at the barrier, completing the phase if last.
+             *
+             * \param[in] leave True if the process is also resigning.
+             */
+            void arrive(bool leave) noexcept
+            {
+                auto state = _state.load();
+                std::uint64_t next;
+                bool last;
+                do
+                {
+                    auto enrolled = (state >> 32) - (leave ? 1 : 0);
+                    auto remaining = (state & 0xFFFFFFFF) - 1;
+                    last = remaining == 0;
+                    // The last to arrive sets up the next phase
+                    next = (enrolled << 32) | (last ? enrolled : remaining);
+                } while (!_state.compare_exchange_weak(state, next));
+                if (last)
+                {
+                    _sense.fetch_add(1);
+                    _waiter.wake();
+                }
+            }
+
+        public:
+            /*!
+             * \brief Creates a new barrier with enrolled processes.
+             *
+             * \param[in] enrolled Number of processes to enrol.
+             */
+            sense_barrier_internal(unsigned int enrolled) noexcept
+            : _state((std::uint64_t(enrolled) << 32) | enrolled), _sense(0)
+            {
+            }
+
+            /*!
+             * \brief Syncs a process with the barrier.
+             */
+            void sync() noexcept override final
+            {
+                auto sense = _sense.load();
+                arrive(false);
+                _waiter.await([&]() { return _sense.load() != sense; });
+            }
+
+            /*!
+             * \brief Enrolls another process with the barrier.
+             */
+            void enroll() noexcept(false) override final
+            {
+                _state.fetch_add((std::uint64_t(1) << 32) | 1);
+            }
+
+            /*!
+             * \brief Resigns a process from the barrier.
+             */
+            void resign() noexcept(false) override final
+            {
+                arrive(true);
+            }
+
+            /*!
+             * \brief Resets the number of processes enrolled.  No process may be waiting on the barrier.
+             *
+             * \param[in] enrolled The number of processes to be enrolled with the barrier.
+             */
+            void reset(unsigned int enrolled) noexcept override final
+            {
+                _state.store((std::uint64_t(enrolled) << 32) | enrolled);
+            }
+
+            /*!
+             * \brief Sets how processes wait on the barrier.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _waiter.set_strategy(strategy); }
+        };
+
+        /*! \class fixed_barrier_internal
+         * \brief Base of the barriers built for a fixed number of processes.  Processes take a
+         * ticket when they arrive.  The ticket gives the phase the process is in and its place in
+         * the barrier for that phase, so processes need no identity of their own.
+         *
+         * The number enrolled can only be changed by reset, while no process is using the barrier.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class fixed_barrier_internal : public barrier_internal
+        {
+        protected:
+            unsigned int _size = 0; //!< Number of processes enrolled.
+
+            std::atomic<std::uint64_t> _ticket; //!< Number of arrivals since the barrier was reset.
+
+            wait_strategy _strategy = wait_strategy::DEFAULT; //!< Strategy given to the waiters.
+
+            /*!
+             * \brief Rebuilds the barrier for the given number of processes.
+             *
+             * \param[in] size The number of processes.
+             */
+            virtual void build(unsigned int size) noexcept = 0;
+
+            /*!
+             * \brief Gives the wait strategy to every waiter of the barrier.
+             */
+            virtual void apply_strategy() noexcept = 0;
+
+        public:
+            /*!
+             * \brief Creates an empty barrier.
+             */
+            fixed_barrier_internal() noexcept
+            : _ticket(0)
+            {
+            }
+
+            /*!
+             * \brief Fixed barriers cannot grow while in use.  Use reset.
+             */
+            void enroll() noexcept(false) override final
+            {
+                throw std::logic_error("Barrier has a fixed number of processes.  Use reset to change it.");
+            }
+
+            /*!
+             * \brief Fixed barriers cannot shrink while in use.  Use reset.
+             */
+            void resign() noexcept(false) override final
+            {
+                throw std::logic_error("Barrier has a fixed number of processes.  Use reset to change it.");
+            }
+
+            /*!
+             * \brief Resets the number of processes enrolled.  No process may be using the barrier.
+             *
+             * \param[in] enrolled The number of processes to be enrolled with the barrier.
+             */
+            void reset(unsigned int enrolled) noexcept override final
+            {
+                build(enrolled);
+                _size = enrolled;
+                _ticket.store(0);
+                apply_strategy();
+            }
+
+            /*!
+             * \brief Sets how processes wait on the barrier.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final
+            {
+                _strategy = strategy;
+                apply_strategy();
+            }
+        };
+
+        /*! \class tree_barrier_internal
+         * \brief A combining tree barrier.  Processes arrive at the leaves in groups of FAN_IN, and
+         * the last to arrive at a node carries the arrival up to its parent.  The last to arrive at
+         * the root releases the phase.  Processes park on their leaf, so a release wakes each leaf
+         * separately rather than every process through one lock.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class tree_barrier_internal : public fixed_barrier_internal
+        {
+        private:
+            static constexpr unsigned int FAN_IN = 4; //!< Number of arrivals combined at each node.
+
+            /*! \class node
+             * \brief A node of the tree.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class node
+            {
+            public:
+                std::atomic<unsigned int> _count; //!< Number arrived at the node this phase.
+
+                unsigned int _expected = 0; //!< Number that arrive at the node each phase.
+
+                node *_parent = nullptr; //!< The parent node, or nullptr for the root.
+
+                chan_waiter _waiter; //!< Used by processes of a leaf to wait for the release.
+
+                node() noexcept
+                : _count(0)
+                {
+                }
+            };
+
+            std::vector<std::unique_ptr<node>> _nodes; //!< Nodes of the tree.  The leaves come first.  Never shrinks.
+
+            unsigned int _leaves = 0; //!< Number of leaves in the tree.
+
+            std::atomic<std::uint64_t> _released; //!< Number of phases released.
+
+        protected:
+            /*!
+             * \brief Rebuilds the tree for the given number of processes.
+             *
+             * \param[in] size The number of processes.
+             */
+            void build(unsigned int size) noexcept override final
+            {
+                // Work out each level, from the leaves up
+                std::vector<unsigned int> level_sizes;
+                auto arrivals = size;
+                do
+                {
+                    level_sizes.push_back((arrivals + FAN_IN - 1) / FAN_IN);
+                    arrivals = level_sizes.back();
+                } while (arrivals > 1);
+                unsigned int total = 0;
+                for (auto n : level_sizes)
+                    total += n;
+                // Nodes are kept, as a released process may still be leaving one
+                while (_nodes.size() < total)
+                    _nodes.push_back(std::unique_ptr<node>(new node()));
+                // Link each level to the one above
+                unsigned int start = 0;
+                arrivals = size;
+                for (size_t level = 0; level < level_sizes.size(); ++level)
+                {
+                    auto parents = start + level_sizes[level];
+                    for (unsigned int i = 0; i < level_sizes[level]; ++i)
+                    {
+                        auto &n = _nodes[start + i];
+                        n->_count.store(0);
+                        auto left = arrivals - i * FAN_IN;
+                        n->_expected = left < FAN_IN ? left : FAN_IN;
+                        n->_parent = level + 1 < level_sizes.size() ? _nodes[parents + i / FAN_IN].get() : nullptr;
+                    }
+                    arrivals = level_sizes[level];
+                    start = parents;
+                }
+                _leaves = level_sizes[0];
+                _released.store(0);
+            }
+
+            /*!
+             * \brief Gives the wait strategy to the waiter of each leaf.
+             */
+            void apply_strategy() noexcept override final
+            {
+                for (auto &n : _nodes)
+                    n->_waiter.set_strategy(_strategy);
+            }
+
+        public:
+            /*!
+             * \brief Creates a new barrier with enrolled processes.
+             *
+             * \param[in] enrolled Number of processes to enrol.
+             */
+            tree_barrier_internal(unsigned int enrolled) noexcept
+            : _released(0)
+            {
+                reset(enrolled);
+            }
+
+            /*!
+             * \brief Syncs a process with the barrier.
+             */
+            void sync() noexcept override final
+            {
+                if (_size < 2)
+                    return;
+                // The ticket gives the phase and the leaf to arrive at
+                auto ticket = _ticket.fetch_add(1);
+                auto phase = ticket / _size;
+                auto leaf = _nodes[static_cast<unsigned int>(ticket % _size) / FAN_IN].get();
+                // Climb while last to arrive at a node.  The node is ready for the next phase as
+                // soon as its last process has arrived.
+                auto n = leaf;
+                while (n->_count.fetch_add(1) + 1 == n->_expected)
+                {
+                    n->_count.store(0);
+                    if (!n->_parent)
+                    {
+                        // Last to arrive at the root.  Release the phase and wake each leaf.
+                        _released.store(phase + 1);
+                        for (unsigned int i = 0; i < _leaves; ++i)
+                            _nodes[i]->_waiter.wake();
+                        return;
+                    }
+                    n = n->_parent;
+                }
+                // Wait for the release
+                leaf->_waiter.await([&]() { return _released.load() > phase; });
+            }
+        };
+
+        /*! \class dissemination_barrier_internal
+         * \brief A dissemination barrier.  In each of log2(n) rounds, process i signals process
+         * i + 2^round and waits for the signal from process i - 2^round.  After the last round
+         * every process has heard from every other.  There is no last process to release the rest,
+         * and each process waits on its own flags.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class dissemination_barrier_internal : public fixed_barrier_internal
+        {
+        private:
+            /*! \class slot
+             * \brief The flags of one place in the barrier.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class slot
+            {
+            public:
+                std::unique_ptr<std::atomic<std::uint64_t>[]> _flags; //!< The last phase signalled in each round.
+
+                chan_waiter _waiter; //!< Used to wait for a signal.
+            };
+
+            std::vector<std::unique_ptr<slot>> _slots; //!< A slot for each place in the barrier.  Never shrinks.
+
+            unsigned int _rounds = 0; //!< Number of rounds.
+
+        protected:
+            /*!
+             * \brief Rebuilds the slots for the given number of processes.
+             *
+             * \param[in] size The number of processes.
+             */
+            void build(unsigned int size) noexcept override final
+            {
+                _rounds = 0;
+                while ((1u << _rounds) < size)
+                    ++_rounds;
+                // Slots are kept, as a process may still be leaving one
+                while (_slots.size() < size)
+                    _slots.push_back(std::unique_ptr<slot>(new slot()));
+                for (auto &s : _slots)
+                {
+                    s->_flags.reset(new std::atomic<std::uint64_t>[_rounds]);
+                    for (unsigned int round = 0; round < _rounds; ++round)
+                        s->_flags[round].store(0);
+                }
+            }
+
+            /*!
+             * \brief Gives the wait strategy to the waiter of each slot.
+             */
+            void apply_strategy() noexcept override final
+            {
+                for (auto &s : _slots)
+                    s->_waiter.set_strategy(_strategy);
+            }
+
+        public:
+            /*!
+             * \brief Creates a new barrier with enrolled processes.
+             *
+             * \param[in] enrolled Number of processes to enrol.
+             */
+            dissemination_barrier_internal(unsigned int enrolled) noexcept
+            {
+                reset(enrolled);
+            }
+
+            /*!
+             * \brief Syncs a process with the barrier.
+             */
+            void sync() noexcept override final
+            {
+                if (_size < 2)
+                    return;
+                // The ticket gives the phase and the place to take.  Phases are counted from one
+                // so that a zero flag is never signalled.
+                auto ticket = _ticket.fetch_add(1);
+                auto phase = ticket / _size + 1;
+                auto i = static_cast<unsigned int>(ticket % _size);
+                auto &me = *_slots[i];
+                for (unsigned int round = 0; round < _rounds; ++round)
+                {
+                    // Signal the partner.  Places are handed out again each phase, so a process
+                    // holding the place in a later phase may already have signalled it.  Never
+                    // lower the flag.
+                    auto &partner = *_slots[(i + (1u << round)) % _size];
+                    auto &flag = partner._flags[round];
+                    auto seen = flag.load();
+                    while (seen < phase && !flag.compare_exchange_weak(seen, phase)) { }
+                    partner._waiter.wake();
+                    // Wait for our signal.  A fast process may already have signalled the next phase.
+                    me._waiter.await([&]() { return me._flags[round].load() >= phase; });
+                }
+            }
         };
 
         std::shared_ptr<barrier_internal> _internal = nullptr; //<! Pointer to internal representation of the barrier
@@ -157,6 +618,44 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Creates a new barrier of the given kind with enrolled processes.  Fixed size
+         * barriers cannot be enrolled on or resigned from.
+         *
+         * \param[in] size The number of processes to be enrolled with the barrier.
+         * \param[in] kind The kind of barrier.
+         */
+        barrier(unsigned int size, barrier_kind kind) noexcept
+        {
+            switch (kind)
+            {
+                case barrier_kind::SENSE_REVERSING:
+                    _internal = std::shared_ptr<barrier_internal>(new sense_barrier_internal(size));
+                    break;
+                case barrier_kind::COMBINING_TREE:
+                    _internal = std::shared_ptr<barrier_internal>(new tree_barrier_internal(size));
+                    break;
+                case barrier_kind::DISSEMINATION:
+                    _internal = std::shared_ptr<barrier_internal>(new dissemination_barrier_internal(size));
+                    break;
+                default:
+                    _internal = std::shared_ptr<barrier_internal>(new barrier_internal(size));
+                    break;
+            }
+        }
+
+        /*!
+         * \brief Gets the kind of fixed size barrier that syncs processes fastest.  The
+         * sense-reversing barrier beats the central one at every size barrierbench measures, and
+         * beats or stays close to the combining tree and dissemination barriers.
+         *
+         * \return The kind of barrier to use.
+         */
+        static barrier_kind best_kind() noexcept
+        {
+            return barrier_kind::SENSE_REVERSING;
+        }
+
         /*!
          * \brief Syncs a process with the barrier.
          */
@@ -170,12 +669,12 @@ namespace csp
         /*!
          * \brief Enrolls another process with the barrier.
          */
-        void enroll() const noexcept { _internal->enroll(); }
+        void enroll() const noexcept(false) { _internal->enroll(); }
 
         /*!
          * \brief Resigns a process from the barrier.
          */
-        void resign() const noexcept { _internal->resign(); }
+        void resign() const noexcept(false) { _internal->resign(); }
 
         /*!
          * \brief Resets the number of processes enrolled.
@@ -183,6 +682,13 @@ namespace csp
          * \param[in] enrolled The number of processes to be enrolled with the barrier.
          */
         void reset(unsigned int enrolled) const noexcept { _internal->reset(enrolled); }
+
+        /*!
+         * \brief Sets how processes wait on the barrier.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _internal->set_wait_strategy(strategy); }
     };
 }
 
@@ -8,11 +8,17 @@
 #include <memory>
 #include <limits>
 #include <mutex>
-#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
 #include "poison_exception.h"
 #include "alt.h"
 #include "alting_barrier.h"
 #include "chan_data_store.h"
+#include "chan_waiter.h"
+#include "fiber_scheduler.h"
+#include "coroutine.h"
 
 namespace csp
 {
@@ -31,6 +37,23 @@ namespace csp
     class any2one_chan;
     template<typename T, bool POISONABLE>
     class any2any_chan;
+    template<typename T, typename KIND, bool BUFFERED, bool POISONABLE>
+    class static_chan;
+    template<typename T, typename KIND, bool BUFFERED, bool POISONABLE>
+    class static_chan_in;
+    template<typename T, typename KIND, bool BUFFERED, bool POISONABLE>
+    class static_chan_out;
+    namespace net
+    {
+        template<typename T, bool POISONABLE>
+        class net_chan_in;
+        template<typename T, bool POISONABLE>
+        class net_chan_out;
+        template<typename T, bool POISONABLE>
+        class shm_chan_in;
+        template<typename T, bool POISONABLE>
+        class shm_chan_out;
+    }
 
     /*! \class chan
      * \brief A channel object.
@@ -47,6 +70,8 @@ namespace csp
         friend class chan_in<T, POISONABLE>;
         friend class chan_out<T, POISONABLE>;
         friend class alting_chan_in<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
     protected:
         /*! \class chan_internal
          * \brief Internal representation of a channel object.
@@ -84,6 +109,117 @@ namespace csp
              */
             virtual void end_read() noexcept(false) = 0;
 
+            /*!
+             * \brief Performs the next step of a write operation for a process that cannot block.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value Value to write to the channel.  Moved from by the first step.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            virtual bool write_async(async_op &op, T &value) noexcept(false) = 0;
+
+            /*!
+             * \brief Performs the next step of a read operation for a process that cannot block.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            virtual bool read_async(async_op &op, T &value) noexcept(false) = 0;
+
+            /*!
+             * \brief Writes a number of values to the channel.  By default performs a write for each
+             * value.  Channels override this to hand the values over in as few synchronisations as
+             * they can.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            virtual void write_n(const T *values, size_t n) noexcept(false)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    write(batch_copy(values[i]));
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  By default performs a read for each
+             * value.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            virtual void read_n(T *values, size_t n) noexcept(false)
+            {
+                for (size_t i = 0; i < n; ++i)
+                    values[i] = read();
+            }
+
+            /*!
+             * \brief Writes a value to the channel only if it can complete without waiting for a
+             * reader to arrive.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            virtual bool try_write(T &value) noexcept(false) = 0;
+
+            /*!
+             * \brief Reads a value from the channel only if one is available without waiting.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            virtual bool try_read(T &value) noexcept(false) = 0;
+
+            /*!
+             * \brief Writes a value to the channel, giving up if the write has not been accepted
+             * by the given time.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            virtual bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) = 0;
+
+            /*!
+             * \brief Reads a value from the channel, giving up if no value is available by the
+             * given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            virtual bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) = 0;
+
+            /*!
+             * \brief Checks if the channel can be used by several writers, and several readers, at
+             * once.  Shared ends of such a channel only lock for batched and extended operations.
+             *
+             * \return True if the channel handles concurrent writers and readers itself, false otherwise.
+             */
+            virtual bool concurrent() const noexcept { return false; }
+
+            /*!
+             * \brief Sets how processes wait on the channel.  Channels that do not wait ignore this.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            virtual void set_wait_strategy(wait_strategy) noexcept { }
+
+            /*!
+             * \brief Channels keep an alt registered until a writer schedules it or the alt disables
+             * the channel.
+             *
+             * \return Always true.
+             */
+            bool persistent() const noexcept override { return true; }
+
             /*!
              * \brief Checks if a message is pending on the channel.
              *
@@ -139,6 +275,87 @@ namespace csp
          */
         void end_read() const noexcept(false) { _internal->end_read(); }
 
+        /*!
+         * \brief Performs the next step of a write operation.
+         *
+         * \param[in] op The state of the operation.
+         * \param[in] value Value to write to the channel.
+         *
+         * \return True if the write has completed, false if the operation is waiting.
+         */
+        bool write_async(async_op &op, T &value) const noexcept(false) { return _internal->write_async(op, value); }
+
+        /*!
+         * \brief Performs the next step of a read operation.
+         *
+         * \param[in] op The state of the operation.
+         * \param[out] value Set to the value read once the read has completed.
+         *
+         * \return True if the read has completed, false if the operation is waiting.
+         */
+        bool read_async(async_op &op, T &value) const noexcept(false) { return _internal->read_async(op, value); }
+
+        /*!
+         * \brief Writes a number of values to the channel.
+         *
+         * \param[in] values The values to write.
+         * \param[in] n The number of values to write.
+         */
+        void write_n(const T *values, size_t n) const noexcept(false) { _internal->write_n(values, n); }
+
+        /*!
+         * \brief Reads a number of values from the channel.
+         *
+         * \param[out] values Where to put the values read.
+         * \param[in] n The number of values to read.
+         */
+        void read_n(T *values, size_t n) const noexcept(false) { _internal->read_n(values, n); }
+
+        /*!
+         * \brief Writes a value to the channel if it can complete without waiting for a reader.
+         *
+         * \param[in,out] value Value to write to the channel.  Moved from only if written.
+         *
+         * \return True if the value was written, false otherwise.
+         */
+        bool try_write(T &value) const noexcept(false) { return _internal->try_write(value); }
+
+        /*!
+         * \brief Reads a value from the channel if one is available without waiting.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         *
+         * \return True if a value was read, false otherwise.
+         */
+        bool try_read(T &value) const noexcept(false) { return _internal->try_read(value); }
+
+        /*!
+         * \brief Writes a value to the channel, giving up at the given time.
+         *
+         * \param[in,out] value Value to write to the channel.  Moved from only if written.
+         * \param[in] time The time to give up the write.
+         *
+         * \return True if the value was written, false if the time was reached first.
+         */
+        bool write_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _internal->write_until(value, time); }
+
+        /*!
+         * \brief Reads a value from the channel, giving up at the given time.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         * \param[in] time The time to give up the read.
+         *
+         * \return True if a value was read, false if the time was reached first.
+         */
+        bool read_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _internal->read_until(value, time); }
+
+        /*!
+         * \brief Checks if the channel handles concurrent writers and readers itself.
+         *
+         * \return True if shared ends need not lock single operations, false otherwise.
+         */
+        bool concurrent() const noexcept { return _internal->concurrent(); }
+
         /*!
          * \brief Checks if a message is pending on the channel.
          *
@@ -202,6 +419,13 @@ namespace csp
          * \brief Virtual destructor - interface class.
          */
         virtual ~chan() noexcept { }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _internal->set_wait_strategy(strategy); }
     };
 
     /*! \class chan_in
@@ -268,12 +492,56 @@ namespace csp
              */
             virtual void end_read() const noexcept(false) { _chan.end_read(); }
 
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            virtual bool read_async(async_op &op, T &value) const noexcept(false) { return _chan.read_async(op, value); }
+
+            /*!
+             * \brief Reads a number of values.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            virtual void read_n(T *values, size_t n) const noexcept(false) { _chan.read_n(values, n); }
+
+            /*!
+             * \brief Reads a value if one is available without waiting.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            virtual bool try_read(T &value) const noexcept(false) { return _chan.try_read(value); }
+
+            /*!
+             * \brief Reads a value, giving up at the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            virtual bool read_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _chan.read_until(value, time); }
+
             /*!
              * \brief Poisons the channel end.
              *
              * \param strength The strength of the poison to apply to the channel.
              */
             virtual void poison(unsigned int strength) const noexcept { _chan.reader_poison(strength); }
+
+            /*!
+             * \brief Checks if the channel handles concurrent readers itself.
+             *
+             * \return True if the channel can be read by several processes at once, false otherwise.
+             */
+            bool concurrent() const noexcept { return _chan.concurrent(); }
         };
 
         std::shared_ptr<chan_in_internal> _internal = nullptr; //<! Pointer to the internal representation.
@@ -370,6 +638,90 @@ namespace csp
          */
         void end_read() const noexcept(false) { _internal->end_read(); }
 
+        /*!
+         * \brief Reads a number of values from the channel.  Values written in a batch are taken
+         * in as few synchronisations as the channel allows.
+         *
+         * \param[out] values Where to put the values read.
+         * \param[in] n The number of values to read.
+         */
+        void read_n(T *values, size_t n) const noexcept(false) { _internal->read_n(values, n); }
+
+        /*!
+         * \brief Reads a value from the channel only if one is available without waiting.  Costs a
+         * single check of the channel, so is cheaper than an alt with a skip guard when polling.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         *
+         * \return True if a value was read, false otherwise.
+         */
+        bool try_read(T &value) const noexcept(false) { return _internal->try_read(value); }
+
+        /*!
+         * \brief Reads a value from the channel, giving up if none is available by the given time.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         * \param[in] time The time to give up the read.
+         *
+         * \return True if a value was read, false if the time was reached first.
+         */
+        bool read_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _internal->read_until(value, time); }
+
+        /*!
+         * \brief Reads a value from the channel, giving up if none is available within the given
+         * duration.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         * \param[in] duration The time to wait for a value.
+         *
+         * \return True if a value was read, false if the duration passed first.
+         */
+        template<typename Rep, typename Period>
+        bool read_for(T &value, const std::chrono::duration<Rep, Period> &duration) const noexcept(false)
+        {
+            return _internal->read_until(value, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+        }
+
+#if defined(__cpp_impl_coroutine)
+        /*! \class read_op
+         * \brief Awaitable read operation.  The result of the co_await is the value read.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class read_op : public co_op
+        {
+        private:
+            std::shared_ptr<chan_in_internal> _in; //!< The channel end being read from.
+
+            T _value = T(); //!< The value read.
+
+        protected:
+            bool step() noexcept(false) override final { return _in->read_async(*this, _value); }
+
+        public:
+            read_op(const std::shared_ptr<chan_in_internal> &in) noexcept
+            : _in(in)
+            {
+            }
+
+            T await_resume() noexcept(false)
+            {
+                this->rethrow();
+                return std::move(_value);
+            }
+        };
+
+        /*!
+         * \brief Reads a value from the channel within a coroutine, suspending the coroutine rather
+         * than blocking.  Use as co_await in.co_read().
+         *
+         * \return The awaitable read operation.
+         */
+        read_op co_read() const noexcept { return read_op(_internal); }
+#endif
+
         /*!
          * \brief Poisons the channel.
          *
@@ -398,6 +750,8 @@ namespace csp
         // Friend declarations
         friend class one2any_chan<T, POISONABLE>;
         friend class any2any_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
     protected:
         /*! \class shared_chan_in_internal
          * \brief Internal representation of a shared channel input.
@@ -410,7 +764,9 @@ namespace csp
         {
         public:
 
-            mutable std::mutex _mut; //<! Mutex used to control access to the channel.
+            mutable process_mutex _mut; //<! Mutex used to control access to the channel.
+
+            const bool _concurrent; //!< Flag set if the channel handles concurrent readers, so single reads need not lock.
 
             /*!
              * \brief Creates a new internal shared channel input.
@@ -419,7 +775,7 @@ namespace csp
              * \param[in] immunity The poison immunity level.
              */
             shared_chan_in_internal(chan<T, POISONABLE> chan, unsigned int immunity) noexcept
-            : chan_in<T, POISONABLE>::chan_in_internal(chan, immunity)
+            : chan_in<T, POISONABLE>::chan_in_internal(chan, immunity), _concurrent(chan_in<T, POISONABLE>::chan_in_internal::concurrent())
             {
             }
 
@@ -430,12 +786,72 @@ namespace csp
              */
             T read() const noexcept(false) override
             {
+                // A concurrent channel queues readers itself
+                if (_concurrent)
+                    return chan_in<T, POISONABLE>::chan_in_internal::read();
                 // Lock the channel
-                std::unique_lock<std::mutex> lock(_mut);
+                std::unique_lock<process_mutex> lock(_mut);
                 // Perform the read
                 return chan_in<T, POISONABLE>::chan_in_internal::read();
             }
 
+            /*!
+             * \brief Reads a number of values from the channel.  The channel is locked for the whole batch.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) const noexcept(false) override
+            {
+                // Lock the channel
+                std::unique_lock<process_mutex> lock(_mut);
+                // Perform the read
+                chan_in<T, POISONABLE>::chan_in_internal::read_n(values, n);
+            }
+
+            /*!
+             * \brief Reads a value from the channel if one is available without waiting.  Fails if
+             * another reader holds the channel.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) const noexcept(false) override
+            {
+                // A concurrent channel queues readers itself
+                if (_concurrent)
+                    return chan_in<T, POISONABLE>::chan_in_internal::try_read(value);
+                // Lock the channel if no other reader has it
+                std::unique_lock<process_mutex> lock(_mut, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return false;
+                // Perform the read
+                return chan_in<T, POISONABLE>::chan_in_internal::try_read(value);
+            }
+
+            /*!
+             * \brief Reads a value from the channel, giving up at the given time.  Time spent waiting
+             * for other readers counts towards the timeout.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) override
+            {
+                // A concurrent channel queues readers itself
+                if (_concurrent)
+                    return chan_in<T, POISONABLE>::chan_in_internal::read_until(value, time);
+                // Lock the channel
+                std::unique_lock<process_mutex> lock(_mut, time);
+                if (!lock.owns_lock())
+                    return false;
+                // Perform the read
+                return chan_in<T, POISONABLE>::chan_in_internal::read_until(value, time);
+            }
+
             /*!
              * \brief Starts an extended read on the channel.
              *
@@ -460,6 +876,42 @@ namespace csp
                 _mut.unlock();
             }
 
+            /*!
+             * \brief Performs the next step of a read operation.  The channel is locked for the whole read.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) const noexcept(false) override
+            {
+                // A concurrent channel queues readers itself
+                if (_concurrent)
+                    return chan_in<T, POISONABLE>::chan_in_internal::read_async(op, value);
+                // Lock the channel
+                if (!op._locked)
+                {
+                    if (!_mut.lock_async(op))
+                        return false;
+                    op._locked = true;
+                }
+                // Perform the read, keeping the lock while waiting
+                try
+                {
+                    if (!chan_in<T, POISONABLE>::chan_in_internal::read_async(op, value))
+                        return false;
+                }
+                catch (...)
+                {
+                    _mut.unlock();
+                    throw;
+                }
+                // Unlock the channel
+                _mut.unlock();
+                return true;
+            }
+
             /*!
              * \brief Poisons the channel.
              *
@@ -467,8 +919,11 @@ namespace csp
              */
             void poison(unsigned int strength) const noexcept override
             {
+                // A concurrent channel is poisoned without waiting for other readers
+                if (_concurrent)
+                    return chan_in<T, POISONABLE>::chan_in_internal::poison(strength);
                 // Lock the channel
-                std::unique_lock<std::mutex> lock(_mut);
+                std::unique_lock<process_mutex> lock(_mut);
                 // Poison the channel
                 chan_in<T, POISONABLE>::chan_in_internal::poison(strength);
             }
@@ -536,6 +991,10 @@ namespace csp
         // Friend declarations
         friend class one2one_chan<T, POISONABLE>;
         friend class any2one_chan<T, POISONABLE>;
+        friend class net::net_chan_in<T, POISONABLE>;
+        friend class net::shm_chan_in<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
     protected:
         /*! \class alting_chan_in_internal.
          * \brief Creates a new internal alting channel input.
@@ -589,6 +1048,16 @@ namespace csp
             {
                 return chan_in<T, POISONABLE>::chan_in_internal::_chan.disable();
             }
+
+            /*!
+             * \brief Checks if the channel stays enabled between selections.
+             *
+             * \return True if the channel stays enabled, false otherwise.
+             */
+            bool persistent() const noexcept override
+            {
+                return chan_in<T, POISONABLE>::chan_in_internal::_chan.persistent();
+            }
         };
 
         std::shared_ptr<alting_chan_in_internal> _internal = nullptr; //<! Pointer to the internal representation of the alting channel input.
@@ -663,6 +1132,10 @@ namespace csp
         // Friend declarations
         friend class one2one_chan<T, POISONABLE>;
         friend class one2any_chan<T, POISONABLE>;
+        friend class net::net_chan_out<T, POISONABLE>;
+        friend class net::shm_chan_out<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
     protected:
         /*! \class chan_out_internal
          * \brief Internal representation of a channel output.
@@ -697,6 +1170,43 @@ namespace csp
              */
             virtual void write(T value) const noexcept(false) { _chan.write(std::move(value)); }
 
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value Value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            virtual bool write_async(async_op &op, T &value) const noexcept(false) { return _chan.write_async(op, value); }
+
+            /*!
+             * \brief Writes a number of values to the channel.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            virtual void write_n(const T *values, size_t n) const noexcept(false) { _chan.write_n(values, n); }
+
+            /*!
+             * \brief Writes a value if it can complete without waiting for a reader.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            virtual bool try_write(T &value) const noexcept(false) { return _chan.try_write(value); }
+
+            /*!
+             * \brief Writes a value, giving up at the given time.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            virtual bool write_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _chan.write_until(value, time); }
+
             /*!
              * \brief Poisons the channel.
              *
@@ -704,6 +1214,13 @@ namespace csp
              */
             virtual void poison(unsigned int strength) const noexcept { _chan.writer_poison(strength); }
 
+            /*!
+             * \brief Checks if the channel handles concurrent writers itself.
+             *
+             * \return True if the channel can be written by several processes at once, false otherwise.
+             */
+            bool concurrent() const noexcept { return _chan.concurrent(); }
+
         public:
 
             /*!
@@ -712,6 +1229,26 @@ namespace csp
             virtual ~chan_out_internal() noexcept { }
         };
 
+        /*!
+         * \brief Writes a range held in an array.
+         */
+        template<typename InputIt>
+        void write_range(InputIt first, InputIt last, std::true_type) const noexcept(false)
+        {
+            const T *values = first;
+            write_n(values, static_cast<size_t>(last - first));
+        }
+
+        /*!
+         * \brief Writes a range not held in an array.
+         */
+        template<typename InputIt>
+        void write_range(InputIt first, InputIt last, std::false_type) const noexcept(false)
+        {
+            std::vector<T> values(first, last);
+            write_n(values.data(), values.size());
+        }
+
         std::shared_ptr<chan_out_internal> _internal = nullptr; //<! Pointer to the internal representation of the channel.
 
         /*!
@@ -831,7 +1368,107 @@ namespace csp
         void operator()(T value) const noexcept { _internal->write(std::move(value)); }
 
         /*!
-         * \brief Poisons the channel.
+         * \brief Writes a number of values to the channel.  Buffered channels take as many values as
+         * fit in each synchronisation, and unbuffered channels hand the values to a batched read in
+         * a single rendezvous.
+         *
+         * \param[in] values The values to write.
+         * \param[in] n The number of values to write.
+         */
+        void write_n(const T *values, size_t n) const noexcept(false) { _internal->write_n(values, n); }
+
+        /*!
+         * \brief Writes a range of values to the channel.  A range that is not held in an array is
+         * copied into one first.
+         *
+         * \tparam InputIt The type of iterator.
+         *
+         * \param[in] first The start of the range.
+         * \param[in] last The end of the range.
+         */
+        template<typename InputIt>
+        void write_range(InputIt first, InputIt last) const noexcept(false)
+        {
+            write_range(first, last, std::is_convertible<InputIt, const T*>());
+        }
+
+        /*!
+         * \brief Writes a value to the channel only if it can complete without waiting.  An
+         * unbuffered channel needs a reader already committed to reading, and a buffered channel
+         * needs space in its buffer.
+         *
+         * \param[in] value Value to write to the channel.
+         *
+         * \return True if the value was written, false otherwise.
+         */
+        bool try_write(T value) const noexcept(false) { return _internal->try_write(value); }
+
+        /*!
+         * \brief Writes a value to the channel, withdrawing it if no reader has taken it by the
+         * given time.
+         *
+         * \param[in] value Value to write to the channel.
+         * \param[in] time The time to give up the write.
+         *
+         * \return True if the value was written, false if the time was reached first.
+         */
+        bool write_until(T value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _internal->write_until(value, time); }
+
+        /*!
+         * \brief Writes a value to the channel, withdrawing it if no reader has taken it within the
+         * given duration.
+         *
+         * \param[in] value Value to write to the channel.
+         * \param[in] duration The time to wait for a reader.
+         *
+         * \return True if the value was written, false if the duration passed first.
+         */
+        template<typename Rep, typename Period>
+        bool write_for(T value, const std::chrono::duration<Rep, Period> &duration) const noexcept(false)
+        {
+            return _internal->write_until(value, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+        }
+
+#if defined(__cpp_impl_coroutine)
+        /*! \class write_op
+         * \brief Awaitable write operation.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class write_op : public co_op
+        {
+        private:
+            std::shared_ptr<chan_out_internal> _out; //!< The channel end being written to.
+
+            T _value; //!< The value to write.
+
+        protected:
+            bool step() noexcept(false) override final { return _out->write_async(*this, _value); }
+
+        public:
+            write_op(const std::shared_ptr<chan_out_internal> &out, T value) noexcept
+            : _out(out), _value(std::move(value))
+            {
+            }
+
+            void await_resume() const noexcept(false) { this->rethrow(); }
+        };
+
+        /*!
+         * \brief Writes a value to the channel within a coroutine, suspending the coroutine rather
+         * than blocking.  Use as co_await out.co_write(value).
+         *
+         * \param[in] value Value to write to the channel.
+         *
+         * \return The awaitable write operation.
+         */
+        write_op co_write(T value) const noexcept { return write_op(_internal, std::move(value)); }
+#endif
+
+        /*!
+         * \brief Poisons the channel.
          *
          * \param[in] strength The strength of the poison to apply to the channel.
          */
@@ -854,6 +1491,8 @@ namespace csp
         // Friend declarations
         friend class any2one_chan<T, POISONABLE>;
         friend class any2any_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
     protected:
         /*! \class shared_chan_out_internal
          * \brief Internal representation of a shared channel output.
@@ -866,7 +1505,9 @@ namespace csp
         {
         public:
 
-            mutable std::mutex _mut; //<! Mutex used to control access to the channel.
+            mutable process_mutex _mut; //<! Mutex used to control access to the channel.
+
+            const bool _concurrent; //!< Flag set if the channel handles concurrent writers, so single writes need not lock.
 
             /*!
              * \brief Creates a new internal shared channel output from an existing pointer to a channel.
@@ -875,7 +1516,7 @@ namespace csp
              * \param[in] immunity The poison immunity level of the channel.
              */
             shared_chan_out_internal(chan<T, POISONABLE> chan, unsigned int immunity) noexcept
-            : chan_out<T, POISONABLE>::chan_out_internal(chan, immunity)
+            : chan_out<T, POISONABLE>::chan_out_internal(chan, immunity), _concurrent(chan_out<T, POISONABLE>::chan_out_internal::concurrent())
             {
             }
 
@@ -886,12 +1527,108 @@ namespace csp
              */
             void write(T value) const noexcept override
             {
+                // A concurrent channel queues writers itself
+                if (_concurrent)
+                    return chan_out<T, POISONABLE>::chan_out_internal::write(std::move(value));
                 // Lock the channel
-                std::unique_lock<std::mutex> lock(_mut);
+                std::unique_lock<process_mutex> lock(_mut);
                 // Perform the write
                 chan_out<T, POISONABLE>::chan_out_internal::write(std::move(value));
             }
 
+            /*!
+             * \brief Writes a number of values to the channel.  The channel is locked for the whole batch.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) const noexcept(false) override
+            {
+                // Lock the channel
+                std::unique_lock<process_mutex> lock(_mut);
+                // Perform the write
+                chan_out<T, POISONABLE>::chan_out_internal::write_n(values, n);
+            }
+
+            /*!
+             * \brief Writes a value if it can complete without waiting.  Fails if another writer
+             * holds the channel.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) const noexcept(false) override
+            {
+                // A concurrent channel queues writers itself
+                if (_concurrent)
+                    return chan_out<T, POISONABLE>::chan_out_internal::try_write(value);
+                // Lock the channel if no other writer has it
+                std::unique_lock<process_mutex> lock(_mut, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return false;
+                // Perform the write
+                return chan_out<T, POISONABLE>::chan_out_internal::try_write(value);
+            }
+
+            /*!
+             * \brief Writes a value, giving up at the given time.  Time spent waiting for other
+             * writers counts towards the timeout.
+             *
+             * \param[in,out] value Value to write to the channel.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) override
+            {
+                // A concurrent channel queues writers itself
+                if (_concurrent)
+                    return chan_out<T, POISONABLE>::chan_out_internal::write_until(value, time);
+                // Lock the channel
+                std::unique_lock<process_mutex> lock(_mut, time);
+                if (!lock.owns_lock())
+                    return false;
+                // Perform the write
+                return chan_out<T, POISONABLE>::chan_out_internal::write_until(value, time);
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.  The channel is locked for the whole write.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value Value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) const noexcept(false) override
+            {
+                // A concurrent channel queues writers itself
+                if (_concurrent)
+                    return chan_out<T, POISONABLE>::chan_out_internal::write_async(op, value);
+                // Lock the channel
+                if (!op._locked)
+                {
+                    if (!_mut.lock_async(op))
+                        return false;
+                    op._locked = true;
+                }
+                // Perform the write, keeping the lock while waiting
+                try
+                {
+                    if (!chan_out<T, POISONABLE>::chan_out_internal::write_async(op, value))
+                        return false;
+                }
+                catch (...)
+                {
+                    _mut.unlock();
+                    throw;
+                }
+                // Unlock the channel
+                _mut.unlock();
+                return true;
+            }
+
             /*!
              * \brief Poisons the channel.
              *
@@ -899,8 +1636,11 @@ namespace csp
              */
             void poison(unsigned int strength) const noexcept override
             {
+                // A concurrent channel is poisoned without waiting for other writers
+                if (_concurrent)
+                    return chan_out<T, POISONABLE>::chan_out_internal::poison(strength);
                 // Lock the channel
-                std::unique_lock<std::mutex> lock(_mut);
+                std::unique_lock<process_mutex> lock(_mut);
                 // Perform the write
                 chan_out<T, POISONABLE>::chan_out_internal::poison(strength);
             }
@@ -1068,7 +1808,9 @@ namespace csp
 
             mutable std::mutex _mut; //!< Lock used to control access to the channel.
 
-            std::condition_variable _cond; //!< Condition variable used to wait for events.
+            condition _cond; //!< Condition variable used to wait for events.
+
+            wait_policy _policy; //!< How processes wait for events.
 
             std::vector<T> _hold; //!< Current value on the channel.
 
@@ -1082,6 +1824,60 @@ namespace csp
 
             unsigned int _strength = 0; //!< Strength of poison on channel.
 
+            const T *_span = nullptr; //!< Values of a batched write not yet read.
+
+            size_t _span_n = 0; //!< Number of values of a batched write not yet read.
+
+            /*!
+             * \brief Takes the next value offered by the writer.  The channel must be locked.
+             *
+             * \return The value taken.
+             */
+            T take() noexcept(false)
+            {
+                // Take from a batched write if there is one, otherwise from the hold
+                if (_span_n > 0)
+                {
+                    --_span_n;
+                    return batch_copy(*_span++);
+                }
+                auto to_return = std::move(_hold[0]);
+                _hold.pop_back();
+                return to_return;
+            }
+
+            /*!
+             * \brief Completes a read.  A writer with more of its batch to offer stays committed to
+             * the channel, otherwise it is released.  The channel must be locked.
+             */
+            void complete_read() noexcept
+            {
+                if (_span_n > 0)
+                    _empty = false;
+                else
+                    _cond.notify_one();
+            }
+
+            /*!
+             * \brief Hands a value to a reader waiting on the channel and waits for the reader to
+             * take it.  The channel must be locked.
+             *
+             * \param[in] lock The lock held on the channel.
+             * \param[in] value The value to hand over.
+             */
+            void hand_over(std::unique_lock<std::mutex> &lock, T &value) noexcept(false)
+            {
+                // Put the value in the hold and complete the communication
+                _hold.push_back(std::move(value));
+                _empty = true;
+                _cond.notify_one();
+                // Wait until reader has completed
+                _policy.wait(lock, _cond, [this]() { return _hold.empty() || _strength > 0; });
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+            }
+
         protected:
             /*!
              * \brief Performs a write operation on the channel.
@@ -1112,7 +1908,7 @@ namespace csp
                     _cond.notify_one();
                 }
                 // Wait until reader has completed
-                _cond.wait(lock);
+                _policy.wait(lock, _cond, [this]() { return _hold.empty() || _strength > 0; });
                 // Check if poisoned
                 if (_strength > 0)
                     throw poison_exception(_strength);
@@ -1134,21 +1930,96 @@ namespace csp
                 if (_empty)
                 {
                     _empty = false;
-                    _cond.wait(lock);
+                    _policy.wait(lock, _cond, [this]() { return _empty || _strength > 0; });
                 }
                     // Otherwise set empty to true
                 else
                     _empty = true;
-                // Get the value from the hold
-                auto to_return = std::move(_hold[0]);
-                _hold.pop_back();
-                // Inform waiting writer and return read value
-                _cond.notify_one();
                 // Check if poisoned
                 if (_strength > 0)
                     throw poison_exception(_strength);
-                // Otherwise return value
-                return std::move(to_return);
+                // Get the value and inform waiting writer
+                auto to_return = take();
+                complete_read();
+                return to_return;
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  A batched read takes as many of
+             * them as it wants in a single rendezvous.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                if (n == 0)
+                    return;
+                // Offer the values
+                _span = values;
+                _span_n = n;
+                // If channel is empty, then set empty to false and notify any waiting alt.
+                if (_empty)
+                {
+                    _empty = false;
+                    if (_alting)
+                        guard::guard_internal::schedule(_alt);
+                }
+                else
+                {
+                    // Otherwise complete the communication
+                    _empty = true;
+                    _cond.notify_one();
+                }
+                // Wait until reader has taken every value
+                _policy.wait(lock, _cond, [this]() { return _span_n == 0 || _strength > 0; });
+                _span = nullptr;
+                _span_n = 0;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Takes as many as a batched
+             * write offers in each rendezvous.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Meet the writer.  If channel is empty, set empty to false and wait for writer
+                    if (_empty)
+                    {
+                        _empty = false;
+                        _policy.wait(lock, _cond, [this]() { return _empty || _strength > 0; });
+                    }
+                    // Otherwise set empty to true
+                    else
+                        _empty = true;
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Take all that the writer offers, up to the number wanted
+                    values[i++] = take();
+                    while (i < n && _span_n > 0)
+                        values[i++] = take();
+                    complete_read();
+                }
             }
 
             /*!
@@ -1170,7 +2041,7 @@ namespace csp
                 if (_empty)
                 {
                     _empty = false;
-                    _cond.wait(lock);
+                    _policy.wait(lock, _cond, [this]() { return _empty || _strength > 0; });
                 }
                     // Otherwise set empty to true
                 else
@@ -1180,7 +2051,9 @@ namespace csp
                 // Check if poisoned
                 if (_strength > 0)
                     throw poison_exception(_strength);
-                // Return hold value
+                // Return the value offered
+                if (_span_n > 0)
+                    return batch_copy(*_span);
                 return std::move(_hold[0]);
             }
 
@@ -1191,100 +2064,314 @@ namespace csp
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
-                // Check if channel is already reading
-                if (_reading)
+                // Check if channel is reading
+                if (!_reading)
                     throw std::logic_error("Channel not in extended read");
                 // Set empty to true and reading to false
-                _hold.pop_back();
                 _empty = true;
                 _reading = false;
+                take();
                 // Inform waiting writer
-                _cond.notify_one();
+                complete_read();
             }
 
             /*!
-             * \brief Enable the channel with an alt
+             * \brief Performs the next step of a write operation.
              *
-             * \param[in] a The alt that is being used in the selection.
+             * \param[in] op The state of the operation.
+             * \param[in] value The value to write to the channel.
              *
-             * \return True if the channel is ready, false otherwise.
+             * \return True if the write has completed, false if the operation is waiting.
              */
-            bool enable(const alt &a) noexcept override final
+            bool write_async(async_op &op, T &value) noexcept(false) override final
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
-                // Check if poisoned
-                if (_strength > 0)
-                    return true;
-                // If channel is empty, register alt and return false
-                if (_empty)
+                if (op._phase == 0)
                 {
-                    _alt = a;
-                    _alting = true;
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Put the value in the hold
+                    _hold.push_back(std::move(value));
+                    // If channel is empty, then set empty to false and notify any waiting alt.
+                    if (_empty)
+                    {
+                        _empty = false;
+                        if (_alting)
+                            guard::guard_internal::schedule(_alt);
+                    }
+                    else
+                    {
+                        // Otherwise complete the communication
+                        _empty = true;
+                        _cond.notify_one();
+                    }
+                    // Wait until reader has completed
+                    op._phase = 1;
+                    _cond.wait_async(lock, op);
                     return false;
                 }
-                    // Otherwise return true
-                else
-                    return true;
+                // Reader has completed.  Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                return true;
             }
 
             /*!
-             * \brief Disables the channel with an alt.
+             * \brief Performs the next step of a read operation.
              *
-             * \return True if the channel is ready, false otherwise.
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
              */
-            bool disable() noexcept override final
+            bool read_async(async_op &op, T &value) noexcept(false) override final
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
-                _alting = false;
-                // Return either if empty, or has been poisoned.
-                return !_empty || (_strength > 0);
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Check if channel is empty, and if so set empty to false and wait for writer
+                    if (_empty)
+                    {
+                        _empty = false;
+                        op._phase = 1;
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                    // Otherwise set empty to true
+                    _empty = true;
+                }
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Get the value and inform waiting writer
+                value = take();
+                complete_read();
+                return true;
             }
 
             /*!
-             * \brief Checks if a message is pending on the channel.
+             * \brief Writes a value only if a reader is already committed to the channel.
              *
-             * \return True if the channel is ready, false otherwise.
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
              */
-            bool pending() const noexcept override final
+            bool try_write(T &value) noexcept(false) override final
             {
-                return !_empty || (_strength > 0);
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If no reader is waiting, fail
+                if (_empty)
+                    return false;
+                hand_over(lock, value);
+                return true;
             }
 
             /*!
-             * \brief Poisons the reading end of the channel.
+             * \brief Reads a value only if a writer is already committed to the channel.
              *
-             * \param[in] strength The strength of the poison to apply to the channel.
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
              */
-            void reader_poison(unsigned int strength) noexcept override final
+            bool try_read(T &value) noexcept(false) override final
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
-                // Set strength
-                _strength = strength;
-                // Notify all waiting processes
-                _cond.notify_all();
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If no writer is waiting, fail
+                if (_empty)
+                    return false;
+                // Get the value and inform waiting writer
+                _empty = true;
+                value = take();
+                complete_read();
+                return true;
             }
 
             /*!
-             * \brief Poisons the writer end of the channel
+             * \brief Writes a value, withdrawing it if no reader has committed by the given time.  An
+             * alt that selected the channel before the value was withdrawn will find no value waiting.
              *
-             * \param[in] strength The strength of the poison to apply to the channel.
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
              */
-            void writer_poison(unsigned int strength) noexcept override final
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
-                // Set strength
-                _strength = strength;
-                // Notify all waiting processes
-                _cond.notify_all();
-                // If in alt, schedule
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If a reader is waiting, complete the communication
+                if (!_empty)
+                {
+                    hand_over(lock, value);
+                    return true;
+                }
+                // Otherwise offer the value and notify any waiting alt
+                _hold.push_back(std::move(value));
+                _empty = false;
                 if (_alting)
                     guard::guard_internal::schedule(_alt);
-            }
-
+                // Wait for a reader to commit.  A reader sets empty, and has taken the value if a later reader has since cleared it.
+                if (!_cond.wait_until(lock, time, [this]() { return _empty || _hold.empty() || _strength > 0; }))
+                {
+                    // No reader arrived.  Withdraw the value.
+                    value = std::move(_hold[0]);
+                    _hold.pop_back();
+                    _empty = true;
+                    return false;
+                }
+                // Wait until the reader has completed.  An extended read holds the value until it ends.
+                _policy.wait(lock, _cond, [this]() { return _hold.empty() || _strength > 0; });
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value, giving up if no writer has committed by the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If channel is empty, set empty to false and wait for writer
+                if (_empty)
+                {
+                    _empty = false;
+                    if (!_cond.wait_until(lock, time, [this]() { return _empty || _strength > 0; }))
+                    {
+                        // No writer arrived.  Withdraw from the channel.
+                        _empty = true;
+                        return false;
+                    }
+                }
+                    // Otherwise set empty to true
+                else
+                    _empty = true;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Get the value and inform waiting writer
+                value = take();
+                complete_read();
+                return true;
+            }
+
+            /*!
+             * \brief Enable the channel with an alt
+             *
+             * \param[in] a The alt that is being used in the selection.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool enable(const alt &a) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    return true;
+                // If channel is empty, register alt and return false
+                if (_empty)
+                {
+                    _alt = a;
+                    _alting = true;
+                    return false;
+                }
+                    // Otherwise return true
+                else
+                    return true;
+            }
+
+            /*!
+             * \brief Disables the channel with an alt.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool disable() noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                _alting = false;
+                // Return either if empty, or has been poisoned.
+                return !_empty || (_strength > 0);
+            }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _policy.set(strategy); }
+
+            /*!
+             * \brief Checks if a message is pending on the channel.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool pending() const noexcept override final
+            {
+                return !_empty || (_strength > 0);
+            }
+
+            /*!
+             * \brief Poisons the reading end of the channel.
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void reader_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _cond.notify_all();
+            }
+
+            /*!
+             * \brief Poisons the writer end of the channel
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void writer_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _cond.notify_all();
+                // If in alt, schedule
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+            }
+
         public:
             /*!
              * \brief Creates a new channel object.
@@ -1349,12 +2436,14 @@ namespace csp
      *
      * \tparam T The type that the channel operates on.
      * \tparam POISONABLE Flag to indicate if the channel can be poisoned.
+     * \tparam STORE The data store used by the channel.  Either a chan_data_store, which is called
+     * through a vtable, or a data store policy, which is called directly.
      *
      * \author Kevin Chalmers
      *
      * \date 28/04/2016
      */
-    template<typename T, bool POISONABLE = false>
+    template<typename T, bool POISONABLE = false, typename STORE = chan_data_store<T>>
     class buffered_chan : public chan<T, POISONABLE>
     {
         // Friend declarations.
@@ -1370,11 +2459,13 @@ namespace csp
         {
         private:
 
-            chan_data_store<T> _buffer; //<! The internal buffer used to store messages.
+            STORE _buffer; //<! The internal buffer used to store messages.
 
             mutable std::mutex _mut; //<! Lock used to control access to the channel.
 
-            std::condition_variable _cond; //<! Condition variable used to wait for events.
+            condition _cond; //<! Condition variable used to wait for events.
+
+            wait_policy _policy; //<! How processes wait for events.
 
             bool _reading = false; //<! Flag to indicate whether the channel is in an extended read operation.
 
@@ -1394,6 +2485,8 @@ namespace csp
             {
                 // Lock the mutex
                 std::unique_lock<std::mutex> lock(_mut);
+                // Wait for space.  The buffer is only full here after a try_write or write_until.
+                _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::FULL || _strength > 0; });
                 // Check if poisoned
                 if (_strength > 0)
                     throw poison_exception(_strength);
@@ -1405,8 +2498,7 @@ namespace csp
                 else
                     _cond.notify_one();
                 // Check if buffer is full and wait if it is
-                if (_buffer.get_state() == DATA_STORE_STATE::FULL)
-                    _cond.wait(lock);
+                _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::FULL || _strength > 0; });
                 // Check if poisoned
                 if (_strength > 0)
                     throw poison_exception(_strength);
@@ -1417,65 +2509,2970 @@ namespace csp
              *
              * \return The value read from the channel.
              */
-            T read() noexcept(false) override final
+            T read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Check if buffer is empty, and if so wait until a write occurs.
+                _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0; });
+                // Inform any waiting writers
+                _cond.notify_one();
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Return value in the buffer.
+                return std::move(_buffer.get());
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  As many values as fit in the buffer
+             * are added each time the channel is locked.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Put as many values in the buffer as fit
+                    while (i < n && _buffer.get_state() != DATA_STORE_STATE::FULL)
+                        _buffer.put(batch_copy(values[i++]));
+                    // If channel is in select then inform alt, otherwise inform reader
+                    if (_alting)
+                        guard::guard_internal::schedule(_alt);
+                    else
+                        _cond.notify_one();
+                    // Check if buffer is full and wait if it is
+                    _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::FULL || _strength > 0; });
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                }
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Takes as many values as the
+             * buffer holds each time the channel is locked.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Check if buffer is empty, and if so wait until a write occurs.
+                    if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
+                    {
+                        _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0; });
+                        continue;
+                    }
+                    // Take as many values as the buffer holds, and inform any waiting writers
+                    while (i < n && _buffer.get_state() != DATA_STORE_STATE::EMPTY)
+                        values[i++] = _buffer.get();
+                    _cond.notify_one();
+                }
+            }
+
+            /*!
+             * \brief Starts an extended read operation.
+             *
+             * \return The value read from the channel.
+             */
+            T start_read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Ensure that we are not already reading.
+                if (_reading)
+                    throw std::logic_error("Channel already in extended read");
+                // If buffer is empty then we wait
+                _policy.wait(lock, _cond, [this]() { return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0; });
+                // Set reading flag to true and return value in the buffer.
+                _reading = true;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                return std::move(_buffer.get());
+            }
+
+            /*!
+             * \brief Ends an extended read operation.
+             */
+            void end_read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check that channel is in a reading state
+                if (_reading)
+                    throw std::logic_error("Channel not in extended read");
+                // Inform any waiting writer
+                _cond.notify_one();
+                // Set reading flag to false
+                _reading = false;
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value The value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Wait for space.  The buffer is only full here after a try_write or write_until.
+                    if (_buffer.get_state() == DATA_STORE_STATE::FULL)
+                    {
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                    // Put the value in the buffer
+                    _buffer.put(std::move(value));
+                    // If channel is in select then inform alt, otherwise inform reader
+                    if (_alting)
+                        guard::guard_internal::schedule(_alt);
+                    else
+                        _cond.notify_one();
+                    // Check if buffer is full and wait if it is
+                    if (_buffer.get_state() == DATA_STORE_STATE::FULL)
+                    {
+                        op._phase = 1;
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                }
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                return true;
+            }
+
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Check if buffer is empty, and if so wait until a write occurs.
+                    if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
+                    {
+                        op._phase = 1;
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                }
+                // Inform any waiting writers
+                _cond.notify_one();
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Take the value in the buffer.
+                value = std::move(_buffer.get());
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value only if the buffer has space for it.  Does not wait for the
+             * buffer to drain afterwards.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If buffer is full, fail
+                if (_buffer.get_state() == DATA_STORE_STATE::FULL)
+                    return false;
+                // Put the value in the buffer
+                _buffer.put(std::move(value));
+                // If channel is in select then inform alt, otherwise inform reader
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+                else
+                    _cond.notify_one();
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value only if the buffer holds one.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If buffer is empty, fail
+                if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
+                    return false;
+                // Inform any waiting writers and take the value in the buffer
+                _cond.notify_one();
+                value = std::move(_buffer.get());
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value, giving up if the buffer has no space for it by the given time.
+             * Completes once the value is in the buffer.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Wait for space in the buffer
+                if (!_cond.wait_until(lock, time, [this]() { return _buffer.get_state() != DATA_STORE_STATE::FULL || _strength > 0; }))
+                    return false;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Put the value in the buffer
+                _buffer.put(std::move(value));
+                // If channel is in select then inform alt, otherwise inform reader
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+                else
+                    _cond.notify_one();
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value, giving up if the buffer is still empty at the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Wait for a value in the buffer
+                if (!_cond.wait_until(lock, time, [this]() { return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0; }))
+                    return false;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Inform any waiting writers and take the value in the buffer
+                _cond.notify_one();
+                value = std::move(_buffer.get());
+                return true;
+            }
+
+            /*!
+             * \brief Enables the channel during an alt operation.
+             *
+             * \param[in] a The alt being used in the selection.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool enable(const alt &a) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    return true;
+                // If buffer is empty, then set alt and return false
+                if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
+                {
+                    _alting = true;
+                    _alt = a;
+                    return false;
+                }
+                    // Otherwise return true
+                else
+                    return true;
+            }
+
+            /*!
+             * \brief Disables the channel during an alt operation.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool disable() noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set alting to false
+                _alting = false;
+                // Return whether the buffer has a value within it
+                return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0;
+            }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _policy.set(strategy); }
+
+            /*!
+             * \brief Checks if a message is pending on the channel.
+             *
+             * \return True if a value is on the channel, false otherwise.
+             */
+            bool pending() const noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Return whether the buffer has a value within it.
+                return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0;
+            }
+
+            /*!
+             * \brief Poisons the reading end of the channel.
+             *
+             * \param[in] strength The strength of poison to apply to the channel.
+             */
+            void reader_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _cond.notify_all();
+            }
+
+            /*!
+             * \brief Poisons the writing end of the channel.
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void writer_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _cond.notify_all();
+                // If in alt, schedule
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+            }
+        public:
+            /*!
+             * \brief Creates a new internal buffered channel.
+             *
+             * \param[in] buffer Buffer used within the underlying channel
+             */
+            buffered_chan_internal(STORE buffer) noexcept
+            : _buffer(std::move(buffer))
+            {
+            }
+
+            /*!
+             * \brief Destroys the internal buffered channel.
+             */
+            ~buffered_chan_internal() noexcept { }
+        };
+
+    public:
+
+        /*!
+         * \brief Creates a new buffered channel.
+         *
+         * \param[in] buffer The buffer to use in the channel.
+         */
+        buffered_chan(STORE buffer) noexcept
+        : chan<T, POISONABLE>(std::shared_ptr<buffered_chan_internal>(new buffered_chan_internal(std::move(buffer))))
+        {
+        }
+
+        /*!
+         * \brief Copy constructor.
+         *
+         * \param[in] other The buffered channel to copy.
+         */
+        buffered_chan(const buffered_chan<T, POISONABLE, STORE> &other) noexcept = default;
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The buffered channel to copy.
+         */
+        buffered_chan(buffered_chan<T, POISONABLE, STORE> &&rhs) noexcept = default;
+
+        /*!
+         * \brief Copy assignment operator.
+         *
+         * \param[in] other The buffered channel to copy.
+         *
+         * \return A copy of the buffered channel.
+         */
+        buffered_chan<T, POISONABLE, STORE>& operator=(const buffered_chan<T, POISONABLE, STORE> &other) noexcept = default;
+
+        /*!
+         * \brief Move assignment operator.
+         *
+         * \param[in] rhs The buffered channel to copy.
+         *
+         * \return A copy of the buffered channel.
+         */
+        buffered_chan<T, POISONABLE, STORE>& operator=(buffered_chan<T, POISONABLE, STORE> &&rhs) noexcept = default;
+
+        /*!
+         * \brief Destroys the channel.
+         */
+        ~buffered_chan() { }
+    };
+
+    /*! \class one2one_basic_chan
+     * \brief Unbuffered channel specialised for a single writer and a single reader.
+     *
+     * The rendezvous is performed with an atomic state word rather than a mutex.  Each side
+     * spins briefly waiting for its partner and only parks on a condition variable if the
+     * partner has not arrived.  Only usable where there is exactly one writing and one
+     * reading process, as is the case with a one2one_chan.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam POISONABLE Flag used to indicate if the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, bool POISONABLE = false>
+    class one2one_basic_chan : public chan<T, POISONABLE>
+    {
+        // Friend declarations
+        friend class one2one_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
+    protected:
+        /*! \class one2one_basic_chan_internal
+         * \brief Internal representation of a one2one basic channel.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class one2one_basic_chan_internal : public chan<T, POISONABLE>::chan_internal
+        {
+            template<typename, typename, bool, bool>
+            friend class static_chan;
+            template<typename, typename, bool, bool>
+            friend class static_chan_in;
+            template<typename, typename, bool, bool>
+            friend class static_chan_out;
+        private:
+            /*! \enum STATE
+             * \brief The states of the rendezvous handshake.
+             */
+            enum STATE : unsigned int
+            {
+                EMPTY       = 0,    //!< No value on the channel and no alt registered
+                ALTING      = 1,    //!< Reader has registered an alt and no value is on the channel
+                SCHEDULING  = 2,    //!< A writer or poisoner is currently scheduling the registered alt
+                READY       = 3,    //!< Writer has placed a value in the hold and is waiting for the reader
+                TAKING      = 4,    //!< Reader has claimed the value in the hold.  A timed writer can no longer withdraw it.
+            };
+
+            std::atomic<unsigned int> _state; //!< Current state of the handshake.
+
+            std::atomic<unsigned int> _strength; //!< Strength of poison on channel.
+
+            std::atomic<bool> _reader_waiting; //!< Flag set while the reader waits for a writer.  Lets try_write find a committed reader.
+
+            std::vector<T> _hold; //!< Current value on the channel.
+
+            bool _reading = false; //!< Flag used to determine when the channel is in an extended read state.
+
+            alt _alt; //!< Alt used when channel is in a selection operation.
+
+            chan_waiter _waiter; //!< Used to wait for the partner process.
+
+            const T *_span = nullptr; //!< Values of a batched write not yet read.  Only read by the reader while the state is READY.
+
+            size_t _span_n = 0; //!< Number of values of a batched write not yet read.
+
+            /*!
+             * \brief Schedules the alt registered by the reader, if there is one.
+             *
+             * \param[in] next The state to leave the channel in once the alt is scheduled.
+             *
+             * \return True if an alt was scheduled, false otherwise.
+             */
+            bool schedule_alt(unsigned int next) noexcept
+            {
+                unsigned int expected = ALTING;
+                if (!_state.compare_exchange_strong(expected, SCHEDULING))
+                    return false;
+                guard::guard_internal::schedule(_alt);
+                _state.store(next);
+                return true;
+            }
+
+            /*!
+             * \brief Publishes the value in the hold, or the batch being written, to the reader.
+             * Informs any waiting alt and wakes the reader if it is parked.
+             */
+            void publish() noexcept
+            {
+                unsigned int count = 0;
+                while (true)
+                {
+                    unsigned int state = _state.load();
+                    if (state == EMPTY)
+                    {
+                        if (_state.compare_exchange_weak(state, READY))
+                            break;
+                    }
+                    else if (state == ALTING)
+                    {
+                        if (schedule_alt(READY))
+                            break;
+                    }
+                    else
+                        chan_waiter::backoff(count);
+                }
+                _waiter.wake();
+            }
+
+            /*!
+             * \brief Claims the value offered by the writer, so that a timed writer cannot withdraw it.
+             *
+             * \return True if a value was claimed, false if none is offered.
+             */
+            bool claim() noexcept
+            {
+                // A plain load first, so a poll of an empty channel does not take the cache line
+                unsigned int expected = READY;
+                return _state.load() == READY && _state.compare_exchange_strong(expected, TAKING);
+            }
+
+            /*!
+             * \brief Checks whether the reader has finished with the value the writer offered.
+             *
+             * \return True if the value has been taken, false otherwise.
+             */
+            bool taken() const noexcept
+            {
+                auto state = _state.load();
+                return state != READY && state != TAKING;
+            }
+
+            /*!
+             * \brief Waits for the writer and claims its value.  Only marks the reader as waiting if
+             * the writer is not already there.
+             */
+            void await_writer() noexcept
+            {
+                if (claim())
+                    return;
+                _reader_waiting.store(true);
+                _waiter.await([this](){ return claim() || _strength.load() > 0; });
+                _reader_waiting.store(false);
+            }
+
+            /*!
+             * \brief Withdraws a value the reader has not claimed.
+             *
+             * \param[out] value Set to the value withdrawn.
+             *
+             * \return True if the value was withdrawn, false if the reader claimed it first.
+             */
+            bool withdraw(T &value) noexcept
+            {
+                unsigned int expected = READY;
+                if (!_state.compare_exchange_strong(expected, EMPTY))
+                    return false;
+                value = std::move(_hold[0]);
+                _hold.pop_back();
+                return true;
+            }
+
+            /*!
+             * \brief Takes the next value offered by the writer.  Only called while the state is TAKING.
+             *
+             * \return The value taken.
+             */
+            T take() noexcept(false)
+            {
+                // Take from a batched write if there is one, otherwise from the hold
+                if (_span_n > 0)
+                {
+                    --_span_n;
+                    return batch_copy(*_span++);
+                }
+                auto to_return = std::move(_hold[0]);
+                _hold.pop_back();
+                return to_return;
+            }
+
+            /*!
+             * \brief Completes a read.  A writer with more of its batch to offer stays committed to
+             * the channel, otherwise it is released.
+             */
+            void complete_read() noexcept
+            {
+                if (_span_n == 0)
+                {
+                    _state.store(EMPTY);
+                    _waiter.wake();
+                }
+                else
+                    _state.store(READY);
+            }
+
+        protected:
+            /*!
+             * \brief Performs a write operation on the channel.
+             *
+             * \param[in] value The value to write to the channel.
+             */
+            void write(T value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Put the value in the hold.  The reader will not touch it until the state is READY.
+                _hold.push_back(std::move(value));
+                // Publish the value, informing any waiting alt
+                publish();
+                // Wait until reader has completed
+                _waiter.await([this](){ return taken() || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+            }
+
+            /*!
+             * \brief Performs a read operation on the channel.
+             *
+             * \return The value read from the channel.
+             */
+            T read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait for the writer
+                await_writer();
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Get the value and release the writer
+                auto to_return = take();
+                complete_read();
+                return to_return;
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  A batched read takes as many of
+             * them as it wants each time it meets the writer.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                if (n == 0)
+                    return;
+                // Offer the values.  The reader will not touch them until the state is READY.
+                _span = values;
+                _span_n = n;
+                publish();
+                // Wait until reader has taken every value
+                _waiter.await([this](){ return taken() || _strength.load() > 0; });
+                _span = nullptr;
+                _span_n = 0;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Takes as many as a batched write
+             * offers each time it meets the writer.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Wait for the writer
+                    await_writer();
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Take all that the writer offers, up to the number wanted
+                    values[i++] = take();
+                    while (i < n && _span_n > 0)
+                        values[i++] = take();
+                    complete_read();
+                }
+            }
+
+            /*!
+             * \brief Extended read operation.
+             *
+             * \return The value read from the channel.
+             */
+            T start_read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Check if channel is already reading
+                if (_reading)
+                    throw std::logic_error("Channel already in extended read");
+                // Wait for the writer
+                await_writer();
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Set reading to true.  The writer stays blocked until end_read, and cannot withdraw the value.
+                _reading = true;
+                if (_span_n > 0)
+                    return batch_copy(*_span);
+                return std::move(_hold[0]);
+            }
+
+            /*!
+             * \brief Extended read completion operation
+             */
+            void end_read() noexcept(false) override final
+            {
+                // Check if channel is reading
+                if (!_reading)
+                    throw std::logic_error("Channel not in extended read");
+                take();
+                _reading = false;
+                // Release the writer
+                complete_read();
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value The value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) noexcept(false) override final
+            {
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Put the value in the hold and publish it, informing any waiting alt
+                    _hold.push_back(std::move(value));
+                    publish();
+                    op._phase = 1;
+                }
+                // Wait until reader has completed
+                if (!_waiter.await_async([this](){ return taken() || _strength.load() > 0; }, op))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                return true;
+            }
+
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Check if poisoned, unless already parked
+                if (!op._waiting && _strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait for the writer, marking the reader as waiting if the writer is not already there
+                if (op._waiting || !claim())
+                {
+                    _reader_waiting.store(true);
+                    if (!_waiter.await_async([this](){ return claim() || _strength.load() > 0; }, op))
+                        return false;
+                    _reader_waiting.store(false);
+                }
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Get the value and release the writer
+                value = take();
+                complete_read();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value only if the reader is already waiting for it.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // If the reader is not waiting, fail
+                if (!_reader_waiting.load())
+                    return false;
+                // Publish the value
+                _hold.push_back(std::move(value));
+                publish();
+                // Wait until the reader has completed.  A timed reader may give up at the same time, so stop if it leaves without claiming.
+                _waiter.await([this](){ return taken() || _strength.load() > 0 || (!_reader_waiting.load() && _state.load() == READY); });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // If the reader left, withdraw the value unless it has been claimed since
+                if (!taken())
+                {
+                    if (withdraw(value))
+                        return false;
+                    _waiter.await([this](){ return taken() || _strength.load() > 0; });
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                }
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value only if the writer has already offered one.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // If no value is offered, fail
+                if (!claim())
+                    return false;
+                // Get the value and release the writer
+                value = take();
+                complete_read();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value, withdrawing it if the reader has not claimed it by the given time.
+             * An alt woken by the value may find it withdrawn, so pair timed writes with reads.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Publish the value, informing any waiting alt
+                _hold.push_back(std::move(value));
+                publish();
+                // Wait until reader has completed, withdrawing the value if it has not been claimed in time
+                if (!_waiter.await_until([this](){ return taken() || _strength.load() > 0; }, time))
+                {
+                    if (withdraw(value))
+                        return false;
+                    _waiter.await([this](){ return taken() || _strength.load() > 0; });
+                }
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value, giving up if the writer has not offered one by the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait for the writer
+                if (!claim())
+                {
+                    _reader_waiting.store(true);
+                    auto claimed = _waiter.await_until([this](){ return claim() || _strength.load() > 0; }, time);
+                    _reader_waiting.store(false);
+                    if (!claimed)
+                    {
+                        // Release a try_write that saw us waiting
+                        _waiter.wake();
+                        return false;
+                    }
+                }
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Get the value and release the writer
+                value = take();
+                complete_read();
+                return true;
+            }
+
+            /*!
+             * \brief Enable the channel with an alt
+             *
+             * \param[in] a The alt that is being used in the selection.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool enable(const alt &a) noexcept override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    return true;
+                // Nobody reads the alt until the state is ALTING, so it is safe to set here
+                _alt = a;
+                unsigned int expected = EMPTY;
+                // If the writer got there first, we are ready
+                return !_state.compare_exchange_strong(expected, ALTING);
+            }
+
+            /*!
+             * \brief Disables the channel with an alt.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool disable() noexcept override final
+            {
+                unsigned int count = 0;
+                while (true)
+                {
+                    unsigned int state = _state.load();
+                    if (state == ALTING)
+                    {
+                        // Withdraw the alt
+                        if (_state.compare_exchange_weak(state, EMPTY))
+                            return _strength.load() > 0;
+                    }
+                    else if (state == SCHEDULING)
+                        // Wait for the alt to be scheduled before reusing it
+                        chan_waiter::backoff(count);
+                    else
+                        return state == READY || _strength.load() > 0;
+                }
+            }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _waiter.set_strategy(strategy); }
+
+            /*!
+             * \brief Checks if a message is pending on the channel.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool pending() const noexcept override final
+            {
+                return _state.load() == READY || _strength.load() > 0;
+            }
+
+            /*!
+             * \brief Poisons the reading end of the channel.
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void reader_poison(unsigned int strength) noexcept override final
+            {
+                // Set strength
+                _strength.store(strength);
+                // Notify all waiting processes
+                _waiter.wake_all();
+            }
+
+            /*!
+             * \brief Poisons the writer end of the channel
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void writer_poison(unsigned int strength) noexcept override final
+            {
+                // Set strength
+                _strength.store(strength);
+                // If in alt, schedule
+                schedule_alt(ALTING);
+                // Notify all waiting processes
+                _waiter.wake_all();
+            }
+
+        public:
+            /*!
+             * \brief Creates a new channel object.
+             */
+            one2one_basic_chan_internal() noexcept
+            : _state(EMPTY), _strength(0), _reader_waiting(false)
+            {
+                _hold.reserve(1);
+            }
+
+            /*!
+             * \brief Destroys the channel
+             */
+            ~one2one_basic_chan_internal() noexcept { }
+        };
+
+        using internal_type = one2one_basic_chan_internal; //!< Used by statically dispatched channels to call the implementation directly.
+
+    public:
+        /*!
+         * \brief Creates a new one2one basic channel
+         */
+        one2one_basic_chan() noexcept
+        : chan<T, POISONABLE>(std::shared_ptr<one2one_basic_chan_internal>(new one2one_basic_chan_internal()))
+        {
+        }
+
+        /*!
+         * \brief Copy constructor.
+         *
+         * \param[in] other The channel object to copy.
+         */
+        one2one_basic_chan(const one2one_basic_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The channel object to copy.
+         */
+        one2one_basic_chan(one2one_basic_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Copy assignment operator.
+         *
+         * \param[in] other The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        one2one_basic_chan<T, POISONABLE>& operator=(const one2one_basic_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move assignment operator.
+         *
+         * \param[in] rhs The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        one2one_basic_chan<T, POISONABLE>& operator=(one2one_basic_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Destroys the channel object.
+         */
+        ~one2one_basic_chan() { }
+    };
+
+    /*! \class any2any_basic_chan
+     * \brief Unbuffered channel for any number of writers and readers.
+     *
+     * Waiting writers and readers are queued on the channel itself, under its one mutex, so the
+     * shared ends of the channel do not need a lock of their own.  A writer that finds a reader
+     * waiting hands its value straight over, and a reader that finds a writer waiting takes the
+     * value and releases that writer.  Each waiting process is woken on its own.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam POISONABLE Flag to indicate if the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, bool POISONABLE = false>
+    class any2any_basic_chan : public chan<T, POISONABLE>
+    {
+        // Friend declarations
+        friend class one2any_chan<T, POISONABLE>;
+        friend class any2one_chan<T, POISONABLE>;
+        friend class any2any_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
+    protected:
+        /*! \class any2any_basic_chan_internal
+         * \brief Internal representation of an any2any basic channel.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class any2any_basic_chan_internal : public chan<T, POISONABLE>::chan_internal
+        {
+            template<typename, typename, bool, bool>
+            friend class static_chan;
+            template<typename, typename, bool, bool>
+            friend class static_chan_in;
+            template<typename, typename, bool, bool>
+            friend class static_chan_out;
+        private:
+            /*! \class waiter
+             * \brief A process waiting on the channel.  Lives on the stack of the waiting process,
+             * or on the heap for an operation that cannot block.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class waiter
+            {
+            public:
+                T *_value = nullptr; //!< Value offered by a single write.
+
+                const T *_span = nullptr; //!< Values of a batched write not yet read.
+
+                size_t _remaining = 0; //!< Number of values a writer has still to hand over.
+
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type _slot; //!< Where a writer puts the value for a waiting reader.
+
+                bool _done = false; //!< Flag set once the partner has completed the communication.
+
+                condition _cond; //!< Used to wake this process alone.
+
+                waiter *_next = nullptr; //!< Next process in the queue.
+
+                /*!
+                 * \brief Gets the value a writer handed to this reader.
+                 *
+                 * \return The value in the slot.
+                 */
+                T& slot() noexcept { return *reinterpret_cast<T*>(&_slot); }
+            };
+
+            /*! \class queue
+             * \brief FIFO queue of waiting processes.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class queue
+            {
+            public:
+                waiter *_head = nullptr; //!< First process in the queue.
+
+                waiter *_tail = nullptr; //!< Last process in the queue.
+
+                bool empty() const noexcept { return _head == nullptr; }
+
+                void push(waiter *w) noexcept
+                {
+                    w->_next = nullptr;
+                    if (_tail)
+                        _tail->_next = w;
+                    else
+                        _head = w;
+                    _tail = w;
+                }
+
+                void push_front(waiter *w) noexcept
+                {
+                    w->_next = _head;
+                    _head = w;
+                    if (!_tail)
+                        _tail = w;
+                }
+
+                waiter* pop() noexcept
+                {
+                    auto w = _head;
+                    _head = w->_next;
+                    if (!_head)
+                        _tail = nullptr;
+                    return w;
+                }
+
+                /*!
+                 * \brief Removes a process that has given up waiting.
+                 *
+                 * \param[in] w The process to remove.
+                 *
+                 * \return True if the process was queued, false otherwise.
+                 */
+                bool remove(waiter *w) noexcept
+                {
+                    waiter *prev = nullptr;
+                    for (auto n = _head; n; prev = n, n = n->_next)
+                    {
+                        if (n != w)
+                            continue;
+                        if (prev)
+                            prev->_next = n->_next;
+                        else
+                            _head = n->_next;
+                        if (_tail == n)
+                            _tail = prev;
+                        return true;
+                    }
+                    return false;
+                }
+
+                /*!
+                 * \brief Wakes every queued process.  Used when poisoning.
+                 */
+                void notify_all() noexcept
+                {
+                    for (auto n = _head; n; n = n->_next)
+                        n->_cond.notify_one();
+                }
+            };
+
+            mutable std::mutex _mut; //!< Lock used to control access to the channel.
+
+            queue _writers; //!< Writers waiting for a reader.
+
+            queue _readers; //!< Readers waiting for a writer.  Never non-empty while a writer waits.
+
+            waiter *_extended = nullptr; //!< Writer whose value is held by an extended read.
+
+            condition _extended_cond; //!< Used by an extended read to wait for a writer.
+
+            wait_policy _policy; //!< How processes wait for a partner.
+
+            unsigned int _extended_waiting = 0; //!< Number of extended reads waiting for a writer.
+
+            bool _reading = false; //!< Flag used to determine when the channel is in an extended read state.
+
+            alt _alt; //!< Alt used when channel is in a selection operation.
+
+            bool _alting = false; //!< Flag used to indicate whether the channel is being used in a selection operation.
+
+            unsigned int _strength = 0; //!< Strength of poison on channel.
+
+            /*!
+             * \brief Releases a writer whose values have all been read.  The channel must be locked.
+             *
+             * \param[in] w The writer to release.
+             */
+            void release(waiter *w) noexcept
+            {
+                w->_done = true;
+                w->_cond.notify_one();
+            }
+
+            /*!
+             * \brief Hands a value to the reader at the head of the queue and wakes it.  The
+             * channel must be locked.
+             *
+             * \param[in] value The value to hand over.
+             */
+            void hand_over(T &&value) noexcept(false)
+            {
+                auto r = _readers.pop();
+                new (&r->_slot) T(std::move(value));
+                r->_done = true;
+                r->_cond.notify_one();
+            }
+
+            /*!
+             * \brief Takes the next value from the writer at the head of the queue, releasing the
+             * writer once all of its values are taken.  The channel must be locked.
+             *
+             * \return The value taken.
+             */
+            T take() noexcept(false)
+            {
+                auto w = _writers._head;
+                T value = w->_span ? batch_copy(*w->_span++) : std::move(*w->_value);
+                if (--w->_remaining == 0)
+                {
+                    _writers.pop();
+                    release(w);
+                }
+                return value;
+            }
+
+            /*!
+             * \brief Informs any alt or extended read waiting for a writer.  The channel must be locked.
+             */
+            void inform() noexcept
+            {
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+                if (_extended_waiting > 0)
+                    _extended_cond.notify_all();
+            }
+
+            /*!
+             * \brief Queues a writer and informs any alt or extended read waiting for one.  The
+             * channel must be locked.
+             *
+             * \param[in] w The writer to queue.
+             */
+            void offer(waiter *w) noexcept
+            {
+                _writers.push(w);
+                inform();
+            }
+
+            /*!
+             * \brief Removes a writer that has given up waiting.  The channel must be locked.
+             *
+             * \param[in] w The writer to remove.
+             */
+            void abandon(waiter *w) noexcept
+            {
+                if (_extended == w)
+                    _extended = nullptr;
+                else
+                    _writers.remove(w);
+            }
+
+            /*!
+             * \brief Waits for a queued writer to be released.  The channel must be locked.
+             *
+             * \param[in] lock The lock held on the channel.
+             * \param[in] w The writer waiting.
+             */
+            void await_release(std::unique_lock<std::mutex> &lock, waiter &w) noexcept(false)
+            {
+                _policy.wait(lock, w._cond, [&]() { return w._done || _strength > 0; });
+                if (!w._done)
+                {
+                    abandon(&w);
+                    throw poison_exception(_strength);
+                }
+            }
+
+            /*!
+             * \brief Waits as a queued reader for a writer to hand over a value.  The channel must
+             * be locked.
+             *
+             * \param[in] lock The lock held on the channel.
+             *
+             * \return The value handed over.
+             */
+            T await_value(std::unique_lock<std::mutex> &lock) noexcept(false)
+            {
+                waiter r;
+                _readers.push(&r);
+                _policy.wait(lock, r._cond, [&]() { return r._done || _strength > 0; });
+                if (!r._done)
+                {
+                    _readers.remove(&r);
+                    throw poison_exception(_strength);
+                }
+                T value = std::move(r.slot());
+                r.slot().~T();
+                return value;
+            }
+
+        protected:
+            /*!
+             * \brief Performs a write operation on the channel.
+             *
+             * \param[in] value The value to write to the channel.
+             */
+            void write(T value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If a reader is waiting, hand the value straight over
+                if (!_readers.empty())
+                {
+                    hand_over(std::move(value));
+                    return;
+                }
+                // Otherwise queue and wait for a reader
+                waiter w;
+                w._value = &value;
+                w._remaining = 1;
+                offer(&w);
+                await_release(lock, w);
+            }
+
+            /*!
+             * \brief Performs a read operation on the channel.
+             *
+             * \return The value read from the channel.
+             */
+            T read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If a writer is waiting, take its value, otherwise queue and wait for one
+                if (!_writers.empty())
+                    return take();
+                return await_value(lock);
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  Values go straight to any waiting
+             * readers, and the rest are offered together for readers to take in turn.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Hand values to any waiting readers
+                size_t i = 0;
+                while (i < n && !_readers.empty())
+                    hand_over(batch_copy(values[i++]));
+                if (i == n)
+                    return;
+                // Offer the rest and wait until they have all been read
+                waiter w;
+                w._span = values + i;
+                w._remaining = n - i;
+                offer(&w);
+                await_release(lock, w);
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Takes as many as the waiting
+             * writers offer each time the channel is locked.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // Take from the waiting writers, or wait for one
+                    if (_writers.empty())
+                        values[i++] = await_value(lock);
+                    while (i < n && !_writers.empty())
+                        values[i++] = take();
+                }
+            }
+
+            /*!
+             * \brief Extended read operation.  The writer is taken off the queue and held until
+             * the read ends.
+             *
+             * \return The value read from the channel.
+             */
+            T start_read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Check if channel is already reading
+                if (_reading)
+                    throw std::logic_error("Channel already in extended read");
+                // Wait for a writer
+                ++_extended_waiting;
+                _policy.wait(lock, _extended_cond, [this]() { return !_writers.empty() || _strength > 0; });
+                --_extended_waiting;
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // Hold the writer.  It stays blocked until end_read.
+                _reading = true;
+                _extended = _writers.pop();
+                if (_extended->_span)
+                    return batch_copy(*_extended->_span);
+                return std::move(*_extended->_value);
+            }
+
+            /*!
+             * \brief Extended read completion operation
+             */
+            void end_read() noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if channel is reading
+                if (!_reading)
+                    throw std::logic_error("Channel not in extended read");
+                _reading = false;
+                // Nothing to release if the writer was poisoned meanwhile
+                auto w = _extended;
+                _extended = nullptr;
+                if (!w)
+                    return;
+                if (w->_span)
+                    ++w->_span;
+                if (--w->_remaining == 0)
+                {
+                    release(w);
+                    return;
+                }
+                // The writer has more of its batch to offer.  Put it back at the front and serve any reader that queued meanwhile.
+                _writers.push_front(w);
+                while (!_writers.empty() && !_readers.empty())
+                    hand_over(take());
+                if (!_writers.empty())
+                    inform();
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.  Holds the queued writer while waiting.
+             * \param[in] value The value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // If a reader is waiting, hand the value straight over
+                    if (!_readers.empty())
+                    {
+                        hand_over(std::move(value));
+                        return true;
+                    }
+                    // Otherwise queue and wait for a reader
+                    auto w = new waiter();
+                    w->_value = &value;
+                    w->_remaining = 1;
+                    op._state = w;
+                    offer(w);
+                    op._phase = 1;
+                    w->_cond.wait_async(lock, op);
+                    return false;
+                }
+                // Woken by a reader or by poison
+                std::unique_ptr<waiter> w(static_cast<waiter*>(op._state));
+                op._state = nullptr;
+                if (!w->_done)
+                {
+                    abandon(w.get());
+                    throw poison_exception(_strength);
+                }
+                return true;
+            }
+
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.  Holds the queued reader while waiting.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (op._phase == 0)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    // If a writer is waiting, take its value
+                    if (!_writers.empty())
+                    {
+                        value = take();
+                        return true;
+                    }
+                    // Otherwise queue and wait for a writer
+                    auto r = new waiter();
+                    op._state = r;
+                    _readers.push(r);
+                    op._phase = 1;
+                    r->_cond.wait_async(lock, op);
+                    return false;
+                }
+                // Woken by a writer or by poison
+                std::unique_ptr<waiter> r(static_cast<waiter*>(op._state));
+                op._state = nullptr;
+                if (!r->_done)
+                {
+                    _readers.remove(r.get());
+                    throw poison_exception(_strength);
+                }
+                value = std::move(r->slot());
+                r->slot().~T();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value only if a reader is already waiting for it.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If no reader is waiting, fail
+                if (_readers.empty())
+                    return false;
+                hand_over(std::move(value));
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value only if a writer is already waiting.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If no writer is waiting, fail
+                if (_writers.empty())
+                    return false;
+                value = take();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value, withdrawing it if no reader has taken it by the given time.  An
+             * alt woken by the value may find it withdrawn, so pair timed writes with reads.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If a reader is waiting, hand the value straight over
+                if (!_readers.empty())
+                {
+                    hand_over(std::move(value));
+                    return true;
+                }
+                // Otherwise queue and wait for a reader until the given time
+                waiter w;
+                w._value = &value;
+                w._remaining = 1;
+                offer(&w);
+                while (!w._done && _strength == 0)
+                    if (w._cond.wait_until(lock, time) == std::cv_status::timeout)
+                        break;
+                if (w._done)
+                    return true;
+                // Withdraw the value, unless an extended read holds it
+                if (_strength == 0 && _extended != &w)
+                {
+                    _writers.remove(&w);
+                    return false;
+                }
+                await_release(lock, w);
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value, giving up if no writer has offered one by the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Check if poisoned
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                // If a writer is waiting, take its value
+                if (!_writers.empty())
+                {
+                    value = take();
+                    return true;
+                }
+                // Otherwise queue and wait for a writer until the given time
+                waiter r;
+                _readers.push(&r);
+                while (!r._done && _strength == 0)
+                    if (r._cond.wait_until(lock, time) == std::cv_status::timeout)
+                        break;
+                if (r._done)
+                {
+                    value = std::move(r.slot());
+                    r.slot().~T();
+                    return true;
+                }
+                _readers.remove(&r);
+                if (_strength > 0)
+                    throw poison_exception(_strength);
+                return false;
+            }
+
+            /*!
+             * \brief Enable the channel with an alt
+             *
+             * \param[in] a The alt that is being used in the selection.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool enable(const alt &a) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Ready if poisoned or a writer is waiting
+                if (_strength > 0 || !_writers.empty())
+                    return true;
+                // Otherwise register the alt
+                _alt = a;
+                _alting = true;
+                return false;
+            }
+
+            /*!
+             * \brief Disables the channel with an alt.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool disable() noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                _alting = false;
+                return !_writers.empty() || _strength > 0;
+            }
+
+            /*!
+             * \brief Checks if the channel handles concurrent writers and readers itself.
+             *
+             * \return Always true.
+             */
+            bool concurrent() const noexcept override final { return true; }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _policy.set(strategy); }
+
+            /*!
+             * \brief Checks if a message is pending on the channel.
+             *
+             * \return True if a writer is waiting, false otherwise.
+             */
+            bool pending() const noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                return !_writers.empty() || _strength > 0;
+            }
+
+            /*!
+             * \brief Poisons the reading end of the channel.
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void reader_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _writers.notify_all();
+                _readers.notify_all();
+                if (_extended)
+                    _extended->_cond.notify_one();
+                _extended_cond.notify_all();
+            }
+
+            /*!
+             * \brief Poisons the writer end of the channel
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void writer_poison(unsigned int strength) noexcept override final
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                // Set strength
+                _strength = strength;
+                // Notify all waiting processes
+                _writers.notify_all();
+                _readers.notify_all();
+                if (_extended)
+                    _extended->_cond.notify_one();
+                _extended_cond.notify_all();
+                // If in alt, schedule
+                if (_alting)
+                    guard::guard_internal::schedule(_alt);
+            }
+
+        public:
+            /*!
+             * \brief Creates a new channel object.
+             */
+            any2any_basic_chan_internal() noexcept { }
+
+            /*!
+             * \brief Destroys the channel
+             */
+            ~any2any_basic_chan_internal() noexcept { }
+        };
+
+        using internal_type = any2any_basic_chan_internal; //!< Used by statically dispatched channels to call the implementation directly.
+
+    public:
+        /*!
+         * \brief Creates a new any2any basic channel
+         */
+        any2any_basic_chan() noexcept
+        : chan<T, POISONABLE>(std::shared_ptr<any2any_basic_chan_internal>(new any2any_basic_chan_internal()))
+        {
+        }
+
+        /*!
+         * \brief Copy constructor.
+         *
+         * \param[in] other The channel object to copy.
+         */
+        any2any_basic_chan(const any2any_basic_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The channel object to copy.
+         */
+        any2any_basic_chan(any2any_basic_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Copy assignment operator.
+         *
+         * \param[in] other The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        any2any_basic_chan<T, POISONABLE>& operator=(const any2any_basic_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move assignment operator.
+         *
+         * \param[in] rhs The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        any2any_basic_chan<T, POISONABLE>& operator=(any2any_basic_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Destroys the channel object.
+         */
+        ~any2any_basic_chan() { }
+    };
+
+    /*! \class one2one_buffered_chan
+     * \brief Buffered channel for a single writer and a single reader, built on a lock-free ring.
+     *
+     * Writer and reader only wait for each other when the buffer is full or empty, spinning,
+     * yielding and then parking as the one2one_basic_chan does.  Used when a one2one_chan is
+     * created with a buffer.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam POISONABLE Flag used to indicate if the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, bool POISONABLE = false>
+    class one2one_buffered_chan : public chan<T, POISONABLE>
+    {
+        // Friend declarations
+        friend class one2one_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
+    protected:
+        /*! \class one2one_buffered_chan_internal
+         * \brief Internal representation of a one2one buffered channel.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class one2one_buffered_chan_internal : public chan<T, POISONABLE>::chan_internal
+        {
+            template<typename, typename, bool, bool>
+            friend class static_chan;
+            template<typename, typename, bool, bool>
+            friend class static_chan_in;
+            template<typename, typename, bool, bool>
+            friend class static_chan_out;
+        private:
+            /*! \enum STATE
+             * \brief The states of the alt registration.
+             */
+            enum STATE : unsigned int
+            {
+                IDLE        = 0,    //!< No alt registered
+                ALTING      = 1,    //!< Reader has registered an alt while the buffer was empty
+                SCHEDULING  = 2,    //!< A writer or poisoner is currently scheduling the registered alt
+            };
+
+            spsc_ring<T> _queue; //!< The buffer used to store messages.
+
+            std::atomic<unsigned int> _state; //!< Current state of the alt registration.
+
+            std::atomic<unsigned int> _strength; //!< Strength of poison on channel.
+
+            bool _reading = false; //!< Flag used to determine when the channel is in an extended read state.
+
+            alt _alt; //!< Alt used when channel is in a selection operation.
+
+            chan_waiter _waiter; //!< Used to wait on the full and empty edges.
+
+            /*!
+             * \brief Schedules the alt registered by the reader, if there is one.
+             */
+            void schedule_alt() noexcept
+            {
+                unsigned int expected = ALTING;
+                if (!_state.compare_exchange_strong(expected, SCHEDULING))
+                    return;
+                guard::guard_internal::schedule(_alt);
+                _state.store(IDLE);
+            }
+
+            /*!
+             * \brief Adds a value to the buffer and informs the reader.  The buffer must have room.
+             *
+             * \param[in] value The value to add to the buffer.
+             */
+            void publish(T &&value) noexcept(false)
+            {
+                _queue.push(std::move(value));
+                // If channel is in select then inform alt, and wake the reader if it is parked
+                schedule_alt();
+                _waiter.wake();
+            }
+
+        protected:
+            /*!
+             * \brief Performs a write operation on the channel.
+             *
+             * \param[in] value The value to write to the channel.
+             */
+            void write(T value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait for room.  The buffer is only full here after a try_write or write_until.
+                _waiter.await([this](){ return !_queue.full() || _strength.load() > 0; });
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Put the value in the buffer
+                publish(std::move(value));
+                // Check if buffer is full and wait if it is
+                _waiter.await([this](){ return !_queue.full() || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+            }
+
+            /*!
+             * \brief Performs a read operation on the channel.
+             *
+             * \return The value read from the channel.
+             */
+            T read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait until the buffer has a value
+                _waiter.await([this](){ return !_queue.empty() || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Take the value and inform any waiting writer
+                auto to_return = _queue.pop();
+                _waiter.wake();
+                return to_return;
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  As many values as fit are added
+             * to the buffer and published together.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Put as many values in the buffer as fit
+                    i += _queue.push_n(values + i, n - i);
+                    // If channel is in select then inform alt, and wake the reader if it is parked
+                    schedule_alt();
+                    _waiter.wake();
+                    // Check if buffer is full and wait if it is
+                    _waiter.await([this](){ return !_queue.full() || _strength.load() > 0; });
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                }
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Takes as many values as the
+             * buffer holds each time.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                size_t i = 0;
+                while (i < n)
+                {
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Wait until the buffer has a value
+                    _waiter.await([this](){ return !_queue.empty() || _strength.load() > 0; });
+                    // Check if poisoned
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Take as many values as the buffer holds and inform any waiting writer
+                    i += _queue.pop_n(values + i, n - i);
+                    _waiter.wake();
+                }
+            }
+
+            /*!
+             * \brief Starts an extended read operation.  The value stays in the buffer until the
+             * read ends.
+             *
+             * \return The value read from the channel.
+             */
+            T start_read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Ensure that we are not already reading.
+                if (_reading)
+                    throw std::logic_error("Channel already in extended read");
+                // Wait until the buffer has a value
+                _waiter.await([this](){ return !_queue.empty() || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                _reading = true;
+                return std::move(_queue.front());
+            }
+
+            /*!
+             * \brief Ends an extended read operation.
+             */
+            void end_read() noexcept(false) override final
+            {
+                // Check that channel is in a reading state
+                if (!_reading)
+                    throw std::logic_error("Channel not in extended read");
+                // Release the slot and inform any waiting writer
+                _queue.pop();
+                _reading = false;
+                _waiter.wake();
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value The value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) noexcept(false) override final
+            {
+                if (op._phase == 0)
+                {
+                    // Check if poisoned, unless already parked
+                    if (!op._waiting && _strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Wait for room.  The buffer is only full here after a try_write or write_until.
+                    if (!_waiter.await_async([this](){ return !_queue.full() || _strength.load() > 0; }, op))
+                        return false;
+                    if (_strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Put the value in the buffer
+                    publish(std::move(value));
+                    op._phase = 1;
+                }
+                // Check if buffer is full and wait if it is
+                if (!_waiter.await_async([this](){ return !_queue.full() || _strength.load() > 0; }, op))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                return true;
+            }
+
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Check if poisoned, unless already parked
+                if (!op._waiting && _strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Wait until the buffer has a value
+                if (!_waiter.await_async([this](){ return !_queue.empty() || _strength.load() > 0; }, op))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Take the value and inform any waiting writer
+                value = _queue.pop();
+                _waiter.wake();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value only if the buffer has room for it.  Does not wait for the
+             * buffer to drain afterwards.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // If buffer is full, fail
+                if (_queue.full())
+                    return false;
+                publish(std::move(value));
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value only if the buffer holds one.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // If buffer is empty, fail
+                if (_queue.empty())
+                    return false;
+                // Take the value and inform any waiting writer
+                value = _queue.pop();
+                _waiter.wake();
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value, giving up if the buffer has no room for it by the given time.
+             * Completes once the value is in the buffer.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
+             */
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Wait for room in the buffer
+                if (!_waiter.await_until([this](){ return !_queue.full() || _strength.load() > 0; }, time))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                publish(std::move(value));
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value, giving up if the buffer is still empty at the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
+             */
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+            {
+                // Wait until the buffer has a value
+                if (!_waiter.await_until([this](){ return !_queue.empty() || _strength.load() > 0; }, time))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Take the value and inform any waiting writer
+                value = _queue.pop();
+                _waiter.wake();
+                return true;
+            }
+
+            /*!
+             * \brief Enables the channel during an alt operation.
+             *
+             * \param[in] a The alt being used in the selection.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool enable(const alt &a) noexcept override final
+            {
+                // Check if poisoned or a value is already buffered
+                if (_strength.load() > 0 || !_queue.empty())
+                    return true;
+                // Nobody reads the alt until the state is ALTING, so it is safe to set here
+                _alt = a;
+                _state.store(ALTING);
+                // A write may have arrived before the alt was registered
+                return !_queue.empty() || _strength.load() > 0;
+            }
+
+            /*!
+             * \brief Disables the channel during an alt operation.
+             *
+             * \return True if the channel is ready, false otherwise.
+             */
+            bool disable() noexcept override final
+            {
+                unsigned int count = 0;
+                while (true)
+                {
+                    unsigned int state = _state.load();
+                    if (state == ALTING)
+                    {
+                        // Withdraw the alt
+                        if (_state.compare_exchange_weak(state, IDLE))
+                            break;
+                    }
+                    else if (state == SCHEDULING)
+                        // Wait for the alt to be scheduled before reusing it
+                        chan_waiter::backoff(count);
+                    else
+                        break;
+                }
+                return !_queue.empty() || _strength.load() > 0;
+            }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _waiter.set_strategy(strategy); }
+
+            /*!
+             * \brief Checks if a message is pending on the channel.
+             *
+             * \return True if a value is on the channel, false otherwise.
+             */
+            bool pending() const noexcept override final
+            {
+                return !_queue.empty() || _strength.load() > 0;
+            }
+
+            /*!
+             * \brief Poisons the reading end of the channel.
+             *
+             * \param[in] strength The strength of poison to apply to the channel.
+             */
+            void reader_poison(unsigned int strength) noexcept override final
+            {
+                // Set strength
+                _strength.store(strength);
+                // Notify all waiting processes
+                _waiter.wake_all();
+            }
+
+            /*!
+             * \brief Poisons the writing end of the channel.
+             *
+             * \param[in] strength The strength of the poison to apply to the channel.
+             */
+            void writer_poison(unsigned int strength) noexcept override final
+            {
+                // Set strength
+                _strength.store(strength);
+                // If in alt, schedule
+                schedule_alt();
+                // Notify all waiting processes
+                _waiter.wake_all();
+            }
+
+        public:
+            /*!
+             * \brief Creates a new internal one2one buffered channel.
+             *
+             * \param[in] size The number of values the buffer holds.
+             */
+            one2one_buffered_chan_internal(size_t size) noexcept(false)
+            : _queue(size), _state(IDLE), _strength(0)
+            {
+            }
+
+            /*!
+             * \brief Destroys the internal one2one buffered channel.
+             */
+            ~one2one_buffered_chan_internal() noexcept { }
+        };
+
+        using internal_type = one2one_buffered_chan_internal; //!< Used by statically dispatched channels to call the implementation directly.
+
+    public:
+        /*!
+         * \brief Creates a new one2one buffered channel.
+         *
+         * \param[in] size The number of values the buffer holds.
+         */
+        one2one_buffered_chan(size_t size) noexcept(false)
+        : chan<T, POISONABLE>(std::shared_ptr<one2one_buffered_chan_internal>(new one2one_buffered_chan_internal(size)))
+        {
+        }
+
+        /*!
+         * \brief Copy constructor.
+         *
+         * \param[in] other The channel object to copy.
+         */
+        one2one_buffered_chan(const one2one_buffered_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The channel object to copy.
+         */
+        one2one_buffered_chan(one2one_buffered_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Copy assignment operator.
+         *
+         * \param[in] other The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        one2one_buffered_chan<T, POISONABLE>& operator=(const one2one_buffered_chan<T, POISONABLE> &other) = default;
+
+        /*!
+         * \brief Move assignment operator.
+         *
+         * \param[in] rhs The channel object to copy.
+         *
+         * \return A copy of the channel object.
+         */
+        one2one_buffered_chan<T, POISONABLE>& operator=(one2one_buffered_chan<T, POISONABLE> &&rhs) = default;
+
+        /*!
+         * \brief Destroys the channel object.
+         */
+        ~one2one_buffered_chan() { }
+    };
+
+    /*! \class any2any_buffered_chan
+     * \brief Buffered channel for any number of writers and readers, built on a lock-free bounded
+     * MPMC queue.
+     *
+     * Processes only wait when the buffer is full or empty.  Used when a one2any_chan, any2one_chan
+     * or any2any_chan is created with a buffer.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam POISONABLE Flag used to indicate if the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, bool POISONABLE = false>
+    class any2any_buffered_chan : public chan<T, POISONABLE>
+    {
+        // Friend declarations
+        friend class one2any_chan<T, POISONABLE>;
+        friend class any2one_chan<T, POISONABLE>;
+        friend class any2any_chan<T, POISONABLE>;
+        template<typename, typename, bool, bool>
+        friend class static_chan;
+    protected:
+        /*! \class any2any_buffered_chan_internal
+         * \brief Internal representation of an any2any buffered channel.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class any2any_buffered_chan_internal : public chan<T, POISONABLE>::chan_internal
+        {
+            template<typename, typename, bool, bool>
+            friend class static_chan;
+            template<typename, typename, bool, bool>
+            friend class static_chan_in;
+            template<typename, typename, bool, bool>
+            friend class static_chan_out;
+        private:
+            /*! \enum STATE
+             * \brief The states of the alt registration.
+             */
+            enum STATE : unsigned int
+            {
+                IDLE        = 0,    //!< No alt registered
+                ALTING      = 1,    //!< Reader has registered an alt while the buffer was empty
+                SCHEDULING  = 2,    //!< A writer or poisoner is currently scheduling the registered alt
+            };
+
+            using cell = typename mpmc_ring<T>::cell;
+
+            mpmc_ring<T> _queue; //!< The buffer used to store messages.
+
+            size_t _size; //!< The number of values the buffer holds when full.
+
+            std::atomic<size_t> _room; //!< Number of values that may still be added.  The ring is rounded up, so holds more than the size.
+
+            std::atomic<unsigned int> _state; //!< Current state of the alt registration.
+
+            std::atomic<unsigned int> _strength; //!< Strength of poison on channel.
+
+            bool _reading = false; //!< Flag used to determine when the channel is in an extended read state.
+
+            cell *_extended = nullptr; //!< The cell holding the value of an extended read.
+
+            size_t _extended_pos = 0; //!< The position of the cell holding the value of an extended read.
+
+            alt _alt; //!< Alt used when channel is in a selection operation.
+
+            chan_waiter _waiter; //!< Used to wait on the full and empty edges.
+
+            /*!
+             * \brief Schedules the alt registered by the reader, if there is one.
+             */
+            void schedule_alt() noexcept
+            {
+                unsigned int expected = ALTING;
+                if (!_state.compare_exchange_strong(expected, SCHEDULING))
+                    return;
+                guard::guard_internal::schedule(_alt);
+                _state.store(IDLE);
+            }
+
+            /*!
+             * \brief Claims a cell to add a value to, once the buffer has room for it.
+             *
+             * \param[out] pos Set to the position of the cell claimed.
+             * \param[in,out] reserved Whether room has been reserved.  Kept between calls by a waiting writer.
+             *
+             * \return The cell claimed, or nullptr if the buffer is full.
+             */
+            cell* claim_push(size_t &pos, bool &reserved) noexcept
+            {
+                if (!reserved)
+                {
+                    auto room = _room.load();
+                    while (room > 0 && !_room.compare_exchange_weak(room, room - 1)) { }
+                    if (room == 0)
+                        return nullptr;
+                    reserved = true;
+                }
+                // Only fails while a reader is still freeing the cell
+                return _queue.claim_push(pos);
+            }
+
+            /*!
+             * \brief Gives back room reserved by a writer that has given up.
+             *
+             * \param[in] reserved Whether room was reserved.
+             */
+            void unreserve(bool reserved) noexcept
+            {
+                if (reserved)
+                {
+                    _room.fetch_add(1);
+                    _waiter.wake();
+                }
+            }
+
+            /*!
+             * \brief Places a value in a claimed cell and informs the readers.
+             *
+             * \param[in] c The cell claimed.
+             * \param[in] pos The position of the cell.
+             * \param[in] value The value to add to the buffer.
+             */
+            void publish(cell *c, size_t pos, T &&value) noexcept(false)
+            {
+                _queue.publish_push(c, pos, std::move(value));
+                // If channel is in select then inform alt, and wake any parked reader
+                schedule_alt();
+                _waiter.wake();
+            }
+
+            /*!
+             * \brief Takes the value from a claimed cell and informs the writers.
+             *
+             * \param[in] c The cell claimed.
+             * \param[in] pos The position of the cell.
+             *
+             * \return The value taken.
+             */
+            T take(cell *c, size_t pos) noexcept(false)
+            {
+                auto to_return = _queue.publish_pop(c, pos);
+                _room.fetch_add(1);
+                _waiter.wake();
+                return to_return;
+            }
+
+        protected:
+            /*!
+             * \brief Performs a write operation on the channel.
+             *
+             * \param[in] value The value to write to the channel.
+             */
+            void write(T value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, waiting if the buffer is full
+                cell *c = nullptr;
+                size_t pos = 0;
+                bool reserved = false;
+                _waiter.await([&](){ return _strength.load() > 0 || (c = claim_push(pos, reserved)) != nullptr; });
+                if (c == nullptr)
+                {
+                    unreserve(reserved);
+                    throw poison_exception(_strength.load());
+                }
+                publish(c, pos, std::move(value));
+                // Check if buffer is full and wait if it is
+                _waiter.await([this](){ return _room.load() > 0 || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+            }
+
+            /*!
+             * \brief Performs a read operation on the channel.
+             *
+             * \return The value read from the channel.
+             */
+            T read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, waiting if the buffer is empty
+                cell *c = nullptr;
+                size_t pos = 0;
+                _waiter.await([&](){ return _strength.load() > 0 || (c = _queue.claim_pop(&pos)) != nullptr; });
+                if (c == nullptr)
+                    throw poison_exception(_strength.load());
+                return take(c, pos);
+            }
+
+            /*!
+             * \brief Writes a number of values to the channel.  Readers are only informed once the
+             * buffer is full or the batch is written.
+             *
+             * \param[in] values The values to write.
+             * \param[in] n The number of values to write.
+             */
+            void write_n(const T *values, size_t n) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                if (n == 0)
+                    return;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    // Claim a cell.  If the buffer is full, inform the readers and wait.
+                    size_t pos = 0;
+                    bool reserved = false;
+                    cell *c = claim_push(pos, reserved);
+                    if (c == nullptr)
+                    {
+                        schedule_alt();
+                        _waiter.wake();
+                        _waiter.await([&](){ return _strength.load() > 0 || (c = claim_push(pos, reserved)) != nullptr; });
+                        if (c == nullptr)
+                        {
+                            unreserve(reserved);
+                            throw poison_exception(_strength.load());
+                        }
+                    }
+                    _queue.publish_push(c, pos, batch_copy(values[i]));
+                }
+                // Inform the readers of the batch
+                schedule_alt();
+                _waiter.wake();
+                // Check if buffer is full and wait if it is
+                _waiter.await([this](){ return _room.load() > 0 || _strength.load() > 0; });
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+            }
+
+            /*!
+             * \brief Reads a number of values from the channel.  Writers are only informed once the
+             * buffer is empty or the batch is read.
+             *
+             * \param[out] values Where to put the values read.
+             * \param[in] n The number of values to read.
+             */
+            void read_n(T *values, size_t n) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                for (size_t i = 0; i < n; ++i)
+                {
+                    // Claim a cell.  If the buffer is empty, inform the writers and wait.
+                    size_t pos = 0;
+                    cell *c = _queue.claim_pop(&pos);
+                    if (c == nullptr)
+                    {
+                        _waiter.wake();
+                        _waiter.await([&](){ return _strength.load() > 0 || (c = _queue.claim_pop(&pos)) != nullptr; });
+                        if (c == nullptr)
+                            throw poison_exception(_strength.load());
+                    }
+                    values[i] = _queue.publish_pop(c, pos);
+                    _room.fetch_add(1);
+                }
+                // Inform the writers of the batch
+                _waiter.wake();
+            }
+
+            /*!
+             * \brief Starts an extended read operation.  The value keeps its place in the buffer
+             * until the read ends.
+             *
+             * \return The value read from the channel.
+             */
+            T start_read() noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Ensure that we are not already reading.
+                if (_reading)
+                    throw std::logic_error("Channel already in extended read");
+                // Claim a cell, waiting if the buffer is empty.  Other readers pass it by.
+                cell *c = nullptr;
+                size_t pos = 0;
+                _waiter.await([&](){ return _strength.load() > 0 || (c = _queue.claim_pop(&pos)) != nullptr; });
+                if (c == nullptr)
+                    throw poison_exception(_strength.load());
+                _extended = c;
+                _extended_pos = pos;
+                _reading = true;
+                return std::move(c->value());
+            }
+
+            /*!
+             * \brief Ends an extended read operation.
+             */
+            void end_read() noexcept(false) override final
+            {
+                // Check that channel is in a reading state
+                if (!_reading)
+                    throw std::logic_error("Channel not in extended read");
+                // Release the cell and inform any waiting writer
+                take(_extended, _extended_pos);
+                _extended = nullptr;
+                _reading = false;
+            }
+
+            /*!
+             * \brief Performs the next step of a write operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[in] value The value to write to the channel.
+             *
+             * \return True if the write has completed, false if the operation is waiting.
+             */
+            bool write_async(async_op &op, T &value) noexcept(false) override final
+            {
+                if (op._phase != 1)
+                {
+                    // Check if poisoned, unless already parked
+                    if (!op._waiting && _strength.load() > 0)
+                        throw poison_exception(_strength.load());
+                    // Claim a cell, waiting if the buffer is full.  Phase 2 records reserved room.
+                    cell *c = nullptr;
+                    size_t pos = 0;
+                    bool reserved = op._phase == 2;
+                    auto claimed = [&]()
+                    {
+                        if (_strength.load() > 0)
+                            return true;
+                        c = claim_push(pos, reserved);
+                        if (reserved)
+                            op._phase = 2;
+                        return c != nullptr;
+                    };
+                    if (!_waiter.await_async(claimed, op))
+                        return false;
+                    if (c == nullptr)
+                    {
+                        unreserve(reserved);
+                        throw poison_exception(_strength.load());
+                    }
+                    publish(c, pos, std::move(value));
+                    op._phase = 1;
+                }
+                // Check if buffer is full and wait if it is
+                if (!_waiter.await_async([this](){ return _room.load() > 0 || _strength.load() > 0; }, op))
+                    return false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                return true;
+            }
+
+            /*!
+             * \brief Performs the next step of a read operation.
+             *
+             * \param[in] op The state of the operation.
+             * \param[out] value Set to the value read once the read has completed.
+             *
+             * \return True if the read has completed, false if the operation is waiting.
+             */
+            bool read_async(async_op &op, T &value) noexcept(false) override final
+            {
+                // Check if poisoned, unless already parked
+                if (!op._waiting && _strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, waiting if the buffer is empty
+                cell *c = nullptr;
+                size_t pos = 0;
+                if (!_waiter.await_async([&](){ return _strength.load() > 0 || (c = _queue.claim_pop(&pos)) != nullptr; }, op))
+                    return false;
+                if (c == nullptr)
+                    throw poison_exception(_strength.load());
+                value = take(c, pos);
+                return true;
+            }
+
+            /*!
+             * \brief Writes a value only if the buffer has room for it.  Does not wait for the
+             * buffer to drain afterwards.
+             *
+             * \param[in,out] value The value to write.  Moved from only if written.
+             *
+             * \return True if the value was written, false otherwise.
+             */
+            bool try_write(T &value) noexcept(false) override final
+            {
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, failing if the buffer is full
+                size_t pos = 0;
+                bool reserved = false;
+                cell *c = claim_push(pos, reserved);
+                if (c == nullptr)
+                {
+                    unreserve(reserved);
+                    return false;
+                }
+                publish(c, pos, std::move(value));
+                return true;
+            }
+
+            /*!
+             * \brief Reads a value only if the buffer holds one.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             *
+             * \return True if a value was read, false otherwise.
+             */
+            bool try_read(T &value) noexcept(false) override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Check if poisoned
-                if (_strength > 0)
-                    throw poison_exception(_strength);
-                // Check if buffer is empty, and if so wait until a write occurs.
-                if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
-                    _cond.wait(lock);
-                // Inform any waiting writers
-                _cond.notify_one();
                 // Check if poisoned
-                if (_strength > 0)
-                    throw poison_exception(_strength);
-                // Return value in the buffer.
-                return std::move(_buffer.get());
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, failing if the buffer is empty
+                size_t pos = 0;
+                cell *c = _queue.claim_pop(&pos);
+                if (c == nullptr)
+                    return false;
+                value = take(c, pos);
+                return true;
             }
 
             /*!
-             * \brief Starts an extended read operation.
+             * \brief Writes a value, giving up if the buffer has no room for it by the given time.
+             * Completes once the value is in the buffer.
              *
-             * \return The value read from the channel.
+             * \param[in,out] value The value to write.  Moved from only if written.
+             * \param[in] time The time to give up the write.
+             *
+             * \return True if the value was written, false if the time was reached first.
              */
-            T start_read() noexcept(false) override final
+            bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Check if poisoned
-                if (_strength > 0)
-                    throw poison_exception(_strength);
-                // Ensure that we are not already reading.
-                if (_reading)
-                    throw std::logic_error("Channel already in extended read");
-                // If buffer is empty then we wait
-                if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
-                    _cond.wait(lock);
-                // Set reading flag to true and return value in the buffer.
-                _reading = true;
                 // Check if poisoned
-                if (_strength > 0)
-                    throw poison_exception(_strength);
-                return std::move(_buffer.get());
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, waiting if the buffer is full
+                cell *c = nullptr;
+                size_t pos = 0;
+                bool reserved = false;
+                if (!_waiter.await_until([&](){ return _strength.load() > 0 || (c = claim_push(pos, reserved)) != nullptr; }, time))
+                {
+                    unreserve(reserved);
+                    return false;
+                }
+                if (c == nullptr)
+                {
+                    unreserve(reserved);
+                    throw poison_exception(_strength.load());
+                }
+                publish(c, pos, std::move(value));
+                return true;
             }
 
             /*!
-             * \brief Ends an extended read operation.
+             * \brief Reads a value, giving up if the buffer is still empty at the given time.
+             *
+             * \param[out] value Set to the value read if the read succeeds.
+             * \param[in] time The time to give up the read.
+             *
+             * \return True if a value was read, false if the time was reached first.
              */
-            void end_read() noexcept(false) override final
+            bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Check that channel is in a reading state
-                if (_reading)
-                    throw std::logic_error("Channel not in extended read");
-                // Inform any waiting writer
-                _cond.notify_one();
-                // Set reading flag to false
-                _reading = false;
+                // Check if poisoned
+                if (_strength.load() > 0)
+                    throw poison_exception(_strength.load());
+                // Claim a cell, waiting if the buffer is empty
+                cell *c = nullptr;
+                size_t pos = 0;
+                if (!_waiter.await_until([&](){ return _strength.load() > 0 || (c = _queue.claim_pop(&pos)) != nullptr; }, time))
+                    return false;
+                if (c == nullptr)
+                    throw poison_exception(_strength.load());
+                value = take(c, pos);
+                return true;
             }
 
             /*!
@@ -1487,21 +5484,14 @@ namespace csp
              */
             bool enable(const alt &a) noexcept override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Check if poisoned
-                if (_strength > 0)
-                    return true;
-                // If buffer is empty, then set alt and return false
-                if (_buffer.get_state() == DATA_STORE_STATE::EMPTY)
-                {
-                    _alting = true;
-                    _alt = a;
-                    return false;
-                }
-                    // Otherwise return true
-                else
+                // Check if poisoned or a value is already buffered
+                if (_strength.load() > 0 || _queue.size() > 0)
                     return true;
+                // Nobody reads the alt until the state is ALTING, so it is safe to set here
+                _alt = a;
+                _state.store(ALTING);
+                // A write may have arrived before the alt was registered
+                return _queue.size() > 0 || _strength.load() > 0;
             }
 
             /*!
@@ -1511,14 +5501,39 @@ namespace csp
              */
             bool disable() noexcept override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Set alting to false
-                _alting = false;
-                // Return whether the buffer has a value within it
-                return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0;
+                unsigned int count = 0;
+                while (true)
+                {
+                    unsigned int state = _state.load();
+                    if (state == ALTING)
+                    {
+                        // Withdraw the alt
+                        if (_state.compare_exchange_weak(state, IDLE))
+                            break;
+                    }
+                    else if (state == SCHEDULING)
+                        // Wait for the alt to be scheduled before reusing it
+                        chan_waiter::backoff(count);
+                    else
+                        break;
+                }
+                return _queue.size() > 0 || _strength.load() > 0;
             }
 
+            /*!
+             * \brief Checks if the channel handles concurrent writers and readers itself.
+             *
+             * \return Always true.
+             */
+            bool concurrent() const noexcept override final { return true; }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) noexcept override final { _waiter.set_strategy(strategy); }
+
             /*!
              * \brief Checks if a message is pending on the channel.
              *
@@ -1526,10 +5541,7 @@ namespace csp
              */
             bool pending() const noexcept override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
-                // Return whether the buffer has a value within it.
-                return _buffer.get_state() != DATA_STORE_STATE::EMPTY || _strength > 0;
+                return _queue.size() > 0 || _strength.load() > 0;
             }
 
             /*!
@@ -1539,12 +5551,10 @@ namespace csp
              */
             void reader_poison(unsigned int strength) noexcept override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
                 // Set strength
-                _strength = strength;
+                _strength.store(strength);
                 // Notify all waiting processes
-                _cond.notify_all();
+                _waiter.wake_all();
             }
 
             /*!
@@ -1554,81 +5564,80 @@ namespace csp
              */
             void writer_poison(unsigned int strength) noexcept override final
             {
-                // Lock the mutex
-                std::unique_lock<std::mutex> lock(_mut);
                 // Set strength
-                _strength = strength;
-                // Notify all waiting processes
-                _cond.notify_all();
+                _strength.store(strength);
                 // If in alt, schedule
-                if (_alting)
-                    guard::guard_internal::schedule(_alt);
+                schedule_alt();
+                // Notify all waiting processes
+                _waiter.wake_all();
             }
+
         public:
             /*!
-             * \brief Creates a new internal buffered channel.
+             * \brief Creates a new internal any2any buffered channel.
              *
-             * \param[in] buffer Buffer used within the underlying channel
+             * \param[in] size The number of values the buffer holds.
              */
-            buffered_chan_internal(chan_data_store<T> &buffer) noexcept
-            : _buffer(buffer)
+            any2any_buffered_chan_internal(size_t size) noexcept(false)
+            : _queue(size), _size(size > 0 ? size : 1), _room(_size), _state(IDLE), _strength(0)
             {
             }
 
             /*!
-             * \brief Destroys the internal buffered channel.
+             * \brief Destroys the internal any2any buffered channel.
              */
-            ~buffered_chan_internal() noexcept { }
+            ~any2any_buffered_chan_internal() noexcept { }
         };
 
-    public:
+        using internal_type = any2any_buffered_chan_internal; //!< Used by statically dispatched channels to call the implementation directly.
 
+    public:
         /*!
-         * \brief Creates a new buffered channel.
+         * \brief Creates a new any2any buffered channel.
          *
-         * \param[in] buffer The buffer to use in the channel.
+         * \param[in] size The number of values the buffer holds.
          */
-        buffered_chan(chan_data_store<T> &buffer) noexcept
-        : chan<T, POISONABLE>(std::shared_ptr<buffered_chan_internal>(new buffered_chan_internal(buffer)))
+        any2any_buffered_chan(size_t size) noexcept(false)
+        : chan<T, POISONABLE>(std::shared_ptr<any2any_buffered_chan_internal>(new any2any_buffered_chan_internal(size)))
         {
         }
 
         /*!
          * \brief Copy constructor.
          *
-         * \param[in] other The buffered channel to copy.
+         * \param[in] other The channel object to copy.
          */
-        buffered_chan(const buffered_chan<T, POISONABLE> &other) noexcept = default;
+        any2any_buffered_chan(const any2any_buffered_chan<T, POISONABLE> &other) = default;
 
         /*!
          * \brief Move constructor.
          *
-         * \param[in] rhs The buffered channel to copy.
+         * \param[in] rhs The channel object to copy.
          */
-        buffered_chan(buffered_chan<T, POISONABLE> &&rhs) noexcept = default;
+        any2any_buffered_chan(any2any_buffered_chan<T, POISONABLE> &&rhs) = default;
 
         /*!
          * \brief Copy assignment operator.
          *
-         * \param[in] other The buffered channel to copy.
+         * \param[in] other The channel object to copy.
          *
-         * \return A copy of the buffered channel.
+         * \return A copy of the channel object.
          */
-        buffered_chan<T, POISONABLE>& operator=(const buffered_chan<T, POISONABLE> &other) noexcept = default;
+        any2any_buffered_chan<T, POISONABLE>& operator=(const any2any_buffered_chan<T, POISONABLE> &other) = default;
 
         /*!
          * \brief Move assignment operator.
          *
-         * \param[in] rhs The buffered channel to copy.
+         * \param[in] rhs The channel object to copy.
          *
-         * \return A copy of the buffered channel.
+         * \return A copy of the channel object.
          */
-        buffered_chan<T, POISONABLE>& operator=(buffered_chan<T, POISONABLE> &&rhs) noexcept = default;
+        any2any_buffered_chan<T, POISONABLE>& operator=(any2any_buffered_chan<T, POISONABLE> &&rhs) = default;
 
         /*!
-         * \brief Destroys the channel.
+         * \brief Destroys the channel object.
          */
-        ~buffered_chan() { }
+        ~any2any_buffered_chan() { }
     };
 
     // TODO: one2one symmetric channel.
@@ -1666,7 +5675,7 @@ namespace csp
          * \param[in] immunity The poison immunity level that the channel has.
          */
         one2one_chan(unsigned int immunity = 0) noexcept
-        : _chan(basic_chan<T, POISONABLE>()),
+        : _chan(one2one_basic_chan<T, POISONABLE>()),
           _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
           _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
         {
@@ -1685,6 +5694,50 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Creates a new buffered one2one channel.  A plain buffer is implemented on a lock-free ring
+         * rather than through the chan_data_store.
+         *
+         * \param[in] buffer The buffer to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        one2one_chan(buffer<T> &buffer, unsigned int immunity = 0) noexcept
+        : _chan(one2one_buffered_chan<T, POISONABLE>(buffer.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered one2one channel on a lock-free ring.
+         *
+         * \param[in] store The buffer store giving the size of the buffer.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        one2one_chan(const buffer_store<T> &store, unsigned int immunity = 0) noexcept
+        : _chan(one2one_buffered_chan<T, POISONABLE>(store.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered one2one channel using a data store policy.  Buffer operations
+         * are called directly rather than through the chan_data_store vtable.
+         *
+         * \tparam STORE The data store policy, e.g. buffer_store<T>.
+         *
+         * \param[in] store The data store policy to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        template<typename STORE, typename = typename std::enable_if<std::is_base_of<chan_data_store_policy, STORE>::value>::type>
+        one2one_chan(STORE store, unsigned int immunity = 0) noexcept
+        : _chan(buffered_chan<T, POISONABLE, STORE>(std::move(store))),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
         /*!
          * \brief Gets the input end of the one2one channel.
          *
@@ -1732,6 +5785,13 @@ namespace csp
         {
             _out.write(value);
         }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
     };
 
     /*! \class one2any_chan
@@ -1767,7 +5827,7 @@ namespace csp
          * \param[in] immunity The poison immunity level of the channel.
          */
         one2any_chan(unsigned int immunity = 0) noexcept
-        : _chan(basic_chan<T, POISONABLE>()),
+        : _chan(any2any_basic_chan<T, POISONABLE>()),
           _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
           _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
         {
@@ -1786,6 +5846,50 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Creates a new buffered one2any channel.  A plain buffer is implemented on a lock-free bounded queue
+         * rather than through the chan_data_store.
+         *
+         * \param[in] buffer The buffer to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        one2any_chan(buffer<T> &buffer, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(buffer.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered one2any channel on a lock-free bounded queue.
+         *
+         * \param[in] store The buffer store giving the size of the buffer.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        one2any_chan(const buffer_store<T> &store, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(store.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered one2any channel using a data store policy.  Buffer operations
+         * are called directly rather than through the chan_data_store vtable.
+         *
+         * \tparam STORE The data store policy, e.g. buffer_store<T>.
+         *
+         * \param[in] store The data store policy to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        template<typename STORE, typename = typename std::enable_if<std::is_base_of<chan_data_store_policy, STORE>::value>::type>
+        one2any_chan(STORE store, unsigned int immunity = 0) noexcept
+        : _chan(buffered_chan<T, POISONABLE, STORE>(std::move(store))),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
         /*!
          * \brief Gets the input end of the one2any channel.
          *
@@ -1827,6 +5931,13 @@ namespace csp
          * \param[in] value The value to write to the channel.
          */
         void operator()(T value) const noexcept { _out.write(value); }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
     };
 
     /*! \class any2one_chan
@@ -1862,7 +5973,7 @@ namespace csp
          * \param[in] immunity The poison immunity level of the channel.
          */
         any2one_chan(unsigned int immunity = 0) noexcept
-        : _chan(basic_chan<T, POISONABLE>()),
+        : _chan(any2any_basic_chan<T, POISONABLE>()),
           _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
           _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
         {
@@ -1881,6 +5992,50 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Creates a new buffered any2one channel.  A plain buffer is implemented on a lock-free bounded queue
+         * rather than through the chan_data_store.
+         *
+         * \param[in] buffer The buffer to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        any2one_chan(buffer<T> &buffer, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(buffer.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered any2one channel on a lock-free bounded queue.
+         *
+         * \param[in] store The buffer store giving the size of the buffer.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        any2one_chan(const buffer_store<T> &store, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(store.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered any2one channel using a data store policy.  Buffer operations
+         * are called directly rather than through the chan_data_store vtable.
+         *
+         * \tparam STORE The data store policy, e.g. buffer_store<T>.
+         *
+         * \param[in] store The data store policy to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        template<typename STORE, typename = typename std::enable_if<std::is_base_of<chan_data_store_policy, STORE>::value>::type>
+        any2one_chan(STORE store, unsigned int immunity = 0) noexcept
+        : _chan(buffered_chan<T, POISONABLE, STORE>(std::move(store))),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
         /*!
          * \brief Gets the input end of the channel.
          *
@@ -1922,6 +6077,13 @@ namespace csp
          * \param[in] value The value to write to the channel.
          */
         void operator()(T value) const noexcept { _out.write(value); }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
     };
 
     /*! \class any2any_chan
@@ -1957,7 +6119,7 @@ namespace csp
          * \param[in] immunity The poison immunity level of the channel.
          */
         any2any_chan(unsigned int immunity = 0) noexcept
-        : _chan(basic_chan<T, POISONABLE>()),
+        : _chan(any2any_basic_chan<T, POISONABLE>()),
           _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
           _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
         {
@@ -1976,6 +6138,50 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Creates a new buffered any2any channel.  A plain buffer is implemented on a lock-free bounded queue
+         * rather than through the chan_data_store.
+         *
+         * \param[in] buffer The buffer to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        any2any_chan(buffer<T> &buffer, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(buffer.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered any2any channel on a lock-free bounded queue.
+         *
+         * \param[in] store The buffer store giving the size of the buffer.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        any2any_chan(const buffer_store<T> &store, unsigned int immunity = 0) noexcept
+        : _chan(any2any_buffered_chan<T, POISONABLE>(store.size())),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
+        /*!
+         * \brief Creates a new buffered any2any channel using a data store policy.  Buffer operations
+         * are called directly rather than through the chan_data_store vtable.
+         *
+         * \tparam STORE The data store policy, e.g. buffer_store<T>.
+         *
+         * \param[in] store The data store policy to use with the channel.
+         * \param[in] immunity The poison immunity level that the channel has.
+         */
+        template<typename STORE, typename = typename std::enable_if<std::is_base_of<chan_data_store_policy, STORE>::value>::type>
+        any2any_chan(STORE store, unsigned int immunity = 0) noexcept
+        : _chan(buffered_chan<T, POISONABLE, STORE>(std::move(store))),
+          _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+          _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+        {
+        }
+
         /*!
          * \brief Gets the input end of the channel.
          *
@@ -2017,6 +6223,13 @@ namespace csp
          * \param[in] value The value written to the channel.
          */
         void operator()(T value) const noexcept { _out.write(value); }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
     };
 }
 
@@ -5,9 +5,15 @@
 #ifndef CPP_CSP_CHAN_DATA_STORE_H
 #define CPP_CSP_CHAN_DATA_STORE_H
 
+#include <atomic>
 #include <exception>
 #include <memory>
-#include <deque>
+#include <new>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace csp
 {
@@ -25,6 +31,919 @@ namespace csp
         FULL = 2
     };
 
+    /*!
+     * \brief Copies a value from a batched write.  Batched writes copy from the array they are
+     * given, so values that cannot be copied cannot be written in a batch.  The check is made when
+     * the batch is written rather than at compile time, as the channel operations are virtual.
+     *
+     * \tparam T The type of value.
+     *
+     * \param[in] value The value to copy.
+     *
+     * \return A copy of the value.
+     */
+    template<typename T>
+    inline typename std::enable_if<std::is_copy_constructible<T>::value, T>::type batch_copy(const T &value) noexcept(false)
+    {
+        return value;
+    }
+
+    template<typename T>
+    inline typename std::enable_if<!std::is_copy_constructible<T>::value, T>::type batch_copy(const T&) noexcept(false)
+    {
+        throw std::logic_error("Batched write of a type that cannot be copied");
+    }
+
+    /*! \class ring_buffer
+     * \brief A queue held in a single block of memory, used as the storage for the channel data stores.
+     *
+     * The capacity is rounded up to a power of two so that indices wrap with a mask rather than a
+     * division, and the slots start on a cache line.  Memory is only allocated on construction and
+     * when the buffer is explicitly grown, so a buffer in use does not allocate.
+     *
+     * \tparam T The type stored in the buffer.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class ring_buffer
+    {
+    private:
+        static constexpr size_t CACHE_LINE = 64; //!< Alignment of the slots.
+
+        char *_memory = nullptr; //!< The memory allocated for the slots.
+
+        T *_slots = nullptr; //!< The slots, aligned to a cache line within the allocated memory.
+
+        size_t _mask = 0; //!< The capacity less one.  Used to wrap indices.
+
+        size_t _head = 0; //!< Count of values taken from the buffer.  The next value is at _head & _mask.
+
+        size_t _tail = 0; //!< Count of values added to the buffer.  The next slot is at _tail & _mask.
+
+        /*!
+         * \brief Allocates slots for the given capacity.
+         *
+         * \param[in] capacity The number of slots.  Must be a power of two.
+         */
+        void allocate(size_t capacity) noexcept(false)
+        {
+            _memory = static_cast<char*>(::operator new(capacity * sizeof(T) + CACHE_LINE - 1));
+            auto address = reinterpret_cast<std::uintptr_t>(_memory);
+            _slots = reinterpret_cast<T*>((address + CACHE_LINE - 1) & ~static_cast<std::uintptr_t>(CACHE_LINE - 1));
+            _mask = capacity - 1;
+            _head = 0;
+            _tail = 0;
+        }
+
+        /*!
+         * \brief Rounds a capacity up to a power of two.
+         *
+         * \param[in] n The capacity required.
+         *
+         * \return The smallest power of two not less than n.
+         */
+        static size_t round_up(size_t n) noexcept
+        {
+            size_t capacity = 1;
+            while (capacity < n)
+                capacity <<= 1;
+            return capacity;
+        }
+
+    public:
+        /*!
+         * \brief Creates a new ring buffer.
+         *
+         * \param[in] capacity The minimum number of values the buffer can hold.
+         */
+        explicit ring_buffer(size_t capacity = 1) noexcept(false)
+        {
+            allocate(round_up(capacity));
+        }
+
+        /*!
+         * \brief Copy constructor.  Copies the values held.
+         *
+         * \param[in] other The ring buffer to copy.
+         */
+        ring_buffer(const ring_buffer<T> &other) noexcept(false)
+        {
+            allocate(other.capacity());
+            for (auto i = other._head; i != other._tail; ++i)
+                push_back(T(other._slots[i & other._mask]));
+        }
+
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The ring buffer to take the values from.
+         */
+        ring_buffer(ring_buffer<T> &&rhs) noexcept
+        : _memory(rhs._memory), _slots(rhs._slots), _mask(rhs._mask), _head(rhs._head), _tail(rhs._tail)
+        {
+            rhs._memory = nullptr;
+            rhs._slots = nullptr;
+            rhs._head = rhs._tail = 0;
+        }
+
+        /*!
+         * \brief Assignment operator.
+         *
+         * \param[in] other The ring buffer to copy.
+         *
+         * \return This ring buffer.
+         */
+        ring_buffer<T>& operator=(ring_buffer<T> other) noexcept
+        {
+            std::swap(_memory, other._memory);
+            std::swap(_slots, other._slots);
+            std::swap(_mask, other._mask);
+            std::swap(_head, other._head);
+            std::swap(_tail, other._tail);
+            return *this;
+        }
+
+        /*!
+         * \brief Destroys the ring buffer and the values within it.
+         */
+        ~ring_buffer() noexcept
+        {
+            clear();
+            ::operator delete(_memory);
+        }
+
+        /*!
+         * \brief Gets the number of values in the buffer.
+         *
+         * \return The number of values in the buffer.
+         */
+        size_t size() const noexcept { return _tail - _head; }
+
+        /*!
+         * \brief Gets the number of values the buffer can hold.
+         *
+         * \return The capacity of the buffer.
+         */
+        size_t capacity() const noexcept { return _mask + 1; }
+
+        /*!
+         * \brief Adds a value to the back of the buffer.  The buffer must not be full.
+         *
+         * \param[in] value The value to add.
+         */
+        void push_back(T &&value) noexcept(false)
+        {
+            new (&_slots[_tail & _mask]) T(std::move(value));
+            ++_tail;
+        }
+
+        /*!
+         * \brief Removes the value at the front of the buffer.  The buffer must not be empty.
+         *
+         * \return The value removed.
+         */
+        T pop_front() noexcept(false)
+        {
+            T &slot = _slots[_head & _mask];
+            T to_return(std::move(slot));
+            slot.~T();
+            ++_head;
+            return to_return;
+        }
+
+        /*!
+         * \brief Gets the value at the back of the buffer.  The buffer must not be empty.
+         *
+         * \return Reference to the newest value.
+         */
+        T& back() noexcept { return _slots[(_tail - 1) & _mask]; }
+
+        /*!
+         * \brief Destroys all values in the buffer.
+         */
+        void clear() noexcept
+        {
+            for (; _head != _tail; ++_head)
+                _slots[_head & _mask].~T();
+        }
+
+        /*!
+         * \brief Doubles the capacity of the buffer, keeping the values held.
+         */
+        void grow() noexcept(false)
+        {
+            ring_buffer<T> larger(capacity() * 2);
+            while (size() > 0)
+                larger.push_back(pop_front());
+            *this = std::move(larger);
+        }
+    };
+
+    /*! \class spsc_ring
+     * \brief A bounded lock-free queue for a single producer and a single consumer.
+     *
+     * The producer owns the tail and the consumer the head, and each is kept on its own cache line
+     * so that neither side writes to a line the other is writing to.  The slots are held as in
+     * ring_buffer.
+     *
+     * \tparam T The type stored in the queue.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class spsc_ring
+    {
+    private:
+        static constexpr size_t CACHE_LINE = 64; //!< Size of a cache line.
+
+        char *_memory; //!< The memory allocated for the slots.
+
+        T *_slots; //!< The slots, aligned to a cache line within the allocated memory.
+
+        size_t _mask; //!< The number of slots less one.  Used to wrap indices.
+
+        size_t _size; //!< The number of values the queue holds when full.
+
+        char _pad0[CACHE_LINE]; //!< Keeps the head off the line holding the fields above.
+
+        std::atomic<size_t> _head; //!< Count of values taken from the queue.  Written by the consumer.
+
+        char _pad1[CACHE_LINE - sizeof(std::atomic<size_t>)]; //!< Keeps the head and tail on separate lines.
+
+        std::atomic<size_t> _tail; //!< Count of values added to the queue.  Written by the producer.
+
+        char _pad2[CACHE_LINE - sizeof(std::atomic<size_t>)]; //!< Keeps the tail off the line of whatever follows.
+
+    public:
+        /*!
+         * \brief Creates a new queue.
+         *
+         * \param[in] size The number of values the queue holds when full.
+         */
+        explicit spsc_ring(size_t size) noexcept(false)
+        : _size(size > 0 ? size : 1), _head(0), _tail(0)
+        {
+            size_t capacity = 1;
+            while (capacity < _size)
+                capacity <<= 1;
+            _memory = static_cast<char*>(::operator new(capacity * sizeof(T) + CACHE_LINE - 1));
+            auto address = reinterpret_cast<std::uintptr_t>(_memory);
+            _slots = reinterpret_cast<T*>((address + CACHE_LINE - 1) & ~static_cast<std::uintptr_t>(CACHE_LINE - 1));
+            _mask = capacity - 1;
+        }
+
+        spsc_ring(const spsc_ring<T>&) = delete;
+
+        spsc_ring<T>& operator=(const spsc_ring<T>&) = delete;
+
+        /*!
+         * \brief Destroys the queue and the values within it.
+         */
+        ~spsc_ring() noexcept
+        {
+            for (auto i = _head.load(); i != _tail.load(); ++i)
+                _slots[i & _mask].~T();
+            ::operator delete(_memory);
+        }
+
+        /*!
+         * \brief Gets the number of values in the queue.
+         *
+         * \return The number of values in the queue.
+         */
+        size_t size() const noexcept { return _tail.load() - _head.load(); }
+
+        /*!
+         * \brief Checks if the queue is empty.  Exact when called by the consumer.
+         *
+         * \return True if the queue holds no values, false otherwise.
+         */
+        bool empty() const noexcept { return _tail.load() == _head.load(); }
+
+        /*!
+         * \brief Checks if the queue is full.  Exact when called by the producer.
+         *
+         * \return True if the queue holds as many values as it can, false otherwise.
+         */
+        bool full() const noexcept { return _tail.load() - _head.load() >= _size; }
+
+        /*!
+         * \brief Adds a value to the back of the queue.  Only called by the producer, and only
+         * when the queue is not full.
+         *
+         * \param[in] value The value to add.
+         */
+        void push(T &&value) noexcept(false)
+        {
+            auto tail = _tail.load(std::memory_order_relaxed);
+            new (&_slots[tail & _mask]) T(std::move(value));
+            _tail.store(tail + 1);
+        }
+
+        /*!
+         * \brief Copies as many values to the back of the queue as fit, publishing them together.
+         * Only called by the producer.
+         *
+         * \param[in] values The values to add.
+         * \param[in] n The number of values to add.
+         *
+         * \return The number of values added.
+         */
+        size_t push_n(const T *values, size_t n) noexcept(false)
+        {
+            auto tail = _tail.load(std::memory_order_relaxed);
+            auto space = _size - (tail - _head.load());
+            if (n > space)
+                n = space;
+            for (size_t i = 0; i < n; ++i)
+                new (&_slots[(tail + i) & _mask]) T(batch_copy(values[i]));
+            _tail.store(tail + n);
+            return n;
+        }
+
+        /*!
+         * \brief Moves as many values from the front of the queue as are there, up to n, releasing
+         * the slots together.  Only called by the consumer.
+         *
+         * \param[out] values Where to put the values removed.
+         * \param[in] n The maximum number of values to remove.
+         *
+         * \return The number of values removed.
+         */
+        size_t pop_n(T *values, size_t n) noexcept(false)
+        {
+            auto head = _head.load(std::memory_order_relaxed);
+            auto available = _tail.load() - head;
+            if (n > available)
+                n = available;
+            for (size_t i = 0; i < n; ++i)
+            {
+                T &slot = _slots[(head + i) & _mask];
+                values[i] = std::move(slot);
+                slot.~T();
+            }
+            _head.store(head + n);
+            return n;
+        }
+
+        /*!
+         * \brief Gets the value at the front of the queue.  Only called by the consumer, and only
+         * when the queue is not empty.
+         *
+         * \return Reference to the oldest value.
+         */
+        T& front() noexcept { return _slots[_head.load(std::memory_order_relaxed) & _mask]; }
+
+        /*!
+         * \brief Removes the value at the front of the queue.  Only called by the consumer, and
+         * only when the queue is not empty.
+         *
+         * \return The value removed.
+         */
+        T pop() noexcept(false)
+        {
+            auto head = _head.load(std::memory_order_relaxed);
+            T &slot = _slots[head & _mask];
+            T to_return(std::move(slot));
+            slot.~T();
+            _head.store(head + 1);
+            return to_return;
+        }
+    };
+
+    /*! \class mpmc_ring
+     * \brief A bounded lock-free queue for many producers and many consumers.
+     *
+     * Based on Dmitry Vyukov's bounded MPMC queue.  Each cell carries a sequence number which
+     * tells a producer or consumer whether the cell is ready for it, so the only contended
+     * operations are a compare and swap on the enqueue or dequeue position.  Adding or removing
+     * a value is split into claiming a cell and publishing it, so that a value need not be
+     * default constructed to be read out.
+     *
+     * \tparam T The type stored in the queue.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class mpmc_ring
+    {
+    public:
+        /*! \struct cell
+         * \brief A slot in the queue.
+         */
+        struct cell
+        {
+            std::atomic<size_t> sequence; //!< Position the cell is next ready for.
+
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage; //!< The value held in the cell.
+
+            /*!
+             * \brief Gets the value held in the cell.
+             *
+             * \return Reference to the value.
+             */
+            T& value() noexcept { return *reinterpret_cast<T*>(&storage); }
+        };
+
+    private:
+        static constexpr size_t CACHE_LINE = 64; //!< Size of a cache line.
+
+        cell *_cells; //!< The cells of the queue.
+
+        size_t _mask; //!< The number of cells less one.  Used to wrap positions.
+
+        char _pad0[CACHE_LINE]; //!< Keeps the enqueue position off the line holding the fields above.
+
+        std::atomic<size_t> _enqueue; //!< Position of the next cell to add a value to.
+
+        char _pad1[CACHE_LINE - sizeof(std::atomic<size_t>)]; //!< Keeps the positions on separate lines.
+
+        std::atomic<size_t> _dequeue; //!< Position of the next cell to take a value from.
+
+        char _pad2[CACHE_LINE - sizeof(std::atomic<size_t>)]; //!< Keeps the dequeue position off the line of whatever follows.
+
+    public:
+        /*!
+         * \brief Creates a new queue.
+         *
+         * \param[in] capacity The minimum number of values the queue can hold.  Rounded up to a
+         * power of two, and to at least two, which the sequence numbering requires.
+         */
+        explicit mpmc_ring(size_t capacity) noexcept(false)
+        : _enqueue(0), _dequeue(0)
+        {
+            size_t n = 2;
+            while (n < capacity)
+                n <<= 1;
+            _cells = new cell[n];
+            for (size_t i = 0; i < n; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            _mask = n - 1;
+        }
+
+        mpmc_ring(const mpmc_ring<T>&) = delete;
+
+        mpmc_ring<T>& operator=(const mpmc_ring<T>&) = delete;
+
+        /*!
+         * \brief Destroys the queue and the values within it.
+         */
+        ~mpmc_ring() noexcept
+        {
+            cell *c;
+            while ((c = claim_pop(nullptr)) != nullptr)
+                c->value().~T();
+            delete[] _cells;
+        }
+
+        /*!
+         * \brief Gets the number of values in the queue.  Only a snapshot while other processes
+         * are using the queue.
+         *
+         * \return The number of values in the queue.
+         */
+        size_t size() const noexcept
+        {
+            auto dequeue = _dequeue.load();
+            auto enqueue = _enqueue.load();
+            return enqueue > dequeue ? enqueue - dequeue : 0;
+        }
+
+        /*!
+         * \brief Claims a cell to add a value to.
+         *
+         * \param[out] pos Set to the position of the cell claimed.
+         *
+         * \return The cell claimed, or nullptr if the queue is full.
+         */
+        cell* claim_push(size_t &pos) noexcept
+        {
+            pos = _enqueue.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell *c = &_cells[pos & _mask];
+                auto seq = c->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return c;
+                }
+                else if (diff < 0)
+                    return nullptr;
+                else
+                    pos = _enqueue.load(std::memory_order_relaxed);
+            }
+        }
+
+        /*!
+         * \brief Places a value in a claimed cell and makes it available to consumers.
+         *
+         * \param[in] c The cell claimed by claim_push.
+         * \param[in] pos The position of the cell.
+         * \param[in] value The value to add.
+         */
+        void publish_push(cell *c, size_t pos, T &&value) noexcept(false)
+        {
+            new (&c->storage) T(std::move(value));
+            c->sequence.store(pos + 1, std::memory_order_seq_cst);
+        }
+
+        /*!
+         * \brief Claims a cell to take a value from.
+         *
+         * \param[out] pos Set to the position of the cell claimed, if not null.
+         *
+         * \return The cell claimed, or nullptr if the queue is empty.
+         */
+        cell* claim_pop(size_t *pos) noexcept
+        {
+            auto p = _dequeue.load(std::memory_order_relaxed);
+            while (true)
+            {
+                cell *c = &_cells[p & _mask];
+                auto seq = c->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(p + 1);
+                if (diff == 0)
+                {
+                    if (_dequeue.compare_exchange_weak(p, p + 1, std::memory_order_relaxed))
+                    {
+                        if (pos)
+                            *pos = p;
+                        return c;
+                    }
+                }
+                else if (diff < 0)
+                    return nullptr;
+                else
+                    p = _dequeue.load(std::memory_order_relaxed);
+            }
+        }
+
+        /*!
+         * \brief Takes the value from a claimed cell and makes the cell available to producers.
+         *
+         * \param[in] c The cell claimed by claim_pop.
+         * \param[in] pos The position of the cell.
+         *
+         * \return The value taken.
+         */
+        T publish_pop(cell *c, size_t pos) noexcept(false)
+        {
+            T to_return(std::move(c->value()));
+            c->value().~T();
+            c->sequence.store(pos + _mask + 1, std::memory_order_seq_cst);
+            return to_return;
+        }
+    };
+
+    /*! \class chan_data_store_policy
+     * \brief Base class of the data store policies.
+     *
+     * A policy is a data store with non-virtual operations.  Channels can be given a policy
+     * directly, in which case every buffer operation is resolved at compile time, or through
+     * one of the chan_data_store classes, in which case it is called through a vtable.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class chan_data_store_policy
+    {
+    };
+
+    /*! \class buffer_store
+     * \brief Policy for a standard buffer of a fixed size.
+     *
+     * \tparam T The type that the buffer operates on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class buffer_store : public chan_data_store_policy
+    {
+    private:
+        size_t _size; //!< The size of the buffer.
+
+        ring_buffer<T> _buffer; //!< The actual buffer used to store data.
+
+    public:
+        /*!
+         * \brief Creates a new buffer store.
+         *
+         * \param[in] size The size of the buffer.
+         */
+        explicit buffer_store(size_t size) noexcept(false)
+        : _size(size), _buffer(size)
+        {
+        }
+
+        /*!
+         * \brief Adds a value to the buffer.  The buffer must not be full.
+         *
+         * \param[in] value The value to add to the buffer.
+         */
+        void put(T value) noexcept(false) { _buffer.push_back(std::move(value)); }
+
+        /*!
+         * \brief Gets a value from the buffer.
+         *
+         * \return The value removed from the buffer.
+         */
+        T get() noexcept(false) { return _buffer.pop_front(); }
+
+        /*!
+         * \brief Clears all values from the buffer.
+         */
+        void clear() noexcept { _buffer.clear(); }
+
+        /*!
+         * \brief Gets the current state of the buffer.
+         *
+         * \return The current state of the buffer.
+         */
+        DATA_STORE_STATE get_state() const noexcept
+        {
+            if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
+            else if (_buffer.size() == _size) return DATA_STORE_STATE::FULL;
+            else return DATA_STORE_STATE::NONEMPTYFULL;
+        }
+
+        /*!
+         * \brief Gets the number of values the buffer holds when full.
+         *
+         * \return The size of the buffer.
+         */
+        size_t size() const noexcept { return _size; }
+    };
+
+    /*! \class infinite_buffer_store
+     * \brief Policy for a buffer with infinite size.  Grows by doubling, so stops allocating once
+     * it has reached the largest size it is used at.
+     *
+     * \tparam T The type that the buffer operates on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class infinite_buffer_store : public chan_data_store_policy
+    {
+    private:
+        static constexpr size_t INITIAL_CAPACITY = 16; //!< Capacity of the buffer when created.
+
+        ring_buffer<T> _buffer; //!< The actual buffer used to store data.
+
+    public:
+        /*!
+         * \brief Creates a new infinite buffer store.
+         */
+        infinite_buffer_store() noexcept(false)
+        : _buffer(INITIAL_CAPACITY)
+        {
+        }
+
+        /*!
+         * \brief Adds a value to the buffer.
+         *
+         * \param[in] value The value to add to the buffer.
+         */
+        void put(T value) noexcept(false)
+        {
+            if (_buffer.size() == _buffer.capacity())
+                _buffer.grow();
+            _buffer.push_back(std::move(value));
+        }
+
+        /*!
+         * \brief Gets a value from the buffer.
+         *
+         * \return The value removed from the buffer.
+         */
+        T get() noexcept(false) { return _buffer.pop_front(); }
+
+        /*!
+         * \brief Clears all values from the buffer.
+         */
+        void clear() noexcept { _buffer.clear(); }
+
+        /*!
+         * \brief Gets the current state of the buffer.
+         *
+         * \return The current state of the buffer.
+         */
+        DATA_STORE_STATE get_state() const noexcept
+        {
+            if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
+            else return DATA_STORE_STATE::NONEMPTYFULL;
+        }
+    };
+
+    /*! \class overflowing_buffer_store
+     * \brief Policy for a buffer that discards any value when it is full.
+     *
+     * \tparam T The type that the buffer operates on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class overflowing_buffer_store : public chan_data_store_policy
+    {
+    private:
+        size_t _size; //!< The size of the buffer.
+
+        ring_buffer<T> _buffer; //!< The actual buffer used to store data.
+
+    public:
+        /*!
+         * \brief Creates a new overflowing buffer store.
+         *
+         * \param[in] size The size of the buffer.
+         */
+        explicit overflowing_buffer_store(size_t size) noexcept(false)
+        : _size(size), _buffer(size)
+        {
+        }
+
+        /*!
+         * \brief Adds a value to the buffer.
+         *
+         * \param[in] value The value to add to the buffer.
+         */
+        void put(T value) noexcept(false)
+        {
+            // Only add values if buffer is not full.
+            if (_buffer.size() < _size)
+                _buffer.push_back(std::move(value));
+        }
+
+        /*!
+         * \brief Gets a value from the buffer.
+         *
+         * \return The value removed from the buffer.
+         */
+        T get() noexcept(false) { return _buffer.pop_front(); }
+
+        /*!
+         * \brief Clears all values from the buffer.
+         */
+        void clear() noexcept { _buffer.clear(); }
+
+        /*!
+         * \brief Gets the current state of the buffer.
+         *
+         * \return The current state of the buffer.
+         */
+        DATA_STORE_STATE get_state() const noexcept
+        {
+            if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
+            else return DATA_STORE_STATE::NONEMPTYFULL;
+        }
+    };
+
+    /*! \class overwrite_oldest_buffer_store
+     * \brief Policy for a buffer that overwrites its oldest value when full.
+     *
+     * \tparam T The type that the buffer operates on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class overwrite_oldest_buffer_store : public chan_data_store_policy
+    {
+    private:
+        size_t _size; //!< The size of the buffer.
+
+        ring_buffer<T> _buffer; //!< The actual buffer used to store data.
+
+    public:
+        /*!
+         * \brief Creates a new overwrite oldest buffer store.
+         *
+         * \param[in] size The size of the buffer.
+         */
+        explicit overwrite_oldest_buffer_store(size_t size) noexcept(false)
+        : _size(size), _buffer(size)
+        {
+        }
+
+        /*!
+         * \brief Adds a value to the buffer.
+         *
+         * \param[in] value The value to add to the buffer.
+         */
+        void put(T value) noexcept(false)
+        {
+            // If buffer is full, remove oldest (front) value
+            if (_buffer.size() == _size)
+                _buffer.pop_front();
+            _buffer.push_back(std::move(value));
+        }
+
+        /*!
+         * \brief Gets a value from the buffer.
+         *
+         * \return The value removed from the buffer.
+         */
+        T get() noexcept(false) { return _buffer.pop_front(); }
+
+        /*!
+         * \brief Clears all values from the buffer.
+         */
+        void clear() noexcept { _buffer.clear(); }
+
+        /*!
+         * \brief Gets the current state of the buffer.
+         *
+         * \return The current state of the buffer.
+         */
+        DATA_STORE_STATE get_state() const noexcept
+        {
+            if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
+            else return DATA_STORE_STATE::NONEMPTYFULL;
+        }
+    };
+
+    /*! \class overwriting_buffer_store
+     * \brief Policy for a buffer that overwrites its newest value when full.
+     *
+     * \tparam T The type that the buffer operates on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T>
+    class overwriting_buffer_store : public chan_data_store_policy
+    {
+    private:
+        size_t _size; //!< The size of the buffer.
+
+        ring_buffer<T> _buffer; //!< The actual buffer used to store data.
+
+    public:
+        /*!
+         * \brief Creates a new overwriting buffer store.
+         *
+         * \param[in] size The size of the buffer.
+         */
+        explicit overwriting_buffer_store(size_t size) noexcept(false)
+        : _size(size), _buffer(size)
+        {
+        }
+
+        /*!
+         * \brief Adds a value to the buffer.
+         *
+         * \param[in] value The value to add to the buffer.
+         */
+        void put(T value) noexcept(false)
+        {
+            // If buffer is full, replace the last item
+            if (_buffer.size() == _size && _size > 0)
+                _buffer.back() = std::move(value);
+            else if (_size > 0)
+                _buffer.push_back(std::move(value));
+        }
+
+        /*!
+         * \brief Gets a value from the buffer.
+         *
+         * \return The value removed from the buffer.
+         */
+        T get() noexcept(false) { return _buffer.pop_front(); }
+
+        /*!
+         * \brief Clears all values from the buffer.
+         */
+        void clear() noexcept { _buffer.clear(); }
+
+        /*!
+         * \brief Gets the current state of the buffer.
+         *
+         * \return The current state of the buffer.
+         */
+        DATA_STORE_STATE get_state() const noexcept
+        {
+            if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
+            else return DATA_STORE_STATE::NONEMPTYFULL;
+        }
+    };
+
     /*! \class chan_data_store
      * \brief Interface for a channel data store.  Used within buffered channels.
      *
@@ -80,6 +999,41 @@ namespace csp
             virtual ~chan_data_store_internal() { }
         };
 
+        /*! \class policy_internal
+         * \brief Internal representation of a channel data store that uses the given policy.
+         *
+         * \tparam POLICY The data store policy.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename POLICY>
+        class policy_internal : public chan_data_store_internal
+        {
+        private:
+            POLICY _store; //!< The data store policy.
+
+        public:
+            /*!
+             * \brief Creates a new internal data store.
+             *
+             * \param[in] store The data store policy.
+             */
+            policy_internal(POLICY &&store) noexcept
+            : _store(std::move(store))
+            {
+            }
+
+            void put(T value) noexcept(false) override final { _store.put(std::move(value)); }
+
+            T get() noexcept(false) override final { return _store.get(); }
+
+            void clear() noexcept override final { _store.clear(); }
+
+            DATA_STORE_STATE get_state() const noexcept override final { return _store.get_state(); }
+        };
+
         std::shared_ptr<chan_data_store_internal> _internal = nullptr; //<! Pointer to the actual channel data store.
 
         /*!
@@ -92,6 +1046,19 @@ namespace csp
         {
         }
 
+        /*!
+         * \brief Protected constructor.  Used to create a chan_data_store from a data store policy.
+         *
+         * \tparam POLICY The data store policy.
+         *
+         * \param[in] store The data store policy.
+         */
+        template<typename POLICY, typename = typename std::enable_if<std::is_base_of<chan_data_store_policy, POLICY>::value>::type>
+        chan_data_store(POLICY &&store) noexcept(false)
+        : _internal(std::make_shared<policy_internal<POLICY>>(std::move(store)))
+        {
+        }
+
     public:
         /*!
          * \brief Copy constructor.
@@ -135,7 +1102,7 @@ namespace csp
          *
          * \param[in] value The value to add to the channel data store.
          */
-        void put(T value) const noexcept { _internal->put(value); }
+        void put(T value) const noexcept { _internal->put(std::move(value)); }
 
         /*!
          * \brief Gets a value from the channel data store.
@@ -169,75 +1136,8 @@ namespace csp
     template<typename T>
     class buffer : public chan_data_store<T>
     {
-    protected:
-        /*! \class buffer_internal
-         * \brief Internal implementation of a standard buffer.
-         *
-         * \author Kevin Chalmers
-         *
-         * \date 26/04/2016
-         */
-        class buffer_internal : public chan_data_store<T>::chan_data_store_internal
-        {
-        private:
-
-            unsigned int _size = 0; //<! The size of the buffer.
-
-            std::deque<T> _buffer; //<! The actual buffer used to store data.
-
-        public:
-            /*!
-             * \brief Creates a new internal buffer.
-             *
-             * \param[in] size The size of the buffer to create.
-             */
-            buffer_internal(unsigned int size) noexcept
-            : _size(size)
-            {
-            }
-
-            /*!
-             * \brief Adds a value to the buffer.
-             *
-             * \param[in] value The value to add to the buffer.
-             */
-            void put(T value) noexcept override final
-            {
-                _buffer.push_back(value);
-            }
-
-            /*!
-             * \brief Gets a value from the buffer.
-             *
-             * \return The value removed from the buffer.
-             */
-            T get() noexcept override final
-            {
-                T to_return = _buffer.front();
-                _buffer.pop_front();
-                return to_return;
-            }
-
-            /*!
-             * \brief Clears all values from the buffer.
-             */
-            void clear() noexcept override final
-            {
-                _buffer.clear();
-            }
-
-            /*!
-             * \brief Gets the current state of the buffer.
-             *
-             * \return The current state of the module.
-             */
-            DATA_STORE_STATE get_state() const noexcept override final
-            {
-                if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
-                else if (_buffer.size() == _size) return DATA_STORE_STATE::FULL;
-                else return DATA_STORE_STATE::NONEMPTYFULL;
-            }
-        };
+    private:
+        unsigned int _size; //!< The size of the buffer.
 
     public:
         /*!
@@ -246,9 +1146,16 @@ namespace csp
          * \param[in] size The size of the buffer to create.
          */
         buffer(unsigned int size) noexcept
-        : chan_data_store<T>(std::shared_ptr<buffer_internal>(new buffer_internal(size)))
+        : chan_data_store<T>(buffer_store<T>(size)), _size(size)
         {
         }
+
+        /*!
+         * \brief Gets the number of values the buffer holds when full.
+         *
+         * \return The size of the buffer.
+         */
+        unsigned int size() const noexcept { return _size; }
     };
 
     /*! \class infinite_buffer
@@ -263,74 +1170,12 @@ namespace csp
     template<typename T>
     class infinite_buffer : public chan_data_store<T>
     {
-    protected:
-        /*! \class infinite_buffer_internal
-         * \brief Internal representation of an infinite buffer.
-         *
-         * \author Kevin Chalmers
-         *
-         * \date 26/04/2016
-         */
-        class infinite_buffer_internal : public chan_data_store<T>::chan_data_store_internal
-        {
-        private:
-
-            std::deque<T> _buffer; //!< The actual buffer used to store data.
-
-        public:
-            /*!
-             * \brief Creates a new buffer.  Used internally by the framework.
-             */
-            infinite_buffer_internal() noexcept { }
-
-            /*!
-             * \brief Adds a value to the buffer.
-             *
-             * \param[in] value The value to add to the buffer.
-             */
-            void put(T value) noexcept override final
-            {
-                _buffer.push_back(value);
-            }
-
-            /*!
-             * \brief Gets a value from the buffer.
-             *
-             * \return Value removed from the buffer.
-             */
-            T get() noexcept override final
-            {
-                T to_return = _buffer.front();
-                _buffer.pop_front();
-                return to_return;
-            }
-
-            /*!
-             * \brief Clears all values from the buffer.
-             */
-            void clear() noexcept override final
-            {
-                _buffer.clear();
-            }
-
-            /*!
-             * \brief Gets the current state of the buffer.
-             *
-             * \return The current state of the buffer.
-             */
-            DATA_STORE_STATE get_state() const noexcept override final
-            {
-                if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
-                else return DATA_STORE_STATE::NONEMPTYFULL;
-            }
-        };
-
     public:
         /*!
          * \brief Creates a new infinite buffer.
          */
         infinite_buffer() noexcept
-        : chan_data_store<T>(std::shared_ptr<infinite_buffer_internal>(new infinite_buffer_internal()))
+        : chan_data_store<T>(infinite_buffer_store<T>())
         {
         }
     };
@@ -347,83 +1192,14 @@ namespace csp
     template<typename T>
     class overflowing_buffer : public chan_data_store<T>
     {
-    protected:
-        /*! \class overflowing_buffer_internal
-         * \brief Creates a new overflowing buffer.
-         *
-         * \author Kevin Chalmers
-         *
-         * \date 26/04/2016
-         */
-        class overflowing_buffer_internal : public chan_data_store<T>::chan_data_store_internal
-        {
-        private:
-
-            unsigned int _size = 0; //<! The size of the buffer.
-
-            std::deque<T> _buffer; //<! The actual buffer used to store data.
-
-        public:
-            /*!
-             * \brief Creates a new internal overflowing buffer.  Used internally by the framework.
-             *
-             * \param[in] size The size of the overflowing buffer.
-             */
-            overflowing_buffer_internal(unsigned int size) noexcept
-            : _size(size)
-            {
-            }
-
-            /*!
-             * \brief Adds a value to the buffer.
-             *
-             * \param[in] value The value to add to the buffer.
-             */
-            void put(T value) noexcept override final
-            {
-                // Only add values if buffer is not full.
-                if (_buffer.size() < _size)
-                    _buffer.push_back(value);
-            }
-
-            /*!
-             * \brief Gets a value from the buffer.
-             *
-             * \return The value removed from the channel.
-             */
-            T get() noexcept override final
-            {
-                T to_return = _buffer.front();
-                _buffer.pop_front();
-                return to_return;
-            }
-
-            /*!
-             * \brief Clears all values from the buffer.
-             */
-            void clear() noexcept override final
-            {
-                _buffer.clear();
-            }
-
-            /*!
-             * \brief Gets the current state of the buffer.
-             *
-             * \return The current state of the buffer.
-             */
-            DATA_STORE_STATE get_state() const noexcept override final
-            {
-                if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
-                else return DATA_STORE_STATE::NONEMPTYFULL;
-            }
-        };
-
     public:
         /*!
          * \brief Creates a new overflowing_buffer.
+         *
+         * \param[in] size The size of the buffer.
          */
-        overflowing_buffer()
-        : chan_data_store<T>(std::shared_ptr<overflowing_buffer_internal>(new overflowing_buffer_internal()))
+        overflowing_buffer(unsigned int size) noexcept
+        : chan_data_store<T>(overflowing_buffer_store<T>(size))
         {
         }
     };
@@ -440,78 +1216,6 @@ namespace csp
     template<typename T>
     class overwrite_oldest_buffer : public chan_data_store<T>
     {
-    protected:
-        /*! \class overwrite_oldest_buffer_internal
-         * \brief Internal implementation of a overwrite oldest buffer.
-         *
-         * \author Kevin Chalmers
-         *
-         * \date 26/04/2016
-         */
-        class overwrite_oldest_buffer_internal : public chan_data_store<T>::chan_data_store_internal
-        {
-        private:
-
-            unsigned int _size = 0; //<! The size of the buffer.
-
-            std::deque<T> _buffer; //<! The actual buffer used to store data.
-
-        public:
-            /*!
-             * \brief Creates a new internal overwrite oldest buffer.
-             *
-             * \param[in] size The size of the buffer.
-             */
-            overwrite_oldest_buffer_internal(unsigned int size) noexcept
-            : _size(size)
-            {
-            }
-
-            /*!
-             * \brief Adds a value to the buffer.
-             *
-             * \param[in] value The value to put into the buffer.
-             */
-            void put(T value) noexcept override final
-            {
-                // If buffer is full, remove oldest (front) value
-                if (_buffer.size() == _size)
-                    _buffer.pop_front();
-                _buffer.push_back(value);
-            }
-
-            /*!
-             * \brief Gets a value from the buffer.
-             *
-             * \return The value removed from the buffer.
-             */
-            T get() noexcept override final
-            {
-                T to_return = _buffer.front();
-                _buffer.pop_front();
-                return to_return;
-            }
-
-            /*!
-             * \brief Clears all values from the buffer.
-             */
-            void clear() noexcept override final
-            {
-                _buffer.clear();
-            }
-
-            /*!
-             * \brief Gets the current state of the buffer.
-             *
-             * \return The current state of the buffer.
-             */
-            DATA_STORE_STATE get_state() const noexcept override final
-            {
-                if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
-                else return DATA_STORE_STATE::NONEMPTYFULL;
-            }
-        };
-
     public:
         /*!
          * \brief Creates a new overwrite oldest buffer.
@@ -519,7 +1223,7 @@ namespace csp
          * \param[in] size The size of the buffer.
          */
         overwrite_oldest_buffer(unsigned int size) noexcept
-        : chan_data_store<T>(std::shared_ptr<overwrite_oldest_buffer_internal>(size))
+        : chan_data_store<T>(overwrite_oldest_buffer_store<T>(size))
         {
         }
     };
@@ -527,7 +1231,7 @@ namespace csp
     /*! \class overwriting_buffer
      * \brief A buffer that overwrites the last entry if it is full.
      *
-     * \tparam T The type that the buffer oe
+     * \tparam T The type that the buffer operates on.
      *
      * \author Kevin Chalmers
      *
@@ -536,78 +1240,6 @@ namespace csp
     template<typename T>
     class overwriting_buffer : public chan_data_store<T>
     {
-    protected:
-        /*! \class overwriting_buffer_internal
-         * \brief The internal representation of an overwriting buffer.
-         *
-         * \author Kevin Chalmers
-         *
-         * \date 28/04/2016
-         */
-        class overwriting_buffer_internal : public chan_data_store<T>::chan_data_store_internal
-        {
-        private:
-
-            unsigned int _size = 0; //<! The size of the buffer.
-
-            std::deque<T> _buffer; //<! The actual buffer used to store data.
-
-        public:
-            /*!
-             * \brief Creates a new internal overwriting buffer.
-             *
-             * \param[in] size The size of the buffer.
-             */
-            overwriting_buffer_internal(unsigned int size) noexcept
-            : _size(size)
-            {
-            }
-
-            /*!
-             * \brief Adds a value to the buffer.
-             *
-             * \param[in] value The value to put in the buffer.
-             */
-            void put(T value) noexcept override final
-            {
-                // If buffer is full, remove last item
-                if (_buffer.size() == _size)
-                    _buffer.pop_back();
-                _buffer.push_back(value);
-            }
-
-            /*!
-             * \brief Gets a value from the buffer.
-             *
-             * \return The value removed from the buffer.
-             */
-            T get() noexcept override final
-            {
-                T to_return = _buffer.front();
-                _buffer.pop_back();
-                return to_return;
-            }
-
-            /*!
-             * \brief Clears all values from the buffer.
-             */
-            void clear() noexcept override final
-            {
-                _buffer.clear();
-            }
-
-            /*!
-             * \brief Gets the current state of the buffer.
-             *
-             * \return The current state of the buffer.
-             */
-            DATA_STORE_STATE get_state() const noexcept final override
-            {
-                if (_buffer.size() == 0) return DATA_STORE_STATE::EMPTY;
-                else return DATA_STORE_STATE::NONEMPTYFULL;
-            }
-        };
-
     public:
         /*!
          * \brief Creates a new overwriting buffer.
@@ -615,7 +1247,7 @@ namespace csp
          * \param[in] size The size of the buffer.
          */
         overwriting_buffer(unsigned int size) noexcept
-        : chan_data_store<T>(std::shared_ptr<overwriting_buffer_internal>(size))
+        : chan_data_store<T>(overwriting_buffer_store<T>(size))
         {
         }
     };
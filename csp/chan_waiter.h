@@ -0,0 +1,190 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_CHAN_WAITER_H
+#define CPP_CSP_CHAN_WAITER_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "fiber_scheduler.h"
+#include "wait_strategy.h"
+
+namespace csp
+{
+    /*! \class chan_waiter
+     * \brief Waits for a condition on a lock-free channel.  Spins, then yields, then parks on a
+     * condition variable, as set by its wait policy.  Processes are only woken if one has parked,
+     * so a channel whose partner is always present never touches the mutex.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class chan_waiter
+    {
+    private:
+        static constexpr unsigned int SPIN_COUNT = 32; //!< Number of busy spins before backing off by yielding.  Skipped on a single core.
+
+        static constexpr unsigned int YIELD_COUNT = 8; //!< Number of yields before parking.
+
+        static constexpr unsigned int FIBER_YIELD_COUNT = 2; //!< Number of yields before parking a fiber.  Parking a fiber is cheap.
+
+        std::atomic<unsigned int> _parked; //!< Number of processes parked on the condition variable.
+
+        std::mutex _mut; //!< Lock used only when parking a process.
+
+        condition _cond; //!< Condition variable used to park a process whose partner has not arrived.
+
+        wait_policy _policy; //!< How long to spin and yield before parking.  Adaptive unless set.
+
+    public:
+        /*!
+         * \brief Creates a new waiter.
+         */
+        chan_waiter() noexcept
+        : _parked(0)
+        {
+        }
+
+        chan_waiter(const chan_waiter&) = delete;
+
+        chan_waiter& operator=(const chan_waiter&) = delete;
+
+        /*!
+         * \brief Hints to the processor that we are in a spin loop.
+         */
+        static void relax() noexcept { wait_policy::relax(); }
+
+        /*!
+         * \brief Backs off while another process finishes a short state change.  Spins for a while,
+         * then yields, as on a single core the other process cannot finish until we give way.
+         *
+         * \param[in,out] count The number of times backed off so far.  Start at zero.
+         */
+        static void backoff(unsigned int &count) noexcept
+        {
+            static const unsigned int spins = std::thread::hardware_concurrency() > 1 ? SPIN_COUNT : 0;
+            if (count++ < spins)
+                relax();
+            else
+                fiber_scheduler::yield();
+        }
+
+        /*!
+         * \brief Waits until the given condition holds.  Spins and yields as the wait policy says,
+         * then parks.
+         *
+         * \tparam Pred The type of the condition.
+         *
+         * \param[in] pred The condition to wait on.  Called until it returns true, and not again after.
+         */
+        template<typename Pred>
+        void await(Pred pred) noexcept
+        {
+            // Wait for the partner without parking, if the policy allows
+            if (_policy.spin(pred, wait_strategy::ADAPTIVE))
+                return;
+            // Partner is not there.  Park until signalled.
+            std::unique_lock<std::mutex> lock(_mut);
+            _parked.fetch_add(1);
+            while (!pred())
+                _cond.wait(lock);
+            _parked.fetch_sub(1);
+        }
+
+        /*!
+         * \brief Waits until the given condition holds or the given time is reached.
+         *
+         * \tparam Pred The type of the condition.
+         *
+         * \param[in] pred The condition to wait on.
+         * \param[in] time The time to give up waiting.
+         *
+         * \return True if the condition holds, false if the time was reached first.
+         */
+        template<typename Pred>
+        bool await_until(Pred pred, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            // Yield rather than spin.  A timed wait is not expected to be met straight away.
+            auto yields = fiber_scheduler::in_fiber() ? FIBER_YIELD_COUNT : YIELD_COUNT;
+            for (unsigned int i = 0; i < yields; ++i)
+            {
+                if (pred())
+                    return true;
+                if (std::chrono::steady_clock::now() >= time)
+                    return false;
+                fiber_scheduler::yield();
+            }
+            // Park until signalled or the time is reached
+            std::unique_lock<std::mutex> lock(_mut);
+            _parked.fetch_add(1);
+            auto result = _cond.wait_until(lock, time, pred);
+            _parked.fetch_sub(1);
+            return result;
+        }
+
+        /*!
+         * \brief Step form of await.  Parks the operation straight away, as parking a coroutine
+         * costs no more than yielding it.
+         *
+         * \tparam Pred The type of the condition.
+         *
+         * \param[in] pred The condition to wait on.  Called until it returns true, and not again after.
+         * \param[in] op The state of the operation.  Its waiting flag records that it is parked.
+         *
+         * \return True if the condition holds, false if the operation is parked.
+         */
+        template<typename Pred>
+        bool await_async(Pred pred, async_op &op) noexcept
+        {
+            if (!op._waiting && pred())
+                return true;
+            std::unique_lock<std::mutex> lock(_mut);
+            if (!op._waiting)
+            {
+                op._waiting = true;
+                _parked.fetch_add(1);
+            }
+            if (pred())
+            {
+                op._waiting = false;
+                _parked.fetch_sub(1);
+                return true;
+            }
+            _cond.wait_async(lock, op);
+            return false;
+        }
+
+        /*!
+         * \brief Sets how the waiter waits.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_strategy(wait_strategy strategy) noexcept { _policy.set(strategy); }
+
+        /*!
+         * \brief Wakes any parked process after a state change.
+         */
+        void wake() noexcept
+        {
+            if (_parked.load() > 0)
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _cond.notify_all();
+            }
+        }
+
+        /*!
+         * \brief Wakes all parked processes unconditionally.  Used when poisoning.
+         */
+        void wake_all() noexcept
+        {
+            std::lock_guard<std::mutex> lock(_mut);
+            _cond.notify_all();
+        }
+    };
+}
+
+#endif //CPP_CSP_CHAN_WAITER_H
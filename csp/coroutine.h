@@ -0,0 +1,475 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_COROUTINE_H
+#define CPP_CSP_COROUTINE_H
+
+// Coroutine processes need a C++20 compiler.  Without one this header declares nothing.
+#if defined(__cpp_impl_coroutine)
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "fiber_scheduler.h"
+
+namespace csp
+{
+    // Forward declarations
+    class co_par;
+
+    /*! \class co_proc
+     * \brief A process written as a C++20 coroutine.
+     *
+     * A function returning co_proc is a process that suspends, rather than blocking, when it
+     * performs co_await on a channel or alt operation (co_read, co_write, co_select).  A suspended
+     * coroutine holds no stack, only its frame, so a network can contain hundreds of thousands
+     * of them.  Coroutines are run by the fiber_scheduler, which must be started first, and
+     * communicate freely with thread and fiber processes over the same channels.
+     *
+     * A co_proc does nothing until it is run by a co_par or awaited by another coroutine.  It
+     * runs once.  Calling a blocking operation from a coroutine blocks the worker running it.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class co_proc
+    {
+        friend class co_par;
+    public:
+        /*! \class promise_type
+         * \brief State of a running coroutine.  Scheduled directly when the coroutine is a root process.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class promise_type : public fiber_scheduler::task
+        {
+        public:
+            std::coroutine_handle<> _continuation = nullptr; //!< Coroutine awaiting completion, if any.
+
+            std::coroutine_handle<> (*_done)(void*) = nullptr; //!< Called on completion of a root process.  Returns the coroutine to run next.
+
+            void *_done_arg = nullptr; //!< Argument to the completion function.
+
+            std::exception_ptr _error = nullptr; //!< Exception that escaped the coroutine.
+
+            /*! \class final_awaiter
+             * \brief Hands control to whoever is waiting for the coroutine to complete.
+             */
+            class final_awaiter
+            {
+            public:
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                {
+                    auto &p = h.promise();
+                    if (p._continuation)
+                        return p._continuation;
+                    // The frame may be destroyed by the completion function, so it is not touched after
+                    if (p._done)
+                        return p._done(p._done_arg);
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+            /*!
+             * \brief Creates a new promise.
+             */
+            promise_type() noexcept
+            : fiber_scheduler::task(&promise_type::resume)
+            {
+            }
+
+            /*!
+             * \brief Runs the coroutine when it is scheduled as a task.
+             *
+             * \param[in] t The promise of the coroutine.
+             */
+            static void resume(fiber_scheduler::task *t) noexcept
+            {
+                std::coroutine_handle<promise_type>::from_promise(*static_cast<promise_type*>(t)).resume();
+            }
+
+            co_proc get_return_object() noexcept { return co_proc(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+            std::suspend_always initial_suspend() const noexcept { return { }; }
+
+            final_awaiter final_suspend() const noexcept { return { }; }
+
+            void return_void() const noexcept { }
+
+            void unhandled_exception() noexcept { _error = std::current_exception(); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> _handle = nullptr; //!< The coroutine.
+
+        /*!
+         * \brief Creates a co_proc owning the given coroutine.
+         *
+         * \param[in] handle The coroutine.
+         */
+        explicit co_proc(std::coroutine_handle<promise_type> handle) noexcept
+        : _handle(handle)
+        {
+        }
+
+    public:
+        /*!
+         * \brief Move constructor.
+         *
+         * \param[in] rhs The co_proc to take the coroutine from.
+         */
+        co_proc(co_proc &&rhs) noexcept
+        : _handle(std::exchange(rhs._handle, nullptr))
+        {
+        }
+
+        /*!
+         * \brief Move assignment operator.
+         *
+         * \param[in] rhs The co_proc to take the coroutine from.
+         *
+         * \return This co_proc.
+         */
+        co_proc& operator=(co_proc &&rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                if (_handle)
+                    _handle.destroy();
+                _handle = std::exchange(rhs._handle, nullptr);
+            }
+            return *this;
+        }
+
+        // A coroutine has a single owner
+        co_proc(const co_proc &other) = delete;
+        co_proc& operator=(const co_proc &other) = delete;
+
+        /*!
+         * \brief Destroys the coroutine.  Must not be called while the coroutine is running.
+         */
+        ~co_proc() noexcept
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+        /*!
+         * \brief Checks whether the coroutine has completed.
+         *
+         * \return True if the coroutine has run to completion, false otherwise.
+         */
+        bool done() const noexcept { return !_handle || _handle.done(); }
+
+        bool await_ready() const noexcept { return done(); }
+
+        /*!
+         * \brief Runs the coroutine in place of the awaiting one, which resumes once it completes.
+         */
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept
+        {
+            _handle.promise()._continuation = h;
+            return _handle;
+        }
+
+        /*!
+         * \brief Rethrows any exception that escaped the coroutine.
+         */
+        void await_resume() const noexcept(false)
+        {
+            if (_handle && _handle.promise()._error)
+                std::rethrow_exception(_handle.promise()._error);
+        }
+    };
+
+    /*! \class co_process
+     * \brief Interface class for declaring a class as a coroutine process.
+     *
+     * The object must outlive the coroutine returned by run.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class co_process
+    {
+    public:
+        /*!
+         * \brief Destroys the process object.
+         */
+        virtual ~co_process() { }
+
+        /*!
+         * \brief Called to create the coroutine that runs the process.
+         *
+         * \return The coroutine.
+         */
+        virtual co_proc run() = 0;
+
+        /*!
+         * \brief Operator overload.  Calls the run method.
+         *
+         * \return The coroutine.
+         */
+        co_proc operator()() { return this->run(); }
+    };
+
+    /*! \class co_par
+     * \brief Runs a collection of coroutine processes in parallel on the fiber_scheduler.
+     *
+     * Either awaited by a coroutine, which resumes once every process has completed, or called
+     * from a thread or fiber, which waits for every process to complete.  Each process is a task
+     * on the scheduler with no stack of its own.  A co_par runs once.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class co_par
+    {
+    private:
+        std::vector<co_proc> _procs; //!< The processes to run.
+
+        std::atomic<size_t> _remaining; //!< Number of processes that have not completed.
+
+        std::coroutine_handle<> _continuation = nullptr; //!< Coroutine awaiting completion, if any.
+
+        std::mutex _mut; //!< Protects the finished flag.
+
+        condition _cond; //!< Used by a thread or fiber to wait for completion.
+
+        bool _finished = false; //!< Flag to indicate that every process has completed.
+
+        /*!
+         * \brief Called as each process completes.
+         *
+         * \param[in] arg The co_par.
+         *
+         * \return The awaiting coroutine if this was the last process to complete, otherwise a no-op.
+         */
+        static std::coroutine_handle<> done(void *arg) noexcept
+        {
+            auto p = static_cast<co_par*>(arg);
+            if (p->_remaining.fetch_sub(1) != 1)
+                return std::noop_coroutine();
+            if (p->_continuation)
+                return p->_continuation;
+            std::lock_guard<std::mutex> lock(p->_mut);
+            p->_finished = true;
+            p->_cond.notify_all();
+            return std::noop_coroutine();
+        }
+
+        /*!
+         * \brief Prepares the processes to be run.
+         */
+        void prepare() noexcept(false)
+        {
+            if (!fiber_scheduler::active())
+                throw std::logic_error("fiber_scheduler not started");
+            _remaining.store(_procs.size());
+            for (auto &p : _procs)
+            {
+                if (p.done())
+                    throw std::logic_error("co_par process has already run");
+                p._handle.promise()._done = &co_par::done;
+                p._handle.promise()._done_arg = this;
+            }
+        }
+
+        /*!
+         * \brief Rethrows the first exception that escaped a process.
+         */
+        void rethrow() const noexcept(false)
+        {
+            for (auto &p : _procs)
+                p.await_resume();
+        }
+
+    public:
+        /*!
+         * \brief Creates a co_par from a list of processes.
+         *
+         * \tparam Procs The types of the remaining processes.  Each must be a co_proc.
+         *
+         * \param[in] first The first process.
+         * \param[in] rest The remaining processes.
+         */
+        template<typename... Procs>
+        co_par(co_proc &&first, Procs&&... rest) noexcept(false)
+        : _remaining(0)
+        {
+            _procs.reserve(1 + sizeof...(rest));
+            _procs.push_back(std::move(first));
+            (_procs.push_back(std::forward<Procs>(rest)), ...);
+        }
+
+        /*!
+         * \brief Creates a co_par from a vector of processes.
+         *
+         * \param[in] procs The processes to run.
+         */
+        co_par(std::vector<co_proc> &&procs) noexcept
+        : _procs(std::move(procs)), _remaining(0)
+        {
+        }
+
+        // A co_par is never copied or moved
+        co_par(const co_par &other) = delete;
+        co_par& operator=(const co_par &other) = delete;
+
+        /*!
+         * \brief Runs the processes and waits for them to complete.  Called from a thread or fiber.
+         */
+        void operator()() noexcept(false)
+        {
+            if (_procs.empty())
+                return;
+            prepare();
+            for (auto &p : _procs)
+                fiber_scheduler::schedule(&p._handle.promise());
+            std::unique_lock<std::mutex> lock(_mut);
+            _cond.wait(lock, [this]() { return _finished; });
+            lock.unlock();
+            rethrow();
+        }
+
+        bool await_ready() const noexcept { return _procs.empty(); }
+
+        /*!
+         * \brief Runs the processes.  The first runs in place of the awaiting coroutine.
+         */
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept(false)
+        {
+            prepare();
+            _continuation = h;
+            for (size_t i = 1; i < _procs.size(); ++i)
+                fiber_scheduler::schedule(&_procs[i]._handle.promise());
+            return _procs[0]._handle;
+        }
+
+        void await_resume() const noexcept(false) { rethrow(); }
+    };
+
+    /*!
+     * \brief Creates a process function that runs a coroutine process, so that it can be run within
+     * a par alongside thread processes.  The calling thread or fiber waits while the coroutine runs.
+     *
+     * \tparam Fun The type of the coroutine function.
+     * \tparam Args The type of the argument pack.
+     *
+     * \param[in] f The coroutine function to use.
+     * \param[in] params The parameters for the function.
+     *
+     * \return A function object that runs a new coroutine each time it is called.
+     */
+    template<typename Fun, typename... Args>
+    std::function<void()> make_co_proc(Fun f, Args... params)
+    {
+        return [f, params...]() { co_par(f(params...))(); };
+    }
+
+    /*! \class co_op
+     * \brief Base class of the awaitable forms of blocking operations.
+     *
+     * Derived classes perform the operation as a series of steps.  The first step is tried when
+     * the coroutine suspends, and if it completes the coroutine carries straight on.  Otherwise the
+     * coroutine stays suspended until the step is woken and completes.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class co_op : public async_op
+    {
+    private:
+        std::coroutine_handle<> _handle = nullptr; //!< The suspended coroutine.
+
+        std::exception_ptr _error = nullptr; //!< Exception thrown by the operation.
+
+        /*!
+         * \brief Performs a step, capturing any exception.
+         *
+         * \return True if the operation has completed, false if it is waiting.
+         */
+        bool try_step() noexcept
+        {
+            try
+            {
+                return step();
+            }
+            catch (...)
+            {
+                _error = std::current_exception();
+                return true;
+            }
+        }
+
+        /*!
+         * \brief Runs the operation when it is woken, resuming the coroutine if it completes.
+         *
+         * \param[in] t The operation.
+         */
+        static void run(fiber_scheduler::task *t) noexcept
+        {
+            auto op = static_cast<co_op*>(t);
+            if (op->try_step())
+                op->_handle.resume();
+        }
+
+    protected:
+        /*!
+         * \brief Performs the next step of the operation.
+         *
+         * \return True if the operation has completed, false if it is waiting.
+         */
+        virtual bool step() noexcept(false) = 0;
+
+        /*!
+         * \brief Rethrows any exception thrown by the operation.
+         */
+        void rethrow() const noexcept(false)
+        {
+            if (_error)
+                std::rethrow_exception(_error);
+        }
+
+    public:
+        /*!
+         * \brief Creates a new operation.
+         */
+        co_op() noexcept
+        : async_op(&co_op::run)
+        {
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        /*!
+         * \brief Starts the operation.  Once waiting the operation may complete on another worker,
+         * so nothing is touched after the first step.
+         */
+        bool await_suspend(std::coroutine_handle<> h) noexcept
+        {
+            _handle = h;
+            return !try_step();
+        }
+    };
+}
+
+#endif
+
+#endif //CPP_CSP_COROUTINE_H
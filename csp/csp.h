@@ -7,16 +7,21 @@
 
 #include "poison_exception.h"
 #include "guard.h"
+#include "fiber_scheduler.h"
+#include "wait_strategy.h"
+#include "coroutine.h"
 #include "alt.h"
 #include "barrier.h"
 #include "timer.h"
 #include "alting_barrier.h"
 #include "chan.h"
+#include "static_chan.h"
 #include "chan_data_store.h"
 #include "process.h"
 #include "skip.h"
 #include "stop.h"
 #include "par.h"
+#include "worker_pool.h"
 #include "patterns.h"
 
 #endif //CPP_CSP_CSP_H
@@ -0,0 +1,1718 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_FIBER_SCHEDULER_H
+#define CPP_CSP_FIBER_SCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+#if !defined(__x86_64__) && !defined(__aarch64__)
+#include <ucontext.h>
+#endif
+#include "timer_wheel.h"
+
+namespace csp
+{
+    // Forward declarations
+    class condition;
+    class async_op;
+    class timer_service;
+
+    /*! \class fiber_scheduler
+     * \brief An optional M:N runtime that multiplexes processes onto a fixed pool of worker threads.
+     *
+     * Once started, every par runs its processes as fibers (user-level stackful contexts) on the
+     * worker pool rather than giving each process its own thread.  Blocking operations within the
+     * framework (channels, alts, barriers and timers) suspend the running fiber and let the worker
+     * run another process, rather than blocking the worker thread.  Blocking operations outside of
+     * the framework (I/O, std::mutex, etc.) still block the worker they are called on.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class fiber_scheduler
+    {
+        friend class condition;
+        friend class async_op;
+        friend class timer_service;
+    public:
+        static constexpr size_t DEFAULT_STACK_SIZE = 256 * 1024; //!< Default stack size of a fiber in bytes.
+
+        /*! \class task
+         * \brief A unit of work that the workers can run.
+         *
+         * A fiber is a task that is switched to.  Any other task is run by calling its run function
+         * on the worker's own stack, which is how coroutines are resumed.  A task is queued at most
+         * once at a time.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class task
+        {
+        public:
+            void (*_run)(task*) = nullptr; //!< Function called to run the task, or nullptr if the task is a fiber.
+
+            /*!
+             * \brief Creates a new task.
+             *
+             * \param[in] run The function called when the task is run.
+             */
+            task(void (*run)(task*) = nullptr) noexcept
+            : _run(run)
+            {
+            }
+        };
+
+    private:
+        /*! \class context
+         * \brief A saved execution context.
+         *
+         * On x86-64 and AArch64 only the callee-saved registers are stored, on the context's own
+         * stack, so a switch costs a few instructions.  Elsewhere ucontext is used, which also saves
+         * the signal mask and so costs a system call per switch.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class context
+        {
+        private:
+#if defined(__x86_64__) || defined(__aarch64__)
+            void *_sp = nullptr; //!< Saved stack pointer.  The registers are stored on the stack.
+
+            /*!
+             * \brief Saves the callee-saved registers on the current stack and resumes another.  The
+             * first argument is the location to save the current stack pointer to, and the second the
+             * stack pointer to resume.  Both are read from registers by the assembly, so are unnamed.
+             */
+            __attribute__((naked, noinline)) static void switch_stack(void **, void *) noexcept
+            {
+#if defined(__x86_64__)
+                asm volatile(
+                    "pushq %rbp\n\t"
+                    "pushq %rbx\n\t"
+                    "pushq %r12\n\t"
+                    "pushq %r13\n\t"
+                    "pushq %r14\n\t"
+                    "pushq %r15\n\t"
+                    "subq $8, %rsp\n\t"
+                    "stmxcsr (%rsp)\n\t"
+                    "fnstcw 4(%rsp)\n\t"
+                    "movq %rsp, (%rdi)\n\t"
+                    "movq %rsi, %rsp\n\t"
+                    "ldmxcsr (%rsp)\n\t"
+                    "fldcw 4(%rsp)\n\t"
+                    "addq $8, %rsp\n\t"
+                    "popq %r15\n\t"
+                    "popq %r14\n\t"
+                    "popq %r13\n\t"
+                    "popq %r12\n\t"
+                    "popq %rbx\n\t"
+                    "popq %rbp\n\t"
+                    "ret\n\t");
+#else
+                asm volatile(
+                    "sub sp, sp, #160\n\t"
+                    "stp x19, x20, [sp, #0]\n\t"
+                    "stp x21, x22, [sp, #16]\n\t"
+                    "stp x23, x24, [sp, #32]\n\t"
+                    "stp x25, x26, [sp, #48]\n\t"
+                    "stp x27, x28, [sp, #64]\n\t"
+                    "stp x29, x30, [sp, #80]\n\t"
+                    "stp d8, d9, [sp, #96]\n\t"
+                    "stp d10, d11, [sp, #112]\n\t"
+                    "stp d12, d13, [sp, #128]\n\t"
+                    "stp d14, d15, [sp, #144]\n\t"
+                    "mov x9, sp\n\t"
+                    "str x9, [x0]\n\t"
+                    "mov sp, x1\n\t"
+                    "ldp x19, x20, [sp, #0]\n\t"
+                    "ldp x21, x22, [sp, #16]\n\t"
+                    "ldp x23, x24, [sp, #32]\n\t"
+                    "ldp x25, x26, [sp, #48]\n\t"
+                    "ldp x27, x28, [sp, #64]\n\t"
+                    "ldp x29, x30, [sp, #80]\n\t"
+                    "ldp d8, d9, [sp, #96]\n\t"
+                    "ldp d10, d11, [sp, #112]\n\t"
+                    "ldp d12, d13, [sp, #128]\n\t"
+                    "ldp d14, d15, [sp, #144]\n\t"
+                    "add sp, sp, #160\n\t"
+                    "ret\n\t");
+#endif
+            }
+#else
+            ucontext_t _context; //!< Saved context.
+#endif
+
+        public:
+            /*!
+             * \brief Prepares the context to start running a function on the given stack.
+             *
+             * \param[in] stack The lowest address of the stack.
+             * \param[in] size The size of the stack.
+             * \param[in] fn The function to run.  Must never return.
+             */
+            void make(char *stack, size_t size, void (*fn)()) noexcept
+            {
+#if defined(__x86_64__) || defined(__aarch64__)
+                // Build the frame that switch_stack expects to restore, returning into fn
+                auto top = reinterpret_cast<uintptr_t>(stack + size) & ~static_cast<uintptr_t>(15);
+                auto frame = reinterpret_cast<uint64_t*>(top);
+#if defined(__x86_64__)
+                frame -= 9;
+                frame[0] = 0x037F00001F80ULL;                   // Default x87 control word and MXCSR
+                for (int i = 1; i < 7; ++i)
+                    frame[i] = 0;                               // r15, r14, r13, r12, rbx, rbp
+                frame[7] = reinterpret_cast<uint64_t>(fn);      // Return address
+                frame[8] = 0;                                   // Fake return address of fn
+#else
+                frame -= 20;
+                for (int i = 0; i < 20; ++i)
+                    frame[i] = 0;
+                frame[11] = reinterpret_cast<uint64_t>(fn);     // x30
+#endif
+                _sp = frame;
+#else
+                getcontext(&_context);
+                _context.uc_stack.ss_sp = stack;
+                _context.uc_stack.ss_size = size;
+                _context.uc_link = nullptr;
+                makecontext(&_context, fn, 0);
+#endif
+            }
+
+            /*!
+             * \brief Saves the current context and resumes another.
+             *
+             * \param[out] from The context to save to.
+             * \param[in] to The context to resume.
+             */
+            static void swap(context &from, context &to) noexcept
+            {
+#if defined(__x86_64__) || defined(__aarch64__)
+                switch_stack(&from._sp, to._sp);
+#else
+                swapcontext(&from._context, &to._context);
+#endif
+            }
+        };
+
+        /*! \class fiber
+         * \brief A user-level context with its own stack.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class fiber : public task
+        {
+        public:
+            context _context; //!< Saved context of the fiber.
+
+            char *_stack = nullptr; //!< Base of the memory mapped for the stack, including the guard page.
+
+            size_t _stack_size = 0; //!< Size of the mapped stack memory.
+
+            std::function<void()> _process; //!< The process that the fiber is running.
+
+            /*!
+             * \brief Creates a new fiber with a stack of the given size.
+             *
+             * \param[in] stack_size The usable size of the stack.
+             */
+            fiber(size_t stack_size) noexcept(false)
+            {
+                // Add a guard page to the bottom of the stack so that overflow faults rather than corrupts.
+                auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                _stack_size = ((stack_size + page - 1) / page) * page + page;
+                void *mem = mmap(nullptr, _stack_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (mem == MAP_FAILED)
+                    throw std::runtime_error("Could not allocate fiber stack");
+                _stack = static_cast<char*>(mem);
+                mprotect(_stack, page, PROT_NONE);
+            }
+
+            /*!
+             * \brief Destroys the fiber and releases its stack.
+             */
+            ~fiber() noexcept
+            {
+                munmap(_stack, _stack_size);
+            }
+
+            // Fibers are never copied or moved
+            fiber(const fiber &other) = delete;
+            fiber& operator=(const fiber &other) = delete;
+        };
+
+        /*! \class worker
+         * \brief State held by each worker thread, including its run queue.
+         *
+         * Each worker owns a queue of ready fibers that other workers may steal from, and a next
+         * slot holding the process it most recently woke.  Running a woken reader on the core of
+         * the writer that woke it keeps the communicated data in that core's cache.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class worker
+        {
+        public:
+            context _context; //!< Context of the worker's scheduling loop.
+
+            fiber *_current = nullptr; //!< The fiber currently running on this worker.
+
+            void (*_hook)(void*) = nullptr; //!< Action to perform once the current fiber has been switched out.
+
+            void *_hook_arg = nullptr; //!< Argument to the hook.
+
+            std::mutex _mut; //!< Protects the run queue and next slot.
+
+            std::deque<task*> _queue; //!< Tasks ready to run on this worker.
+
+            task *_next = nullptr; //!< The task to run once the current one suspends.
+
+            std::atomic<size_t> _size; //!< Number of tasks in the queue.  Read by thieves without locking.
+
+            std::atomic<unsigned int> _switches; //!< Number of tasks run.  Lets thieves tell if the worker is stuck.
+
+            unsigned int _tick = 0; //!< Number of scheduling decisions made.  Used to check the global queue.
+
+            unsigned int _next_runs = 0; //!< Consecutive tasks run from the next slot.
+
+            std::uint32_t _seed; //!< State for choosing which worker to steal from.
+
+            /*!
+             * \brief Creates a new worker.
+             *
+             * \param[in] index The index of the worker.
+             */
+            worker(unsigned int index) noexcept
+            : _size(0), _switches(0), _seed(index * 2654435761u + 1)
+            {
+            }
+        };
+
+        /*! \class wait_node
+         * \brief Represents a process waiting on a condition or a timeout.
+         *
+         * A node can be woken by either a notify or a timeout.  Whichever claims the node first wins.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class wait_node : public timer_wheel::hook
+        {
+        public:
+            task *_task = nullptr; //!< The waiting fiber or coroutine, or nullptr if a thread is waiting.
+
+            std::mutex _thread_mut; //!< Lock held while waking a waiting thread.
+
+            std::condition_variable _thread_cond; //!< Used to wake a waiting thread.
+
+            bool _woken = false; //!< Flag set under _thread_mut once a waiting thread has been woken.
+
+            std::atomic<bool> _claimed; //!< Set by whichever of notify or timeout wakes the node.
+
+            bool _timed_out = false; //!< Flag set if the node was woken by its timeout.
+
+            bool _queued = false; //!< Flag to indicate whether the node is on a condition's wait queue.
+
+            wait_node *_prev = nullptr; //!< Previous node on the condition's wait queue.
+
+            wait_node *_next = nullptr; //!< Next node on the condition's wait queue.
+
+            /*!
+             * \brief Creates a new wait node.
+             *
+             * \param[in] t The task waiting, or nullptr if a thread is waiting.
+             */
+            wait_node(task *t) noexcept
+            : _task(t), _claimed(false)
+            {
+            }
+
+            /*!
+             * \brief Attempts to claim the node for waking.
+             *
+             * \return True if the caller should wake the node, false if it has already been woken.
+             */
+            bool claim() noexcept { return !_claimed.exchange(true); }
+
+            /*!
+             * \brief Wakes the waiting thread.  Called once the node has been claimed.
+             */
+            void wake_thread() noexcept
+            {
+                std::lock_guard<std::mutex> lock(_thread_mut);
+                _woken = true;
+                _thread_cond.notify_one();
+            }
+
+            /*!
+             * \brief Waits until the thread has been woken.
+             */
+            void wait_thread() noexcept
+            {
+                std::unique_lock<std::mutex> lock(_thread_mut);
+                while (!_woken)
+                    _thread_cond.wait(lock);
+            }
+        };
+
+        /*! \class fiber_scheduler_internal
+         * \brief Internal representation of the scheduler.  Owns the workers, queues and timers.
+         *
+         * Idle workers steal from busy ones.  A worker looking for work is spinning.  Ready
+         * work only wakes a parked worker when nobody is spinning, so bursts ramp up quickly
+         * while steady traffic makes few system calls.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class fiber_scheduler_internal
+        {
+        public:
+            static constexpr unsigned int GLOBAL_CHECK = 61; //!< How often a worker takes from the global queue before its own.
+
+            static constexpr unsigned int MAX_NEXT_RUNS = 32; //!< Consecutive next slot runs before the queue gets a turn.
+
+            static constexpr unsigned int STEAL_ROUNDS = 4; //!< Passes over the other workers before parking.
+
+            static constexpr std::chrono::steady_clock::rep NO_DEADLINE = std::numeric_limits<std::chrono::steady_clock::rep>::max(); //!< Deadline used when no timers are set.
+
+            size_t _stack_size; //!< Stack size given to new fibers.
+
+            std::vector<std::unique_ptr<worker>> _workers; //!< State of each worker.
+
+            std::vector<std::thread> _threads; //!< The worker threads.
+
+            std::mutex _mut; //!< Protects the global queue, timers and parking.
+
+            std::condition_variable _cond; //!< Used to park idle workers.
+
+            std::deque<task*> _global; //!< Tasks made ready by threads outside the scheduler.
+
+            std::atomic<size_t> _global_size; //!< Number of fibers in the global queue.
+
+            timer_wheel _timers; //!< Fibers waiting on a timeout.
+
+            std::atomic<std::chrono::steady_clock::rep> _deadline; //!< Time of the earliest timer.  Checked without locking.
+
+            unsigned int _signals = 0; //!< Number of pending wake ups for parked workers.
+
+            std::atomic<unsigned int> _idle; //!< Number of parked workers.
+
+            std::atomic<unsigned int> _spinning; //!< Number of workers looking for work to steal.
+
+            std::atomic<bool> _running; //!< Flag to indicate whether the workers should keep running.
+
+            std::mutex _pool_mut; //!< Protects the fiber pool.
+
+            std::vector<fiber*> _free; //!< Finished fibers available for reuse.
+
+            std::vector<std::unique_ptr<fiber>> _all; //!< All fibers created by the scheduler.
+
+            /*!
+             * \brief Creates the scheduler and starts the workers.
+             *
+             * \param[in] workers The number of worker threads.
+             * \param[in] stack_size The stack size of each fiber.
+             */
+            fiber_scheduler_internal(unsigned int workers, size_t stack_size) noexcept
+            : _stack_size(stack_size), _global_size(0),
+              _timers(timer_wheel::default_slack()), _deadline(NO_DEADLINE),
+              _idle(0), _spinning(0), _running(true)
+            {
+                // All workers must exist before any thread starts stealing
+                for (unsigned int i = 0; i < workers; ++i)
+                    _workers.push_back(std::unique_ptr<worker>(new worker(i)));
+                for (unsigned int i = 0; i < workers; ++i)
+                    _threads.push_back(std::thread(&fiber_scheduler_internal::run, this, _workers[i].get()));
+            }
+
+            /*!
+             * \brief Stops the workers.  Any fibers still suspended are discarded.
+             */
+            ~fiber_scheduler_internal() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _running.store(false);
+                    _cond.notify_all();
+                }
+                for (auto &t : _threads)
+                    t.join();
+            }
+
+            /*!
+             * \brief Makes a task ready to run.
+             *
+             * Called from a worker the task is queued on that worker.  If it has been woken by the
+             * running process it goes in the next slot, so a reader runs on its writer's core.  Called
+             * from any other thread the task goes on the global queue.
+             *
+             * \param[in] f The task to schedule.
+             * \param[in] next Flag indicating whether to run the task before the rest of the queue.
+             */
+            void schedule(task *f, bool next = true) noexcept
+            {
+                auto w = current_worker();
+                if (w)
+                {
+                    std::lock_guard<std::mutex> lock(w->_mut);
+                    if (next)
+                    {
+                        // Displace any task already in the next slot to the back of the queue
+                        if (w->_next)
+                        {
+                            w->_queue.push_back(w->_next);
+                            w->_size.fetch_add(1);
+                        }
+                        w->_next = f;
+                    }
+                    else
+                    {
+                        w->_queue.push_back(f);
+                        w->_size.fetch_add(1);
+                    }
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _global.push_back(f);
+                    _global_size.fetch_add(1);
+                }
+                wake();
+            }
+
+            /*!
+             * \brief Wakes a parked worker to look for work, unless a worker is already looking.
+             */
+            void wake() noexcept
+            {
+                if (_idle.load() == 0 || _spinning.load() != 0)
+                    return;
+                // The woken worker starts out spinning.  Claim that now so only one is woken.
+                unsigned int expected = 0;
+                if (!_spinning.compare_exchange_strong(expected, 1))
+                    return;
+                std::lock_guard<std::mutex> lock(_mut);
+                if (_idle.load() == 0)
+                {
+                    _spinning.fetch_sub(1);
+                    return;
+                }
+                ++_signals;
+                _cond.notify_one();
+            }
+
+            /*!
+             * \brief Takes the next task from a worker's own queue.
+             *
+             * \param[in] w The worker.
+             *
+             * \return The task to run, or nullptr if the worker has no work.
+             */
+            task* pop_local(worker *w) noexcept
+            {
+                std::lock_guard<std::mutex> lock(w->_mut);
+                // Favour the next slot, but not so often that the queue starves
+                if (w->_next && (w->_next_runs < MAX_NEXT_RUNS || w->_queue.empty()))
+                {
+                    auto f = w->_next;
+                    w->_next = nullptr;
+                    ++w->_next_runs;
+                    return f;
+                }
+                w->_next_runs = 0;
+                if (w->_queue.empty())
+                    return nullptr;
+                auto f = w->_queue.front();
+                w->_queue.pop_front();
+                w->_size.fetch_sub(1);
+                return f;
+            }
+
+            /*!
+             * \brief Takes the next task from the global queue.
+             *
+             * \return The task to run, or nullptr if the global queue is empty.
+             */
+            task* pop_global() noexcept
+            {
+                if (_global_size.load() == 0)
+                    return nullptr;
+                std::lock_guard<std::mutex> lock(_mut);
+                if (_global.empty())
+                    return nullptr;
+                auto f = _global.front();
+                _global.pop_front();
+                _global_size.fetch_sub(1);
+                return f;
+            }
+
+            /*!
+             * \brief Steals half of another worker's queue.
+             *
+             * \param[in] thief The worker stealing.
+             * \param[in] victim The worker to steal from.
+             * \param[in] take_next Flag indicating whether the victim's next slot may be taken.
+             *
+             * \return The task to run, or nullptr if there was nothing to steal.
+             */
+            task* steal(worker *thief, worker *victim, bool take_next) noexcept
+            {
+                std::vector<task*> stolen;
+                {
+                    std::lock_guard<std::mutex> lock(victim->_mut);
+                    auto n = victim->_queue.size();
+                    if (n == 0)
+                    {
+                        if (!take_next || !victim->_next)
+                            return nullptr;
+                        auto f = victim->_next;
+                        victim->_next = nullptr;
+                        return f;
+                    }
+                    // Take the newest half.  The victim keeps the ones it will run soonest.
+                    auto count = (n + 1) / 2;
+                    stolen.assign(victim->_queue.end() - count, victim->_queue.end());
+                    victim->_queue.erase(victim->_queue.end() - count, victim->_queue.end());
+                    victim->_size.fetch_sub(count);
+                }
+                // Run the first and queue the rest locally
+                auto f = stolen.front();
+                if (stolen.size() > 1)
+                {
+                    std::lock_guard<std::mutex> lock(thief->_mut);
+                    thief->_queue.insert(thief->_queue.end(), stolen.begin() + 1, stolen.end());
+                    thief->_size.fetch_add(stolen.size() - 1);
+                }
+                return f;
+            }
+
+            /*!
+             * \brief Tries to steal work from the other workers.
+             *
+             * \param[in] w The worker stealing.
+             *
+             * \return The task to run, or nullptr if nothing was found.
+             */
+            task* steal_work(worker *w) noexcept
+            {
+                auto n = _workers.size();
+                if (n < 2)
+                    return nullptr;
+                // Switch counts of each worker when first seen with a next slot
+                std::vector<unsigned int> seen(n, 0);
+                std::vector<bool> stuck(n, false);
+                for (unsigned int round = 0; round < STEAL_ROUNDS; ++round)
+                {
+                    // Start from a random worker so thieves spread out
+                    w->_seed = w->_seed * 1664525u + 1013904223u;
+                    auto start = static_cast<size_t>(w->_seed >> 8) % n;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        auto idx = (start + i) % n;
+                        auto victim = _workers[idx].get();
+                        if (victim == w)
+                            continue;
+                        // Only take a next slot if the victim has not switched since we last looked
+                        auto switches = victim->_switches.load();
+                        bool take_next = round > 0 && stuck[idx] && seen[idx] == switches;
+                        seen[idx] = switches;
+                        stuck[idx] = true;
+                        auto f = steal(w, victim, take_next);
+                        if (f)
+                            return f;
+                        if (_global_size.load() > 0 && (f = pop_global()))
+                            return f;
+                    }
+                    std::this_thread::yield();
+                }
+                return nullptr;
+            }
+
+            /*!
+             * \brief Checks whether any queue other than a next slot holds work.
+             *
+             * \return True if there is work to do, false otherwise.
+             */
+            bool has_work() noexcept
+            {
+                if (_global_size.load() > 0)
+                    return true;
+                for (auto &w : _workers)
+                    if (w->_size.load() > 0)
+                        return true;
+                return false;
+            }
+
+            /*!
+             * \brief Parks the worker until there is work to do or a timer is due.
+             *
+             * \return True if woken to look for work, in which case the worker is spinning.
+             */
+            bool park() noexcept
+            {
+                _idle.fetch_add(1);
+                // Look again now we are idle.  Anything queued after this will wake us.
+                if (has_work())
+                {
+                    _idle.fetch_sub(1);
+                    return false;
+                }
+                std::unique_lock<std::mutex> lock(_mut);
+                while (_signals == 0 && _running.load())
+                {
+                    auto deadline = _deadline.load();
+                    if (deadline == NO_DEADLINE)
+                        _cond.wait(lock);
+                    else
+                    {
+                        auto time = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(deadline));
+                        if (std::chrono::steady_clock::now() >= time)
+                            break;
+                        _cond.wait_until(lock, time);
+                    }
+                }
+                bool signalled = _signals > 0;
+                if (signalled)
+                    --_signals;
+                _idle.fetch_sub(1);
+                return signalled;
+            }
+
+            /*!
+             * \brief Updates the earliest timer.  Called with _mut held.
+             */
+            void update_deadline() noexcept
+            {
+                auto next = _timers.next_time();
+                _deadline.store(next == std::chrono::steady_clock::time_point::max() ? NO_DEADLINE
+                                                                                  : next.time_since_epoch().count());
+            }
+
+            /*!
+             * \brief Registers a node to be woken at the given time.  Called with _mut held.
+             *
+             * \param[in] n The node to wake.
+             * \param[in] time The time to wake the node at.
+             */
+            void arm(wait_node *n, const std::chrono::steady_clock::time_point &time) noexcept
+            {
+                // If this is now the earliest timer a parked worker needs to recalculate its wait
+                if (_timers.insert(n, time))
+                {
+                    update_deadline();
+                    if (_idle.load() > 0)
+                        _cond.notify_one();
+                }
+            }
+
+            /*!
+             * \brief Removes a node from the timers if it has not already fired.
+             *
+             * \param[in] n The node to remove.
+             */
+            void disarm(wait_node *n) noexcept
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                if (n->linked())
+                {
+                    _timers.remove(n);
+                    update_deadline();
+                }
+            }
+
+            /*!
+             * \brief Wakes any tasks whose timeout has passed.
+             */
+            void fire_timers() noexcept
+            {
+                auto deadline = _deadline.load();
+                if (deadline == NO_DEADLINE)
+                    return;
+                auto now = std::chrono::steady_clock::now();
+                if (now.time_since_epoch().count() < deadline)
+                    return;
+                std::vector<task*> woken;
+                {
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _timers.advance(now, [&woken](timer_wheel::hook *h)
+                    {
+                        auto n = static_cast<wait_node*>(h);
+                        if (n->claim())
+                        {
+                            n->_timed_out = true;
+                            woken.push_back(n->_task);
+                        }
+                    });
+                    update_deadline();
+                }
+                for (auto f : woken)
+                    schedule(f, false);
+            }
+
+            /*!
+             * \brief Finds the next task for a worker to run, parking the worker if there is none.
+             *
+             * \param[in] w The worker.
+             * \param[in,out] spinning Flag indicating whether the worker is looking for work.
+             *
+             * \return The task to run, or nullptr if the worker parked and should look again.
+             */
+            task* find_work(worker *w, bool &spinning) noexcept
+            {
+                fire_timers();
+                task *f = nullptr;
+                // Occasionally favour the global queue so it is not starved by local work
+                if (++w->_tick % GLOBAL_CHECK == 0 && (f = pop_global()))
+                    return f;
+                if ((f = pop_local(w)) || (f = pop_global()))
+                    return f;
+                // Steal, unless half of the busy workers are already looking
+                if (!spinning)
+                {
+                    auto busy = _workers.size() - _idle.load();
+                    if (2 * _spinning.load() < busy)
+                    {
+                        spinning = true;
+                        _spinning.fetch_add(1);
+                    }
+                }
+                if (spinning && (f = steal_work(w)))
+                    return f;
+                // Nothing to do.  Stop spinning and park.
+                if (spinning)
+                {
+                    spinning = false;
+                    _spinning.fetch_sub(1);
+                }
+                spinning = park();
+                return nullptr;
+            }
+
+            /*!
+             * \brief Creates a fiber to run the given process and makes it ready.
+             *
+             * \param[in] proc The process to run.
+             */
+            void spawn(std::function<void()> proc) noexcept(false)
+            {
+                fiber *f = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(_pool_mut);
+                    if (!_free.empty())
+                    {
+                        f = _free.back();
+                        _free.pop_back();
+                    }
+                }
+                if (!f)
+                {
+                    std::unique_ptr<fiber> created(new fiber(_stack_size));
+                    f = created.get();
+                    std::lock_guard<std::mutex> lock(_pool_mut);
+                    _all.push_back(std::move(created));
+                }
+                f->_process = std::move(proc);
+                // Build a fresh context on the fiber's stack
+                auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                f->_context.make(f->_stack + page, f->_stack_size - page, &fiber_scheduler::entry);
+                schedule(f, false);
+            }
+
+            /*!
+             * \brief The scheduling loop run by each worker.
+             *
+             * \param[in] w The worker's state.
+             */
+            void run(worker *w) noexcept
+            {
+                current_worker() = w;
+                bool spinning = false;
+                while (_running.load())
+                {
+                    auto t = find_work(w, spinning);
+                    if (!t)
+                        continue;
+                    // Found work.  If we were the last worker looking, wake another to look in our place.
+                    if (spinning)
+                    {
+                        spinning = false;
+                        if (_spinning.fetch_sub(1) == 1)
+                            wake();
+                    }
+                    w->_switches.fetch_add(1, std::memory_order_relaxed);
+                    // A task that is not a fiber runs on the worker's stack
+                    if (t->_run)
+                    {
+                        t->_run(t);
+                        continue;
+                    }
+                    // Run the fiber until it suspends
+                    auto f = static_cast<fiber*>(t);
+                    w->_current = f;
+                    context::swap(w->_context, f->_context);
+                    w->_current = nullptr;
+                    // Complete whatever the fiber asked for now its context is saved
+                    if (w->_hook)
+                    {
+                        auto hook = w->_hook;
+                        w->_hook = nullptr;
+                        hook(w->_hook_arg);
+                    }
+                }
+                if (spinning)
+                    _spinning.fetch_sub(1);
+                current_worker() = nullptr;
+            }
+        };
+
+        static std::atomic<fiber_scheduler_internal*> _internal; //!< The running scheduler, or nullptr if not started.
+
+        /*!
+         * \brief Gets the worker state of the calling thread.
+         *
+         * Never inlined, and opaque to the optimiser, so that a fiber which has moved to another
+         * worker does not use a thread local address cached from before it was suspended.
+         *
+         * \return Reference to the worker pointer of the calling thread.
+         */
+        __attribute__((noinline)) static worker*& current_worker() noexcept
+        {
+            static thread_local worker *w = nullptr;
+            asm volatile("" ::: "memory");
+            return w;
+        }
+
+        /*!
+         * \brief Gets the fiber that the calling thread is running.
+         *
+         * \return The current fiber, or nullptr if not running on a fiber.
+         */
+        static fiber* current_fiber() noexcept
+        {
+            auto w = current_worker();
+            return w ? w->_current : nullptr;
+        }
+
+        /*!
+         * \brief Suspends the current fiber.  The hook is run by the worker once the fiber's context
+         * has been saved, and is responsible for arranging for the fiber to be scheduled again.
+         *
+         * \param[in] hook The action to run once the fiber has been switched out.
+         * \param[in] arg The argument to pass to the hook.
+         */
+        static void suspend(void (*hook)(void*), void *arg) noexcept
+        {
+            auto w = current_worker();
+            auto f = w->_current;
+            w->_hook = hook;
+            w->_hook_arg = arg;
+            context::swap(f->_context, w->_context);
+        }
+
+        /*!
+         * \brief Entry point of every fiber.
+         */
+        static void entry() noexcept
+        {
+            auto f = current_fiber();
+            // A process escaping with an exception would end its thread, so it ends the program here.
+            try
+            {
+                f->_process();
+            }
+            catch (...)
+            {
+                std::terminate();
+            }
+            f->_process = nullptr;
+            // Return the fiber to the pool.  Never resumed.
+            suspend([](void *arg)
+            {
+                auto sched = _internal.load();
+                std::lock_guard<std::mutex> lock(sched->_pool_mut);
+                sched->_free.push_back(static_cast<fiber*>(arg));
+            }, f);
+        }
+
+    public:
+        /*!
+         * \brief Starts the scheduler.  From this point on par runs its processes on the worker pool.
+         *
+         * \param[in] workers The number of worker threads.  Defaults to one per core.
+         * \param[in] stack_size The stack size of each fiber.
+         */
+        static void start(unsigned int workers = std::thread::hardware_concurrency(), size_t stack_size = DEFAULT_STACK_SIZE) noexcept(false)
+        {
+            if (_internal.load())
+                throw std::logic_error("fiber_scheduler already started");
+            _internal.store(new fiber_scheduler_internal(workers > 0 ? workers : 1, stack_size));
+        }
+
+        /*!
+         * \brief Stops the scheduler and joins the workers.  Must not be called while processes are
+         * still running on the scheduler.
+         */
+        static void stop() noexcept
+        {
+            // Workers may still be completing hooks that use the scheduler, so join them first
+            delete _internal.load();
+            _internal.store(nullptr);
+        }
+
+        /*!
+         * \brief Checks whether the scheduler has been started.
+         *
+         * \return True if the scheduler is running, false otherwise.
+         */
+        static bool active() noexcept { return _internal.load() != nullptr; }
+
+        /*!
+         * \brief Checks whether the caller is running as a fiber.
+         *
+         * \return True if the caller is a fiber, false if it is an ordinary thread.
+         */
+        static bool in_fiber() noexcept { return current_fiber() != nullptr; }
+
+        /*!
+         * \brief Runs a process as a new fiber.
+         *
+         * \param[in] proc The process to run.
+         */
+        static void spawn(std::function<void()> proc) noexcept(false)
+        {
+            auto sched = _internal.load();
+            if (!sched)
+                throw std::logic_error("fiber_scheduler not started");
+            sched->spawn(std::move(proc));
+        }
+
+        /*!
+         * \brief Makes a task ready to run on the workers.
+         *
+         * \param[in] t The task to run.
+         */
+        static void schedule(task *t) noexcept(false)
+        {
+            auto sched = _internal.load();
+            if (!sched)
+                throw std::logic_error("fiber_scheduler not started");
+            sched->schedule(t, false);
+        }
+
+        /*!
+         * \brief Lets another process run.  Yields the thread if not called from a fiber.
+         */
+        static void yield() noexcept
+        {
+            auto f = current_fiber();
+            if (!f)
+            {
+                std::this_thread::yield();
+                return;
+            }
+            suspend([](void *arg) { _internal.load()->schedule(static_cast<fiber*>(arg), false); }, f);
+        }
+
+        /*!
+         * \brief Waits until the given time.  Sleeps the thread if not called from a fiber.
+         *
+         * \param[in] time The time to wait until.
+         */
+        static void sleep_until(const std::chrono::steady_clock::time_point &time) noexcept;
+
+        /*!
+         * \brief Waits for the given duration.  Sleeps the thread if not called from a fiber.
+         *
+         * \param[in] duration The time to wait for.
+         */
+        static void sleep_for(const std::chrono::steady_clock::duration &duration) noexcept
+        {
+            sleep_until(std::chrono::steady_clock::now() + duration);
+        }
+    };
+
+    // Initialise the scheduler pointer
+    std::atomic<fiber_scheduler::fiber_scheduler_internal*> fiber_scheduler::_internal(nullptr);
+
+    /*! \class timer_service
+     * \brief Wakes threads whose timed waits have expired.
+     *
+     * Every timed wait and sleep made by a thread outside the fiber scheduler is placed on one
+     * timing wheel, driven by a single background thread.  So however many processes are waiting
+     * on a timeout there is only one kernel timer.  Fibers use the wheel of the fiber scheduler
+     * instead, driven by its workers.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class timer_service
+    {
+    private:
+        using wait_node = fiber_scheduler::wait_node;
+
+        std::mutex _mut; //!< Protects the wheel.
+
+        std::condition_variable _cond; //!< Used to wake the service thread when an earlier timeout is added.
+
+        timer_wheel _wheel; //!< The timeouts of the waiting threads.
+
+        std::chrono::steady_clock::time_point _wake; //!< Time the service thread will next wake.
+
+        /*!
+         * \brief Creates the service and starts its thread.  The service lives until the program ends.
+         */
+        timer_service() noexcept
+        : _wheel(timer_wheel::default_slack()),
+          _wake(std::chrono::steady_clock::time_point::max())
+        {
+            std::thread(&timer_service::run, this).detach();
+        }
+
+        /*!
+         * \brief Gets the service, starting it on first use.
+         *
+         * \return The service.
+         */
+        static timer_service& get() noexcept
+        {
+            static timer_service *service = new timer_service();
+            return *service;
+        }
+
+        /*!
+         * \brief Fires timeouts as they expire.  Run by the service thread.
+         */
+        void run() noexcept
+        {
+#if defined(__linux__)
+            // The wheel already coalesces timeouts, so the kernel need not add slack of its own
+            prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+            std::vector<wait_node*> woken;
+            std::unique_lock<std::mutex> lock(_mut);
+            while (true)
+            {
+                // Claim the expired nodes.  A claimed waiter cannot leave until it has been woken.
+                _wheel.advance(std::chrono::steady_clock::now(), [&woken](timer_wheel::hook *h)
+                {
+                    auto n = static_cast<wait_node*>(h);
+                    if (n->claim())
+                    {
+                        n->_timed_out = true;
+                        woken.push_back(n);
+                    }
+                });
+                // Wake them without the lock, so they do not queue behind us when they cancel
+                if (!woken.empty())
+                {
+                    lock.unlock();
+                    for (auto n : woken)
+                        n->wake_thread();
+                    woken.clear();
+                    lock.lock();
+                    continue;
+                }
+                _wake = _wheel.next_time();
+                if (_wake == std::chrono::steady_clock::time_point::max())
+                    _cond.wait(lock);
+                else
+                    _cond.wait_until(lock, _wake);
+            }
+        }
+
+    public:
+        timer_service(const timer_service&) = delete;
+
+        timer_service& operator=(const timer_service&) = delete;
+
+        /*!
+         * \brief Registers a waiting thread to be woken at the given time.
+         *
+         * \param[in] n The node of the waiting thread.
+         * \param[in] time The time to wake the thread at.
+         */
+        static void arm(wait_node *n, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            auto &service = get();
+            std::lock_guard<std::mutex> lock(service._mut);
+            service._wheel.insert(n, time);
+            // Only wake the service if it would otherwise sleep past the new timeout
+            if (service._wheel.next_time() < service._wake)
+            {
+                service._wake = service._wheel.next_time();
+                service._cond.notify_one();
+            }
+        }
+
+        /*!
+         * \brief Removes a waiting thread's timeout if it has not fired.  Once this returns the
+         * service no longer refers to the node.
+         *
+         * \param[in] n The node of the waiting thread.
+         */
+        static void disarm(wait_node *n) noexcept
+        {
+            auto &service = get();
+            std::lock_guard<std::mutex> lock(service._mut);
+            service._wheel.remove(n);
+        }
+    };
+
+    void fiber_scheduler::sleep_until(const std::chrono::steady_clock::time_point &time) noexcept
+    {
+        if (time <= std::chrono::steady_clock::now())
+            return;
+        auto f = current_fiber();
+        wait_node n(f);
+        if (!f)
+        {
+            // Only the timer can wake the node, and it is done with the node once it has
+            timer_service::arm(&n, time);
+            n.wait_thread();
+            return;
+        }
+        std::pair<wait_node*, std::chrono::steady_clock::time_point> args(&n, time);
+        suspend([](void *arg)
+        {
+            auto a = *static_cast<std::pair<wait_node*, std::chrono::steady_clock::time_point>*>(arg);
+            auto sched = _internal.load();
+            std::lock_guard<std::mutex> lock(sched->_mut);
+            sched->arm(a.first, a.second);
+        }, &args);
+    }
+
+    /*! \class async_op
+     * \brief State of a blocking operation performed in steps by a process that cannot block.
+     *
+     * A coroutine cannot suspend from inside a channel operation, so each blocking operation also
+     * has a step form that either completes, or queues this object on a condition and returns.  When
+     * woken the task is run, and calls the step again to carry on from where it left off.  The step
+     * must record its progress before it waits, as once queued the object may be run at any time.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class async_op : public fiber_scheduler::task
+    {
+        friend class condition;
+    private:
+        fiber_scheduler::wait_node _node; //!< Node queued when the operation waits.
+
+        bool _timed = false; //!< Flag to indicate whether the last wait had a timeout.
+
+    public:
+        unsigned int _phase = 0; //!< Progress of the operation through its steps.
+
+        bool _locked = false; //!< Flag used by the shared end of a channel to record that it holds its lock.
+
+        bool _waiting = false; //!< Flag used by a step to record that it is registered as waiting.
+
+        void *_state = nullptr; //!< State a channel keeps for the operation between steps.
+
+        /*!
+         * \brief Creates a new operation.
+         *
+         * \param[in] run The function called when the operation is woken.
+         */
+        async_op(void (*run)(fiber_scheduler::task*)) noexcept
+        : fiber_scheduler::task(run), _node(this)
+        {
+        }
+
+        // Operations are never copied or moved
+        async_op(const async_op &other) = delete;
+        async_op& operator=(const async_op &other) = delete;
+    };
+
+    /*! \class condition
+     * \brief A condition variable that suspends fibers rather than blocking their worker.
+     *
+     * Used in place of std::condition_variable throughout the framework.  Behaves as a
+     * std::condition_variable used with a std::unique_lock<std::mutex>, except that it never
+     * wakes spuriously.  Threads and fibers may wait on the same condition.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class condition
+    {
+    private:
+        using wait_node = fiber_scheduler::wait_node;
+
+        std::mutex _mut; //!< Protects the wait queue.
+
+        wait_node *_head = nullptr; //!< First waiting process.
+
+        wait_node *_tail = nullptr; //!< Last waiting process.
+
+        std::atomic<unsigned int> _waiting; //!< Number of waiting processes.  Lets notify skip the lock.
+
+        /*!
+         * \brief Adds a node to the back of the wait queue.  Called with _mut held.
+         *
+         * \param[in] n The node to add.
+         */
+        void push(wait_node *n) noexcept
+        {
+            n->_prev = _tail;
+            n->_next = nullptr;
+            if (_tail)
+                _tail->_next = n;
+            else
+                _head = n;
+            _tail = n;
+            n->_queued = true;
+            _waiting.fetch_add(1);
+        }
+
+        /*!
+         * \brief Removes a node from the wait queue.  Called with _mut held.
+         *
+         * \param[in] n The node to remove.
+         */
+        void remove(wait_node *n) noexcept
+        {
+            if (!n->_queued)
+                return;
+            if (n->_prev)
+                n->_prev->_next = n->_next;
+            else
+                _head = n->_next;
+            if (n->_next)
+                n->_next->_prev = n->_prev;
+            else
+                _tail = n->_prev;
+            n->_queued = false;
+            _waiting.fetch_sub(1);
+        }
+
+        /*!
+         * \brief Wakes the node at the front of the queue.  Called with _mut held.
+         *
+         * \return True if a process was woken, false if there was none to wake.
+         */
+        bool wake_one() noexcept
+        {
+            while (_head)
+            {
+                auto n = _head;
+                remove(n);
+                // A fiber that has already timed out is skipped.
+                if (n->claim())
+                {
+                    if (n->_task)
+                        fiber_scheduler::_internal.load()->schedule(n->_task);
+                    else
+                        n->wake_thread();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*!
+         * \brief Arguments passed to the suspend hook when a fiber waits.
+         */
+        struct wait_args
+        {
+            condition *cond;
+            wait_node *node;
+            std::mutex *lock;
+            bool timed;
+            std::chrono::steady_clock::time_point time;
+        };
+
+        /*!
+         * \brief Performs a wait on the condition.
+         *
+         * \param[in] lock The lock held on the caller's mutex.
+         * \param[in] timed Flag indicating whether the wait has a timeout.
+         * \param[in] time The timeout.
+         *
+         * \return std::cv_status::timeout if the wait timed out, std::cv_status::no_timeout otherwise.
+         */
+        std::cv_status do_wait(std::unique_lock<std::mutex> &lock, bool timed, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            // No need to queue if the time has already passed
+            if (timed && time <= std::chrono::steady_clock::now())
+                return std::cv_status::timeout;
+            auto f = fiber_scheduler::current_fiber();
+            wait_node n(f);
+            if (!f)
+            {
+                // Thread waiter.  Queue before releasing the caller's lock so no notify is lost.
+                {
+                    std::lock_guard<std::mutex> queue_lock(_mut);
+                    push(&n);
+                }
+                lock.unlock();
+                if (timed)
+                    timer_service::arm(&n, time);
+                n.wait_thread();
+                // If timed out, take ourselves off the wait queue; otherwise cancel the timer.
+                if (timed)
+                {
+                    timer_service::disarm(&n);
+                    if (n._timed_out)
+                    {
+                        std::lock_guard<std::mutex> queue_lock(_mut);
+                        remove(&n);
+                    }
+                }
+                lock.lock();
+                return n._timed_out ? std::cv_status::timeout : std::cv_status::no_timeout;
+            }
+            // Fiber waiter.  The node is queued and the caller's lock released once our context is saved.
+            wait_args args{this, &n, lock.mutex(), timed, time};
+            fiber_scheduler::suspend([](void *arg)
+            {
+                // Copy the arguments.  Once queued the fiber may be resumed elsewhere and its stack reused.
+                auto a = *static_cast<wait_args*>(arg);
+                {
+                    std::lock_guard<std::mutex> queue_lock(a.cond->_mut);
+                    a.cond->push(a.node);
+                    if (a.timed)
+                    {
+                        auto sched = fiber_scheduler::_internal.load();
+                        std::lock_guard<std::mutex> sched_lock(sched->_mut);
+                        sched->arm(a.node, a.time);
+                    }
+                }
+                a.lock->unlock();
+            }, &args);
+            // Resumed.  If timed out, take ourselves off the wait queue; otherwise cancel the timer.
+            if (timed)
+            {
+                fiber_scheduler::_internal.load()->disarm(&n);
+                if (n._timed_out)
+                {
+                    std::lock_guard<std::mutex> queue_lock(_mut);
+                    remove(&n);
+                }
+            }
+            // The lock still records ownership, so relock the mutex directly
+            lock.mutex()->lock();
+            return n._timed_out ? std::cv_status::timeout : std::cv_status::no_timeout;
+        }
+
+        /*!
+         * \brief Queues an operation to be woken.
+         *
+         * \param[in] lock The lock held on the caller's mutex.
+         * \param[in] op The operation to wake.
+         * \param[in] timed Flag indicating whether the wait has a timeout.
+         * \param[in] time The timeout.
+         */
+        void queue_async(std::unique_lock<std::mutex> &lock, async_op &op, bool timed, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            auto n = &op._node;
+            n->_claimed.store(false);
+            n->_timed_out = false;
+            op._timed = timed;
+            {
+                std::lock_guard<std::mutex> queue_lock(_mut);
+                push(n);
+                if (timed)
+                {
+                    auto sched = fiber_scheduler::_internal.load();
+                    std::lock_guard<std::mutex> sched_lock(sched->_mut);
+                    sched->arm(n, time);
+                }
+            }
+            lock.unlock();
+        }
+
+    public:
+        /*!
+         * \brief Creates a new condition.
+         */
+        condition() noexcept
+        : _waiting(0)
+        {
+        }
+
+        // Conditions cannot be copied
+        condition(const condition &other) = delete;
+        condition& operator=(const condition &other) = delete;
+
+        /*!
+         * \brief Waits on the condition.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released while waiting.
+         */
+        void wait(std::unique_lock<std::mutex> &lock) noexcept
+        {
+            do_wait(lock, false, std::chrono::steady_clock::time_point());
+        }
+
+        /*!
+         * \brief Waits on the condition until the predicate is true.
+         *
+         * \tparam Pred The type of the predicate.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released while waiting.
+         * \param[in] pred The predicate to wait on.
+         */
+        template<typename Pred>
+        void wait(std::unique_lock<std::mutex> &lock, Pred pred) noexcept
+        {
+            while (!pred())
+                wait(lock);
+        }
+
+        /*!
+         * \brief Waits on the condition until notified or the given time is reached.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released while waiting.
+         * \param[in] time The time to wait until.
+         *
+         * \return std::cv_status::timeout if the time was reached, std::cv_status::no_timeout otherwise.
+         */
+        std::cv_status wait_until(std::unique_lock<std::mutex> &lock, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            return do_wait(lock, true, time);
+        }
+
+        /*!
+         * \brief Waits on the condition until the predicate is true or the given time is reached.
+         *
+         * \tparam Pred The type of the predicate.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released while waiting.
+         * \param[in] time The time to wait until.
+         * \param[in] pred The predicate to wait on.
+         *
+         * \return The value of the predicate.
+         */
+        template<typename Pred>
+        bool wait_until(std::unique_lock<std::mutex> &lock, const std::chrono::steady_clock::time_point &time, Pred pred) noexcept
+        {
+            while (!pred())
+                if (wait_until(lock, time) == std::cv_status::timeout)
+                    return pred();
+            return true;
+        }
+
+        /*!
+         * \brief Waits on the condition until notified or the given duration passes.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released while waiting.
+         * \param[in] duration The time to wait for.
+         *
+         * \return std::cv_status::timeout if the time passed, std::cv_status::no_timeout otherwise.
+         */
+        std::cv_status wait_for(std::unique_lock<std::mutex> &lock, const std::chrono::steady_clock::duration &duration) noexcept
+        {
+            return wait_until(lock, std::chrono::steady_clock::now() + duration);
+        }
+
+        /*!
+         * \brief Queues an operation on the condition and releases the caller's lock.  The operation is
+         * run once notified.  The caller must not touch the operation after this call.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released on return.
+         * \param[in] op The operation to wake.
+         */
+        void wait_async(std::unique_lock<std::mutex> &lock, async_op &op) noexcept
+        {
+            queue_async(lock, op, false, std::chrono::steady_clock::time_point());
+        }
+
+        /*!
+         * \brief Queues an operation on the condition and releases the caller's lock.  The operation is
+         * run once notified or the given time is reached.  The caller must not touch the operation after
+         * this call.
+         *
+         * \param[in] lock The lock held on the caller's mutex.  Released on return.
+         * \param[in] op The operation to wake.
+         * \param[in] time The time to wait until.
+         */
+        void wait_async_until(std::unique_lock<std::mutex> &lock, async_op &op, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            queue_async(lock, op, true, time);
+        }
+
+        /*!
+         * \brief Completes a wait by an operation once it has been run.
+         *
+         * \param[in] op The operation that waited.
+         *
+         * \return std::cv_status::timeout if the time was reached, std::cv_status::no_timeout otherwise.
+         */
+        std::cv_status finish_async(async_op &op) noexcept
+        {
+            auto n = &op._node;
+            if (!op._timed)
+                return std::cv_status::no_timeout;
+            // If timed out, take the operation off the wait queue; otherwise cancel the timer.
+            fiber_scheduler::_internal.load()->disarm(n);
+            if (n->_timed_out)
+            {
+                std::lock_guard<std::mutex> queue_lock(_mut);
+                remove(n);
+                return std::cv_status::timeout;
+            }
+            return std::cv_status::no_timeout;
+        }
+
+        /*!
+         * \brief Wakes one waiting process.
+         */
+        void notify_one() noexcept
+        {
+            if (_waiting.load() == 0)
+                return;
+            std::lock_guard<std::mutex> lock(_mut);
+            wake_one();
+        }
+
+        /*!
+         * \brief Wakes all waiting processes.
+         */
+        void notify_all() noexcept
+        {
+            if (_waiting.load() == 0)
+                return;
+            std::lock_guard<std::mutex> lock(_mut);
+            while (wake_one()) { }
+        }
+    };
+
+    /*! \class process_mutex
+     * \brief A mutex that suspends a waiting fiber rather than blocking its worker.
+     *
+     * Used where a lock is held across a blocking channel operation, such as on the shared
+     * ends of a channel.  Unlike std::mutex it may be unlocked from a different thread,
+     * which happens when a fiber moves between workers.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class process_mutex
+    {
+    private:
+        std::mutex _mut; //!< Protects the locked flag.
+
+        condition _cond; //!< Used to wait for the mutex.
+
+        bool _locked = false; //!< Flag to indicate whether the mutex is held.
+
+    public:
+        /*!
+         * \brief Creates a new unlocked mutex.
+         */
+        process_mutex() noexcept { }
+
+        // Mutexes cannot be copied
+        process_mutex(const process_mutex &other) = delete;
+        process_mutex& operator=(const process_mutex &other) = delete;
+
+        /*!
+         * \brief Locks the mutex, waiting until it is available.
+         */
+        void lock() noexcept
+        {
+            std::unique_lock<std::mutex> lock(_mut);
+            while (_locked)
+                _cond.wait(lock);
+            _locked = true;
+        }
+
+        /*!
+         * \brief Locks the mutex as a step of an operation.
+         *
+         * \param[in] op The operation to wake once the mutex may be available.
+         *
+         * \return True if the mutex was locked, false if the operation is waiting.
+         */
+        bool lock_async(async_op &op) noexcept
+        {
+            std::unique_lock<std::mutex> lock(_mut);
+            if (!_locked)
+            {
+                _locked = true;
+                return true;
+            }
+            _cond.wait_async(lock, op);
+            return false;
+        }
+
+        /*!
+         * \brief Attempts to lock the mutex without waiting.
+         *
+         * \return True if the mutex was locked, false otherwise.
+         */
+        bool try_lock() noexcept
+        {
+            std::lock_guard<std::mutex> lock(_mut);
+            if (_locked)
+                return false;
+            _locked = true;
+            return true;
+        }
+
+        /*!
+         * \brief Attempts to lock the mutex, waiting no later than the given time.
+         *
+         * \param[in] time The time to give up waiting.
+         *
+         * \return True if the mutex was locked, false if the time was reached first.
+         */
+        bool try_lock_until(const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            std::unique_lock<std::mutex> lock(_mut);
+            if (!_cond.wait_until(lock, time, [this]() { return !_locked; }))
+                return false;
+            _locked = true;
+            return true;
+        }
+
+        /*!
+         * \brief Unlocks the mutex.
+         */
+        void unlock() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                _locked = false;
+            }
+            _cond.notify_one();
+        }
+    };
+}
+
+#endif //CPP_CSP_FIBER_SCHEDULER_H
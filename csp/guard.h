@@ -55,6 +55,15 @@ namespace csp
              */
             virtual bool disable() noexcept(false) = 0;
 
+            /*!
+             * \brief Checks if the guard stays enabled between selections.  Such a guard keeps its
+             * registration with an alt until it schedules the alt or is disabled, even while the alt
+             * is not selecting, so a ready-queue alt need only enable it again once it is selected.
+             *
+             * \return True if the guard stays enabled, false if it must be enabled for every selection.
+             */
+            virtual bool persistent() const noexcept { return false; }
+
             /*!
              * \brief Allows a subclass to schedule with the alt.  Helper
              * method to overcome some of the class protection levels.
@@ -153,6 +162,13 @@ namespace csp
          */
         bool disable() const noexcept(false) { return _internal->disable(); }
 
+        /*!
+         * \brief Checks if the guard stays enabled between selections.
+         *
+         * \return True if the guard stays enabled, false otherwise.
+         */
+        bool persistent() const noexcept { return _internal->persistent(); }
+
     };
 }
 
@@ -0,0 +1,413 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_CODEC_H
+#define CPP_CSP_CODEC_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/uio.h>
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class encoder
+         * \brief Gathers the pieces of memory a value is sent from.
+         *
+         * A codec adds the memory of a value as it is, so the value is sent straight from where it
+         * lives without being copied.  Small fields the value does not hold, such as the length of
+         * a container, are copied into scratch space the encoder owns.  Pieces next to each other
+         * in memory are merged.  The encoder is kept by the channel end and reused for each write,
+         * so once it has grown to the size of the values written it does not allocate again.
+         *
+         * The first piece is left free for the frame header.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class encoder
+        {
+        private:
+            std::vector<iovec> _parts; //!< The pieces, after the one left for the header.
+
+            std::vector<char> _scratch; //!< Copies of fields the value does not hold.
+
+            size_t _size = 0; //!< Number of bytes added so far.
+
+            /*!
+             * \brief Adds a piece, merging it with the last if they are next to each other.
+             *
+             * \param[in] data The start of the piece.
+             * \param[in] n The number of bytes.
+             */
+            void add(const void *data, size_t n) noexcept
+            {
+                _size += n;
+                auto &last = _parts.back();
+                if (_parts.size() > 1 && static_cast<const char*>(last.iov_base) + last.iov_len == data)
+                    last.iov_len += n;
+                else
+                    _parts.push_back(iovec{const_cast<void*>(data), n});
+            }
+
+        public:
+            /*!
+             * \brief Creates an empty encoder.
+             */
+            encoder() noexcept
+            : _parts(1, iovec{nullptr, 0})
+            {
+                _scratch.reserve(64);
+            }
+
+            /*!
+             * \brief Clears the encoder for the next value.
+             */
+            void clear() noexcept
+            {
+                _parts.resize(1);
+                _scratch.clear();
+                _size = 0;
+            }
+
+            /*!
+             * \brief Adds memory of the value to send.  The memory must stay as it is until the value is sent.
+             *
+             * \param[in] data The start of the memory.
+             * \param[in] n The number of bytes.
+             */
+            void put(const void *data, size_t n) noexcept
+            {
+                if (n > 0)
+                    add(data, n);
+            }
+
+            /*!
+             * \brief Adds an array of the value to send, aligned within the message so it can be
+             * read in place.  The memory must stay as it is until the value is sent.
+             *
+             * \tparam U The type of the elements.  Must be trivially copyable.
+             *
+             * \param[in] data The first element.
+             * \param[in] n The number of elements.
+             */
+            template<typename U>
+            void put_array(const U *data, size_t n) noexcept
+            {
+                static_assert(std::is_trivially_copyable<U>::value, "Only arrays of trivially copyable elements can be sent in place");
+                static const char padding[alignof(U)] = { };
+                if (_size % alignof(U) != 0)
+                    add(padding, alignof(U) - _size % alignof(U));
+                put(data, n * sizeof(U));
+            }
+
+            /*!
+             * \brief Adds a copy of a small field.
+             *
+             * \tparam S The type of the field.  Must be trivially copyable.
+             *
+             * \param[in] field The field.
+             */
+            template<typename S>
+            void put_copy(const S &field) noexcept
+            {
+                static_assert(std::is_trivially_copyable<S>::value, "Only trivially copyable fields can be copied");
+                if (_scratch.size() + sizeof(S) > _scratch.capacity())
+                {
+                    // Growing moves the scratch space, so move the pieces in it too
+                    auto old = _scratch.data();
+                    auto used = _scratch.size();
+                    _scratch.reserve(2 * _scratch.capacity() + sizeof(S));
+                    for (size_t i = 1; i < _parts.size(); ++i)
+                    {
+                        auto base = static_cast<char*>(_parts[i].iov_base);
+                        if (base >= old && base < old + used)
+                            _parts[i].iov_base = _scratch.data() + (base - old);
+                    }
+                }
+                auto at = _scratch.size();
+                _scratch.resize(at + sizeof(S));
+                std::memcpy(_scratch.data() + at, &field, sizeof(S));
+                add(_scratch.data() + at, sizeof(S));
+            }
+
+            /*!
+             * \brief Gets the pieces.  The first is left free for the frame header.
+             *
+             * \return The first piece.
+             */
+            iovec* parts() noexcept { return _parts.data(); }
+
+            /*!
+             * \brief Gets the number of pieces, including the one left for the header.
+             *
+             * \return The number of pieces.
+             */
+            size_t count() const noexcept { return _parts.size(); }
+        };
+
+        /*! \class decoder
+         * \brief Reads a value from the bytes it was received as.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class decoder
+        {
+        private:
+            const char *_data; //!< The bytes not yet read.
+
+            size_t _left; //!< The number of bytes not yet read.
+
+            size_t _read = 0; //!< The number of bytes read.
+
+        public:
+            /*!
+             * \brief Creates a decoder over received bytes.
+             *
+             * \param[in] data The bytes.
+             * \param[in] n The number of bytes.
+             */
+            decoder(const char *data, size_t n) noexcept
+            : _data(data), _left(n)
+            {
+            }
+
+            /*!
+             * \brief Takes a number of bytes.
+             *
+             * \param[in] n The number of bytes.
+             *
+             * \return The bytes, which stay valid until the value has been read.
+             */
+            const char* take(size_t n) noexcept(false)
+            {
+                if (n > _left)
+                    throw std::runtime_error("Networked channel value is shorter than its codec expects");
+                auto data = _data;
+                _data += n;
+                _left -= n;
+                _read += n;
+                return data;
+            }
+
+            /*!
+             * \brief Takes an array added with put_array.  The bytes received start on a boundary
+             * suitable for any type, so the array can be read in place.
+             *
+             * \tparam U The type of the elements.
+             *
+             * \param[in] n The number of elements.
+             *
+             * \return The first element, which stays valid until the value has been read.
+             */
+            template<typename U>
+            const U* take_array(size_t n) noexcept(false)
+            {
+                if (_read % alignof(U) != 0)
+                    take(alignof(U) - _read % alignof(U));
+                if (n > _left / sizeof(U))
+                    throw std::runtime_error("Networked channel value is shorter than its codec expects");
+                return reinterpret_cast<const U*>(take(n * sizeof(U)));
+            }
+
+            /*!
+             * \brief Copies a number of bytes out.
+             *
+             * \param[out] data Where to copy the bytes.
+             * \param[in] n The number of bytes.
+             */
+            void get(void *data, size_t n) noexcept(false)
+            {
+                if (n > 0)
+                    std::memcpy(data, take(n), n);
+            }
+
+            /*!
+             * \brief Reads a field added with put_copy.
+             *
+             * \tparam S The type of the field.
+             *
+             * \return The field.
+             */
+            template<typename S>
+            S get_copy() noexcept(false)
+            {
+                S field;
+                get(&field, sizeof(S));
+                return field;
+            }
+
+            /*!
+             * \brief Gets the number of bytes not yet read.
+             *
+             * \return The number of bytes.
+             */
+            size_t left() const noexcept { return _left; }
+        };
+
+        /*! \struct codec
+         * \brief Sends values of a type over a networked channel.
+         *
+         * A codec has two static functions.  encode adds the memory a value is sent from to an
+         * encoder, and decode builds a value from a decoder.  Trivially copyable types are sent
+         * as their bytes, and vectors, strings and pairs of types with codecs are built in.
+         * Specialise codec for other types, encoding each field with its own codec.
+         *
+         * Values are sent in the layout and byte order of the writing node, so nodes must agree.
+         *
+         * \tparam T The type of the values.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, typename = void>
+        struct codec
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "No codec for this type.  Specialise csp::net::codec with encode and decode.");
+
+            /*!
+             * \brief Adds the bytes of a value.
+             *
+             * \param[in] value The value.
+             * \param[in,out] out The encoder.
+             */
+            static void encode(const T &value, encoder &out) noexcept { out.put(&value, sizeof(T)); }
+
+            /*!
+             * \brief Reads a value from its bytes.
+             *
+             * \param[in,out] in The decoder.
+             *
+             * \return The value.
+             */
+            static T decode(decoder &in) noexcept(false)
+            {
+                typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+                in.get(&storage, sizeof(T));
+                return *reinterpret_cast<T*>(&storage);
+            }
+        };
+
+        /*! \struct codec
+         * \brief Sends a vector as its length and then its elements.  A vector of trivially copyable
+         * elements is sent straight from its buffer.
+         *
+         * \tparam U The type of the elements.
+         * \tparam A The allocator.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename U, typename A>
+        struct codec<std::vector<U, A>>
+        {
+            static_assert(!std::is_same<U, bool>::value, "std::vector<bool> has no codec.  Send a std::vector<char>.");
+
+            static void encode(const std::vector<U, A> &value, encoder &out) noexcept
+            {
+                out.put_copy(static_cast<uint64_t>(value.size()));
+                put(value, out, std::is_trivially_copyable<U>());
+            }
+
+            static std::vector<U, A> decode(decoder &in) noexcept(false)
+            {
+                auto size = static_cast<size_t>(in.get_copy<uint64_t>());
+                return get(size, in, std::is_trivially_copyable<U>());
+            }
+
+        private:
+            static void put(const std::vector<U, A> &value, encoder &out, std::true_type) noexcept
+            {
+                out.put_array(value.data(), value.size());
+            }
+
+            static void put(const std::vector<U, A> &value, encoder &out, std::false_type) noexcept
+            {
+                for (auto &item : value)
+                    codec<U>::encode(item, out);
+            }
+
+            static std::vector<U, A> get(size_t size, decoder &in, std::true_type) noexcept(false)
+            {
+                auto data = in.take_array<U>(size);
+                return std::vector<U, A>(data, data + size);
+            }
+
+            static std::vector<U, A> get(size_t size, decoder &in, std::false_type) noexcept(false)
+            {
+                std::vector<U, A> value;
+                value.reserve(size < in.left() ? size : in.left());
+                for (size_t i = 0; i < size; ++i)
+                    value.push_back(codec<U>::decode(in));
+                return value;
+            }
+        };
+
+        /*! \struct codec
+         * \brief Sends a string as its length and then its characters, straight from its buffer.
+         *
+         * \tparam C The type of the characters.
+         * \tparam TR The character traits.
+         * \tparam A The allocator.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename C, typename TR, typename A>
+        struct codec<std::basic_string<C, TR, A>>
+        {
+            static void encode(const std::basic_string<C, TR, A> &value, encoder &out) noexcept
+            {
+                out.put_copy(static_cast<uint64_t>(value.size()));
+                out.put_array(value.data(), value.size());
+            }
+
+            static std::basic_string<C, TR, A> decode(decoder &in) noexcept(false)
+            {
+                auto size = static_cast<size_t>(in.get_copy<uint64_t>());
+                return std::basic_string<C, TR, A>(in.take_array<C>(size), size);
+            }
+        };
+
+        /*! \struct codec
+         * \brief Sends a pair as its two values.  A trivially copyable pair is sent as its bytes.
+         *
+         * \tparam F The type of the first value.
+         * \tparam S The type of the second value.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename F, typename S>
+        struct codec<std::pair<F, S>, typename std::enable_if<!std::is_trivially_copyable<std::pair<F, S>>::value>::type>
+        {
+            static void encode(const std::pair<F, S> &value, encoder &out) noexcept
+            {
+                codec<F>::encode(value.first, out);
+                codec<S>::encode(value.second, out);
+            }
+
+            static std::pair<F, S> decode(decoder &in) noexcept(false)
+            {
+                auto first = codec<F>::decode(in);
+                return std::pair<F, S>(std::move(first), codec<S>::decode(in));
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_CODEC_H
@@ -0,0 +1,444 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_EPOLL_ENGINE_H
+#define CPP_CSP_EPOLL_ENGINE_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "io_engine.h"
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class epoll_engine
+         * \brief An I/O engine that waits on the sockets with epoll and reads those ready.
+         *
+         * Each I/O thread waits on the one epoll set.  With more than one thread a socket is
+         * handed to one thread at a time, and watched again once that thread has read it.  Events
+         * carry a number for the socket rather than a pointer, so an event taken by one thread
+         * for a socket another has just stopped watching is ignored.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class epoll_engine : public io_engine
+        {
+        private:
+            static constexpr size_t RECEIVE_SIZE = 64 * 1024; //!< Bytes read from a socket at a time.
+
+            static constexpr int EVENTS = 64; //!< Most sockets taken from one wait.
+
+            static constexpr int READS = 4; //!< Most reads of one socket before the others are served.
+
+            /*! \struct watched
+             * \brief A socket the engine watches.
+             */
+            struct watched
+            {
+                uint64_t id; //!< The number of the socket in the engine.
+
+                int fd; //!< The socket.
+
+                std::shared_ptr<stream> s; //!< The stream of a connected socket.
+
+                std::shared_ptr<acceptor> a; //!< The acceptor of a listening socket.
+
+                std::mutex busy; //!< Held while the stream or acceptor is called.
+
+                bool done = false; //!< Whether the stream or acceptor has been told the socket closed.
+
+                std::chrono::steady_clock::time_point due = std::chrono::steady_clock::time_point::max(); //!< When to call the stream's timer.
+            };
+
+            int _epoll; //!< The epoll set.
+
+            int _wake; //!< Event used to wake the I/O threads to stop.
+
+            bool _oneshot; //!< Whether sockets are watched again after each read, as more than one thread waits.
+
+            std::mutex _mut; //!< Lock used to control access to the sockets watched.
+
+            uint64_t _next = 1; //!< Number of the next socket watched.  Zero is the wake event.
+
+            std::unordered_map<uint64_t, std::shared_ptr<watched>> _watched; //!< The sockets watched, by number.
+
+            std::unordered_set<uint64_t> _timed; //!< The sockets whose stream has asked for a call.
+
+            std::atomic<bool> _stopping; //!< Whether the engine is stopping.
+
+            std::vector<std::thread> _threads; //!< The I/O threads.
+
+            /*!
+             * \brief Adds a socket to the epoll set.
+             *
+             * \param[in] w The socket.
+             */
+            void add(const std::shared_ptr<watched> &w) noexcept(false)
+            {
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    w->id = _next++;
+                    _watched[w->id] = w;
+                }
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = _oneshot ? EPOLLIN | EPOLLONESHOT : EPOLLIN;
+                event.data.u64 = w->id;
+                if (epoll_ctl(_epoll, EPOLL_CTL_ADD, w->fd, &event) != 0)
+                {
+                    auto error = errno;
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _watched.erase(w->id);
+                    throw std::runtime_error(std::string("Cannot watch socket: ") + std::strerror(error));
+                }
+            }
+
+            /*!
+             * \brief Watches a socket again after a thread has read it.
+             *
+             * \param[in] w The socket.
+             */
+            void rearm(watched *w) noexcept
+            {
+                if (!_oneshot)
+                    return;
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN | EPOLLONESHOT;
+                event.data.u64 = w->id;
+                epoll_ctl(_epoll, EPOLL_CTL_MOD, w->fd, &event);
+            }
+
+            /*!
+             * \brief Finds a socket watched.
+             *
+             * \param[in] id The number of the socket.
+             *
+             * \return The socket, or null if no longer watched.
+             */
+            std::shared_ptr<watched> find(uint64_t id) noexcept
+            {
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                auto found = _watched.find(id);
+                return found == _watched.end() ? nullptr : found->second;
+            }
+
+            /*!
+             * \brief Stops watching a socket, and tells its stream or acceptor.  Called with the socket busy.
+             *
+             * \param[in] w The socket.
+             */
+            void remove(watched *w) noexcept
+            {
+                epoll_ctl(_epoll, EPOLL_CTL_DEL, w->fd, nullptr);
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _timed.erase(w->id);
+                    _watched.erase(w->id);
+                }
+                w->done = true;
+                if (w->a)
+                    w->a->closed();
+                else
+                    w->s->closed();
+            }
+
+            /*!
+             * \brief Records when a stream asked to be called.  Called with the socket busy.
+             *
+             * \param[in] w The socket.
+             * \param[in] due The time asked for.
+             */
+            void set_due(watched *w, const std::chrono::steady_clock::time_point &due) noexcept
+            {
+                if (due == w->due)
+                    return;
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                w->due = due;
+                if (due == std::chrono::steady_clock::time_point::max())
+                    _timed.erase(w->id);
+                else
+                    _timed.insert(w->id);
+            }
+
+            /*!
+             * \brief Reads a connected socket that is ready, and hands the bytes to its stream.
+             *
+             * \param[in] w The socket.
+             * \param[in] buffer The thread's buffer to read into.
+             */
+            void read(watched *w, std::vector<char> &buffer) noexcept
+            {
+                // Lock the socket
+                std::lock_guard<std::mutex> lock(w->busy);
+                if (w->done)
+                    return;
+                for (int i = 0; i < READS; ++i)
+                {
+                    auto got = recv(w->fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+                    if (got > 0)
+                    {
+                        set_due(w, w->s->received(buffer.data(), static_cast<size_t>(got)));
+                        // Read all there was
+                        if (static_cast<size_t>(got) < buffer.size())
+                            break;
+                        continue;
+                    }
+                    if (got < 0 && errno == EINTR)
+                        continue;
+                    if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                        break;
+                    // Closed or failed
+                    remove(w);
+                    return;
+                }
+                rearm(w);
+            }
+
+            /*!
+             * \brief Accepts a socket on a listening socket that is ready.
+             *
+             * \param[in] w The listening socket.
+             */
+            void accept(watched *w) noexcept
+            {
+                // Lock the socket
+                std::lock_guard<std::mutex> lock(w->busy);
+                if (w->done)
+                    return;
+                auto fd = ::accept4(w->fd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (fd >= 0)
+                    w->a->accepted(fd);
+                else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ECONNABORTED)
+                {
+                    // The listening socket has closed
+                    remove(w);
+                    return;
+                }
+                rearm(w);
+            }
+
+            /*!
+             * \brief Calls the streams whose time has been reached.
+             *
+             * \return The earliest time a stream has asked for.
+             */
+            std::chrono::steady_clock::time_point run_timers() noexcept
+            {
+                auto now = std::chrono::steady_clock::now();
+                auto next = std::chrono::steady_clock::time_point::max();
+                std::vector<std::shared_ptr<watched>> due;
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    for (auto id : _timed)
+                    {
+                        auto &w = _watched[id];
+                        if (w->due <= now)
+                            due.push_back(w);
+                        else if (w->due < next)
+                            next = w->due;
+                    }
+                }
+                for (auto &w : due)
+                {
+                    // Lock the socket.  Another thread may be reading it.
+                    std::lock_guard<std::mutex> lock(w->busy);
+                    if (w->done || w->due > now)
+                        continue;
+                    auto again = w->s->timer();
+                    set_due(w.get(), again);
+                    if (again < next)
+                        next = again;
+                }
+                return next;
+            }
+
+            /*!
+             * \brief Waits for sockets to be ready, or until the given time.
+             *
+             * \param[out] events The sockets ready.
+             * \param[in] until The time to stop waiting.
+             *
+             * \return The number of sockets ready.
+             */
+            int wait(epoll_event *events, const std::chrono::steady_clock::time_point &until) noexcept
+            {
+                if (until == std::chrono::steady_clock::time_point::max())
+                    return epoll_wait(_epoll, events, EVENTS, -1);
+                auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(until - std::chrono::steady_clock::now()).count();
+                if (left < 0)
+                    left = 0;
+#if defined(SYS_epoll_pwait2)
+                // Wait to the nanosecond where the kernel allows, as acks are held for microseconds
+                timespec timeout{static_cast<time_t>(left / 1000000000), static_cast<long>(left % 1000000000)};
+                auto ready = static_cast<int>(syscall(SYS_epoll_pwait2, _epoll, events, EVENTS, &timeout, nullptr, 0));
+                if (ready >= 0 || errno != ENOSYS)
+                    return ready;
+#endif
+                return epoll_wait(_epoll, events, EVENTS, static_cast<int>((left + 999999) / 1000000));
+            }
+
+            /*!
+             * \brief Serves the sockets until the engine stops.  Run by each I/O thread.
+             */
+            void run() noexcept
+            {
+                std::vector<char> buffer(RECEIVE_SIZE);
+                epoll_event events[EVENTS];
+                auto next = std::chrono::steady_clock::time_point::max();
+                while (!_stopping.load())
+                {
+                    auto ready = wait(events, next);
+                    for (int i = 0; i < ready; ++i)
+                    {
+                        if (events[i].data.u64 == 0)
+                            continue;
+                        auto w = find(events[i].data.u64);
+                        if (!w)
+                            continue;
+                        if (w->a)
+                            accept(w.get());
+                        else
+                            read(w.get(), buffer);
+                    }
+                    next = run_timers();
+                }
+            }
+
+        public:
+            /*!
+             * \brief Creates an engine and starts its I/O threads.
+             *
+             * \param[in] threads The number of I/O threads.
+             */
+            explicit epoll_engine(unsigned int threads = 1) noexcept(false)
+            : _epoll(epoll_create1(EPOLL_CLOEXEC)), _wake(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)), _oneshot(threads > 1), _stopping(false)
+            {
+                if (_epoll < 0 || _wake < 0)
+                {
+                    auto error = errno;
+                    if (_epoll >= 0)
+                        ::close(_epoll);
+                    if (_wake >= 0)
+                        ::close(_wake);
+                    throw std::runtime_error(std::string("Cannot create epoll engine: ") + std::strerror(error));
+                }
+                // The wake event has no socket, so is seen by every thread until the engine stops
+                epoll_event event;
+                std::memset(&event, 0, sizeof(event));
+                event.events = EPOLLIN;
+                event.data.u64 = 0;
+                epoll_ctl(_epoll, EPOLL_CTL_ADD, _wake, &event);
+                for (unsigned int i = 0; i < (threads > 0 ? threads : 1); ++i)
+                    _threads.emplace_back(&epoll_engine::run, this);
+            }
+
+            epoll_engine(const epoll_engine&) = delete;
+
+            epoll_engine& operator=(const epoll_engine&) = delete;
+
+            /*!
+             * \brief Stops the I/O threads.
+             */
+            ~epoll_engine() noexcept
+            {
+                _stopping.store(true);
+                uint64_t one = 1;
+                if (::write(_wake, &one, sizeof(one)) < 0) { }
+                for (auto &t : _threads)
+                    t.join();
+                ::close(_wake);
+                ::close(_epoll);
+            }
+
+            /*!
+             * \brief Starts receiving on a connected socket.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] s The stream to hand the bytes received.
+             */
+            void watch(int fd, std::shared_ptr<stream> s) noexcept(false) override final
+            {
+                auto w = std::make_shared<watched>();
+                w->fd = fd;
+                w->s = std::move(s);
+                add(w);
+            }
+
+            /*!
+             * \brief Starts accepting on a listening socket.  The socket is made non-blocking.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] a The acceptor to hand the sockets accepted.
+             */
+            void listen(int fd, std::shared_ptr<acceptor> a) noexcept(false) override final
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                auto w = std::make_shared<watched>();
+                w->fd = fd;
+                w->a = std::move(a);
+                add(w);
+            }
+
+            /*!
+             * \brief Stops accepting on a listening socket.
+             *
+             * \param[in] fd The socket.
+             */
+            void unlisten(int fd) noexcept override final
+            {
+                std::shared_ptr<watched> w;
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    for (auto &entry : _watched)
+                        if (entry.second->a && entry.second->fd == fd)
+                            w = entry.second;
+                }
+                if (!w)
+                    return;
+                // Lock the socket.  An I/O thread may be accepting on it.
+                std::lock_guard<std::mutex> lock(w->busy);
+                if (!w->done)
+                    remove(w.get());
+            }
+
+            /*!
+             * \brief Gets the name of the engine.
+             *
+             * \return The name.
+             */
+            const char* name() const noexcept override final { return "epoll"; }
+        };
+    }
+}
+
+#endif //CPP_CSP_EPOLL_ENGINE_H
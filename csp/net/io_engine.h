@@ -0,0 +1,140 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_IO_ENGINE_H
+#define CPP_CSP_IO_ENGINE_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class io_engine
+         * \brief Receives from the sockets of many links on a few I/O threads.
+         *
+         * A socket is watched with a stream, which the engine hands the bytes received.  A
+         * listening socket is watched with an acceptor, which the engine hands the sockets
+         * accepted.  Each is called by one I/O thread at a time, and must not block for long as
+         * other sockets wait meanwhile.  Shutting a connected socket down ends its watch, and
+         * unlisten ends the watch of a listening socket.  The engine then tells the stream or
+         * acceptor it has closed.
+         *
+         * A stream may ask to be called back at a time, such as when acks held back are due.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class io_engine
+        {
+        public:
+            /*! \class stream
+             * \brief Takes the bytes received on a socket.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class stream
+            {
+            public:
+                /*!
+                 * \brief Takes bytes received.
+                 *
+                 * \param[in] data The bytes.  Only valid during the call.
+                 * \param[in] n The number of bytes.
+                 *
+                 * \return The time to call timer, or the latest time point if none.
+                 */
+                virtual std::chrono::steady_clock::time_point received(const char *data, size_t n) noexcept = 0;
+
+                /*!
+                 * \brief Called once the time asked for has been reached.
+                 *
+                 * \return The time to call again, or the latest time point if none.
+                 */
+                virtual std::chrono::steady_clock::time_point timer() noexcept { return std::chrono::steady_clock::time_point::max(); }
+
+                /*!
+                 * \brief Tells the stream the socket has closed or failed.  No more calls follow.
+                 */
+                virtual void closed() noexcept = 0;
+
+                /*!
+                 * \brief Destroys the stream.
+                 */
+                virtual ~stream() noexcept { }
+            };
+
+            /*! \class acceptor
+             * \brief Takes the sockets accepted on a listening socket.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class acceptor
+            {
+            public:
+                /*!
+                 * \brief Takes a socket accepted.  The acceptor owns it.
+                 *
+                 * \param[in] fd The socket.
+                 */
+                virtual void accepted(int fd) noexcept = 0;
+
+                /*!
+                 * \brief Tells the acceptor the listening socket has closed.  No more calls follow.
+                 */
+                virtual void closed() noexcept = 0;
+
+                /*!
+                 * \brief Destroys the acceptor.
+                 */
+                virtual ~acceptor() noexcept { }
+            };
+
+            /*!
+             * \brief Starts receiving on a connected socket.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] s The stream to hand the bytes received.
+             */
+            virtual void watch(int fd, std::shared_ptr<stream> s) noexcept(false) = 0;
+
+            /*!
+             * \brief Starts accepting on a listening socket.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] a The acceptor to hand the sockets accepted.
+             */
+            virtual void listen(int fd, std::shared_ptr<acceptor> a) noexcept(false) = 0;
+
+            /*!
+             * \brief Stops accepting on a listening socket.  Shutting a Unix-domain listening socket
+             * down does not wake those waiting to accept on it, so this is needed.
+             *
+             * \param[in] fd The socket.
+             */
+            virtual void unlisten(int fd) noexcept = 0;
+
+            /*!
+             * \brief Gets the name of the engine.
+             *
+             * \return The name.
+             */
+            virtual const char* name() const noexcept = 0;
+
+            /*!
+             * \brief Stops the I/O threads.  Sockets still watched are no longer received from.
+             */
+            virtual ~io_engine() noexcept { }
+        };
+    }
+}
+
+#endif //CPP_CSP_IO_ENGINE_H
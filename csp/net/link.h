@@ -0,0 +1,706 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_LINK_H
+#define CPP_CSP_LINK_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../fiber_scheduler.h"
+#include "net_address.h"
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \enum frame_type
+         * \brief The kinds of frame sent over a link.
+         */
+        enum class frame_type : uint32_t
+        {
+            DATA = 1, //!< A value written to an input.  Source is the writing output.
+            ACK = 2, //!< The value has been read.  Sent to the writing output.
+            CANCEL = 3, //!< A timed write has given up.  Source is the writing output.
+            CANCELLED = 4, //!< The value was withdrawn before it was read.  Sent to the writing output.
+            POISON = 5, //!< The other end has been poisoned.  Source is the strength of the poison.
+            RESOLVE = 6, //!< Asks for the input with the name in the payload.  Source is the asking output.
+            RESOLVED = 7, //!< The input asked for.  Source is its channel number.
+            HELLO = 8 //!< Sent first by a dialling node.  The payload is the address it listens on.
+        };
+
+        /*! \struct frame_header
+         * \brief The header sent before each frame's payload.  Fields are in network byte order on the wire.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct frame_header
+        {
+            uint32_t type; //!< The frame_type.
+
+            uint32_t channel; //!< The channel number the frame is for on the receiving node.
+
+            uint32_t source; //!< The channel number that sent the frame, or a value given by the frame type.
+
+            uint32_t length; //!< The number of bytes of payload that follow.
+        };
+
+        /*! \struct batch_policy
+         * \brief How a link gathers frames into batches.
+         *
+         * Frames sent while a batch is being written go together in the next, so a busy link
+         * sends many frames per system call and an idle link sends each frame at once.  A delay
+         * lets a batch wait for more frames, and acks can be held back to go with the next frame
+         * the other way.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct batch_policy
+        {
+            size_t max_bytes; //!< A batch waiting for more frames is sent once it holds this many bytes.
+
+            std::chrono::microseconds max_delay; //!< The longest a batch waits for more frames.  Zero sends when idle.
+
+            std::chrono::microseconds ack_delay; //!< The longest an ack is held back for a frame going the other way.  Zero sends at once.
+
+            /*!
+             * \brief Creates a batch policy.
+             *
+             * \param[in] max_bytes A batch waiting for more frames is sent once it holds this many bytes.
+             * \param[in] max_delay The longest a batch waits for more frames.
+             * \param[in] ack_delay The longest an ack is held back for a frame going the other way.
+             */
+            batch_policy(size_t max_bytes = 64 * 1024, std::chrono::microseconds max_delay = std::chrono::microseconds(0), std::chrono::microseconds ack_delay = std::chrono::microseconds(0)) noexcept
+            : max_bytes(max_bytes), max_delay(max_delay), ack_delay(ack_delay)
+            {
+            }
+        };
+
+        // Forward declaration
+        class link;
+
+        /*! \class endpoint
+         * \brief Interface of a channel end that takes frames from links.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class endpoint
+        {
+        public:
+            /*!
+             * \brief Takes a frame sent to this end.  Called by an I/O thread of the node, so must not block.
+             *
+             * \param[in] from The link the frame came over.
+             * \param[in] header The frame header, in host byte order.
+             * \param[in,out] payload The payload of the frame.  May be moved from.
+             */
+            virtual void receive(const std::shared_ptr<link> &from, const frame_header &header, std::vector<char> &payload) noexcept = 0;
+
+            /*!
+             * \brief Tells the end that a link has failed or closed.
+             *
+             * \param[in] lost The link lost.
+             */
+            virtual void link_lost(const link *lost) noexcept = 0;
+
+            /*!
+             * \brief Destroys the end.
+             */
+            virtual ~endpoint() noexcept { }
+        };
+
+        /*! \class link
+         * \brief A connection between two nodes over a TCP or Unix-domain socket.  Every channel
+         * between the two nodes shares the link, each frame carrying the channel it is for.
+         *
+         * Any process may send on a link.  Frames are queued, and the first sender to find no
+         * batch being written writes the queue in one system call.  Frames queued meanwhile go in
+         * the next batch, so concurrent writers share system calls while a lone writer's frame is
+         * sent at once.  A frame with a payload is sent from where it lives, so its sender waits
+         * until its batch is written.
+         *
+         * Acks may be held back for up to the ack delay after a value arrives, so they go with the
+         * frame the reading node sends next.  The I/O engine sends any still held when the delay
+         * ends.
+         *
+         * The I/O engine must not block, so frames it sends are posted.  A posted frame is queued,
+         * and if no batch is being written the I/O thread writes the queue without lingering and
+         * without waiting for room in the socket.  A batch the socket has no room for is finished
+         * by the next sender, or by the I/O engine's timer.
+         *
+         * The I/O engine of the link manager receives on the socket and hands the link the bytes,
+         * which are gathered into frames.  A batch is received in few system calls.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class link
+        {
+        private:
+            int _fd; //!< The socket.
+
+            std::atomic<bool> _open; //!< Whether the link can still be used.
+
+            batch_policy _policy; //!< How frames are gathered into batches.
+
+            std::mutex _mut; //!< Lock used to control access to the queue.
+
+            condition _cond; //!< Wakes senders once their batch is written, and a batch waiting for frames.
+
+            std::vector<iovec> _queue; //!< Pieces of the queued frames.  Header pieces are set when written.
+
+            std::vector<frame_header> _headers; //!< Headers of the queued frames, in network byte order.
+
+            std::vector<size_t> _header_at; //!< Where each header goes in the queued pieces.
+
+            std::vector<iovec> _batch; //!< Pieces of the batch being written.
+
+            std::vector<frame_header> _batch_headers; //!< Headers of the batch being written.
+
+            std::vector<size_t> _batch_header_at; //!< Where each header goes in the batch being written.
+
+            size_t _batch_next = 0; //!< The first piece of the batch not yet written.
+
+            uint64_t _batch_last = 0; //!< Number of the last frame in the batch being written.
+
+            size_t _queued_bytes = 0; //!< Bytes queued.
+
+            uint64_t _queued = 0; //!< Number of frames queued since the link opened.
+
+            uint64_t _written = 0; //!< Number of frames written, or given up, since the link opened.
+
+            uint64_t _failed = std::numeric_limits<uint64_t>::max(); //!< Number of the first frame not written when the link failed.
+
+            bool _writing = false; //!< Whether a sender is writing batches.
+
+            bool _stalled = false; //!< Whether the batch being written was left part written by an I/O thread, for want of room in the socket.
+
+            std::chrono::steady_clock::time_point _first_queued; //!< When the oldest queued frame was queued.
+
+            std::chrono::steady_clock::time_point _hold_until; //!< Acks may be held back until this time.
+
+            frame_header _header_in; //!< Header of the frame being received, in network byte order until whole.
+
+            size_t _header_got = 0; //!< Bytes of the header received.
+
+            std::vector<char> _payload; //!< Payload of the frame being received.
+
+            size_t _payload_got = 0; //!< Bytes of the payload received.
+
+            /*!
+             * \brief Builds the socket address for an address.
+             *
+             * \param[in] address The address.
+             * \param[out] storage Where the socket address is put.
+             * \param[out] length The length of the socket address.
+             */
+            static void to_sockaddr(const net_address &address, sockaddr_storage &storage, socklen_t &length) noexcept(false)
+            {
+                std::memset(&storage, 0, sizeof(storage));
+                if (address.kind == transport::UNIX_DOMAIN)
+                {
+                    auto un = reinterpret_cast<sockaddr_un*>(&storage);
+                    if (address.host.size() >= sizeof(un->sun_path))
+                        throw std::invalid_argument("Unix-domain socket path too long: " + address.host);
+                    un->sun_family = AF_UNIX;
+                    std::memcpy(un->sun_path, address.host.c_str(), address.host.size() + 1);
+                    length = sizeof(sockaddr_un);
+                    return;
+                }
+                addrinfo hints;
+                std::memset(&hints, 0, sizeof(hints));
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                addrinfo *info = nullptr;
+                auto host = address.host.empty() ? "0.0.0.0" : address.host.c_str();
+                if (getaddrinfo(host, std::to_string(address.port).c_str(), &hints, &info) != 0 || !info)
+                    throw std::runtime_error("Cannot resolve host " + address.host);
+                std::memcpy(&storage, info->ai_addr, info->ai_addrlen);
+                length = info->ai_addrlen;
+                freeaddrinfo(info);
+            }
+
+            /*!
+             * \brief Queues a frame.  Called with _mut held.
+             *
+             * \param[in] type The kind of frame.
+             * \param[in] channel The channel number on the receiving node.
+             * \param[in] source The channel number sending, or a value given by the frame type.
+             * \param[in] parts The pieces of the payload.
+             * \param[in] n The number of pieces.
+             *
+             * \return The number of the frame.
+             */
+            uint64_t enqueue(frame_type type, uint32_t channel, uint32_t source, const iovec *parts, size_t n) noexcept
+            {
+                size_t length = 0;
+                for (size_t i = 0; i < n; ++i)
+                    length += parts[i].iov_len;
+                if (_queue.empty() && _policy.max_delay.count() > 0)
+                    _first_queued = std::chrono::steady_clock::now();
+                // The header piece is pointed at its header when the batch is written
+                _header_at.push_back(_queue.size());
+                _headers.push_back(frame_header{htonl(static_cast<uint32_t>(type)), htonl(channel), htonl(source), htonl(static_cast<uint32_t>(length))});
+                _queue.push_back(iovec{nullptr, sizeof(frame_header)});
+                for (size_t i = 0; i < n; ++i)
+                    if (parts[i].iov_len > 0)
+                        _queue.push_back(parts[i]);
+                _queued_bytes += sizeof(frame_header) + length;
+                // Wake a batch lingering for more frames once it is full
+                if (_queued_bytes >= _policy.max_bytes)
+                    _cond.notify_all();
+                return ++_queued;
+            }
+
+            /*!
+             * \brief Writes the pieces of the batch not yet written to the socket, in as few system
+             * calls as the socket allows.
+             *
+             * \param[in] wait Whether to wait for room in the socket.  If not, writes what fits.
+             *
+             * \return True unless the link has failed or closed.  Pieces may be left if not waiting.
+             */
+            bool write_batch(bool wait) noexcept
+            {
+                msghdr message;
+                std::memset(&message, 0, sizeof(message));
+                while (_batch_next < _batch.size())
+                {
+                    if (!_open.load())
+                        return false;
+                    // A call takes at most IOV_MAX pieces
+                    auto n = _batch.size() - _batch_next;
+                    message.msg_iov = &_batch[_batch_next];
+                    message.msg_iovlen = n < static_cast<size_t>(IOV_MAX) ? n : static_cast<size_t>(IOV_MAX);
+                    auto sent = sendmsg(_fd, &message, wait ? MSG_NOSIGNAL : MSG_NOSIGNAL | MSG_DONTWAIT);
+                    if (sent < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        return !wait && (errno == EAGAIN || errno == EWOULDBLOCK);
+                    }
+                    // Step past what was sent
+                    auto left = static_cast<size_t>(sent);
+                    while (_batch_next < _batch.size() && left >= _batch[_batch_next].iov_len)
+                    {
+                        left -= _batch[_batch_next].iov_len;
+                        ++_batch_next;
+                    }
+                    if (_batch_next < _batch.size())
+                    {
+                        _batch[_batch_next].iov_base = static_cast<char*>(_batch[_batch_next].iov_base) + left;
+                        _batch[_batch_next].iov_len -= left;
+                    }
+                }
+                return true;
+            }
+
+            /*!
+             * \brief Writes the queued frames in batches until none are left.  Called with _mut held
+             * by a sender that found no batch being written, or a stalled one.
+             *
+             * \param[in] lock The lock on _mut.  Released while each batch is written.
+             * \param[in] wait Whether the caller may wait.  If not, a batch does not linger for more
+             * frames, and writing stops, stalled, when the socket has no room.
+             */
+            void write_batches(std::unique_lock<std::mutex> &lock, bool wait) noexcept
+            {
+                _writing = true;
+                _stalled = false;
+                while (true)
+                {
+                    if (_batch_next == _batch.size())
+                    {
+                        if (_queue.empty())
+                            break;
+                        // Let more frames join the batch, up to the delay or size allowed
+                        if (wait && _policy.max_delay.count() > 0)
+                            _cond.wait_until(lock, _first_queued + _policy.max_delay, [this]() { return _queued_bytes >= _policy.max_bytes || !_open.load(); });
+                        // Take the queue as the batch.  The buffers swapped back are reused.
+                        std::swap(_queue, _batch);
+                        std::swap(_headers, _batch_headers);
+                        std::swap(_header_at, _batch_header_at);
+                        _queued_bytes = 0;
+                        _batch_next = 0;
+                        _batch_last = _queued;
+                        for (size_t i = 0; i < _batch_header_at.size(); ++i)
+                            _batch[_batch_header_at[i]].iov_base = &_batch_headers[i];
+                    }
+                    lock.unlock();
+                    auto written = write_batch(wait);
+                    lock.lock();
+                    if (written && _batch_next < _batch.size())
+                    {
+                        // The socket is full.  The next sender or the I/O engine's timer goes on.
+                        _stalled = true;
+                        return;
+                    }
+                    _batch.clear();
+                    _batch_headers.clear();
+                    _batch_header_at.clear();
+                    _batch_next = 0;
+                    if (!written)
+                    {
+                        // The frames of this batch and any after it are lost
+                        if (_failed > _written)
+                            _failed = _written + 1;
+                        if (_open.exchange(false))
+                            shutdown(_fd, SHUT_RDWR);
+                    }
+                    _written = _batch_last;
+                    _cond.notify_all();
+                }
+                _writing = false;
+            }
+
+            /*!
+             * \brief Gets when the I/O engine should call flush_held.  Called with _mut held.
+             *
+             * \return The time the acks held back are due, soon if a batch is stalled, or the
+             * latest time point if neither.
+             */
+            std::chrono::steady_clock::time_point due() const noexcept
+            {
+                if (_stalled)
+                    return std::chrono::steady_clock::now() + std::chrono::microseconds(100);
+                if (_policy.ack_delay.count() > 0)
+                    return _hold_until;
+                return std::chrono::steady_clock::time_point::max();
+            }
+
+        public:
+            /*!
+             * \brief Creates a link over a connected socket.  The link owns the socket.
+             *
+             * \param[in] fd The socket.
+             * \param[in] policy How frames are gathered into batches.
+             */
+            link(int fd, const batch_policy &policy = batch_policy()) noexcept
+            : _fd(fd), _open(true), _policy(policy)
+            {
+                int one = 1;
+                setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            }
+
+            link(const link&) = delete;
+
+            link& operator=(const link&) = delete;
+
+            /*!
+             * \brief Closes the socket.
+             */
+            ~link() noexcept
+            {
+                ::close(_fd);
+            }
+
+            /*!
+             * \brief Connects to a node.
+             *
+             * \param[in] address The address the node listens on.
+             *
+             * \return The connected socket.
+             */
+            static int dial(const net_address &address) noexcept(false)
+            {
+                sockaddr_storage storage;
+                socklen_t length;
+                to_sockaddr(address, storage, length);
+                auto fd = ::socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                if (fd < 0)
+                    throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+                if (connect(fd, reinterpret_cast<sockaddr*>(&storage), length) != 0)
+                {
+                    auto error = errno;
+                    ::close(fd);
+                    throw std::runtime_error("Cannot connect to " + address.to_string() + ": " + std::strerror(error));
+                }
+                return fd;
+            }
+
+            /*!
+             * \brief Listens for links from other nodes.
+             *
+             * \param[in,out] address The address to listen on.  A TCP port of zero is set to the port picked.
+             *
+             * \return The listening socket.
+             */
+            static int listen(net_address &address) noexcept(false)
+            {
+                sockaddr_storage storage;
+                socklen_t length;
+                to_sockaddr(address, storage, length);
+                auto fd = ::socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                if (fd < 0)
+                    throw std::runtime_error(std::string("Cannot create socket: ") + std::strerror(errno));
+                int one = 1;
+                if (address.kind == transport::UNIX_DOMAIN)
+                    unlink(address.host.c_str());
+                else
+                    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+                if (bind(fd, reinterpret_cast<sockaddr*>(&storage), length) != 0 || ::listen(fd, SOMAXCONN) != 0)
+                {
+                    auto error = errno;
+                    ::close(fd);
+                    throw std::runtime_error("Cannot listen on " + address.to_string() + ": " + std::strerror(error));
+                }
+                // Find the port picked
+                if (address.kind == transport::TCP && address.port == 0)
+                {
+                    length = sizeof(storage);
+                    getsockname(fd, reinterpret_cast<sockaddr*>(&storage), &length);
+                    if (storage.ss_family == AF_INET)
+                        address.port = ntohs(reinterpret_cast<sockaddr_in*>(&storage)->sin_port);
+                    else
+                        address.port = ntohs(reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port);
+                }
+                return fd;
+            }
+
+            /*!
+             * \brief Sends a frame whose payload is gathered from several pieces of memory.  The
+             * payload is not copied, so waits until the batch holding the frame is written.  A
+             * frame with no payload goes with a batch being written and does not wait.
+             *
+             * \param[in] type The kind of frame.
+             * \param[in] channel The channel number on the receiving node.
+             * \param[in] source The channel number sending, or a value given by the frame type.
+             * \param[in] parts The pieces of the payload, after a first entry left for the header.
+             * \param[in] n The number of entries, including the one for the header.
+             *
+             * \return True if sent, false if the link has failed or closed.
+             */
+            bool send(frame_type type, uint32_t channel, uint32_t source, iovec *parts, size_t n) noexcept
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (!_open.load())
+                    return false;
+                auto number = enqueue(type, channel, source, parts + 1, n - 1);
+                if (!_writing || _stalled)
+                    write_batches(lock, true);
+                else if (n > 1)
+                    _cond.wait(lock, [this, number]() { return _written >= number; });
+                return number < _failed;
+            }
+
+            /*!
+             * \brief Sends a frame.
+             *
+             * \param[in] type The kind of frame.
+             * \param[in] channel The channel number on the receiving node.
+             * \param[in] source The channel number sending, or a value given by the frame type.
+             * \param[in] data The payload.
+             * \param[in] n The number of bytes of payload.
+             *
+             * \return True if sent, false if the link has failed or closed.
+             */
+            bool send(frame_type type, uint32_t channel, uint32_t source, const void *data = nullptr, size_t n = 0) noexcept
+            {
+                iovec parts[2] = {{nullptr, 0}, {const_cast<void*>(data), n}};
+                return send(type, channel, source, parts, n > 0 ? 2 : 1);
+            }
+
+            /*!
+             * \brief Posts a frame with no payload.  Used by the I/O engine, so never waits.  The
+             * frame goes with a batch being written, or is written if the socket has room, and
+             * otherwise is left for the next sender or the I/O engine's timer.  Only call from the
+             * I/O thread's callbacks, as the engine arms that timer after them.
+             *
+             * \param[in] type The kind of frame.
+             * \param[in] channel The channel number on the receiving node.
+             * \param[in] source The channel number sending, or a value given by the frame type.
+             *
+             * \return True if queued or sent, false if the link has failed or closed.
+             */
+            bool post(frame_type type, uint32_t channel, uint32_t source) noexcept
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (!_open.load())
+                    return false;
+                auto number = enqueue(type, channel, source, nullptr, 0);
+                if (!_writing)
+                    write_batches(lock, false);
+                return number < _failed;
+            }
+
+            /*!
+             * \brief Sends an ack.  While the ack delay after a value arriving has not passed, the
+             * ack is held back to go with the next frame sent, or sent when the delay ends.
+             *
+             * \param[in] channel The channel number on the receiving node.
+             * \param[in] source The channel number sending.
+             *
+             * \return True if queued or sent, false if the link has failed or closed.
+             */
+            bool acknowledge(uint32_t channel, uint32_t source) noexcept
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (!_open.load())
+                    return false;
+                auto number = enqueue(frame_type::ACK, channel, source, nullptr, 0);
+                // Goes with the batch being written, or waits for the next frame while the hold lasts
+                if ((_writing && !_stalled) || (_policy.ack_delay.count() > 0 && std::chrono::steady_clock::now() < _hold_until))
+                    return true;
+                write_batches(lock, true);
+                return number < _failed;
+            }
+
+            /*!
+             * \brief Takes bytes received on the socket, and delivers each frame they complete.
+             * Called by one I/O thread at a time.
+             *
+             * \tparam F The type of the function delivering frames.
+             *
+             * \param[in] data The bytes.
+             * \param[in] n The number of bytes.
+             * \param[in] deliver Called with the header, in host byte order, and payload of each
+             * frame completed.  The payload may be moved from.
+             *
+             * \return The time to call flush_held, or the latest time point if none.
+             */
+            template<typename F>
+            std::chrono::steady_clock::time_point received(const char *data, size_t n, F deliver) noexcept
+            {
+                while (true)
+                {
+                    if (_header_got < sizeof(frame_header))
+                    {
+                        // Gather the header
+                        auto take = std::min(n, sizeof(frame_header) - _header_got);
+                        std::memcpy(reinterpret_cast<char*>(&_header_in) + _header_got, data, take);
+                        _header_got += take;
+                        data += take;
+                        n -= take;
+                        if (_header_got < sizeof(frame_header))
+                            break;
+                        _header_in.type = ntohl(_header_in.type);
+                        _header_in.channel = ntohl(_header_in.channel);
+                        _header_in.source = ntohl(_header_in.source);
+                        _header_in.length = ntohl(_header_in.length);
+                        if (_policy.ack_delay.count() > 0 && static_cast<frame_type>(_header_in.type) == frame_type::DATA)
+                        {
+                            // The ack for this value may wait for a frame going back
+                            std::lock_guard<std::mutex> lock(_mut);
+                            _hold_until = std::chrono::steady_clock::now() + _policy.ack_delay;
+                        }
+                        _payload.resize(_header_in.length);
+                        _payload_got = 0;
+                    }
+                    // Gather the payload
+                    auto take = std::min(n, _payload.size() - _payload_got);
+                    if (take > 0)
+                        std::memcpy(_payload.data() + _payload_got, data, take);
+                    _payload_got += take;
+                    data += take;
+                    n -= take;
+                    if (_payload_got < _payload.size())
+                        break;
+                    _header_got = 0;
+                    deliver(_header_in, _payload);
+                }
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                return due();
+            }
+
+            /*!
+             * \brief Goes on with a stalled batch, and sends the acks held back once their hold has
+             * ended.  Called by the I/O thread when the time returned by received is reached, so
+             * never waits.
+             *
+             * \return The time to call again, or the latest time point if none.
+             */
+            std::chrono::steady_clock::time_point flush_held() noexcept
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (!_stalled && std::chrono::steady_clock::now() < _hold_until)
+                    return _hold_until;
+                // Hold over.  Send the acks held unless a sender is about to.
+                if (_open.load() && (_stalled || (!_queue.empty() && !_writing)))
+                    write_batches(lock, false);
+                if (_stalled)
+                    return due();
+                return std::chrono::steady_clock::time_point::max();
+            }
+
+            /*!
+             * \brief Gets the socket of the link, for the I/O engine to receive on.
+             *
+             * \return The socket.
+             */
+            int socket() const noexcept { return _fd; }
+
+            /*!
+             * \brief Checks if the link can still be used.
+             *
+             * \return True if open, false if it has failed or closed.
+             */
+            bool open() const noexcept { return _open.load(); }
+
+            /*!
+             * \brief Closes the link.  Ends its watch by the I/O engine, which then tells the
+             * channels using the link, and wakes any batch waiting for frames.  A stalled batch,
+             * and the frames queued after it, are given up.
+             */
+            void close() noexcept
+            {
+                if (_open.exchange(false))
+                {
+                    shutdown(_fd, SHUT_RDWR);
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    if (_stalled)
+                    {
+                        if (_failed > _written)
+                            _failed = _written + 1;
+                        _written = _queued;
+                        _queue.clear();
+                        _headers.clear();
+                        _header_at.clear();
+                        _queued_bytes = 0;
+                        _batch.clear();
+                        _batch_headers.clear();
+                        _batch_header_at.clear();
+                        _batch_next = 0;
+                        _stalled = false;
+                        _writing = false;
+                    }
+                    _cond.notify_all();
+                }
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_LINK_H
@@ -0,0 +1,564 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_LINK_MANAGER_H
+#define CPP_CSP_LINK_MANAGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "epoll_engine.h"
+#include "io_engine.h"
+#include "link.h"
+#include "name_server.h"
+#include "net_address.h"
+#include "uring_engine.h"
+
+namespace csp
+{
+    namespace net
+    {
+        /*!
+         * \brief Creates an I/O engine for link managers.  Uses io_uring where the kernel supports
+         * it, and epoll otherwise.
+         *
+         * \param[in] threads The number of I/O threads.
+         *
+         * \return The engine.
+         */
+        inline std::shared_ptr<io_engine> make_io_engine(unsigned int threads = 1) noexcept(false)
+        {
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+            try
+            {
+                return std::make_shared<uring_engine>(threads);
+            }
+            catch (std::runtime_error&)
+            {
+                // The kernel lacks what the engine needs, or io_uring is disabled
+            }
+#endif
+            return std::make_shared<epoll_engine>(threads);
+        }
+
+        // Forward declarations
+        template<typename T, bool POISONABLE>
+        class net_chan;
+        template<typename T, bool POISONABLE>
+        class net_chan_in;
+        template<typename T, bool POISONABLE>
+        class net_chan_out;
+
+        /*! \class link_manager
+         * \brief A node of a networked process network.  Listens for links from other nodes, dials
+         * links to them, and routes the frames that arrive to the channel ends of the node.
+         *
+         * A node dialling another tells it the address it listens on, so the two share one link
+         * and every networked channel between them, either way, uses it.  Each channel end has a
+         * number unique to its node, and each frame carries the number of the end it is for.
+         * Inputs are given names in the node's name server, which outputs on other nodes look up
+         * over the link.
+         *
+         * An I/O engine receives the frames of every link and accepts links, so a node needs no
+         * thread per link and an alt over networked inputs is woken by the engine.  Nodes may
+         * share an engine.  The batch policy of the node sets how its links gather frames sent
+         * together.  The node is closed when the link manager is destroyed, which poisons the
+         * channel ends still using its links.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class link_manager
+        {
+            // Friend declarations
+            template<typename, bool>
+            friend class net_chan;
+            template<typename, bool>
+            friend class net_chan_in;
+            template<typename, bool>
+            friend class net_chan_out;
+        protected:
+            /*! \class link_manager_internal
+             * \brief Internal representation of a link manager.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class link_manager_internal
+            {
+            private:
+                net_address _address; //!< The address the node listens on.
+
+                batch_policy _policy; //!< How the links of the node gather frames into batches.
+
+                std::shared_ptr<io_engine> _engine; //!< Receives on the links and accepts links.
+
+                int _listener; //!< The listening socket.
+
+                std::atomic<uint32_t> _next; //!< Number of the next channel end.  Zero is never used.
+
+                std::mutex _mut; //!< Lock used to control access to the ends and links.
+
+                std::unordered_map<uint32_t, std::weak_ptr<endpoint>> _endpoints; //!< The channel ends of the node by number.
+
+                std::vector<std::pair<net_address, std::shared_ptr<link>>> _dialled; //!< Links to other nodes, by the address the other node listens on.
+
+                std::vector<std::shared_ptr<link>> _links; //!< Every link of the node.
+
+                unsigned int _watched = 0; //!< Number of links and listening sockets the engine has not yet closed.
+
+                std::condition_variable _all_closed; //!< Wakes the process closing the node once the engine has closed them all.
+
+                bool _closed = false; //!< Whether the node has been closed.
+
+                /*! \class link_stream
+                 * \brief Hands the bytes the engine receives on a link to the link, and routes the
+                 * frames they complete.
+                 *
+                 * \author Kevin Chalmers
+                 *
+                 * \date 16/10/2026
+                 */
+                class link_stream : public io_engine::stream
+                {
+                private:
+                    link_manager_internal *_node; //!< The node of the link.
+
+                    std::shared_ptr<link> _link; //!< The link.
+
+                public:
+                    /*!
+                     * \brief Creates a stream for a link.
+                     *
+                     * \param[in] node The node of the link.
+                     * \param[in] l The link.
+                     */
+                    link_stream(link_manager_internal *node, const std::shared_ptr<link> &l) noexcept
+                    : _node(node), _link(l)
+                    {
+                    }
+
+                    /*!
+                     * \brief Routes the frames the bytes complete.
+                     *
+                     * \param[in] data The bytes.
+                     * \param[in] n The number of bytes.
+                     *
+                     * \return The time the acks held back are due.
+                     */
+                    std::chrono::steady_clock::time_point received(const char *data, size_t n) noexcept override final
+                    {
+                        return _link->received(data, n, [this](const frame_header &header, std::vector<char> &payload)
+                        {
+                            _node->route(_link, header, payload);
+                        });
+                    }
+
+                    /*!
+                     * \brief Sends the acks held back.
+                     *
+                     * \return The time the acks held back are next due.
+                     */
+                    std::chrono::steady_clock::time_point timer() noexcept override final { return _link->flush_held(); }
+
+                    /*!
+                     * \brief Tells the node the link has been lost.
+                     */
+                    void closed() noexcept override final
+                    {
+                        _link->close();
+                        _node->lost(_link);
+                        _node->unwatched();
+                    }
+                };
+
+                /*! \class link_acceptor
+                 * \brief Starts the links the engine accepts.
+                 *
+                 * \author Kevin Chalmers
+                 *
+                 * \date 16/10/2026
+                 */
+                class link_acceptor : public io_engine::acceptor
+                {
+                private:
+                    link_manager_internal *_node; //!< The node.
+
+                public:
+                    /*!
+                     * \brief Creates an acceptor for a node.
+                     *
+                     * \param[in] node The node.
+                     */
+                    explicit link_acceptor(link_manager_internal *node) noexcept
+                    : _node(node)
+                    {
+                    }
+
+                    /*!
+                     * \brief Starts a link accepted.
+                     *
+                     * \param[in] fd The socket.
+                     */
+                    void accepted(int fd) noexcept override final
+                    {
+                        _node->start(std::make_shared<link>(fd, _node->_policy));
+                    }
+
+                    /*!
+                     * \brief Tells the node its listening socket has closed.
+                     */
+                    void closed() noexcept override final { _node->unwatched(); }
+                };
+
+                /*!
+                 * \brief Has the engine receive on a link.
+                 *
+                 * \param[in] l The link.
+                 *
+                 * \return True if started, false if the node has been closed.
+                 */
+                bool start(const std::shared_ptr<link> &l) noexcept
+                {
+                    {
+                        // Lock the mutex
+                        std::lock_guard<std::mutex> lock(_mut);
+                        if (_closed)
+                            return false;
+                        _links.push_back(l);
+                        ++_watched;
+                    }
+                    try
+                    {
+                        _engine->watch(l->socket(), std::make_shared<link_stream>(this, l));
+                        return true;
+                    }
+                    catch (std::exception&)
+                    {
+                        l->close();
+                        lost(l);
+                        unwatched();
+                        return false;
+                    }
+                }
+
+                /*!
+                 * \brief Routes a frame received on a link to its channel end.  Called by an I/O thread.
+                 *
+                 * \param[in] l The link.
+                 * \param[in] header The frame header.
+                 * \param[in,out] payload The payload of the frame.
+                 */
+                void route(const std::shared_ptr<link> &l, const frame_header &header, std::vector<char> &payload) noexcept
+                {
+                    if (static_cast<frame_type>(header.type) == frame_type::RESOLVE)
+                    {
+                        names.resolve(std::string(payload.begin(), payload.end()), l, header.source);
+                        return;
+                    }
+                    if (static_cast<frame_type>(header.type) == frame_type::HELLO)
+                    {
+                        hello(l, std::string(payload.begin(), payload.end()));
+                        return;
+                    }
+                    auto e = find(header.channel);
+                    if (e)
+                        e->receive(l, header, payload);
+                    else if (static_cast<frame_type>(header.type) == frame_type::DATA)
+                        // No such input.  Poison the writer.
+                        l->post(frame_type::POISON, header.source, std::numeric_limits<unsigned int>::max());
+                }
+
+                /*!
+                 * \brief Records that the engine has closed a link or the listening socket.
+                 */
+                void unwatched() noexcept
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    if (--_watched == 0)
+                        _all_closed.notify_all();
+                }
+
+                /*!
+                 * \brief Records the address a node that dialled a link listens on, so channels to
+                 * that node share the link.  Traffic both ways then goes over one link, and acks can
+                 * go with values sent back.
+                 *
+                 * \param[in] l The link.
+                 * \param[in] text The address the dialling node listens on.
+                 */
+                void hello(const std::shared_ptr<link> &l, const std::string &text) noexcept
+                {
+                    net_address address;
+                    try
+                    {
+                        address = net_address::parse(text);
+                    }
+                    catch (std::exception&)
+                    {
+                        return;
+                    }
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    for (auto &d : _dialled)
+                        if (d.first == address && d.second->open())
+                            return;
+                    _dialled.emplace_back(address, l);
+                }
+
+                /*!
+                 * \brief Tells the channel ends and name server that a link has been lost.
+                 *
+                 * \param[in] l The link.
+                 */
+                void lost(const std::shared_ptr<link> &l) noexcept
+                {
+                    std::vector<std::shared_ptr<endpoint>> ends;
+                    {
+                        // Lock the mutex
+                        std::lock_guard<std::mutex> lock(_mut);
+                        for (size_t i = 0; i < _dialled.size(); ++i)
+                        {
+                            if (_dialled[i].second == l)
+                            {
+                                _dialled.erase(_dialled.begin() + i);
+                                break;
+                            }
+                        }
+                        for (size_t i = 0; i < _links.size(); ++i)
+                        {
+                            if (_links[i] == l)
+                            {
+                                _links.erase(_links.begin() + i);
+                                break;
+                            }
+                        }
+                        for (auto &entry : _endpoints)
+                        {
+                            auto e = entry.second.lock();
+                            if (e)
+                                ends.push_back(e);
+                        }
+                    }
+                    for (auto &e : ends)
+                        e->link_lost(l.get());
+                    names.link_lost(l.get());
+                }
+
+            public:
+                name_server names; //!< The names of the inputs of the node.
+
+                /*!
+                 * \brief Creates a node listening on the given address.
+                 *
+                 * \param[in] address The address to listen on.
+                 * \param[in] policy How the links of the node gather frames into batches.
+                 * \param[in] engine Receives on the links and accepts links.  Null creates one for the node.
+                 */
+                link_manager_internal(const net_address &address, const batch_policy &policy, const std::shared_ptr<io_engine> &engine) noexcept(false)
+                : _address(address), _policy(policy), _engine(engine ? engine : make_io_engine()), _listener(link::listen(_address)), _next(1)
+                {
+                    _watched = 1;
+                    try
+                    {
+                        _engine->listen(_listener, std::make_shared<link_acceptor>(this));
+                    }
+                    catch (std::exception&)
+                    {
+                        ::close(_listener);
+                        throw;
+                    }
+                }
+
+                link_manager_internal(const link_manager_internal&) = delete;
+
+                link_manager_internal& operator=(const link_manager_internal&) = delete;
+
+                /*!
+                 * \brief Closes the node.
+                 */
+                ~link_manager_internal() noexcept
+                {
+                    close();
+                }
+
+                /*!
+                 * \brief Gets the address the node listens on.
+                 *
+                 * \return The address.
+                 */
+                const net_address& address() const noexcept { return _address; }
+
+                /*!
+                 * \brief Adds a channel end to the node.
+                 *
+                 * \param[in] e The channel end.
+                 *
+                 * \return The number of the end.
+                 */
+                uint32_t add(const std::shared_ptr<endpoint> &e) noexcept
+                {
+                    auto id = _next.fetch_add(1);
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _endpoints[id] = e;
+                    return id;
+                }
+
+                /*!
+                 * \brief Removes a channel end from the node.
+                 *
+                 * \param[in] id The number of the end.
+                 */
+                void remove(uint32_t id) noexcept
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    _endpoints.erase(id);
+                }
+
+                /*!
+                 * \brief Finds a channel end.
+                 *
+                 * \param[in] id The number of the end.
+                 *
+                 * \return The end, or null if there is no such end.
+                 */
+                std::shared_ptr<endpoint> find(uint32_t id) noexcept
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    auto found = _endpoints.find(id);
+                    return found == _endpoints.end() ? nullptr : found->second.lock();
+                }
+
+                /*!
+                 * \brief Gets the link to a node, dialling it if there is none.
+                 *
+                 * \param[in] address The address the node listens on.
+                 *
+                 * \return The link.
+                 */
+                std::shared_ptr<link> link_to(const net_address &address) noexcept(false)
+                {
+                    {
+                        // Lock the mutex
+                        std::lock_guard<std::mutex> lock(_mut);
+                        if (_closed)
+                            throw std::logic_error("Node closed");
+                        for (auto &d : _dialled)
+                            if (d.first == address && d.second->open())
+                                return d.second;
+                    }
+                    auto l = std::make_shared<link>(link::dial(address), _policy);
+                    if (!start(l))
+                        throw std::logic_error("Node closed");
+                    // Tell the node where this one listens, so it links back over this link
+                    auto hello = _address.to_string();
+                    l->send(frame_type::HELLO, 0, 0, hello.data(), hello.size());
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(_mut);
+                    for (auto &d : _dialled)
+                    {
+                        // Another process dialled at the same time.  Both links work, so keep the first.
+                        if (d.first == address && d.second->open())
+                            return d.second;
+                    }
+                    _dialled.emplace_back(address, l);
+                    return l;
+                }
+
+                /*!
+                 * \brief Closes the node.  Stops accepting links, closes the links, and waits for
+                 * the engine to finish with them.
+                 */
+                void close() noexcept
+                {
+                    {
+                        // Lock the mutex
+                        std::lock_guard<std::mutex> lock(_mut);
+                        if (_closed)
+                            return;
+                        _closed = true;
+                        for (auto &l : _links)
+                            l->close();
+                    }
+                    // The acceptor may be told it has closed on this thread
+                    _engine->unlisten(_listener);
+                    {
+                        // Lock the mutex
+                        std::unique_lock<std::mutex> lock(_mut);
+                        _all_closed.wait(lock, [this]() { return _watched == 0; });
+                    }
+                    ::close(_listener);
+                    if (_address.kind == transport::UNIX_DOMAIN)
+                        unlink(_address.host.c_str());
+                }
+            };
+
+            std::shared_ptr<link_manager_internal> _internal = nullptr; //!< Pointer to the internal representation.
+
+        public:
+            /*!
+             * \brief Creates a node listening on the given address.
+             *
+             * \param[in] address The address to listen on.  A TCP port of zero picks a free port.
+             * \param[in] policy How the links of the node gather frames into batches.  By default
+             * frames sent together share system calls, and an idle link sends at once.
+             * \param[in] engine Receives on the links and accepts links, and may be shared by nodes.
+             * By default the node has its own, with one I/O thread.
+             */
+            link_manager(const net_address &address, const batch_policy &policy = batch_policy(), const std::shared_ptr<io_engine> &engine = nullptr) noexcept(false)
+            : _internal(std::make_shared<link_manager_internal>(address, policy, engine))
+            {
+            }
+
+            link_manager(const link_manager&) = delete;
+
+            link_manager& operator=(const link_manager&) = delete;
+
+            /*!
+             * \brief Closes the node.
+             */
+            ~link_manager() noexcept
+            {
+                _internal->close();
+            }
+
+            /*!
+             * \brief Gets the address the node listens on.
+             *
+             * \return The address.
+             */
+            net_address get_address() const noexcept { return _internal->address(); }
+
+            /*!
+             * \brief Looks up the channel number of an input of this node.
+             *
+             * \param[in] name The name of the input.
+             *
+             * \return The channel number, or zero if there is no input with the name.
+             */
+            uint32_t lookup(const std::string &name) const noexcept { return _internal->names.lookup(name); }
+
+            /*!
+             * \brief Closes the node.  The channel ends of the node are poisoned.
+             */
+            void close() const noexcept { _internal->close(); }
+        };
+    }
+}
+
+#endif //CPP_CSP_LINK_MANAGER_H
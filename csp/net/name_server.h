@@ -0,0 +1,143 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_NAME_SERVER_H
+#define CPP_CSP_NAME_SERVER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "link.h"
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class name_server
+         * \brief Maps names to the networked channel inputs of a node.
+         *
+         * Each node has its own name server.  An output connecting to a node sends it the name
+         * of the input wanted over the link, and the node's name server answers with the input's
+         * channel number.  A name asked for before it is defined is answered once it is, so the
+         * nodes of a network may start in any order.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class name_server
+        {
+        private:
+            mutable std::mutex _mut; //!< Lock used to control access to the names.
+
+            std::map<std::string, uint32_t> _names; //!< Channel number of each defined name.
+
+            std::map<std::string, std::vector<std::pair<std::shared_ptr<link>, uint32_t>>> _waiting; //!< Links and outputs waiting on names not yet defined.
+
+        public:
+            /*!
+             * \brief Defines a name for an input, and answers any output waiting on it.
+             *
+             * \param[in] name The name.
+             * \param[in] channel The channel number of the input.
+             */
+            void define(const std::string &name, uint32_t channel) noexcept(false)
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                if (!_names.insert(std::make_pair(name, channel)).second)
+                    throw std::logic_error("Channel name already defined: " + name);
+                auto found = _waiting.find(name);
+                if (found == _waiting.end())
+                    return;
+                auto waiting = std::move(found->second);
+                _waiting.erase(found);
+                lock.unlock();
+                for (auto &w : waiting)
+                    w.first->send(frame_type::RESOLVED, w.second, channel);
+            }
+
+            /*!
+             * \brief Removes a name.
+             *
+             * \param[in] name The name.
+             */
+            void remove(const std::string &name) noexcept
+            {
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                _names.erase(name);
+            }
+
+            /*!
+             * \brief Looks up a name.
+             *
+             * \param[in] name The name.
+             *
+             * \return The channel number of the input, or zero if the name is not defined.
+             */
+            uint32_t lookup(const std::string &name) const noexcept
+            {
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                auto found = _names.find(name);
+                return found == _names.end() ? 0 : found->second;
+            }
+
+            /*!
+             * \brief Answers an output asking for a name over a link, now or once the name is defined.
+             *
+             * \param[in] name The name.
+             * \param[in] from The link the request came over.
+             * \param[in] output The channel number of the asking output.
+             */
+            void resolve(const std::string &name, const std::shared_ptr<link> &from, uint32_t output) noexcept
+            {
+                // Lock the mutex
+                std::unique_lock<std::mutex> lock(_mut);
+                auto found = _names.find(name);
+                if (found == _names.end())
+                {
+                    _waiting[name].emplace_back(from, output);
+                    return;
+                }
+                auto channel = found->second;
+                lock.unlock();
+                from->post(frame_type::RESOLVED, output, channel);
+            }
+
+            /*!
+             * \brief Drops the requests waiting over a link that has been lost.
+             *
+             * \param[in] lost The link lost.
+             */
+            void link_lost(const link *lost) noexcept
+            {
+                // Lock the mutex
+                std::lock_guard<std::mutex> lock(_mut);
+                for (auto &w : _waiting)
+                {
+                    auto &list = w.second;
+                    for (size_t i = 0; i < list.size(); )
+                    {
+                        if (list[i].first.get() == lost)
+                        {
+                            list[i] = std::move(list.back());
+                            list.pop_back();
+                        }
+                        else
+                            ++i;
+                    }
+                }
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_NAME_SERVER_H
@@ -0,0 +1,111 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_NET_ADDRESS_H
+#define CPP_CSP_NET_ADDRESS_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \enum transport
+         * \brief The kind of socket a node listens on and links are made over.
+         */
+        enum class transport
+        {
+            TCP, //!< A TCP socket.  Links nodes on different hosts.
+            UNIX_DOMAIN //!< A Unix-domain socket.  Links nodes on the same host without the TCP stack.
+        };
+
+        /*! \struct net_address
+         * \brief The address a node listens on.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct net_address
+        {
+            transport kind = transport::TCP; //!< The kind of socket.
+
+            std::string host; //!< The host name or IP address for TCP, or the socket path for a Unix-domain socket.
+
+            uint16_t port = 0; //!< The TCP port.  Zero when listening picks a free port.
+
+            /*!
+             * \brief Creates a TCP address.
+             *
+             * \param[in] host The host name or IP address.
+             * \param[in] port The port.  Zero when listening picks a free port.
+             *
+             * \return The address.
+             */
+            static net_address tcp(const std::string &host, uint16_t port) noexcept
+            {
+                net_address address;
+                address.kind = transport::TCP;
+                address.host = host;
+                address.port = port;
+                return address;
+            }
+
+            /*!
+             * \brief Creates a Unix-domain socket address.
+             *
+             * \param[in] path The path of the socket.
+             *
+             * \return The address.
+             */
+            static net_address unix_domain(const std::string &path) noexcept
+            {
+                net_address address;
+                address.kind = transport::UNIX_DOMAIN;
+                address.host = path;
+                return address;
+            }
+
+            /*!
+             * \brief Gets the address as a string, such as tcp://127.0.0.1:7000 or unix:///tmp/node.
+             *
+             * \return The address as a string.
+             */
+            std::string to_string() const noexcept
+            {
+                if (kind == transport::UNIX_DOMAIN)
+                    return "unix://" + host;
+                return "tcp://" + host + ":" + std::to_string(port);
+            }
+
+            /*!
+             * \brief Reads an address from a string made by to_string.
+             *
+             * \param[in] text The address as a string.
+             *
+             * \return The address.
+             */
+            static net_address parse(const std::string &text) noexcept(false)
+            {
+                if (text.compare(0, 7, "unix://") == 0)
+                    return unix_domain(text.substr(7));
+                auto colon = text.rfind(':');
+                if (text.compare(0, 6, "tcp://") != 0 || colon == std::string::npos || colon < 6)
+                    throw std::invalid_argument("Not a node address: " + text);
+                return tcp(text.substr(6, colon - 6), static_cast<uint16_t>(std::stoi(text.substr(colon + 1))));
+            }
+
+            bool operator==(const net_address &other) const noexcept
+            {
+                return kind == other.kind && host == other.host && port == other.port;
+            }
+
+            bool operator!=(const net_address &other) const noexcept { return !(*this == other); }
+        };
+    }
+}
+
+#endif //CPP_CSP_NET_ADDRESS_H
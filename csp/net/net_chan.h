@@ -5,29 +5,987 @@
 #ifndef CPP_CSP_NET_CHAN_H
 #define CPP_CSP_NET_CHAN_H
 
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include "../chan.h"
+#include "codec.h"
+#include "link.h"
+#include "link_manager.h"
+#include "name_server.h"
+#include "net_address.h"
 
 namespace csp
 {
     namespace net
     {
-        struct net_address
-        {
-        };
-
+        /*! \class networked
+         * \brief Interface of an object that lives at a node of a networked process network.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 07/08/2016
+         */
         class networked
         {
         public:
+            /*!
+             * \brief Gets the address of the node the object lives at.
+             *
+             * \return The address of the node.
+             */
             virtual net_address get_address() const noexcept = 0;
+
+            /*!
+             * \brief Destroys the object.
+             */
+            virtual ~networked() noexcept { }
         };
 
+        /*! \class net_chan
+         * \brief A channel between processes on different nodes.
+         *
+         * The input end lives on one node and is named in its name server.  Output ends on any
+         * node connect to it by the address of the node and the name, so many writers may share
+         * one input.  Each write is sent over the link between the nodes and the writer waits
+         * for the reader to take it, so the channel keeps the rendezvous of a local channel.  The
+         * node of the input queues the writes that arrive until the reader takes them, in the
+         * order they arrive, and an alt may select the input as a guard.
+         *
+         * Values are sent with the codec for their type, straight from the memory of the value.
+         * A lost link poisons the outputs using it.
+         *
+         * \tparam T The type the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether the channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 07/08/2016
+         */
         template<typename T, bool POISONABLE = false>
-        class net_chan : public chan<T, POISONABLE>, public networked {
+        class net_chan : public chan<T, POISONABLE>
+        {
+            // Friend declarations
+            friend class net_chan_in<T, POISONABLE>;
+            friend class net_chan_out<T, POISONABLE>;
         protected:
-            class net_chan_in_internal : public chan<T, POISONABLE>::chan_internal
+            using manager = link_manager::link_manager_internal;
+
+            /*! \class net_chan_internal
+             * \brief State shared by both ends of a networked channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class net_chan_internal : public chan<T, POISONABLE>::chan_internal, public endpoint
+            {
+            protected:
+                std::shared_ptr<manager> _manager; //!< The node the end lives at.
+
+                uint32_t _id = 0; //!< The number of the end on its node.
+
+                mutable std::mutex _mut; //!< Lock used to control access to the end.
+
+                condition _cond; //!< Condition variable used to wait for frames.
+
+                wait_policy _policy; //!< How processes wait for frames.
+
+                unsigned int _strength = 0; //!< Strength of poison on the end.
+
+                /*!
+                 * \brief Gets the error thrown by an operation made on the wrong end of the channel.
+                 *
+                 * \return The error.
+                 */
+                static std::logic_error wrong_end() noexcept
+                {
+                    return std::logic_error("Operation not supported on this end of a networked channel");
+                }
+
+            public:
+                /*!
+                 * \brief Creates a channel end.
+                 *
+                 * \param[in] node The node the end lives at.
+                 */
+                net_chan_internal(const std::shared_ptr<manager> &node) noexcept
+                : _manager(node)
+                {
+                }
+
+                /*!
+                 * \brief Sets the number of the end on its node.
+                 *
+                 * \param[in] id The number.
+                 */
+                void set_id(uint32_t id) noexcept { _id = id; }
+
+                /*!
+                 * \brief Sets how processes wait on the channel.
+                 *
+                 * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+                 */
+                void set_wait_strategy(wait_strategy strategy) noexcept override final { _policy.set(strategy); }
+
+                /*!
+                 * \brief Removes the end from its node.
+                 */
+                virtual ~net_chan_internal() noexcept
+                {
+                    _manager->remove(_id);
+                }
+            };
+
+            /*! \class net_chan_in_internal
+             * \brief Internal representation of the input end of a networked channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class net_chan_in_internal : public net_chan_internal
             {
-                virtual net_address get_address() const noexcept = 0;
+            private:
+                /*! \struct message
+                 * \brief A value written to the input and not yet read.
+                 */
+                struct message
+                {
+                    std::shared_ptr<link> from; //!< The link the value came over.
+
+                    uint32_t source; //!< The number of the writing output on its node.
+
+                    std::vector<char> data; //!< The bytes of the value.
+                };
+
+                using net_chan_internal::_manager;
+                using net_chan_internal::_id;
+                using net_chan_internal::_mut;
+                using net_chan_internal::_cond;
+                using net_chan_internal::_policy;
+                using net_chan_internal::_strength;
+
+                std::string _name; //!< The name of the input.  Empty until defined.
+
+                std::deque<message> _queue; //!< Values written, in the order they arrived.
+
+                bool _reading = false; //!< Flag used to determine when the channel is in an extended read state.
+
+                alt _alt; //!< Alt used when channel is in a selection operation.
+
+                bool _alting = false; //!< Flag used to indicate whether the channel is being used in a selection operation.
+
+                std::vector<std::vector<char>> _spare; //!< Buffers of values read, given back to the link to receive into.
+
+                static constexpr size_t SPARE_BUFFERS = 4; //!< Most buffers kept for reuse.
+
+                /*!
+                 * \brief Gets the value of a message.
+                 *
+                 * \param[in] m The message.
+                 *
+                 * \return The value.
+                 */
+                static T decode(const message &m) noexcept(false)
+                {
+                    decoder in(m.data.data(), m.data.size());
+                    auto value = codec<T>::decode(in);
+                    if (in.left() > 0)
+                        throw std::runtime_error("Networked channel value is longer than its codec expects");
+                    return value;
+                }
+
+                /*!
+                 * \brief Takes the first value written, and tells its writer.  The channel must be locked.
+                 *
+                 * \return The value.
+                 */
+                T take() noexcept(false)
+                {
+                    auto m = std::move(_queue.front());
+                    _queue.pop_front();
+                    m.from->acknowledge(m.source, _id);
+                    auto value = decode(m);
+                    // Keep the buffer to receive a later value into
+                    if (_spare.size() < SPARE_BUFFERS)
+                        _spare.push_back(std::move(m.data));
+                    return value;
+                }
+
+                /*!
+                 * \brief Checks if a value is waiting or the channel is poisoned.  The channel must be locked.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool ready() const noexcept { return !_queue.empty() || _strength > 0; }
+
+            protected:
+                void write(T) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool write_async(async_op&, T&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool try_write(T&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool write_until(T&, const std::chrono::steady_clock::time_point&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                /*!
+                 * \brief Performs a read operation on the channel.
+                 *
+                 * \return The value read from the channel.
+                 */
+                T read() noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Wait for a writer
+                    _policy.wait(lock, _cond, [this]() { return ready(); });
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    return take();
+                }
+
+                /*!
+                 * \brief Extended read operation.  The writer waits until the read ends.
+                 *
+                 * \return The value read from the channel.
+                 */
+                T start_read() noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Check if channel is already reading
+                    if (_reading)
+                        throw std::logic_error("Channel already in extended read");
+                    // Wait for a writer
+                    _policy.wait(lock, _cond, [this]() { return ready(); });
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    _reading = true;
+                    return decode(_queue.front());
+                }
+
+                /*!
+                 * \brief Extended read completion operation.
+                 */
+                void end_read() noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Check if channel is reading
+                    if (!_reading)
+                        throw std::logic_error("Channel not in extended read");
+                    _reading = false;
+                    // Release the writer, unless poison has already done so
+                    if (!_queue.empty())
+                        take();
+                }
+
+                /*!
+                 * \brief Performs the next step of a read operation.
+                 *
+                 * \param[in] op The state of the operation.
+                 * \param[out] value Set to the value read once the read has completed.
+                 *
+                 * \return True if the read has completed, false if the operation is waiting.
+                 */
+                bool read_async(async_op &op, T &value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Wait for a writer
+                    if (!ready())
+                    {
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    value = take();
+                    return true;
+                }
+
+                /*!
+                 * \brief Reads a value only if one has already arrived.
+                 *
+                 * \param[out] value Set to the value read if the read succeeds.
+                 *
+                 * \return True if a value was read, false otherwise.
+                 */
+                bool try_read(T &value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    if (_queue.empty())
+                        return false;
+                    value = take();
+                    return true;
+                }
+
+                /*!
+                 * \brief Reads a value, giving up if none has arrived by the given time.
+                 *
+                 * \param[out] value Set to the value read if the read succeeds.
+                 * \param[in] time The time to give up the read.
+                 *
+                 * \return True if a value was read, false if the time was reached first.
+                 */
+                bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Wait for a writer
+                    if (!_cond.wait_until(lock, time, [this]() { return ready(); }))
+                        return false;
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    value = take();
+                    return true;
+                }
+
+                /*!
+                 * \brief Enable the channel with an alt
+                 *
+                 * \param[in] a The alt that is being used in the selection.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool enable(const alt &a) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    if (ready())
+                        return true;
+                    // Register alt to be scheduled when a value arrives
+                    _alt = a;
+                    _alting = true;
+                    return false;
+                }
+
+                /*!
+                 * \brief Disables the channel with an alt.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool disable() noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    _alting = false;
+                    return ready();
+                }
+
+                /*!
+                 * \brief Checks if a message is pending on the channel.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool pending() const noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    return ready();
+                }
+
+                /*!
+                 * \brief Poisons the reading end of the channel.  Writers waiting, and any that write
+                 * later, are poisoned.
+                 *
+                 * \param[in] strength The strength of the poison to apply to the channel.
+                 */
+                void reader_poison(unsigned int strength) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    _strength = strength;
+                    auto waiting = std::move(_queue);
+                    _queue.clear();
+                    _cond.notify_all();
+                    lock.unlock();
+                    // Not on the I/O thread, so send rather than post.  A stalled post would wait
+                    // for a timer the I/O engine has not armed.
+                    for (auto &m : waiting)
+                        m.from->send(frame_type::POISON, m.source, strength);
+                }
+
+                /*!
+                 * \brief Poisoning the writing end is done by the outputs.
+                 */
+                void writer_poison(unsigned int) noexcept override final { }
+
+            public:
+                /*!
+                 * \brief Creates the input end of a networked channel.
+                 *
+                 * \param[in] node The node the input lives at.
+                 */
+                net_chan_in_internal(const std::shared_ptr<manager> &node) noexcept
+                : net_chan_internal(node)
+                {
+                }
+
+                /*!
+                 * \brief Names the input in the name server of its node.
+                 *
+                 * \param[in] name The name.
+                 */
+                void define(const std::string &name) noexcept(false)
+                {
+                    _manager->names.define(name, _id);
+                    _name = name;
+                }
+
+                /*!
+                 * \brief Takes a frame sent to the input.
+                 *
+                 * \param[in] from The link the frame came over.
+                 * \param[in] header The frame header.
+                 * \param[in,out] payload The payload of the frame.
+                 */
+                void receive(const std::shared_ptr<link> &from, const frame_header &header, std::vector<char> &payload) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    switch (static_cast<frame_type>(header.type))
+                    {
+                        case frame_type::DATA:
+                            // Poison the writer if the input is poisoned, otherwise queue the value
+                            if (_strength > 0)
+                            {
+                                from->post(frame_type::POISON, header.source, _strength);
+                                return;
+                            }
+                            _queue.push_back(message{from, header.source, std::move(payload)});
+                            // Give the link a used buffer, so receiving does not allocate
+                            if (!_spare.empty())
+                            {
+                                payload.swap(_spare.back());
+                                _spare.pop_back();
+                            }
+                            _cond.notify_one();
+                            if (_alting)
+                                guard::guard_internal::schedule(_alt);
+                            return;
+                        case frame_type::CANCEL:
+                            // Withdraw the value if it has not been read.  If it has, its writer has been told.
+                            for (size_t i = _reading ? 1 : 0; i < _queue.size(); ++i)
+                            {
+                                if (_queue[i].from == from && _queue[i].source == header.source)
+                                {
+                                    _queue.erase(_queue.begin() + i);
+                                    from->post(frame_type::CANCELLED, header.source, _id);
+                                    return;
+                                }
+                            }
+                            return;
+                        case frame_type::POISON:
+                            _strength = header.source;
+                            _cond.notify_all();
+                            if (_alting)
+                                guard::guard_internal::schedule(_alt);
+                            return;
+                        default:
+                            return;
+                    }
+                }
+
+                /*!
+                 * \brief Drops the values written over a lost link.  Their writers are gone.
+                 *
+                 * \param[in] lost The link lost.
+                 */
+                void link_lost(const link *lost) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    for (size_t i = _reading ? 1 : 0; i < _queue.size(); )
+                    {
+                        if (_queue[i].from.get() == lost)
+                            _queue.erase(_queue.begin() + i);
+                        else
+                            ++i;
+                    }
+                }
+
+                /*!
+                 * \brief Removes the name of the input, and poisons any writer left waiting.
+                 */
+                ~net_chan_in_internal() noexcept
+                {
+                    if (!_name.empty())
+                        _manager->names.remove(_name);
+                    for (auto &m : _queue)
+                        m.from->send(frame_type::POISON, m.source, std::numeric_limits<unsigned int>::max());
+                }
+            };
+
+            /*! \class net_chan_out_internal
+             * \brief Internal representation of an output end of a networked channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class net_chan_out_internal : public net_chan_internal
+            {
+            private:
+                using net_chan_internal::_manager;
+                using net_chan_internal::_id;
+                using net_chan_internal::_mut;
+                using net_chan_internal::_cond;
+                using net_chan_internal::_policy;
+                using net_chan_internal::_strength;
+
+                std::shared_ptr<link> _link = nullptr; //!< The link to the node of the input.
+
+                uint32_t _remote = 0; //!< The number of the input on its node.  Zero until resolved.
+
+                bool _acked = false; //!< Whether the last value written has been read.
+
+                bool _cancelled = false; //!< Whether the last value written has been withdrawn.
+
+                encoder _encoder; //!< Gathers the memory of each value written.
+
+                /*!
+                 * \brief Sends a value to the input.  The channel must be locked.
+                 *
+                 * \param[in] value The value.
+                 */
+                void send(const T &value) noexcept(false)
+                {
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    _acked = false;
+                    _cancelled = false;
+                    _encoder.clear();
+                    codec<T>::encode(value, _encoder);
+                    if (!_link->send(frame_type::DATA, _remote, _id, _encoder.parts(), _encoder.count()))
+                    {
+                        _strength = std::numeric_limits<unsigned int>::max();
+                        throw poison_exception(_strength);
+                    }
+                }
+
+            protected:
+                /*!
+                 * \brief Performs a write operation on the channel.
+                 *
+                 * \param[in] value The value to write to the channel.
+                 */
+                void write(T value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    send(value);
+                    // Wait until reader has completed
+                    _policy.wait(lock, _cond, [this]() { return _acked || _strength > 0; });
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                }
+
+                /*!
+                 * \brief Performs the next step of a write operation.
+                 *
+                 * \param[in] op The state of the operation.
+                 * \param[in] value The value to write to the channel.
+                 *
+                 * \return True if the write has completed, false if the operation is waiting.
+                 */
+                bool write_async(async_op &op, T &value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    if (op._phase == 0)
+                    {
+                        send(value);
+                        op._phase = 1;
+                    }
+                    // Wait until reader has completed
+                    if (!_acked && _strength == 0)
+                    {
+                        _cond.wait_async(lock, op);
+                        return false;
+                    }
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    return true;
+                }
+
+                /*!
+                 * \brief Whether a remote reader is committed is not known without asking it, so this
+                 * never writes.
+                 *
+                 * \return False, unless poisoned.
+                 */
+                bool try_write(T&) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    return false;
+                }
+
+                /*!
+                 * \brief Writes a value, withdrawing it if it has not been read by the given time.  The
+                 * withdrawal goes to the input, so the write may still complete if the reader takes
+                 * the value first.
+                 *
+                 * \param[in,out] value The value to write.
+                 * \param[in] time The time to give up the write.
+                 *
+                 * \return True if the value was written, false if the time was reached first.
+                 */
+                bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    send(value);
+                    if (!_cond.wait_until(lock, time, [this]() { return _acked || _strength > 0; }))
+                    {
+                        // Withdraw the value, and wait to hear whether it was read first
+                        _link->send(frame_type::CANCEL, _remote, _id);
+                        _policy.wait(lock, _cond, [this]() { return _acked || _cancelled || _strength > 0; });
+                    }
+                    // Check if poisoned
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                    return _acked;
+                }
+
+                T read() noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                T start_read() noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                void end_read() noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool read_async(async_op&, T&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool try_read(T&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool read_until(T&, const std::chrono::steady_clock::time_point&) noexcept(false) override final { throw net_chan_internal::wrong_end(); }
+
+                bool enable(const alt&) noexcept override final { return false; }
+
+                bool disable() noexcept override final { return false; }
+
+                bool pending() const noexcept override final { return false; }
+
+                /*!
+                 * \brief Poisoning the reading end is done by the input.
+                 */
+                void reader_poison(unsigned int) noexcept override final { }
+
+                /*!
+                 * \brief Poisons the writing end of the channel, and the input.
+                 *
+                 * \param[in] strength The strength of the poison to apply to the channel.
+                 */
+                void writer_poison(unsigned int strength) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    _strength = strength;
+                    if (_link && _remote != 0)
+                        _link->send(frame_type::POISON, _remote, strength);
+                    _cond.notify_all();
+                }
+
+            public:
+                /*!
+                 * \brief Creates an output end of a networked channel.
+                 *
+                 * \param[in] node The node the output lives at.
+                 */
+                net_chan_out_internal(const std::shared_ptr<manager> &node) noexcept
+                : net_chan_internal(node)
+                {
+                }
+
+                /*!
+                 * \brief Connects to a named input.  Waits until the input is defined.
+                 *
+                 * \param[in] address The address of the node of the input.
+                 * \param[in] name The name of the input.
+                 */
+                void connect(const net_address &address, const std::string &name) noexcept(false)
+                {
+                    auto l = _manager->link_to(address);
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    _link = l;
+                    if (!_link->send(frame_type::RESOLVE, 0, _id, name.data(), name.size()))
+                        _strength = std::numeric_limits<unsigned int>::max();
+                    _cond.wait(lock, [this]() { return _remote != 0 || _strength > 0; });
+                    // Check if the link was lost
+                    if (_strength > 0)
+                        throw poison_exception(_strength);
+                }
+
+                /*!
+                 * \brief Takes a frame sent to the output.  Frames sent to an output carry no payload.
+                 *
+                 * \param[in] header The frame header.
+                 */
+                void receive(const std::shared_ptr<link> &, const frame_header &header, std::vector<char> &) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    switch (static_cast<frame_type>(header.type))
+                    {
+                        case frame_type::ACK:
+                            _acked = true;
+                            break;
+                        case frame_type::CANCELLED:
+                            _cancelled = true;
+                            break;
+                        case frame_type::POISON:
+                            _strength = header.source;
+                            break;
+                        case frame_type::RESOLVED:
+                            _remote = header.source;
+                            break;
+                        default:
+                            return;
+                    }
+                    _cond.notify_all();
+                }
+
+                /*!
+                 * \brief Poisons the output if its link is lost.
+                 *
+                 * \param[in] lost The link lost.
+                 */
+                void link_lost(const link *lost) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    if (_link.get() != lost)
+                        return;
+                    _strength = std::numeric_limits<unsigned int>::max();
+                    _cond.notify_all();
+                }
             };
+
+            /*!
+             * \brief Creates a channel object on one end of a networked channel.
+             *
+             * \param[in] internal The end.
+             */
+            net_chan(std::shared_ptr<net_chan_internal> internal) noexcept
+            : chan<T, POISONABLE>(internal)
+            {
+            }
+
+            /*!
+             * \brief Creates the input end of a networked channel, named at its node.
+             *
+             * \param[in] node The node the input lives at.
+             * \param[in] name The name of the input.
+             *
+             * \return The channel object.
+             */
+            static net_chan create_in(const std::shared_ptr<manager> &node, const std::string &name) noexcept(false)
+            {
+                auto internal = std::make_shared<net_chan_in_internal>(node);
+                internal->set_id(node->add(internal));
+                internal->define(name);
+                return net_chan(internal);
+            }
+
+            /*!
+             * \brief Creates an output end of a networked channel, connected to a named input.
+             *
+             * \param[in] node The node the output lives at.
+             * \param[in] address The address of the node of the input.
+             * \param[in] name The name of the input.
+             *
+             * \return The channel object.
+             */
+            static net_chan create_out(const std::shared_ptr<manager> &node, const net_address &address, const std::string &name) noexcept(false)
+            {
+                auto internal = std::make_shared<net_chan_out_internal>(node);
+                internal->set_id(node->add(internal));
+                internal->connect(address, name);
+                return net_chan(internal);
+            }
+        };
+
+        /*! \class net_chan_in
+         * \brief The input end of a networked channel.  Gives a guarded input that reads the values
+         * written by outputs on any node.
+         *
+         * \tparam T Type that the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether this channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, bool POISONABLE = false>
+        class net_chan_in : public networked
+        {
+        private:
+            // Type declarations used by channel.
+            using INPUT = alting_chan_in<T, POISONABLE>;
+            using INPUT_IMPL = typename INPUT::alting_chan_in_internal;
+
+            chan<T, POISONABLE> _chan; //!< Internal channel implementation.
+
+            INPUT _in; //!< The input end of the channel.
+
+            net_address _address; //!< The address of the node the input lives at.
+
+            std::string _name; //!< The name of the input.
+
+        public:
+            /*!
+             * \brief Creates the input end of a networked channel.
+             *
+             * \param[in] node The node the input lives at.
+             * \param[in] name The name outputs connect to.  Must be unique on the node.
+             * \param[in] immunity The poison immunity level that the channel has.
+             */
+            net_chan_in(const link_manager &node, const std::string &name, unsigned int immunity = 0) noexcept(false)
+            : _chan(net_chan<T, POISONABLE>::create_in(node._internal, name)),
+              _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity))),
+              _address(node.get_address()), _name(name)
+            {
+            }
+
+            /*!
+             * \brief Gets the address of the node the input lives at.
+             *
+             * \return The address of the node.
+             */
+            net_address get_address() const noexcept override final { return _address; }
+
+            /*!
+             * \brief Gets the name of the input.
+             *
+             * \return The name.
+             */
+            const std::string& name() const noexcept { return _name; }
+
+            /*!
+             * \brief Gets the input end of the channel.
+             *
+             * \return The input end of the channel.
+             */
+            alting_chan_in<T, POISONABLE> in() const noexcept { return _in; }
+
+            /*!
+             * \brief Conversion operator.  Implicitly gets input end.
+             *
+             * \return The input end of the channel.
+             */
+            operator alting_chan_in<T, POISONABLE>() const noexcept { return _in; }
+
+            /*!
+             * \brief Performs a read on the channel.
+             *
+             * \return Value read from the channel.
+             */
+            T operator()() const noexcept(false) { return _in.read(); }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
+        };
+
+        /*! \class net_chan_out
+         * \brief An output end of a networked channel.  Connects to a named input on a node, which
+         * may be the node the output lives at.
+         *
+         * \tparam T Type that the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether this channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, bool POISONABLE = false>
+        class net_chan_out : public networked
+        {
+        private:
+            // Type declarations used by channel.
+            using OUTPUT = chan_out<T, POISONABLE>;
+            using OUTPUT_IMPL = typename OUTPUT::chan_out_internal;
+
+            chan<T, POISONABLE> _chan; //!< Internal channel implementation.
+
+            OUTPUT _out; //!< The output end of the channel.
+
+            net_address _address; //!< The address of the node of the input.
+
+        public:
+            /*!
+             * \brief Creates an output end of a networked channel.  Waits until the input is named on its node.
+             *
+             * \param[in] node The node the output lives at.
+             * \param[in] address The address of the node of the input.
+             * \param[in] name The name of the input.
+             * \param[in] immunity The poison immunity level that the channel has.
+             */
+            net_chan_out(const link_manager &node, const net_address &address, const std::string &name, unsigned int immunity = 0) noexcept(false)
+            : _chan(net_chan<T, POISONABLE>::create_out(node._internal, address, name)),
+              _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity))),
+              _address(address)
+            {
+            }
+
+            /*!
+             * \brief Gets the address of the node of the input.
+             *
+             * \return The address of the node.
+             */
+            net_address get_address() const noexcept override final { return _address; }
+
+            /*!
+             * \brief Gets the output end of the channel.
+             *
+             * \return The output end of the channel.
+             */
+            chan_out<T, POISONABLE> out() const noexcept { return _out; }
+
+            /*!
+             * \brief Conversion operator.  Implicitly gets output end.
+             *
+             * \return The output end of the channel.
+             */
+            operator chan_out<T, POISONABLE>() const noexcept { return _out; }
+
+            /*!
+             * \brief Performs a write on the channel.
+             *
+             * \param[in] value Value to write to the channel.
+             */
+            void operator()(T value) const noexcept(false) { _out.write(std::move(value)); }
+
+            /*!
+             * \brief Sets how processes wait on the channel.
+             *
+             * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+             */
+            void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
         };
     }
 }
@@ -0,0 +1,1318 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_SHM_CHAN_H
+#define CPP_CSP_SHM_CHAN_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "../chan.h"
+#include "codec.h"
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class shm_segment
+         * \brief A channel in a POSIX shared-memory segment, shared by a writing and a reading process.
+         *
+         * The segment holds a ring of slots.  The writer copies each value into the slot at the
+         * head and moves the head on, and the reader decodes the value from the slot at the tail
+         * and moves the tail on.  Each side owns one counter, so the ring needs no lock.  The
+         * reader claims a slot before reading it, so a writer giving up a timed write can take
+         * back a value not yet claimed.
+         *
+         * A side that has to wait sleeps on a futex, woken by the other when it moves its
+         * counter.  Waking is skipped when no one sleeps.  Sleepers wake now and then to check
+         * that the process on the other side is alive.  If it has died the channel is poisoned,
+         * so the survivor is told rather than left waiting.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class shm_segment
+        {
+        public:
+            /*! \struct slot
+             * \brief The header of a slot.  The value follows it.
+             */
+            struct slot
+            {
+                std::atomic<uint32_t> state; //!< EMPTY, PUBLISHED, CLAIMED or WITHDRAWN.
+
+                uint32_t length; //!< The number of bytes of the value.
+
+                uint64_t padding; //!< Aligns the value for any type.
+            };
+
+        private:
+            static constexpr uint32_t MAGIC = 0x43535053; //!< Set once the segment is ready for use.
+
+            static constexpr unsigned int YIELD_COUNT = 16; //!< Number of yields before sleeping on the futex.
+
+            static constexpr long CHECK_MS = 50; //!< How often a sleeper checks the other side is alive.
+
+            /*! \struct layout
+             * \brief The start of the segment.  The slots follow it.
+             */
+            struct layout
+            {
+                std::atomic<uint32_t> magic; //!< MAGIC once the segment is ready.
+
+                uint32_t slots; //!< Number of slots.
+
+                uint32_t slot_size; //!< Bytes in a slot, including its header.
+
+                uint32_t buffered; //!< Whether writers go on without waiting for the reader.
+
+                alignas(64) std::atomic<uint64_t> head; //!< Number of values written.  Moved by the writer.
+
+                alignas(64) std::atomic<uint64_t> tail; //!< Number of values read.  Moved by the reader.
+
+                alignas(64) std::atomic<uint32_t> data_seq; //!< Futex word moved when a value is written or poison arrives.
+
+                std::atomic<uint32_t> readers_asleep; //!< Number of processes sleeping on data_seq.
+
+                alignas(64) std::atomic<uint32_t> space_seq; //!< Futex word moved when a value is read or poison arrives.
+
+                std::atomic<uint32_t> writers_asleep; //!< Number of processes sleeping on space_seq.
+
+                alignas(64) std::atomic<uint32_t> poison; //!< Strength of poison on the channel.
+
+                std::atomic<int32_t> reader_pid; //!< Process reading.
+
+                std::atomic<int32_t> writer_pid; //!< Process writing.  Zero until a writer opens the channel.
+            };
+
+            static constexpr size_t HEADER_SIZE = (sizeof(layout) + 63) / 64 * 64; //!< Bytes before the first slot.
+
+            std::string _name; //!< The name of the segment.
+
+            layout *_layout = nullptr; //!< The mapped segment.
+
+            size_t _size = 0; //!< Bytes mapped.
+
+            bool _owner; //!< Whether this side created the segment, and removes it.
+
+            /*!
+             * \brief Sleeps on a futex word while it holds the given value, for at most a while.
+             *
+             * \param[in] word The futex word.
+             * \param[in] expected The value it held.
+             * \param[in] ms The most milliseconds to sleep.
+             */
+            static void futex_wait(std::atomic<uint32_t> &word, uint32_t expected, long ms) noexcept
+            {
+                timespec timeout{ms / 1000, (ms % 1000) * 1000000};
+                syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+            }
+
+            /*!
+             * \brief Wakes every process sleeping on a futex word.
+             *
+             * \param[in] word The futex word.
+             */
+            static void futex_wake(std::atomic<uint32_t> &word) noexcept
+            {
+                syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+            }
+
+            /*!
+             * \brief Checks whether a process is alive.  A process that has exited but not been
+             * reaped is dead.
+             *
+             * \param[in] pid The process.
+             *
+             * \return True if alive, false otherwise.
+             */
+            static bool alive(int32_t pid) noexcept
+            {
+                if (kill(pid, 0) != 0 && errno == ESRCH)
+                    return false;
+                std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+                std::string skip;
+                char state = 'R';
+                // The state follows the process name, which is in brackets
+                if (std::getline(stat, skip, ')'))
+                    stat >> state;
+                return state != 'Z' && state != 'X';
+            }
+
+            /*!
+             * \brief Gets the header of a slot.
+             *
+             * \param[in] index The number of the value in the slot.
+             *
+             * \return The slot header.
+             */
+            slot* slot_at(uint64_t index) const noexcept
+            {
+                return reinterpret_cast<slot*>(reinterpret_cast<char*>(_layout) + HEADER_SIZE + (index % _layout->slots) * _layout->slot_size);
+            }
+
+            /*!
+             * \brief Maps the segment.
+             *
+             * \param[in] fd The shared-memory file.
+             * \param[in] size The number of bytes to map.
+             */
+            void map(int fd, size_t size) noexcept(false)
+            {
+                auto address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (address == MAP_FAILED)
+                {
+                    auto error = errno;
+                    ::close(fd);
+                    throw std::runtime_error("Cannot map shared-memory channel " + _name + ": " + std::strerror(error));
+                }
+                _layout = static_cast<layout*>(address);
+                _size = size;
+            }
+
+        public:
+            static constexpr uint32_t EMPTY = 0; //!< Slot state: holds no value.
+
+            static constexpr uint32_t PUBLISHED = 1; //!< Slot state: holds a value not yet claimed.
+
+            static constexpr uint32_t CLAIMED = 2; //!< Slot state: the reader is reading the value.
+
+            static constexpr uint32_t WITHDRAWN = 3; //!< Slot state: the writer has taken the value back.
+
+            /*!
+             * \brief Creates a segment for the reading side.  Replaces any left by an earlier reader.
+             *
+             * \param[in] name The name of the channel.
+             * \param[in] slots The number of values the ring holds.
+             * \param[in] max_size The most bytes an encoded value may take.
+             * \param[in] buffered Whether writers go on without waiting for the reader.
+             */
+            shm_segment(const std::string &name, size_t slots, size_t max_size, bool buffered) noexcept(false)
+            : _name("/csp_" + name), _owner(true)
+            {
+                shm_unlink(_name.c_str());
+                auto fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                if (fd < 0)
+                    throw std::runtime_error("Cannot create shared-memory channel " + _name + ": " + std::strerror(errno));
+                auto slot_size = (sizeof(slot) + max_size + 15) / 16 * 16;
+                auto size = HEADER_SIZE + slots * slot_size;
+                if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+                {
+                    auto error = errno;
+                    ::close(fd);
+                    shm_unlink(_name.c_str());
+                    throw std::runtime_error("Cannot size shared-memory channel " + _name + ": " + std::strerror(error));
+                }
+                map(fd, size);
+                ::close(fd);
+                // The new segment is zeroed, so the counters and slot states start at zero
+                _layout->slots = static_cast<uint32_t>(slots);
+                _layout->slot_size = static_cast<uint32_t>(slot_size);
+                _layout->buffered = buffered ? 1 : 0;
+                _layout->reader_pid.store(getpid());
+                _layout->magic.store(MAGIC);
+            }
+
+            /*!
+             * \brief Opens the segment of a channel for the writing side.  Waits until a living
+             * reader has created it.
+             *
+             * \param[in] name The name of the channel.
+             */
+            shm_segment(const std::string &name) noexcept(false)
+            : _name("/csp_" + name), _owner(false)
+            {
+                while (true)
+                {
+                    auto fd = shm_open(_name.c_str(), O_RDWR, 0600);
+                    struct stat info;
+                    if (fd >= 0 && fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= HEADER_SIZE)
+                    {
+                        map(fd, static_cast<size_t>(info.st_size));
+                        ::close(fd);
+                        // A segment left by a reader that has died is replaced by the next
+                        if (_layout->magic.load() == MAGIC && alive(_layout->reader_pid.load()))
+                            break;
+                        munmap(_layout, _size);
+                        _layout = nullptr;
+                    }
+                    else if (fd >= 0)
+                        ::close(fd);
+                    // Not ready yet
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                int32_t expected = 0;
+                if (!_layout->writer_pid.compare_exchange_strong(expected, getpid()) && alive(expected))
+                {
+                    munmap(_layout, _size);
+                    throw std::logic_error("Shared-memory channel " + _name + " already has a writer");
+                }
+                _layout->writer_pid.store(getpid());
+            }
+
+            shm_segment(const shm_segment&) = delete;
+
+            shm_segment& operator=(const shm_segment&) = delete;
+
+            /*!
+             * \brief Leaves the channel.  A writer leaving makes way for another.  A reader
+             * leaving removes the segment.
+             */
+            ~shm_segment() noexcept
+            {
+                if (!_owner)
+                    _layout->writer_pid.store(0);
+                munmap(_layout, _size);
+                if (_owner)
+                    shm_unlink(_name.c_str());
+            }
+
+            /*!
+             * \brief Gets the most bytes an encoded value may take.
+             *
+             * \return The number of bytes.
+             */
+            size_t max_size() const noexcept { return _layout->slot_size - sizeof(slot); }
+
+            /*!
+             * \brief Checks whether writers go on without waiting for the reader.
+             *
+             * \return True if buffered, false if writers wait for their value to be read.
+             */
+            bool buffered() const noexcept { return _layout->buffered != 0; }
+
+            /*!
+             * \brief Gets the strength of poison on the channel.
+             *
+             * \return The strength, or zero if not poisoned.
+             */
+            unsigned int poisoned() const noexcept { return _layout->poison.load(); }
+
+            /*!
+             * \brief Poisons the channel, and wakes both sides.
+             *
+             * \param[in] strength The strength of the poison.
+             */
+            void poison(unsigned int strength) noexcept
+            {
+                _layout->poison.store(strength);
+                _layout->data_seq.fetch_add(1);
+                _layout->space_seq.fetch_add(1);
+                futex_wake(_layout->data_seq);
+                futex_wake(_layout->space_seq);
+            }
+
+            /*!
+             * \brief Wakes any process of this one waiting for data, such as a thread watching for an alt.
+             */
+            void wake_readers() noexcept
+            {
+                _layout->data_seq.fetch_add(1);
+                futex_wake(_layout->data_seq);
+            }
+
+            /*!
+             * \brief Wakes any process of this one waiting for room or a read, such as a thread watching for a parked write.
+             */
+            void wake_writers() noexcept
+            {
+                _layout->space_seq.fetch_add(1);
+                futex_wake(_layout->space_seq);
+            }
+
+            /*!
+             * \brief Checks if a value is waiting to be read.
+             *
+             * \return True if a value has been written and not read.
+             */
+            bool readable() const noexcept
+            {
+                return _layout->head.load() > _layout->tail.load();
+            }
+
+            /*!
+             * \brief Checks if there is room to write a value.
+             *
+             * \return True if a slot is free.
+             */
+            bool writable() const noexcept
+            {
+                return _layout->head.load() - _layout->tail.load() < _layout->slots;
+            }
+
+            /*!
+             * \brief Gets the number of values written.  Only used by the writer.
+             *
+             * \return The head.
+             */
+            uint64_t head() const noexcept { return _layout->head.load(); }
+
+            /*!
+             * \brief Gets the number of values read.
+             *
+             * \return The tail.
+             */
+            uint64_t tail() const noexcept { return _layout->tail.load(); }
+
+            /*!
+             * \brief Waits until the condition holds, the channel is poisoned, or the time is reached.
+             * Yields, then sleeps on a futex, checking the other side is alive.  Poisons the channel
+             * if it is not.
+             *
+             * \tparam Pred The type of the condition.
+             *
+             * \param[in] reading Whether waiting for data, rather than for space or a read.
+             * \param[in] pred The condition.
+             * \param[in] time The time to give up.
+             *
+             * \return True if the condition holds or the channel is poisoned, false if the time was reached.
+             */
+            template<typename Pred>
+            bool wait(bool reading, Pred pred, const std::chrono::steady_clock::time_point &time = std::chrono::steady_clock::time_point::max()) noexcept
+            {
+                for (unsigned int i = 0; i < YIELD_COUNT; ++i)
+                {
+                    if (pred() || poisoned() > 0)
+                        return true;
+                    fiber_scheduler::yield();
+                }
+                auto &word = reading ? _layout->data_seq : _layout->space_seq;
+                auto &asleep = reading ? _layout->readers_asleep : _layout->writers_asleep;
+                auto &peer = reading ? _layout->writer_pid : _layout->reader_pid;
+                while (true)
+                {
+                    auto seq = word.load();
+                    if (pred() || poisoned() > 0)
+                        return true;
+                    auto now = std::chrono::steady_clock::now();
+                    if (now >= time)
+                        return false;
+                    // Check the other side is alive
+                    auto pid = peer.load();
+                    if (pid != 0 && !alive(pid))
+                    {
+                        poison(std::numeric_limits<unsigned int>::max());
+                        return true;
+                    }
+                    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(time - now).count() + 1;
+                    asleep.fetch_add(1);
+                    futex_wait(word, seq, left < CHECK_MS ? static_cast<long>(left) : CHECK_MS);
+                    asleep.fetch_sub(1);
+                }
+            }
+
+            /*!
+             * \brief Writes a value into the slot at the head, and wakes the reader.  There must be room.
+             *
+             * \param[in] out The encoded value.
+             *
+             * \return The number of the value.
+             */
+            uint64_t publish(encoder &out) noexcept(false)
+            {
+                auto index = _layout->head.load();
+                auto s = slot_at(index);
+                auto parts = out.parts();
+                size_t length = 0;
+                for (size_t i = 1; i < out.count(); ++i)
+                    length += parts[i].iov_len;
+                if (length > max_size())
+                    throw std::length_error("Value too large for shared-memory channel " + _name);
+                // Copy the value into the slot
+                auto data = reinterpret_cast<char*>(s + 1);
+                for (size_t i = 1; i < out.count(); ++i)
+                {
+                    std::memcpy(data, parts[i].iov_base, parts[i].iov_len);
+                    data += parts[i].iov_len;
+                }
+                s->length = static_cast<uint32_t>(length);
+                s->state.store(PUBLISHED);
+                _layout->head.store(index + 1);
+                _layout->data_seq.fetch_add(1);
+                if (_layout->readers_asleep.load() > 0)
+                    futex_wake(_layout->data_seq);
+                return index;
+            }
+
+            /*!
+             * \brief Takes back a value not yet claimed by the reader.  Only used by the writer.
+             *
+             * \param[in] index The number of the value.
+             *
+             * \return True if taken back, false if the reader has claimed it.
+             */
+            bool withdraw(uint64_t index) noexcept
+            {
+                auto s = slot_at(index);
+                auto expected = PUBLISHED;
+                if (!s->state.compare_exchange_strong(expected, WITHDRAWN))
+                    return false;
+                _layout->head.store(index);
+                s->state.store(EMPTY);
+                return true;
+            }
+
+            /*!
+             * \brief Claims the value at the tail.
+             *
+             * \return The claimed slot, or null if the writer has taken the value back.
+             */
+            slot* claim() noexcept
+            {
+                auto s = slot_at(_layout->tail.load());
+                auto expected = PUBLISHED;
+                return s->state.compare_exchange_strong(expected, CLAIMED) ? s : nullptr;
+            }
+
+            /*!
+             * \brief Gets a decoder over a claimed value.
+             *
+             * \param[in] s The slot.
+             *
+             * \return The decoder.
+             */
+            static decoder value(const slot *s) noexcept
+            {
+                return decoder(reinterpret_cast<const char*>(s + 1), s->length);
+            }
+
+            /*!
+             * \brief Frees a claimed slot and moves the tail on, waking the writer.
+             *
+             * \param[in] s The slot.
+             */
+            void release(slot *s) noexcept
+            {
+                s->state.store(EMPTY);
+                _layout->tail.fetch_add(1);
+                _layout->space_seq.fetch_add(1);
+                if (_layout->writers_asleep.load() > 0)
+                    futex_wake(_layout->space_seq);
+            }
+        };
+
+        /*! \class shm_chan
+         * \brief A channel between two processes on one host, through a shared-memory segment.
+         *
+         * The reading process creates the channel by name, and the writing process opens it by
+         * the same name.  Unbuffered, a write waits until its value has been read, as on a local
+         * channel.  Buffered, a write waits only for room in the ring, as on a channel with a
+         * buffer.  Values are copied into the segment with the codec for their type.
+         *
+         * An alt may select the input.  A thread of the reading process watches the segment while
+         * an alt waits on it.  A fiber waiting on the channel yields for a while, then sleeps its
+         * thread.  An operation of a process that cannot block is parked, and a thread of its
+         * process watches the segment and resumes it once the channel is ready.
+         *
+         * \tparam T The type the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether the channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, bool POISONABLE = false>
+        class shm_chan : public chan<T, POISONABLE>
+        {
+            // Friend declarations
+            friend class shm_chan_in<T, POISONABLE>;
+            friend class shm_chan_out<T, POISONABLE>;
+        protected:
+            /*! \class shm_chan_internal
+             * \brief State shared by both ends of a shared-memory channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class shm_chan_internal : public chan<T, POISONABLE>::chan_internal
+            {
+            protected:
+                shm_segment _segment; //!< The shared-memory segment.
+
+                const bool _reads; //!< Whether this is the reading end.
+
+                std::mutex _mut; //!< Lock used to control access to the watcher state.
+
+                condition _cond; //!< Used by the watcher to wait for something to watch for.
+
+                condition _parked; //!< Operations of processes that cannot block, waiting for the channel to be ready.
+
+                bool _parking = false; //!< Flag to indicate whether operations are parked.
+
+                std::atomic<bool> _stopping; //!< Flag used to stop the watcher.
+
+                std::thread _watcher; //!< Watches the segment.  Started when first needed.
+
+                /*!
+                 * \brief Checks if the end can go on, or the channel is poisoned.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                virtual bool ready() const noexcept = 0;
+
+                /*!
+                 * \brief Checks if the watcher has anything to watch for.  Called with _mut held.
+                 *
+                 * \return True if something waits on the channel, false otherwise.
+                 */
+                virtual bool watching() const noexcept { return _parking; }
+
+                /*!
+                 * \brief Resumes what waits on the channel once it is ready.  Called by the watcher
+                 * with _mut held.
+                 */
+                virtual void resume() noexcept
+                {
+                    _parking = false;
+                    _parked.notify_all();
+                }
+
+                /*!
+                 * \brief Watches the segment while something waits on the channel, and resumes it
+                 * once the channel is ready.
+                 */
+                void watch() noexcept
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    while (true)
+                    {
+                        _cond.wait(lock, [this]() { return watching() || _stopping.load(); });
+                        if (_stopping.load())
+                            return;
+                        lock.unlock();
+                        _segment.wait(_reads, [this]() { return ready() || _stopping.load(); });
+                        lock.lock();
+                        if (ready())
+                            resume();
+                    }
+                }
+
+                /*!
+                 * \brief Starts the watcher if needed, and has it watch.  Called with _mut held.
+                 */
+                void start_watching() noexcept
+                {
+                    if (!_watcher.joinable())
+                        _watcher = std::thread(&shm_chan_internal::watch, this);
+                    _cond.notify_one();
+                }
+
+                /*!
+                 * \brief Parks an operation until the channel is ready.  Called with _mut held.
+                 *
+                 * \param[in] lock The lock on _mut.  Released on return.
+                 * \param[in] op The operation to park.
+                 */
+                void park(std::unique_lock<std::mutex> &lock, async_op &op) noexcept
+                {
+                    _parking = true;
+                    start_watching();
+                    _parked.wait_async(lock, op);
+                }
+
+                /*!
+                 * \brief Stops the watcher.  Called by the destructor of each end, as the watcher
+                 * uses the end.
+                 */
+                void stop_watching() noexcept
+                {
+                    {
+                        // Lock the mutex
+                        std::unique_lock<std::mutex> lock(_mut);
+                        _stopping.store(true);
+                        _cond.notify_all();
+                    }
+                    if (_watcher.joinable())
+                    {
+                        if (_reads)
+                            _segment.wake_readers();
+                        else
+                            _segment.wake_writers();
+                        _watcher.join();
+                    }
+                }
+
+                /*!
+                 * \brief Gets the error thrown by an operation made on the wrong end of the channel.
+                 *
+                 * \return The error.
+                 */
+                static std::logic_error wrong_end() noexcept
+                {
+                    return std::logic_error("Operation not supported on this end of a shared-memory channel");
+                }
+
+                /*!
+                 * \brief Throws if the channel is poisoned.
+                 */
+                void check_poison() const noexcept(false)
+                {
+                    auto strength = _segment.poisoned();
+                    if (strength > 0)
+                        throw poison_exception(strength);
+                }
+
+            public:
+                /*!
+                 * \brief Creates the reading end's segment.
+                 */
+                shm_chan_internal(const std::string &name, size_t slots, size_t max_size, bool buffered) noexcept(false)
+                : _segment(name, slots, max_size, buffered), _reads(true), _stopping(false)
+                {
+                }
+
+                /*!
+                 * \brief Opens the writing end's segment.
+                 */
+                shm_chan_internal(const std::string &name) noexcept(false)
+                : _segment(name), _reads(false), _stopping(false)
+                {
+                }
+
+                /*!
+                 * \brief Poisons the channel.
+                 *
+                 * \param[in] strength The strength of the poison to apply to the channel.
+                 */
+                void reader_poison(unsigned int strength) noexcept override final { _segment.poison(strength); }
+
+                /*!
+                 * \brief Poisons the channel.
+                 *
+                 * \param[in] strength The strength of the poison to apply to the channel.
+                 */
+                void writer_poison(unsigned int strength) noexcept override final { _segment.poison(strength); }
+            };
+
+            /*! \class shm_chan_in_internal
+             * \brief Internal representation of the input end of a shared-memory channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class shm_chan_in_internal : public shm_chan_internal
+            {
+            private:
+                using shm_chan_internal::_segment;
+
+                using shm_chan_internal::_mut;
+
+                alt _alt; //!< Alt used when channel is in a selection operation.
+
+                bool _alting = false; //!< Flag used to indicate whether the channel is being used in a selection operation.
+
+                shm_segment::slot *_reading = nullptr; //!< The slot claimed by an extended read.
+
+                /*!
+                 * \brief Checks if a value is waiting or the channel is poisoned.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool ready() const noexcept override final { return _segment.readable() || _segment.poisoned() > 0; }
+
+                /*!
+                 * \brief Checks if an alt or a parked read waits on the channel.
+                 *
+                 * \return True if something waits on the channel, false otherwise.
+                 */
+                bool watching() const noexcept override final { return _alting || shm_chan_internal::watching(); }
+
+                /*!
+                 * \brief Schedules a waiting alt, and resumes parked reads.
+                 */
+                void resume() noexcept override final
+                {
+                    if (_alting)
+                    {
+                        _alting = false;
+                        guard::guard_internal::schedule(_alt);
+                    }
+                    shm_chan_internal::resume();
+                }
+
+                /*!
+                 * \brief Waits for a value and claims it.
+                 *
+                 * \param[in] time The time to give up.
+                 *
+                 * \return The claimed slot, or null if the time was reached.
+                 */
+                shm_segment::slot* wait_and_claim(const std::chrono::steady_clock::time_point &time = std::chrono::steady_clock::time_point::max()) noexcept(false)
+                {
+                    while (true)
+                    {
+                        this->check_poison();
+                        if (!_segment.wait(true, [this]() { return _segment.readable(); }, time))
+                            return nullptr;
+                        this->check_poison();
+                        // A value being taken back by its writer cannot be claimed
+                        auto s = _segment.claim();
+                        if (s)
+                            return s;
+                        fiber_scheduler::yield();
+                    }
+                }
+
+                /*!
+                 * \brief Reads a claimed value and frees its slot.
+                 *
+                 * \param[in] s The slot.
+                 *
+                 * \return The value.
+                 */
+                T take(shm_segment::slot *s) noexcept(false)
+                {
+                    auto in = shm_segment::value(s);
+                    auto value = codec<T>::decode(in);
+                    _segment.release(s);
+                    return value;
+                }
+
+            protected:
+                void write(T) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool write_async(async_op&, T&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool try_write(T&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool write_until(T&, const std::chrono::steady_clock::time_point&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                /*!
+                 * \brief Performs a read operation on the channel.
+                 *
+                 * \return The value read from the channel.
+                 */
+                T read() noexcept(false) override final
+                {
+                    return take(wait_and_claim());
+                }
+
+                /*!
+                 * \brief Extended read operation.  The writer waits until the read ends.
+                 *
+                 * \return The value read from the channel.
+                 */
+                T start_read() noexcept(false) override final
+                {
+                    if (_reading)
+                        throw std::logic_error("Channel already in extended read");
+                    auto s = wait_and_claim();
+                    auto in = shm_segment::value(s);
+                    auto value = codec<T>::decode(in);
+                    _reading = s;
+                    return value;
+                }
+
+                /*!
+                 * \brief Extended read completion operation.
+                 */
+                void end_read() noexcept(false) override final
+                {
+                    if (!_reading)
+                        throw std::logic_error("Channel not in extended read");
+                    _segment.release(_reading);
+                    _reading = nullptr;
+                }
+
+                /*!
+                 * \brief Performs the next step of a read operation.  The other process cannot wake
+                 * a waiting operation, so it is parked until the watcher sees a value arrive.
+                 *
+                 * \param[in] op The state of the operation.
+                 * \param[out] value Set to the value read once the read has completed.
+                 *
+                 * \return True if the read has completed, false if the operation is waiting.
+                 */
+                bool read_async(async_op &op, T &value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    this->check_poison();
+                    // A value being taken back by its writer cannot be claimed
+                    auto s = _segment.readable() ? _segment.claim() : nullptr;
+                    if (s)
+                    {
+                        value = take(s);
+                        return true;
+                    }
+                    this->park(lock, op);
+                    return false;
+                }
+
+                /*!
+                 * \brief Reads a value only if one has already been written.
+                 *
+                 * \param[out] value Set to the value read if the read succeeds.
+                 *
+                 * \return True if a value was read, false otherwise.
+                 */
+                bool try_read(T &value) noexcept(false) override final
+                {
+                    this->check_poison();
+                    if (!_segment.readable())
+                        return false;
+                    auto s = _segment.claim();
+                    if (!s)
+                        return false;
+                    value = take(s);
+                    return true;
+                }
+
+                /*!
+                 * \brief Reads a value, giving up if none has been written by the given time.
+                 *
+                 * \param[out] value Set to the value read if the read succeeds.
+                 * \param[in] time The time to give up the read.
+                 *
+                 * \return True if a value was read, false if the time was reached first.
+                 */
+                bool read_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+                {
+                    auto s = wait_and_claim(time);
+                    if (!s)
+                        return false;
+                    value = take(s);
+                    return true;
+                }
+
+                /*!
+                 * \brief Enable the channel with an alt
+                 *
+                 * \param[in] a The alt that is being used in the selection.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool enable(const alt &a) noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    if (ready())
+                        return true;
+                    // Register alt, and have the watcher schedule it when a value arrives
+                    _alt = a;
+                    _alting = true;
+                    this->start_watching();
+                    return false;
+                }
+
+                /*!
+                 * \brief Disables the channel with an alt.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool disable() noexcept override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    _alting = false;
+                    // The alt holds this channel, so let it go
+                    _alt = alt();
+                    return ready();
+                }
+
+                /*!
+                 * \brief Checks if a message is pending on the channel.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool pending() const noexcept override final { return ready(); }
+
+            public:
+                /*!
+                 * \brief Creates the input end of a shared-memory channel.
+                 */
+                shm_chan_in_internal(const std::string &name, size_t slots, size_t max_size, bool buffered) noexcept(false)
+                : shm_chan_internal(name, slots, max_size, buffered)
+                {
+                }
+
+                /*!
+                 * \brief Stops the watcher.
+                 */
+                ~shm_chan_in_internal() noexcept
+                {
+                    this->stop_watching();
+                }
+            };
+
+            /*! \class shm_chan_out_internal
+             * \brief Internal representation of the output end of a shared-memory channel.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class shm_chan_out_internal : public shm_chan_internal
+            {
+            private:
+                using shm_chan_internal::_segment;
+
+                using shm_chan_internal::_mut;
+
+                encoder _encoder; //!< Gathers the memory of each value written.
+
+                uint64_t _index = 0; //!< Number of the value a parked write has written.
+
+                std::atomic<uint64_t> _resume_after; //!< Parked writes are resumed once this many values have been read.
+
+                /*!
+                 * \brief Checks if a parked write can go on, or the channel is poisoned.
+                 *
+                 * \return True if the channel is ready, false otherwise.
+                 */
+                bool ready() const noexcept override final { return _segment.tail() > _resume_after.load() || _segment.poisoned() > 0; }
+
+                /*!
+                 * \brief Writes a value into the ring once there is room.
+                 *
+                 * \param[in] value The value.
+                 * \param[in] time The time to give up waiting for room.
+                 * \param[out] index Set to the number of the value written.
+                 *
+                 * \return True if written, false if the time was reached.
+                 */
+                bool publish(const T &value, const std::chrono::steady_clock::time_point &time, uint64_t &index) noexcept(false)
+                {
+                    this->check_poison();
+                    _encoder.clear();
+                    codec<T>::encode(value, _encoder);
+                    if (!_segment.wait(false, [this]() { return _segment.writable(); }, time))
+                        return false;
+                    this->check_poison();
+                    index = _segment.publish(_encoder);
+                    return true;
+                }
+
+                /*!
+                 * \brief Waits until a value has been read.
+                 *
+                 * \param[in] index The number of the value.
+                 * \param[in] time The time to give up.
+                 *
+                 * \return True if read, false if the time was reached.
+                 */
+                bool await_read(uint64_t index, const std::chrono::steady_clock::time_point &time = std::chrono::steady_clock::time_point::max()) noexcept(false)
+                {
+                    _segment.wait(false, [this, index]() { return _segment.tail() > index; }, time);
+                    // A value read before the channel was poisoned has been delivered
+                    if (_segment.tail() > index)
+                        return true;
+                    this->check_poison();
+                    return false;
+                }
+
+            protected:
+                /*!
+                 * \brief Performs a write operation on the channel.
+                 *
+                 * \param[in] value The value to write to the channel.
+                 */
+                void write(T value) noexcept(false) override final
+                {
+                    uint64_t index;
+                    publish(value, std::chrono::steady_clock::time_point::max(), index);
+                    if (!_segment.buffered())
+                        await_read(index);
+                }
+
+                /*!
+                 * \brief Performs the next step of a write operation.  The other process cannot wake
+                 * a waiting operation, so it is parked until the watcher sees the reader free a slot,
+                 * or read the value.
+                 *
+                 * \param[in] op The state of the operation.
+                 * \param[in] value The value to write to the channel.
+                 *
+                 * \return True if the write has completed, false if the operation is waiting.
+                 */
+                bool write_async(async_op &op, T &value) noexcept(false) override final
+                {
+                    // Lock the mutex
+                    std::unique_lock<std::mutex> lock(_mut);
+                    if (op._phase == 0)
+                    {
+                        this->check_poison();
+                        // Read first, so a slot freed after the check still resumes the write
+                        auto tail = _segment.tail();
+                        if (!_segment.writable())
+                        {
+                            // Wait for room
+                            _resume_after.store(tail);
+                            this->park(lock, op);
+                            return false;
+                        }
+                        _encoder.clear();
+                        codec<T>::encode(value, _encoder);
+                        _index = _segment.publish(_encoder);
+                        if (_segment.buffered())
+                            return true;
+                        op._phase = 1;
+                    }
+                    // A value read before the channel was poisoned has been delivered
+                    if (_segment.tail() > _index)
+                        return true;
+                    this->check_poison();
+                    // Wait for the reader
+                    _resume_after.store(_index);
+                    this->park(lock, op);
+                    return false;
+                }
+
+                /*!
+                 * \brief Writes a value only if it completes without waiting.  Only a buffered
+                 * channel with room can.
+                 *
+                 * \param[in,out] value The value to write.
+                 *
+                 * \return True if the value was written, false otherwise.
+                 */
+                bool try_write(T &value) noexcept(false) override final
+                {
+                    this->check_poison();
+                    if (!_segment.buffered() || !_segment.writable())
+                        return false;
+                    uint64_t index;
+                    return publish(value, std::chrono::steady_clock::now(), index);
+                }
+
+                /*!
+                 * \brief Writes a value, taking it back if it has not been read by the given time.
+                 * A buffered channel only waits for room.
+                 *
+                 * \param[in,out] value The value to write.
+                 * \param[in] time The time to give up the write.
+                 *
+                 * \return True if the value was written, false if the time was reached first.
+                 */
+                bool write_until(T &value, const std::chrono::steady_clock::time_point &time) noexcept(false) override final
+                {
+                    uint64_t index;
+                    if (!publish(value, time, index))
+                        return false;
+                    if (_segment.buffered() || await_read(index, time))
+                        return true;
+                    // Take the value back, unless the reader has claimed it
+                    if (_segment.withdraw(index))
+                        return false;
+                    await_read(index);
+                    return true;
+                }
+
+                T read() noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                T start_read() noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                void end_read() noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool read_async(async_op&, T&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool try_read(T&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool read_until(T&, const std::chrono::steady_clock::time_point&) noexcept(false) override final { throw shm_chan_internal::wrong_end(); }
+
+                bool enable(const alt&) noexcept override final { return false; }
+
+                bool disable() noexcept override final { return false; }
+
+                bool pending() const noexcept override final { return false; }
+
+            public:
+                /*!
+                 * \brief Opens the output end of a shared-memory channel.
+                 */
+                shm_chan_out_internal(const std::string &name) noexcept(false)
+                : shm_chan_internal(name), _resume_after(0)
+                {
+                }
+
+                /*!
+                 * \brief Stops the watcher.
+                 */
+                ~shm_chan_out_internal() noexcept
+                {
+                    this->stop_watching();
+                }
+            };
+
+            /*!
+             * \brief Creates a channel object on one end of a shared-memory channel.
+             *
+             * \param[in] internal The end.
+             */
+            shm_chan(std::shared_ptr<shm_chan_internal> internal) noexcept
+            : chan<T, POISONABLE>(internal)
+            {
+            }
+        };
+
+        /*!
+         * \brief Gets the default most bytes a value of a shared-memory channel may take.
+         *
+         * \tparam T The type of the values.
+         *
+         * \return The size of the type if trivially copyable, otherwise 4KiB.
+         */
+        template<typename T>
+        constexpr size_t shm_max_size() noexcept
+        {
+            return std::is_trivially_copyable<T>::value ? sizeof(T) : 4096;
+        }
+
+        /*! \class shm_chan_in
+         * \brief The input end of a shared-memory channel.  Creates the channel, and gives a
+         * guarded input that reads the values written by another process.
+         *
+         * \tparam T Type that the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether this channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, bool POISONABLE = false>
+        class shm_chan_in
+        {
+        private:
+            // Type declarations used by channel.
+            using INPUT = alting_chan_in<T, POISONABLE>;
+            using INPUT_IMPL = typename INPUT::alting_chan_in_internal;
+            using IMPL = typename shm_chan<T, POISONABLE>::shm_chan_in_internal;
+
+            chan<T, POISONABLE> _chan; //!< Internal channel implementation.
+
+            INPUT _in; //!< The input end of the channel.
+
+        public:
+            /*!
+             * \brief Creates an unbuffered shared-memory channel.  A write waits until its value is read.
+             *
+             * \param[in] name The name of the channel, shared with the writing process.
+             * \param[in] max_size The most bytes an encoded value may take.
+             * \param[in] immunity The poison immunity level that the channel has.
+             */
+            shm_chan_in(const std::string &name, size_t max_size = shm_max_size<T>(), unsigned int immunity = 0) noexcept(false)
+            : _chan(shm_chan<T, POISONABLE>(std::make_shared<IMPL>(name, 1, max_size, false))),
+              _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity)))
+            {
+            }
+
+            /*!
+             * \brief Creates a buffered shared-memory channel.  A write waits only for room in the buffer.
+             *
+             * \param[in] name The name of the channel, shared with the writing process.
+             * \param[in] buffer The buffer giving the number of values held.
+             * \param[in] max_size The most bytes an encoded value may take.
+             * \param[in] immunity The poison immunity level that the channel has.
+             */
+            shm_chan_in(const std::string &name, buffer<T> &buffer, size_t max_size = shm_max_size<T>(), unsigned int immunity = 0) noexcept(false)
+            : _chan(shm_chan<T, POISONABLE>(std::make_shared<IMPL>(name, buffer.size() > 0 ? buffer.size() : 1, max_size, true))),
+              _in(std::shared_ptr<INPUT_IMPL>(new INPUT_IMPL(_chan, immunity)))
+            {
+            }
+
+            /*!
+             * \brief Gets the input end of the channel.
+             *
+             * \return The input end of the channel.
+             */
+            alting_chan_in<T, POISONABLE> in() const noexcept { return _in; }
+
+            /*!
+             * \brief Conversion operator.  Implicitly gets input end.
+             *
+             * \return The input end of the channel.
+             */
+            operator alting_chan_in<T, POISONABLE>() const noexcept { return _in; }
+
+            /*!
+             * \brief Performs a read on the channel.
+             *
+             * \return Value read from the channel.
+             */
+            T operator()() const noexcept(false) { return _in.read(); }
+        };
+
+        /*! \class shm_chan_out
+         * \brief The output end of a shared-memory channel.  Opens a channel created by another process.
+         *
+         * \tparam T Type that the channel operates on.
+         * \tparam POISONABLE Flag to indicate whether this channel can be poisoned.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T, bool POISONABLE = false>
+        class shm_chan_out
+        {
+        private:
+            // Type declarations used by channel.
+            using OUTPUT = chan_out<T, POISONABLE>;
+            using OUTPUT_IMPL = typename OUTPUT::chan_out_internal;
+            using IMPL = typename shm_chan<T, POISONABLE>::shm_chan_out_internal;
+
+            chan<T, POISONABLE> _chan; //!< Internal channel implementation.
+
+            OUTPUT _out; //!< The output end of the channel.
+
+        public:
+            /*!
+             * \brief Opens a shared-memory channel.  Waits until the reading process has created it.
+             *
+             * \param[in] name The name of the channel, shared with the reading process.
+             * \param[in] immunity The poison immunity level that the channel has.
+             */
+            shm_chan_out(const std::string &name, unsigned int immunity = 0) noexcept(false)
+            : _chan(shm_chan<T, POISONABLE>(std::make_shared<IMPL>(name))),
+              _out(std::shared_ptr<OUTPUT_IMPL>(new OUTPUT_IMPL(_chan, immunity)))
+            {
+            }
+
+            /*!
+             * \brief Gets the output end of the channel.
+             *
+             * \return The output end of the channel.
+             */
+            chan_out<T, POISONABLE> out() const noexcept { return _out; }
+
+            /*!
+             * \brief Conversion operator.  Implicitly gets output end.
+             *
+             * \return The output end of the channel.
+             */
+            operator chan_out<T, POISONABLE>() const noexcept { return _out; }
+
+            /*!
+             * \brief Performs a write on the channel.
+             *
+             * \param[in] value Value to write to the channel.
+             */
+            void operator()(T value) const noexcept(false) { _out.write(std::move(value)); }
+        };
+    }
+}
+
+#endif //CPP_CSP_SHM_CHAN_H
@@ -0,0 +1,761 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_URING_ENGINE_H
+#define CPP_CSP_URING_ENGINE_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+#include "io_engine.h"
+
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+
+namespace csp
+{
+    namespace net
+    {
+        /*! \class uring_engine
+         * \brief An I/O engine that receives on the sockets with io_uring.
+         *
+         * Each I/O thread has its own ring, and each socket is given to one ring.  A socket has
+         * one multishot receive, which completes each time bytes arrive without being submitted
+         * again, into buffers the ring picks from a set registered with the kernel.  A listening
+         * socket has one multishot accept.  Submissions made while handling completions, such as
+         * buffers given back and receives started again, go to the kernel together when the
+         * thread next waits, so a busy thread makes one system call for many sockets.
+         *
+         * Needs a kernel with multishot receive and registered buffer rings.  The engine checks
+         * these when created, and throws if the kernel lacks them.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class uring_engine : public io_engine
+        {
+        private:
+            static constexpr unsigned int ENTRIES = 256; //!< Size of each submission queue.
+
+            static constexpr unsigned int BUFFERS = 128; //!< Receive buffers of each ring.  A power of two.
+
+            static constexpr size_t BUFFER_SIZE = 16 * 1024; //!< Bytes in each receive buffer.
+
+            static constexpr uint64_t WAKE = 0; //!< Tag of the read of the wake event.
+
+            static constexpr uint64_t CANCEL = 1; //!< Tag of the cancel made when stopping.
+
+            static constexpr uint64_t PROBE = 2; //!< Tag of the receive made when checking the kernel.
+
+            /*! \struct watched
+             * \brief A socket the engine watches.
+             */
+            struct watched
+            {
+                int fd; //!< The socket.
+
+                std::shared_ptr<stream> s; //!< The stream of a connected socket.
+
+                std::shared_ptr<acceptor> a; //!< The acceptor of a listening socket.
+
+                std::chrono::steady_clock::time_point due = std::chrono::steady_clock::time_point::max(); //!< When to call the stream's timer.
+            };
+
+            /*! \class ring
+             * \brief An io_uring instance and the sockets given to it.  Used only by its I/O thread
+             * once started.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class ring
+            {
+            public:
+                int fd = -1; //!< The ring.
+
+                void *rings = MAP_FAILED; //!< The submission and completion rings, mapped as one.
+
+                size_t rings_size = 0; //!< Bytes mapped for the rings.
+
+                io_uring_sqe *sqes = static_cast<io_uring_sqe*>(MAP_FAILED); //!< The submission entries.
+
+                size_t sqes_size = 0; //!< Bytes mapped for the submission entries.
+
+                unsigned int *sq_head = nullptr; //!< Next submission the kernel takes.
+
+                unsigned int *sq_tail = nullptr; //!< End of the submissions given to the kernel.
+
+                unsigned int sq_mask = 0; //!< Mask of submission queue indices.
+
+                unsigned int sq_entries = 0; //!< Size of the submission queue.
+
+                unsigned int *sq_array = nullptr; //!< Indices of the submission entries queued.
+
+                unsigned int tail = 0; //!< End of the submissions filled.
+
+                unsigned int *cq_head = nullptr; //!< Next completion to handle.
+
+                unsigned int *cq_tail = nullptr; //!< End of the completions posted.
+
+                unsigned int cq_mask = 0; //!< Mask of completion queue indices.
+
+                io_uring_cqe *cqes = nullptr; //!< The completion entries.
+
+                io_uring_buf_ring *buffers = static_cast<io_uring_buf_ring*>(MAP_FAILED); //!< The registered buffer ring.
+
+                char *data = static_cast<char*>(MAP_FAILED); //!< Memory of the receive buffers.
+
+                uint16_t buffers_tail = 0; //!< End of the buffers given to the kernel.
+
+                int wake = -1; //!< Event written to wake the thread.
+
+                uint64_t wake_value = 0; //!< Where the wake event is read to.
+
+                unsigned int armed = 0; //!< Number of multishot operations and reads in flight.
+
+                std::mutex mut; //!< Lock used to control access to the sockets added.
+
+                std::vector<std::shared_ptr<watched>> added; //!< Sockets given to the ring and not yet started.
+
+                std::vector<int> unlistened; //!< Listening sockets to stop accepting on.
+
+                std::unordered_map<watched*, std::shared_ptr<watched>> sockets; //!< The sockets of the ring.
+
+                std::unordered_set<watched*> timed; //!< The sockets whose stream has asked for a call.
+
+                std::thread thread; //!< The I/O thread.
+
+                /*!
+                 * \brief Creates a ring and registers its buffers.
+                 */
+                ring() noexcept(false)
+                {
+                    io_uring_params params;
+                    std::memset(&params, 0, sizeof(params));
+                    params.flags = IORING_SETUP_COOP_TASKRUN;
+                    fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+                    if (fd < 0 && errno == EINVAL)
+                    {
+                        // Older kernel.  Interrupting the thread for completions is fine.
+                        std::memset(&params, 0, sizeof(params));
+                        fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+                    }
+                    if (fd < 0)
+                        fail("Cannot create io_uring");
+                    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG))
+                        fail("io_uring lacks features needed", EOPNOTSUPP);
+                    // Map the rings
+                    auto sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+                    auto cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                    rings_size = sq_size > cq_size ? sq_size : cq_size;
+                    rings = mmap(nullptr, rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+                    if (rings == MAP_FAILED)
+                        fail("Cannot map io_uring");
+                    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+                    sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+                    if (sqes == MAP_FAILED)
+                        fail("Cannot map io_uring");
+                    auto base = static_cast<char*>(rings);
+                    sq_head = reinterpret_cast<unsigned int*>(base + params.sq_off.head);
+                    sq_tail = reinterpret_cast<unsigned int*>(base + params.sq_off.tail);
+                    sq_mask = *reinterpret_cast<unsigned int*>(base + params.sq_off.ring_mask);
+                    sq_entries = params.sq_entries;
+                    sq_array = reinterpret_cast<unsigned int*>(base + params.sq_off.array);
+                    tail = *sq_tail;
+                    cq_head = reinterpret_cast<unsigned int*>(base + params.cq_off.head);
+                    cq_tail = reinterpret_cast<unsigned int*>(base + params.cq_off.tail);
+                    cq_mask = *reinterpret_cast<unsigned int*>(base + params.cq_off.ring_mask);
+                    cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+                    // Register the receive buffers
+                    buffers = static_cast<io_uring_buf_ring*>(mmap(nullptr, BUFFERS * sizeof(io_uring_buf), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+                    data = static_cast<char*>(mmap(nullptr, BUFFERS * BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+                    if (buffers == MAP_FAILED || data == MAP_FAILED)
+                        fail("Cannot allocate io_uring buffers");
+                    io_uring_buf_reg reg;
+                    std::memset(&reg, 0, sizeof(reg));
+                    reg.ring_addr = reinterpret_cast<uint64_t>(buffers);
+                    reg.ring_entries = BUFFERS;
+                    reg.bgid = 0;
+                    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+                        fail("Cannot register io_uring buffers");
+                    for (uint16_t i = 0; i < BUFFERS; ++i)
+                        give_back(i);
+                    publish_buffers();
+                    wake = eventfd(0, EFD_CLOEXEC);
+                    if (wake < 0)
+                        fail("Cannot create event");
+                }
+
+                ring(const ring&) = delete;
+
+                ring& operator=(const ring&) = delete;
+
+                /*!
+                 * \brief Closes the ring, which cancels what is in flight, and frees its memory.
+                 */
+                ~ring() noexcept
+                {
+                    release();
+                }
+
+                /*!
+                 * \brief Frees what the ring holds.
+                 */
+                void release() noexcept
+                {
+                    if (fd >= 0)
+                        ::close(fd);
+                    if (wake >= 0)
+                        ::close(wake);
+                    if (rings != MAP_FAILED)
+                        munmap(rings, rings_size);
+                    if (sqes != MAP_FAILED)
+                        munmap(sqes, sqes_size);
+                    if (buffers != MAP_FAILED)
+                        munmap(buffers, BUFFERS * sizeof(io_uring_buf));
+                    if (data != MAP_FAILED)
+                        munmap(data, BUFFERS * BUFFER_SIZE);
+                    fd = wake = -1;
+                    rings = MAP_FAILED;
+                    sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+                    buffers = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+                    data = static_cast<char*>(MAP_FAILED);
+                }
+
+                /*!
+                 * \brief Frees what the ring holds and throws the error from creating it.
+                 *
+                 * \param[in] what What failed.
+                 * \param[in] error The error number.  By default errno.
+                 */
+                [[noreturn]] void fail(const char *what, int error = 0) noexcept(false)
+                {
+                    if (error == 0)
+                        error = errno;
+                    release();
+                    throw std::runtime_error(std::string(what) + ": " + std::strerror(error));
+                }
+
+                /*!
+                 * \brief Passes the submissions filled to the kernel, and waits for a completion.
+                 *
+                 * \param[in] wait Whether to wait for a completion.
+                 * \param[in] until The time to stop waiting.  The latest time point waits until a completion.
+                 */
+                void enter(bool wait, const std::chrono::steady_clock::time_point &until = std::chrono::steady_clock::time_point::max()) noexcept
+                {
+                    __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+                    auto submit = tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+                    // Do not wait if completions are already posted
+                    if (wait && __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE) != *cq_head)
+                        wait = false;
+                    if (!wait)
+                    {
+                        if (submit > 0)
+                            syscall(__NR_io_uring_enter, fd, submit, 0, 0, nullptr, 0);
+                        return;
+                    }
+                    if (until == std::chrono::steady_clock::time_point::max())
+                    {
+                        syscall(__NR_io_uring_enter, fd, submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        return;
+                    }
+                    auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(until - std::chrono::steady_clock::now()).count();
+                    if (left < 0)
+                        left = 0;
+                    __kernel_timespec timeout{left / 1000000000, left % 1000000000};
+                    io_uring_getevents_arg arg;
+                    std::memset(&arg, 0, sizeof(arg));
+                    arg.sigmask_sz = _NSIG / 8;
+                    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+                    syscall(__NR_io_uring_enter, fd, submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+                }
+
+                /*!
+                 * \brief Gets a cleared submission entry to fill.  Passes those filled to the kernel
+                 * if the queue is full.
+                 *
+                 * \return The entry.
+                 */
+                io_uring_sqe* next() noexcept
+                {
+                    while (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries)
+                        enter(false);
+                    auto index = tail & sq_mask;
+                    auto sqe = &sqes[index];
+                    std::memset(sqe, 0, sizeof(io_uring_sqe));
+                    sq_array[index] = index;
+                    ++tail;
+                    return sqe;
+                }
+
+                /*!
+                 * \brief Starts a multishot receive on a socket, into the registered buffers.
+                 *
+                 * \param[in] socket The socket.
+                 * \param[in] tag The tag of its completions.
+                 */
+                void receive(int socket, uint64_t tag) noexcept
+                {
+                    auto sqe = next();
+                    sqe->opcode = IORING_OP_RECV;
+                    sqe->fd = socket;
+                    sqe->flags = IOSQE_BUFFER_SELECT;
+                    sqe->ioprio = IORING_RECV_MULTISHOT;
+                    sqe->buf_group = 0;
+                    sqe->user_data = tag;
+                    ++armed;
+                }
+
+                /*!
+                 * \brief Starts a multishot accept on a listening socket.
+                 *
+                 * \param[in] socket The socket.
+                 * \param[in] tag The tag of its completions.
+                 */
+                void accept(int socket, uint64_t tag) noexcept
+                {
+                    auto sqe = next();
+                    sqe->opcode = IORING_OP_ACCEPT;
+                    sqe->fd = socket;
+                    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+                    sqe->accept_flags = SOCK_CLOEXEC;
+                    sqe->user_data = tag;
+                    ++armed;
+                }
+
+                /*!
+                 * \brief Starts a read of the wake event.
+                 */
+                void read_wake() noexcept
+                {
+                    auto sqe = next();
+                    sqe->opcode = IORING_OP_READ;
+                    sqe->fd = wake;
+                    sqe->addr = reinterpret_cast<uint64_t>(&wake_value);
+                    sqe->len = sizeof(wake_value);
+                    sqe->user_data = WAKE;
+                    ++armed;
+                }
+
+                /*!
+                 * \brief Cancels an operation in flight.
+                 *
+                 * \param[in] tag The tag of the operation.
+                 */
+                void cancel(uint64_t tag) noexcept
+                {
+                    auto sqe = next();
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->fd = -1;
+                    sqe->addr = tag;
+                    sqe->user_data = CANCEL;
+                }
+
+                /*!
+                 * \brief Cancels everything in flight.
+                 */
+                void cancel_all() noexcept
+                {
+                    auto sqe = next();
+                    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                    sqe->fd = -1;
+                    sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+                    sqe->user_data = CANCEL;
+                }
+
+                /*!
+                 * \brief Gives a receive buffer back to the kernel.  Seen once the buffers are published.
+                 *
+                 * \param[in] id The buffer.
+                 */
+                void give_back(uint16_t id) noexcept
+                {
+                    // Indexed by hand, as the header's flexible array is moved from the start of the ring in C++
+                    auto &b = reinterpret_cast<io_uring_buf*>(buffers)[buffers_tail & (BUFFERS - 1)];
+                    b.addr = reinterpret_cast<uint64_t>(data + id * BUFFER_SIZE);
+                    b.len = BUFFER_SIZE;
+                    b.bid = id;
+                    ++buffers_tail;
+                }
+
+                /*!
+                 * \brief Publishes the buffers given back.
+                 */
+                void publish_buffers() noexcept
+                {
+                    __atomic_store_n(&buffers->tail, buffers_tail, __ATOMIC_RELEASE);
+                }
+
+                /*!
+                 * \brief Handles the completions posted.
+                 *
+                 * \tparam F The type of the function handling a completion.
+                 *
+                 * \param[in] handle Called with each completion.
+                 */
+                template<typename F>
+                void complete(F handle) noexcept
+                {
+                    auto head = *cq_head;
+                    auto end = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+                    while (head != end)
+                    {
+                        // Copy the entry, so its slot can be reused while handling it
+                        auto cqe = cqes[head & cq_mask];
+                        ++head;
+                        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+                        if (!(cqe.flags & IORING_CQE_F_MORE) && cqe.user_data != CANCEL)
+                            --armed;
+                        handle(cqe);
+                        if (cqe.flags & IORING_CQE_F_BUFFER)
+                            give_back(static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT));
+                        end = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+                    }
+                    publish_buffers();
+                }
+
+                /*!
+                 * \brief Checks that the kernel gives multishot receives into registered buffers,
+                 * over a pair of connected sockets.
+                 *
+                 * \return True if it does.
+                 */
+                bool probe() noexcept
+                {
+                    int pair[2];
+                    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, pair) != 0)
+                        return false;
+                    receive(pair[0], PROBE);
+                    char byte = 0;
+                    auto works = ::write(pair[1], &byte, 1) == 1;
+                    bool more = false;
+                    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                    // Wait for the byte, then for the receive to end once the sockets are shut
+                    while (works && armed > 0 && std::chrono::steady_clock::now() < until)
+                    {
+                        enter(true, until);
+                        complete([&](const io_uring_cqe &cqe)
+                        {
+                            if (cqe.user_data != PROBE)
+                                return;
+                            if (cqe.res == 1 && (cqe.flags & IORING_CQE_F_MORE))
+                            {
+                                more = true;
+                                shutdown(pair[1], SHUT_RDWR);
+                            }
+                            else if (!more)
+                                works = false;
+                        });
+                    }
+                    ::close(pair[0]);
+                    ::close(pair[1]);
+                    return works && more && armed == 0;
+                }
+            };
+
+            std::vector<std::unique_ptr<ring>> _rings; //!< The rings, one per I/O thread.
+
+            std::atomic<unsigned int> _next; //!< The ring given the next socket.
+
+            std::atomic<bool> _stopping; //!< Whether the engine is stopping.
+
+            /*!
+             * \brief Gives a socket to a ring.
+             *
+             * \param[in] w The socket.
+             */
+            void add(std::shared_ptr<watched> w) noexcept(false)
+            {
+                auto &r = *_rings[_next.fetch_add(1) % _rings.size()];
+                {
+                    // Lock the mutex
+                    std::lock_guard<std::mutex> lock(r.mut);
+                    r.added.push_back(std::move(w));
+                }
+                if (!wake(r))
+                    throw std::runtime_error(std::string("Cannot wake I/O thread: ") + std::strerror(errno));
+            }
+
+            /*!
+             * \brief Wakes the I/O thread of a ring.
+             *
+             * \param[in] r The ring.
+             *
+             * \return True if woken.
+             */
+            static bool wake(ring &r) noexcept
+            {
+                uint64_t one = 1;
+                return ::write(r.wake, &one, sizeof(one)) == sizeof(one);
+            }
+
+            /*!
+             * \brief Records when a stream asked to be called.
+             *
+             * \param[in] r The ring of the socket.
+             * \param[in] w The socket.
+             * \param[in] due The time asked for.
+             */
+            static void set_due(ring &r, watched *w, const std::chrono::steady_clock::time_point &due) noexcept
+            {
+                w->due = due;
+                if (due == std::chrono::steady_clock::time_point::max())
+                    r.timed.erase(w);
+                else
+                    r.timed.insert(w);
+            }
+
+            /*!
+             * \brief Handles a completion for a socket.
+             *
+             * \param[in] r The ring of the socket.
+             * \param[in] cqe The completion.
+             */
+            static void handle(ring &r, const io_uring_cqe &cqe) noexcept
+            {
+                auto w = reinterpret_cast<watched*>(cqe.user_data);
+                auto more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+                bool again;
+                if (w->a)
+                {
+                    if (cqe.res >= 0)
+                        w->a->accepted(cqe.res);
+                    // Accepting goes on after a connection aborted or a lack of resources
+                    again = cqe.res >= 0 || cqe.res == -ECONNABORTED || cqe.res == -EINTR || cqe.res == -EMFILE || cqe.res == -ENFILE || cqe.res == -ENOBUFS || cqe.res == -ENOMEM;
+                }
+                else
+                {
+                    if (cqe.res > 0)
+                        set_due(r, w, w->s->received(r.data + (cqe.flags >> IORING_CQE_BUFFER_SHIFT) * BUFFER_SIZE, static_cast<size_t>(cqe.res)));
+                    // Receiving goes on after running out of buffers, which are given back once handled
+                    again = cqe.res > 0 || cqe.res == -ENOBUFS || cqe.res == -EINTR || cqe.res == -EAGAIN;
+                }
+                if (more)
+                    return;
+                if (again)
+                {
+                    if (w->a)
+                        r.accept(w->fd, cqe.user_data);
+                    else
+                        r.receive(w->fd, cqe.user_data);
+                    return;
+                }
+                // Closed or failed
+                auto kept = std::move(r.sockets[w]);
+                r.sockets.erase(w);
+                r.timed.erase(w);
+                if (w->a)
+                    w->a->closed();
+                else
+                    w->s->closed();
+            }
+
+            /*!
+             * \brief Calls the streams of a ring whose time has been reached.
+             *
+             * \param[in] r The ring.
+             *
+             * \return The earliest time a stream has asked for.
+             */
+            static std::chrono::steady_clock::time_point run_timers(ring &r) noexcept
+            {
+                auto now = std::chrono::steady_clock::now();
+                auto next = std::chrono::steady_clock::time_point::max();
+                std::vector<watched*> due;
+                for (auto w : r.timed)
+                {
+                    if (w->due <= now)
+                        due.push_back(w);
+                    else if (w->due < next)
+                        next = w->due;
+                }
+                for (auto w : due)
+                {
+                    auto again = w->s->timer();
+                    set_due(r, w, again);
+                    if (again < next)
+                        next = again;
+                }
+                return next;
+            }
+
+            /*!
+             * \brief Serves the sockets of a ring until the engine stops.  Run by its I/O thread.
+             *
+             * \param[in] r The ring.
+             */
+            void run(ring *r) noexcept
+            {
+                r->read_wake();
+                auto next = std::chrono::steady_clock::time_point::max();
+                bool stopping = false;
+                while (!stopping)
+                {
+                    r->enter(true, next);
+                    r->complete([&](const io_uring_cqe &cqe)
+                    {
+                        if (cqe.user_data == CANCEL)
+                            return;
+                        if (cqe.user_data != WAKE)
+                        {
+                            handle(*r, cqe);
+                            return;
+                        }
+                        if (_stopping.load())
+                        {
+                            stopping = true;
+                            return;
+                        }
+                        // Start on the sockets added, then stop accepting on those asked
+                        std::vector<std::shared_ptr<watched>> added;
+                        std::vector<int> unlistened;
+                        {
+                            // Lock the mutex
+                            std::lock_guard<std::mutex> lock(r->mut);
+                            added.swap(r->added);
+                            unlistened.swap(r->unlistened);
+                        }
+                        for (auto &w : added)
+                        {
+                            auto tag = reinterpret_cast<uint64_t>(w.get());
+                            if (w->a)
+                                r->accept(w->fd, tag);
+                            else
+                                r->receive(w->fd, tag);
+                            r->sockets[w.get()] = std::move(w);
+                        }
+                        // The accept ends cancelled, and its acceptor is then told
+                        for (auto fd : unlistened)
+                            for (auto &entry : r->sockets)
+                                if (entry.second->a && entry.second->fd == fd)
+                                    r->cancel(reinterpret_cast<uint64_t>(entry.first));
+                        r->read_wake();
+                    });
+                    next = run_timers(*r);
+                }
+                // Cancel what is in flight, and wait for it to end before the buffers are freed
+                r->cancel_all();
+                auto until = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (r->armed > 0 && std::chrono::steady_clock::now() < until)
+                {
+                    r->enter(true, until);
+                    r->complete([](const io_uring_cqe&) { });
+                }
+            }
+
+        public:
+            /*!
+             * \brief Creates an engine and starts its I/O threads.
+             *
+             * \param[in] threads The number of I/O threads, each with its own ring.
+             */
+            explicit uring_engine(unsigned int threads = 1) noexcept(false)
+            : _next(0), _stopping(false)
+            {
+                for (unsigned int i = 0; i < (threads > 0 ? threads : 1); ++i)
+                    _rings.emplace_back(new ring());
+                if (!_rings[0]->probe())
+                    throw std::runtime_error("io_uring lacks multishot receive into registered buffers");
+                for (auto &r : _rings)
+                    r->thread = std::thread(&uring_engine::run, this, r.get());
+            }
+
+            uring_engine(const uring_engine&) = delete;
+
+            uring_engine& operator=(const uring_engine&) = delete;
+
+            /*!
+             * \brief Stops the I/O threads.
+             */
+            ~uring_engine() noexcept
+            {
+                _stopping.store(true);
+                for (auto &r : _rings)
+                    wake(*r);
+                for (auto &r : _rings)
+                    r->thread.join();
+            }
+
+            /*!
+             * \brief Starts receiving on a connected socket.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] s The stream to hand the bytes received.
+             */
+            void watch(int fd, std::shared_ptr<stream> s) noexcept(false) override final
+            {
+                auto w = std::make_shared<watched>();
+                w->fd = fd;
+                w->s = std::move(s);
+                add(std::move(w));
+            }
+
+            /*!
+             * \brief Starts accepting on a listening socket.
+             *
+             * \param[in] fd The socket.  Stays owned by the caller.
+             * \param[in] a The acceptor to hand the sockets accepted.
+             */
+            void listen(int fd, std::shared_ptr<acceptor> a) noexcept(false) override final
+            {
+                auto w = std::make_shared<watched>();
+                w->fd = fd;
+                w->a = std::move(a);
+                add(std::move(w));
+            }
+
+            /*!
+             * \brief Stops accepting on a listening socket.  Each ring is asked, as any may hold it.
+             *
+             * \param[in] fd The socket.
+             */
+            void unlisten(int fd) noexcept override final
+            {
+                for (auto &r : _rings)
+                {
+                    {
+                        // Lock the mutex
+                        std::lock_guard<std::mutex> lock(r->mut);
+                        r->unlistened.push_back(fd);
+                    }
+                    wake(*r);
+                }
+            }
+
+            /*!
+             * \brief Gets the name of the engine.
+             *
+             * \return The name.
+             */
+            const char* name() const noexcept override final { return "io_uring"; }
+        };
+    }
+}
+
+#endif
+
+#endif //CPP_CSP_URING_ENGINE_H
@@ -14,6 +14,7 @@
 #include <set>
 #include "process.h"
 #include "barrier.h"
+#include "fiber_scheduler.h"
 
 namespace csp
 {
@@ -45,7 +46,7 @@ namespace csp
 
             barrier _bar; //<! The barrier used to synchronise parallel completion.
 
-            barrier _park = barrier(2); //<! The barrier used to coordinate completion of this thread.
+            barrier _park = barrier(2, barrier::best_kind()); //<! The barrier used to coordinate completion of this thread.
 
             bool _running = true; //<! Flag used to determine if the thread is running.
 
@@ -208,6 +209,12 @@ namespace csp
              */
             void run() noexcept
             {
+                // If the fiber scheduler is running, run the processes on it instead of on threads
+                if (fiber_scheduler::active())
+                {
+                    run_fibers();
+                    return;
+                }
                 // Flag to indicate if this is an empty run
                 bool empty_run = true;
                 // Process that the main thread running the par executes
@@ -224,8 +231,9 @@ namespace csp
                     // Check if processes have changed
                     if (_process_changed)
                     {
-                        // Set barrier
-                        _barrier.reset(static_cast<unsigned int>(_processes.size()));
+                        // Set barrier.  A new one is made, as a process of the last run may still be leaving the old one.
+                        auto size = static_cast<unsigned int>(_processes.size());
+                        _barrier = barrier(size, barrier::best_kind());
                         // If the threads is less than number required add to the threads
                         if (_threads.size() < _processes.size() - 1)
                         {
@@ -279,6 +287,31 @@ namespace csp
                 }
             }
 
+            /*!
+             * \brief Runs the processes in parallel as fibers on the fiber scheduler.
+             */
+            void run_fibers() noexcept
+            {
+                // Nothing to do if there are no processes
+                if (_processes.size() == 0)
+                    return;
+                // A fiber runs the last process itself.  A thread leaves all processes to the workers.
+                auto spawned = fiber_scheduler::in_fiber() ? _processes.size() - 1 : _processes.size();
+                // Barrier used to wait for all processes to complete, including the caller
+                auto size = static_cast<unsigned int>(spawned) + 1;
+                barrier bar(size, barrier::best_kind());
+                for (size_t i = 0; i < spawned; ++i)
+                {
+                    auto proc = _processes[i];
+                    fiber_scheduler::spawn([proc, bar]() { proc(); bar(); });
+                }
+                // Run our own process if we kept one
+                if (spawned < _processes.size())
+                    _processes[spawned]();
+                // Sync with barrier
+                bar();
+            }
+
             /*!
              * \brief Adds a thread to the list of all threads associated with the framework.
              *
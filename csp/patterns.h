@@ -7,14 +7,20 @@
 
 #include <vector>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <atomic>
+#include <type_traits>
 #include <cassert>
 #include "chan.h"
 #include "par.h"
+#include "worker_pool.h"
 
 namespace csp
 {
     /*!
-     * \brief Executes a parallel across a collection of data.
+     * \brief Executes a parallel across a collection of data.  The function runs on the worker pool,
+     * once per item, and every item may run at the same time.
      *
      * \tparam RanIt Type of the data range.
      * \tparam Fun Type of the function.
@@ -26,32 +32,298 @@ namespace csp
     template<typename RanIt, typename Fun>
     void par_for(RanIt begin, RanIt end, Fun &&f) noexcept
     {
-        // Create vector of functions.
-        std::vector<std::function<void()>> procs;
-        for (RanIt data = begin; data != end; ++data)
-            procs.push_back(std::bind(f, *data));
-        // Create a par with the functions
-        par p(procs);
-        // Run the par
-        p();
+        // Run each item as its own chunk, as the items may block on each other
+        worker_pool::run(static_cast<size_t>(std::distance(begin, end)), 1, [&](size_t i) { f(*(begin + i)); });
     }
 
-    /*
-     * \brief Executes a n copies of the function in parallel.
+    /*!
+     * \brief Executes n copies of the function in parallel.  Every copy may run at the same time.
      *
      * \param[in] n The number of copies of the function to run.
      * \param[in] f The function to execute.
      */
-    void par_for_n(size_t n, std::function<void()> &&f) noexcept
+    inline void par_for_n(size_t n, std::function<void()> &&f) noexcept
+    {
+        worker_pool::run(n, 1, [&f](size_t) { f(); });
+    }
+
+    /*!
+     * \brief Gets the grain to split a loop into when none is given.  Gives each core a few chunks
+     * so that uneven iterations still balance.
+     *
+     * \param[in] n The number of iterations.
+     *
+     * \return The number of iterations in a chunk.
+     */
+    inline size_t par_grain(size_t n) noexcept
     {
-        // Create vector of functions.
-        std::vector<std::function<void()>> procs;
-        for (size_t i = 0; i < n; ++i)
-            procs.push_back(f);
-        // Create a par with the functions
-        par p(procs);
-        // Run the par
-        p();
+        auto chunks = 4 * (worker_pool::core_helpers() + 1);
+        return n > chunks ? n / chunks : 1;
+    }
+
+    /*!
+     * \brief Executes a loop over the indices [0, n) in parallel.  The indices are split into blocks
+     * of the given grain, which the cores take in turn until none are left.  Returns once every
+     * iteration has finished.
+     *
+     * The iterations only compute, and must not wait on each other.
+     *
+     * \tparam Fun The type of the loop body.
+     *
+     * \param[in] n The number of iterations.
+     * \param[in] f The loop body, called with each index.
+     * \param[in] grain The number of iterations in a block.  Zero picks one from the number of cores.
+     */
+    template<typename Fun>
+    auto par_for_n(size_t n, Fun &&f, size_t grain = 0) noexcept -> decltype(f(size_t(0)), void())
+    {
+        worker_pool::run(n, grain == 0 ? par_grain(n) : grain, f, worker_pool::core_helpers());
+    }
+
+    /*!
+     * \brief Executes a loop over a range of data in parallel, in blocks of the given grain.
+     *
+     * The iterations only compute, and must not wait on each other.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam Fun The type of the loop body.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[in] grain The number of items in a block.  Zero picks one from the number of cores.
+     * \param[in] f The loop body, called with each item.
+     */
+    template<typename RanIt, typename Fun>
+    typename std::enable_if<!std::is_integral<RanIt>::value>::type par_for_range(RanIt begin, RanIt end, size_t grain, Fun &&f) noexcept
+    {
+        par_for_n(static_cast<size_t>(std::distance(begin, end)), [&](size_t i) { f(*(begin + i)); }, grain);
+    }
+
+    /*!
+     * \brief Executes a loop over a range of indices in parallel, in blocks of the given grain.
+     *
+     * The iterations only compute, and must not wait on each other.
+     *
+     * \tparam Int The type of the indices.
+     * \tparam Fun The type of the loop body.
+     *
+     * \param[in] begin The first index.
+     * \param[in] end One past the last index.
+     * \param[in] grain The number of indices in a block.  Zero picks one from the number of cores.
+     * \param[in] f The loop body, called with each index.
+     */
+    template<typename Int, typename Fun>
+    typename std::enable_if<std::is_integral<Int>::value>::type par_for_range(Int begin, Int end, size_t grain, Fun &&f) noexcept
+    {
+        if (end <= begin)
+            return;
+        par_for_n(static_cast<size_t>(end - begin), [&](size_t i) { f(static_cast<Int>(begin + i)); }, grain);
+    }
+
+    /*!
+     * \brief Reduces a range of data in parallel after transforming each item.  The range is split
+     * into blocks, one per iteration of a loop on the worker pool.  Each block is reduced in order,
+     * then the blocks are combined up a binary tree.  The second block of a pair to finish combines
+     * the pair, so no process waits for another.
+     *
+     * The operation must be associative.  It need not be commutative, as blocks are only combined
+     * with their neighbours and in order.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam T The type of the result.
+     * \tparam Op The type of the reduction.
+     * \tparam Trans The type of the transformation.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[in] init The value the reduction starts from.
+     * \param[in] op The reduction, taking two values of type T.
+     * \param[in] trans The transformation applied to each item.
+     *
+     * \return init combined with each transformed item in turn.
+     */
+    template<typename RanIt, typename T, typename Op, typename Trans>
+    T par_transform_reduce(RanIt begin, RanIt end, T init, Op op, Trans trans) noexcept
+    {
+        auto n = static_cast<size_t>(std::distance(begin, end));
+        if (n == 0)
+            return init;
+        auto grain = par_grain(n);
+        auto blocks = (n + grain - 1) / grain;
+        // The result of each block, and of each pair of blocks once combined, is held at the index
+        // of its first block
+        std::vector<T> partials(blocks, init);
+        // Number of children that have finished for each pair, indexed by the in-order position of
+        // the pair in the tree
+        std::unique_ptr<std::atomic<unsigned char>[]> arrived(new std::atomic<unsigned char>[blocks]);
+        for (size_t i = 0; i < blocks; ++i)
+            arrived[i].store(0, std::memory_order_relaxed);
+        worker_pool::run(blocks, 1, [&](size_t block)
+        {
+            // Reduce the block
+            auto first = block * grain;
+            auto last = first + grain < n ? first + grain : n;
+            T acc = trans(*(begin + first));
+            for (auto i = first + 1; i < last; ++i)
+                acc = op(acc, trans(*(begin + i)));
+            partials[block] = std::move(acc);
+            // Climb the tree while we are the second child of a pair to finish
+            for (size_t width = 1; width < blocks; width *= 2)
+            {
+                auto left = block & ~(2 * width - 1);
+                auto right = left + width;
+                if (right < blocks)
+                {
+                    if (arrived[right - 1].fetch_add(1) == 0)
+                        return;
+                    partials[left] = op(partials[left], partials[right]);
+                }
+                block = left;
+            }
+        }, worker_pool::core_helpers());
+        return op(init, partials[0]);
+    }
+
+    /*!
+     * \brief Reduces a range of data in parallel.
+     *
+     * The operation must be associative.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam T The type of the result.
+     * \tparam Op The type of the reduction.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[in] init The value the reduction starts from.
+     * \param[in] op The reduction, taking two values of type T.
+     *
+     * \return init combined with each item in turn.
+     */
+    template<typename RanIt, typename T, typename Op>
+    T par_reduce(RanIt begin, RanIt end, T init, Op op) noexcept
+    {
+        return par_transform_reduce(begin, end, init, op, [](const typename std::iterator_traits<RanIt>::value_type &x) { return x; });
+    }
+
+    /*!
+     * \brief Scans a range of data in parallel.  Each block is reduced on the worker pool, the block
+     * totals are scanned in turn, and then each block is scanned from the total of the blocks before
+     * it.  With more than one core each item is read twice and written once.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam OutIt The type of the output range.
+     * \tparam T The type of the results.
+     * \tparam Op The type of the operation.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[out] out Beginning of the output range.  May be the data range.
+     * \param[in] init The value the scan starts from.
+     * \param[in] op The operation, taking two values of type T.  Must be associative.
+     * \param[in] inclusive True if each output includes the item at its position, false otherwise.
+     *
+     * \return The end of the output range.
+     */
+    template<typename RanIt, typename OutIt, typename T, typename Op>
+    OutIt par_scan(RanIt begin, RanIt end, OutIt out, T init, Op op, bool inclusive) noexcept
+    {
+        auto n = static_cast<size_t>(std::distance(begin, end));
+        if (n == 0)
+            return out;
+        // On one core the first pass only costs more, so scan as one block
+        auto grain = worker_pool::core_helpers() == 0 ? n : par_grain(n);
+        auto blocks = (n + grain - 1) / grain;
+        // Total of each block
+        std::vector<T> totals(blocks, init);
+        worker_pool::run(blocks - 1, 1, [&](size_t block)
+        {
+            auto first = block * grain;
+            T acc = *(begin + first);
+            for (auto i = first + 1; i < first + grain; ++i)
+                acc = op(acc, *(begin + i));
+            totals[block] = std::move(acc);
+        }, worker_pool::core_helpers());
+        // Turn the totals into the value each block starts from
+        T carry = init;
+        for (size_t block = 0; block < blocks; ++block)
+        {
+            T total = std::move(totals[block]);
+            totals[block] = carry;
+            if (block + 1 < blocks)
+                carry = op(carry, total);
+        }
+        // Scan each block from its start.  Each item is read before its output is written.
+        worker_pool::run(blocks, 1, [&](size_t block)
+        {
+            auto first = block * grain;
+            auto last = first + grain < n ? first + grain : n;
+            T acc = totals[block];
+            for (auto i = first; i < last; ++i)
+            {
+                T x = *(begin + i);
+                if (inclusive)
+                {
+                    acc = op(acc, x);
+                    *(out + i) = acc;
+                }
+                else
+                {
+                    *(out + i) = acc;
+                    acc = op(acc, x);
+                }
+            }
+        }, worker_pool::core_helpers());
+        return out + n;
+    }
+
+    /*!
+     * \brief Performs an inclusive scan of a range of data in parallel.  Each output is the
+     * combination of every item up to and including its position.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam OutIt The type of the output range.
+     * \tparam Op The type of the operation.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[out] out Beginning of the output range.  May be the data range.
+     * \param[in] op The operation.  Must be associative.
+     *
+     * \return The end of the output range.
+     */
+    template<typename RanIt, typename OutIt, typename Op>
+    OutIt par_inclusive_scan(RanIt begin, RanIt end, OutIt out, Op op) noexcept
+    {
+        if (begin == end)
+            return out;
+        // The first item starts the scan of the rest
+        typename std::iterator_traits<RanIt>::value_type first = *begin;
+        *out = first;
+        return par_scan(begin + 1, end, out + 1, first, op, true);
+    }
+
+    /*!
+     * \brief Performs an exclusive scan of a range of data in parallel.  Each output is the
+     * starting value combined with every item before its position.
+     *
+     * \tparam RanIt The type of the data range.
+     * \tparam OutIt The type of the output range.
+     * \tparam T The type of the results.
+     * \tparam Op The type of the operation.
+     *
+     * \param[in] begin Beginning of the range of data.
+     * \param[in] end End of the range of data.
+     * \param[out] out Beginning of the output range.  May be the data range.
+     * \param[in] init The value the scan starts from.
+     * \param[in] op The operation.  Must be associative.
+     *
+     * \return The end of the output range.
+     */
+    template<typename RanIt, typename OutIt, typename T, typename Op>
+    OutIt par_exclusive_scan(RanIt begin, RanIt end, OutIt out, T init, Op op) noexcept
+    {
+        return par_scan(begin, end, out, init, op, false);
     }
 
     /*!
@@ -68,21 +340,7 @@ namespace csp
     {
         // Create vector of channels.
         std::vector<chan_in<T>> channels(chans);
-        // Vector to read values into
-        std::vector<T> values(channels.size());
-        // Create vector of processes to run
-        std::vector<std::function<void()>> procs(channels.size());
-        unsigned int i = 0;
-        for (auto &c : channels)
-        {
-            procs[i] = [=, &c, &values](){ values[i] = c(); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
-        // Return values
-        return values;
+        return par_read(channels);
     }
 
     /*!
@@ -99,17 +357,8 @@ namespace csp
     {
         // Vector to read values into
         std::vector<T> values(chans.size());
-        // Create vector of processes to run
-        std::vector<std::function<void()>> procs;
-        unsigned int i = 0;
-        for (auto &c : chans)
-        {
-            procs[i] = [=, &c, &values]() { values[i] = c(); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
+        // Read each channel on the worker pool
+        worker_pool::run(chans.size(), 1, [&](size_t i) { values[i] = chans[i](); });
         // Return values
         return values;
     }
@@ -129,21 +378,7 @@ namespace csp
         static_assert(std::iterator_traits<RanIt>::value_type == typeid(chan_in<T>), "par_read requires a collection of chan_in");
         // Vector of channels
         std::vector<chan_in<T>> chans(begin, end);
-        // Vector to read values into
-        std::vector<T> values(chans.size());
-        // Create vector of processes to run
-        std::vector<std::function<void()>> procs(chans.size());
-        unsigned int i = 0;
-        for (auto &c : chans)
-        {
-            procs[i] = [=, &c, &values](){ values[i] = c(); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
-        // Return values
-        return values;
+        return par_read(chans);
     }
 
     /*!
@@ -157,20 +392,9 @@ namespace csp
     template<typename T>
     void par_write(std::initializer_list<chan_out<T>> &&chans, const std::vector<T> &values) noexcept
     {
-        assert(chans.size() == values.size());
         // Create vector of channels
         std::vector<chan_out<T>> channels(chans);
-        // Create vector of processes to run
-        std::vector<std::function<void()>> procs(channels.size());
-        unsigned int i = 0;
-        for (auto &c : channels)
-        {
-            procs[i] = [=, &c, &values]() { c(values[i]); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
+        par_write(channels, values);
     }
 
     /*!
@@ -185,17 +409,8 @@ namespace csp
     void par_write(std::vector<chan_out<T>> &chans, const std::vector<T> &values) noexcept
     {
         assert(chans.size() == values.size());
-        // Create vector of processes to run
-        std::vector<std::function<void()>> procs(chans.size());
-        unsigned int i = 0;
-        for (auto &c : chans)
-        {
-            procs[i] = [=, &c, &values](){ c(values[i]); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
+        // Write each channel on the worker pool
+        worker_pool::run(chans.size(), 1, [&](size_t i) { chans[i](values[i]); });
     }
 
     /*!
@@ -213,18 +428,7 @@ namespace csp
     {
         static_assert(std::iterator_traits<RanIt>::value_type == typeid(chan_out<T>), "par_write requires a collection of chan_out");
         std::vector<chan_out<T>> chans(begin, end);
-        assert(chans.size() == values.size());
-        // Create a vector of processes to run
-        std::vector<std::function<void()>> procs(chans.size());
-        unsigned int i = 0;
-        for (auto &c : chans)
-        {
-            procs[i] = [=, &c, &values](){ c(values[i]); };
-            ++i;
-        }
-        // Run parallel
-        par p(procs);
-        p();
+        par_write(chans, values);
     }
 }
 
@@ -5,15 +5,20 @@
 #ifndef CPP_CSP_BLOCK_H
 #define CPP_CSP_BLOCK_H
 
+#include <functional>
 #include <memory>
-#include "../process.h"
+#include <vector>
+#include "../par.h"
+#include "connector.h"
 
 namespace csp
 {
     namespace skeletons
     {
-        /* \class block
-         * \brief Base building block for a skeleton application.
+        /*! \class block
+         * \brief Base building block for a skeleton application.  A block reads a stream of items
+         * from one connector and writes a stream to another, and closes its output once its input
+         * has ended.
          *
          * \tparam IN The input type into the block.
          * \tparam OUT The output type from the block
@@ -23,10 +28,10 @@ namespace csp
          * \date 12/08/2016
          */
         template<typename IN, typename OUT>
-        class block : public process
+        class block
         {
         protected:
-            /* \class block_internal
+            /*! \class block_internal
              * \brief Internal representation of a block.
              *
              * \author Kevin Chalmers
@@ -35,14 +40,154 @@ namespace csp
              */
             class block_internal
             {
+            public:
+                /*!
+                 * \brief Virtual destructor.
+                 */
+                virtual ~block_internal() noexcept { }
 
+                /*!
+                 * \brief Runs the block until its input ends.
+                 *
+                 * \param[in] in The input stream.
+                 * \param[in] out The output stream.  Closed on return.
+                 */
+                virtual void run(connector_in<IN> in, connector_out<OUT> out) noexcept = 0;
             };
 
-            std::shared_ptr<block_internal> _internal = nullptr; //<! Pointer to internal representation.
+            std::shared_ptr<block_internal> _internal = nullptr; //!< Pointer to internal representation.
+
+            /*!
+             * \brief Creates a block from its internal representation.
+             *
+             * \param[in] internal The internal representation of the block.
+             */
+            block(std::shared_ptr<block_internal> internal) noexcept
+            : _internal(internal)
+            {
+            }
+
+        public:
+            /*!
+             * \brief Virtual destructor.
+             */
+            virtual ~block() noexcept { }
+
+            /*!
+             * \brief Runs the block until its input ends.
+             *
+             * \param[in] in The input stream.
+             * \param[in] out The output stream.  Closed on return.
+             */
+            void operator()(connector_in<IN> in, connector_out<OUT> out) const noexcept { _internal->run(in, out); }
+
+            /*!
+             * \brief Creates a process that runs the block.
+             *
+             * \param[in] in The input stream.
+             * \param[in] out The output stream.
+             *
+             * \return A process to run in a par.
+             */
+            std::function<void()> process(connector_in<IN> in, connector_out<OUT> out) const noexcept
+            {
+                auto internal = _internal;
+                return [internal, in, out]() { internal->run(in, out); };
+            }
+        };
+
+        /*! \class wrapper
+         * \brief A block that applies a function to each item.
+         *
+         * \tparam IN The input type into the block.
+         * \tparam OUT The output type from the block.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 12/08/2016
+         */
+        template<typename IN, typename OUT>
+        class wrapper : public block<IN, OUT>
+        {
+        protected:
+            /*! \class wrapper_internal
+             * \brief Internal representation of a wrapper.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 12/08/2016
+             */
+            class wrapper_internal : public block<IN, OUT>::block_internal
+            {
+            private:
+                std::function<OUT(IN)> _fun; //!< The function applied to each item.
+
+            public:
+                wrapper_internal(std::function<OUT(IN)> fun) noexcept
+                : _fun(std::move(fun))
+                {
+                }
+
+                void run(connector_in<IN> in, connector_out<OUT> out) noexcept override final
+                {
+                    while (!in.finished())
+                        out(_fun(in()));
+                    out.close();
+                }
+            };
 
         public:
-            template<typename OTHER_IN, typename OTHER_OUT>
+            /*!
+             * \brief Creates a block that applies a function to each item.
+             *
+             * \param[in] fun The function to apply.
+             */
+            wrapper(std::function<OUT(IN)> fun) noexcept
+            : block<IN, OUT>(std::make_shared<wrapper_internal>(std::move(fun)))
+            {
+            }
         };
+
+        /*!
+         * \brief Runs a block over a range of items and gathers what it outputs.
+         *
+         * \tparam IN The input type into the block.
+         * \tparam OUT The output type from the block.
+         * \tparam RanIt The type of the range.
+         *
+         * \param[in] b The block to run.
+         * \param[in] begin The start of the range.
+         * \param[in] end The end of the range.
+         * \param[in] batch The number of items sent to the block together.
+         *
+         * \return The items output by the block, in the order they were output.
+         */
+        template<typename IN, typename OUT, typename RanIt>
+        std::vector<OUT> apply(const block<IN, OUT> &b, RanIt begin, RanIt end, size_t batch = 1) noexcept
+        {
+            connector<IN> input(1, 1, batch);
+            connector<OUT> output(1, 1, batch);
+            std::vector<OUT> results;
+            auto source = input.out();
+            auto sink = output.in();
+            par p
+            {
+                [&]()
+                {
+                    for (auto it = begin; it != end; ++it)
+                        source(*it);
+                    source.close();
+                },
+                b.process(input.in(), output.out()),
+                [&]()
+                {
+                    while (!sink.finished())
+                        results.push_back(sink());
+                }
+            };
+            p();
+            return results;
+        }
     }
 }
 
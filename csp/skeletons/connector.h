@@ -0,0 +1,322 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_CONNECTOR_H
+#define CPP_CSP_CONNECTOR_H
+
+#include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../chan.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        template<typename T>
+        class connector;
+
+        /*! \class connector_in
+         * \brief The reading end of a connector.  Reads the stream one item at a time until every
+         * writer has closed it.
+         *
+         * Each reader takes its own end from the connector, as an end holds the rest of the batch
+         * last read.
+         *
+         * \tparam T The type of the items.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class connector_in
+        {
+            friend class connector<T>;
+        protected:
+            /*! \class connector_in_internal
+             * \brief Internal representation of the reading end of a connector.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class connector_in_internal
+            {
+            private:
+                chan_in<std::vector<T>> _chan; //!< Channel the batches arrive on.
+
+                unsigned int _ends; //!< Number of end markers still to read.
+
+                std::vector<T> _batch; //!< Batch being read.
+
+                size_t _next = 0; //!< Index of the next item of the batch.
+
+            public:
+                connector_in_internal(chan_in<std::vector<T>> chan, unsigned int ends) noexcept
+                : _chan(chan), _ends(ends)
+                {
+                }
+
+                /*!
+                 * \brief Reads batches until one holds an item or the stream ends.
+                 *
+                 * \return True if an item is ready, false if the stream has ended.
+                 */
+                bool fill() noexcept
+                {
+                    while (_next == _batch.size())
+                    {
+                        if (_ends == 0)
+                            return false;
+                        _batch = _chan();
+                        _next = 0;
+                        // An empty batch marks the end of a writer
+                        if (_batch.empty())
+                            --_ends;
+                    }
+                    return true;
+                }
+
+                T read() noexcept
+                {
+                    auto ready = fill();
+                    assert(ready);
+                    (void)ready;
+                    return std::move(_batch[_next++]);
+                }
+            };
+
+            std::shared_ptr<connector_in_internal> _internal = nullptr; //!< Pointer to the internal representation.
+
+            connector_in(chan_in<std::vector<T>> chan, unsigned int ends) noexcept
+            : _internal(std::make_shared<connector_in_internal>(chan, ends))
+            {
+            }
+
+        public:
+            /*!
+             * \brief Reads the next item.  Only call if finished returns false.
+             *
+             * \return The next item of the stream.
+             */
+            T operator()() const noexcept { return _internal->read(); }
+
+            /*!
+             * \brief Checks whether the stream has ended.  Waits for the next item if none is held.
+             *
+             * \return True if every writer has closed the stream and every item has been read, false otherwise.
+             */
+            bool finished() const noexcept { return !_internal->fill(); }
+        };
+
+        /*! \class connector_out
+         * \brief The writing end of a connector.  Gathers items into batches, and marks the end of the
+         * stream when closed.
+         *
+         * Each writer takes its own end from the connector, and must close it once done.
+         *
+         * \tparam T The type of the items.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class connector_out
+        {
+            friend class connector<T>;
+        protected:
+            /*! \class connector_out_internal
+             * \brief Internal representation of the writing end of a connector.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class connector_out_internal
+            {
+            private:
+                chan_out<std::vector<T>> _chan; //!< Channel the batches are sent on.
+
+                unsigned int _ends; //!< Number of end markers to send when closed.
+
+                size_t _size; //!< Number of items in a full batch.
+
+                std::vector<T> _pending; //!< Items not yet sent.
+
+            public:
+                connector_out_internal(chan_out<std::vector<T>> chan, unsigned int ends, size_t size) noexcept
+                : _chan(chan), _ends(ends), _size(size > 0 ? size : 1)
+                {
+                }
+
+                void write(T value) noexcept
+                {
+                    _pending.push_back(std::move(value));
+                    if (_pending.size() >= _size)
+                        flush();
+                }
+
+                void flush() noexcept
+                {
+                    if (_pending.empty())
+                        return;
+                    _chan(std::move(_pending));
+                    _pending = std::vector<T>();
+                    _pending.reserve(_size);
+                }
+
+                void close() noexcept
+                {
+                    flush();
+                    for (unsigned int i = 0; i < _ends; ++i)
+                        _chan(std::vector<T>());
+                }
+            };
+
+            std::shared_ptr<connector_out_internal> _internal = nullptr; //!< Pointer to the internal representation.
+
+            connector_out(chan_out<std::vector<T>> chan, unsigned int ends, size_t batch) noexcept
+            : _internal(std::make_shared<connector_out_internal>(chan, ends, batch))
+            {
+            }
+
+        public:
+            /*!
+             * \brief Writes an item.  The item is sent once the batch is full.
+             *
+             * \param[in] value The item to write.
+             */
+            void operator()(T value) const noexcept { _internal->write(std::move(value)); }
+
+            /*!
+             * \brief Sends any items held without waiting for the batch to fill.
+             */
+            void flush() const noexcept { _internal->flush(); }
+
+            /*!
+             * \brief Sends any items held and marks the end of this writer's stream.
+             */
+            void close() const noexcept { _internal->close(); }
+        };
+
+        /*! \class connector
+         * \brief A stream between the blocks of a skeleton.  Items travel in batches over a channel,
+         * and an empty batch marks the end of a writer.
+         *
+         * A connector has either one writer or one reader.  With many writers the reader waits for
+         * each writer to close.  With many readers the writer sends an end to each of them.
+         *
+         * \tparam T The type of the items.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class connector
+        {
+        protected:
+            /*! \class connector_internal
+             * \brief Internal representation of a connector.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class connector_internal
+            {
+            public:
+                chan_in<std::vector<T>> _in; //!< The reading end of the channel.
+
+                chan_out<std::vector<T>> _out; //!< The writing end of the channel.
+
+                unsigned int _writers; //!< Number of writers.
+
+                unsigned int _readers; //!< Number of readers.
+
+                size_t _batch; //!< Number of items in a full batch.
+
+                connector_internal(unsigned int writers, unsigned int readers, size_t batch, unsigned int capacity) noexcept
+                : connector_internal(make(writers, readers, capacity), writers, readers, batch)
+                {
+                }
+
+            private:
+                using ends = std::pair<chan_in<std::vector<T>>, chan_out<std::vector<T>>>;
+
+                connector_internal(const ends &e, unsigned int writers, unsigned int readers, size_t batch) noexcept
+                : _in(e.first), _out(e.second), _writers(writers), _readers(readers), _batch(batch)
+                {
+                }
+
+                template<typename CHAN>
+                static ends of(const CHAN &c) noexcept { return ends(c.in(), c.out()); }
+
+                /*!
+                 * \brief Creates the cheapest channel for the ends that share it.
+                 *
+                 * \param[in] writers The number of writers.
+                 * \param[in] readers The number of readers.
+                 * \param[in] capacity The number of batches buffered, or zero for none.
+                 *
+                 * \return The ends of the channel.
+                 */
+                static ends make(unsigned int writers, unsigned int readers, unsigned int capacity) noexcept
+                {
+                    assert(writers == 1 || readers == 1);
+                    buffer<std::vector<T>> buf(capacity > 0 ? capacity : 1);
+                    if (writers == 1 && readers == 1)
+                        return capacity > 0 ? of(one2one_chan<std::vector<T>>(buf)) : of(one2one_chan<std::vector<T>>());
+                    else if (writers == 1)
+                        return capacity > 0 ? of(one2any_chan<std::vector<T>>(buf)) : of(one2any_chan<std::vector<T>>());
+                    else
+                        return capacity > 0 ? of(any2one_chan<std::vector<T>>(buf)) : of(any2one_chan<std::vector<T>>());
+                }
+            };
+
+            std::shared_ptr<connector_internal> _internal = nullptr; //!< Pointer to the internal representation.
+
+        public:
+            /*!
+             * \brief Creates a new connector.
+             *
+             * \param[in] writers The number of processes writing to the connector.
+             * \param[in] readers The number of processes reading from the connector.  One of writers
+             * and readers must be one.
+             * \param[in] batch The number of items sent together.  Items wait until their batch is
+             * full, so use one where a stream feeds back on itself.
+             * \param[in] capacity The number of batches the connector buffers.  Zero for none.
+             */
+            connector(unsigned int writers = 1, unsigned int readers = 1, size_t batch = 1, unsigned int capacity = 0) noexcept
+            : _internal(std::make_shared<connector_internal>(writers, readers, batch, capacity))
+            {
+            }
+
+            /*!
+             * \brief Gets a new reading end of the connector.
+             *
+             * \return A reading end for one reader.
+             */
+            connector_in<T> in() const noexcept
+            {
+                return connector_in<T>(_internal->_in, _internal->_readers == 1 ? _internal->_writers : 1);
+            }
+
+            /*!
+             * \brief Gets a new writing end of the connector.
+             *
+             * \return A writing end for one writer.
+             */
+            connector_out<T> out() const noexcept
+            {
+                return connector_out<T>(_internal->_out, _internal->_readers, _internal->_batch);
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_CONNECTOR_H
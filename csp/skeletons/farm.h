@@ -0,0 +1,194 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_FARM_H
+#define CPP_CSP_FARM_H
+
+#include <functional>
+#include <thread>
+#include <vector>
+#include "../chan.h"
+#include "../par.h"
+#include "block.h"
+#include "reorder_buffer.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class farm
+         * \brief A block that applies a function to each item on a number of worker processes.
+         *
+         * An emitter gathers items into batches and sends them to whichever worker is free, so the
+         * work balances itself.  A collector writes out the results of each batch as it arrives,
+         * or, if the farm is ordered, in the order the items came in.  An empty batch tells a
+         * worker, and then the collector, that the stream has ended.
+         *
+         * An ordered farm tags each batch from a reorder buffer.  Only a window of batches may be
+         * out at once, so a stalled worker holds back the emitter rather than the collector
+         * holding every result behind it.
+         *
+         * \tparam IN The input type into the block.
+         * \tparam OUT The output type from the block.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename IN, typename OUT>
+        class farm : public block<IN, OUT>
+        {
+        protected:
+            /*! \class packet
+             * \brief A batch of items and its place in the stream.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            template<typename T>
+            class packet
+            {
+            public:
+                size_t seq = 0; //!< Number of the batch in the stream.
+
+                std::vector<T> items; //!< The items of the batch.  Empty at the end of the stream.
+            };
+
+            /*! \class farm_internal
+             * \brief Internal representation of a farm.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class farm_internal : public block<IN, OUT>::block_internal
+            {
+            private:
+                std::function<OUT(IN)> _fun; //!< The function applied to each item.
+
+                unsigned int _workers; //!< Number of worker processes.
+
+                size_t _batch; //!< Number of items sent to a worker together.
+
+                bool _ordered; //!< Whether results are written in the order the items came in.
+
+                size_t _window; //!< Number of batches an ordered farm may have out at once.
+
+                void emitter(connector_in<IN> in, chan_out<packet<IN>> out, reorder_buffer<std::vector<OUT>> order) noexcept
+                {
+                    packet<IN> p;
+                    p.items.reserve(_batch);
+                    while (!in.finished())
+                    {
+                        p.items.push_back(in());
+                        if (p.items.size() == _batch)
+                        {
+                            if (_ordered)
+                                p.seq = order.next();
+                            out(std::move(p));
+                            p.items = std::vector<IN>();
+                            p.items.reserve(_batch);
+                        }
+                    }
+                    if (!p.items.empty())
+                    {
+                        if (_ordered)
+                            p.seq = order.next();
+                        out(std::move(p));
+                    }
+                    // Tell each worker the stream has ended
+                    for (unsigned int i = 0; i < _workers; ++i)
+                        out(packet<IN>());
+                }
+
+                void worker(chan_in<packet<IN>> in, chan_out<packet<OUT>> out) noexcept
+                {
+                    while (true)
+                    {
+                        auto p = in();
+                        packet<OUT> result;
+                        result.seq = p.seq;
+                        if (p.items.empty())
+                        {
+                            out(std::move(result));
+                            return;
+                        }
+                        result.items.reserve(p.items.size());
+                        for (auto &item : p.items)
+                            result.items.push_back(_fun(std::move(item)));
+                        out(std::move(result));
+                    }
+                }
+
+                void collector(chan_in<packet<OUT>> in, connector_out<OUT> out, reorder_buffer<std::vector<OUT>> order) noexcept
+                {
+                    unsigned int ended = 0;
+                    while (ended < _workers)
+                    {
+                        auto p = in();
+                        if (p.items.empty())
+                            ++ended;
+                        else if (!_ordered)
+                        {
+                            for (auto &item : p.items)
+                                out(std::move(item));
+                        }
+                        else
+                        {
+                            // Write this batch and any held batches that follow it
+                            order.put(p.seq, std::move(p.items), [&out](std::vector<OUT> &&items)
+                            {
+                                for (auto &item : items)
+                                    out(std::move(item));
+                            });
+                        }
+                    }
+                    out.close();
+                }
+
+            public:
+                farm_internal(std::function<OUT(IN)> fun, unsigned int workers, size_t batch, bool ordered, size_t window) noexcept
+                : _fun(std::move(fun)),
+                  _workers(workers > 0 ? workers : (std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1)),
+                  _batch(batch > 0 ? batch : 1), _ordered(ordered), _window(window > 0 ? window : 4 * _workers)
+                {
+                }
+
+                void run(connector_in<IN> in, connector_out<OUT> out) noexcept override final
+                {
+                    one2any_chan<packet<IN>> to_workers;
+                    any2one_chan<packet<OUT>> from_workers;
+                    reorder_buffer<std::vector<OUT>> order(_window);
+                    std::vector<std::function<void()>> procs;
+                    procs.push_back([=]() { emitter(in, to_workers.out(), order); });
+                    for (unsigned int i = 0; i < _workers; ++i)
+                        procs.push_back([=]() { worker(to_workers.in(), from_workers.out()); });
+                    procs.push_back([=]() { collector(from_workers.in(), out, order); });
+                    par p(procs);
+                    p();
+                }
+            };
+
+        public:
+            /*!
+             * \brief Creates a farm.
+             *
+             * \param[in] fun The function applied to each item.
+             * \param[in] workers The number of worker processes.  Zero for one per core.
+             * \param[in] batch The number of items sent to a worker together.  A batch waits until
+             * it is full, so use one where a stream feeds back on itself.
+             * \param[in] ordered Whether results are written in the order the items came in.
+             * \param[in] window The number of batches an ordered farm may have out at once.  Zero
+             * for four per worker.
+             */
+            farm(std::function<OUT(IN)> fun, unsigned int workers = 0, size_t batch = 1, bool ordered = false, size_t window = 0) noexcept
+            : block<IN, OUT>(std::make_shared<farm_internal>(std::move(fun), workers, batch, ordered, window))
+            {
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_FARM_H
@@ -0,0 +1,126 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_FEEDBACK_H
+#define CPP_CSP_FEEDBACK_H
+
+#include <atomic>
+#include <functional>
+#include "../chan_waiter.h"
+#include "../par.h"
+#include "block.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class feedback
+         * \brief A block that passes each item through a body block until a condition holds.  Items
+         * for which the condition does not hold go back into the body.
+         *
+         * At most a window of items is in the loop at a time, and the stream back into the body is
+         * buffered to hold them all, so sending an item round again never waits on the body.  The
+         * input waits while the window is full.  The body is closed once the input has ended and
+         * every item has left the loop.
+         *
+         * \tparam T The type of the items.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class feedback : public block<T, T>
+        {
+        protected:
+            /*! \class feedback_internal
+             * \brief Internal representation of a feedback loop.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class feedback_internal : public block<T, T>::block_internal
+            {
+            private:
+                block<T, T> _body; //!< The block the items loop through.
+
+                std::function<bool(const T&)> _done; //!< Whether an item leaves the loop.
+
+                unsigned int _window; //!< Most items in the loop at a time.
+
+            public:
+                feedback_internal(const block<T, T> &body, std::function<bool(const T&)> done, unsigned int window) noexcept
+                : _body(body), _done(std::move(done)), _window(window)
+                {
+                }
+
+                void run(connector_in<T> in, connector_out<T> out) noexcept override final
+                {
+                    // The body is written to by the input and by the loop, and has room for a full window
+                    connector<T> into_body(2, 1, 1, _window + 2);
+                    connector<T> from_body;
+                    auto entry = into_body.out();
+                    auto loop = into_body.out();
+                    // Items in the loop, plus one while the input is open.  Whoever takes it to zero
+                    // closes the loop's stream into the body.
+                    std::atomic<unsigned int> open(1);
+                    chan_waiter waiter;
+                    par p
+                    {
+                        [&]()
+                        {
+                            while (!in.finished())
+                            {
+                                auto value = in();
+                                // Wait for room in the window
+                                waiter.await([&]() { return open.load() <= _window; });
+                                open.fetch_add(1);
+                                entry(std::move(value));
+                            }
+                            entry.close();
+                            if (open.fetch_sub(1) == 1)
+                                loop.close();
+                        },
+                        _body.process(into_body.in(), from_body.out()),
+                        [&]()
+                        {
+                            auto results = from_body.in();
+                            while (!results.finished())
+                            {
+                                auto value = results();
+                                if (!_done(value))
+                                {
+                                    loop(std::move(value));
+                                    continue;
+                                }
+                                out(std::move(value));
+                                if (open.fetch_sub(1) == 1)
+                                    loop.close();
+                                waiter.wake();
+                            }
+                            out.close();
+                        }
+                    };
+                    p();
+                }
+            };
+
+        public:
+            /*!
+             * \brief Creates a feedback loop.
+             *
+             * \param[in] body The block the items loop through.  Must write one item for each it reads.
+             * \param[in] done Whether an item leaves the loop.
+             * \param[in] window Most items in the loop at a time.
+             */
+            feedback(const block<T, T> &body, std::function<bool(const T&)> done, unsigned int window = 64) noexcept
+            : block<T, T>(std::make_shared<feedback_internal>(body, std::move(done), window > 0 ? window : 1))
+            {
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_FEEDBACK_H
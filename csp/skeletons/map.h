@@ -0,0 +1,80 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_MAP_H
+#define CPP_CSP_MAP_H
+
+#include <functional>
+#include <vector>
+#include "../patterns.h"
+#include "block.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class map
+         * \brief A block that applies a function to each element of each collection it reads.  The
+         * elements of a collection are split into blocks across the cores with par_for_range.
+         *
+         * \tparam IN The element type of the input collections.
+         * \tparam OUT The element type of the output collections.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename IN, typename OUT>
+        class map : public block<std::vector<IN>, std::vector<OUT>>
+        {
+        protected:
+            /*! \class map_internal
+             * \brief Internal representation of a map.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class map_internal : public block<std::vector<IN>, std::vector<OUT>>::block_internal
+            {
+            private:
+                std::function<OUT(const IN&)> _fun; //!< The function applied to each element.
+
+                size_t _grain; //!< Number of elements in a block.  Zero picks one from the number of cores.
+
+            public:
+                map_internal(std::function<OUT(const IN&)> fun, size_t grain) noexcept
+                : _fun(std::move(fun)), _grain(grain)
+                {
+                }
+
+                void run(connector_in<std::vector<IN>> in, connector_out<std::vector<OUT>> out) noexcept override final
+                {
+                    while (!in.finished())
+                    {
+                        auto values = in();
+                        std::vector<OUT> results(values.size());
+                        par_for_range(size_t(0), values.size(), _grain, [&](size_t i) { results[i] = _fun(values[i]); });
+                        out(std::move(results));
+                    }
+                    out.close();
+                }
+            };
+
+        public:
+            /*!
+             * \brief Creates a map.
+             *
+             * \param[in] fun The function applied to each element.
+             * \param[in] grain The number of elements in a block.  Zero picks one from the number of cores.
+             */
+            map(std::function<OUT(const IN&)> fun, size_t grain = 0) noexcept
+            : block<std::vector<IN>, std::vector<OUT>>(std::make_shared<map_internal>(std::move(fun), grain))
+            {
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_MAP_H
@@ -0,0 +1,99 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_PIPELINE_H
+#define CPP_CSP_PIPELINE_H
+
+#include "../par.h"
+#include "block.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class pipeline
+         * \brief A block that runs two blocks in parallel, the output of the first feeding the
+         * input of the second.  Longer pipelines nest, or chain blocks with the | operator.
+         *
+         * \tparam IN The input type into the first block.
+         * \tparam MID The type passed between the blocks.
+         * \tparam OUT The output type from the second block.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename IN, typename MID, typename OUT>
+        class pipeline : public block<IN, OUT>
+        {
+        protected:
+            /*! \class pipeline_internal
+             * \brief Internal representation of a pipeline.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class pipeline_internal : public block<IN, OUT>::block_internal
+            {
+            private:
+                block<IN, MID> _first; //!< The first block.
+
+                block<MID, OUT> _second; //!< The second block.
+
+                size_t _batch; //!< Number of items sent between the blocks together.
+
+            public:
+                pipeline_internal(const block<IN, MID> &first, const block<MID, OUT> &second, size_t batch) noexcept
+                : _first(first), _second(second), _batch(batch)
+                {
+                }
+
+                void run(connector_in<IN> in, connector_out<OUT> out) noexcept override final
+                {
+                    connector<MID> link(1, 1, _batch);
+                    par p
+                    {
+                        _first.process(in, link.out()),
+                        _second.process(link.in(), out)
+                    };
+                    p();
+                }
+            };
+
+        public:
+            /*!
+             * \brief Creates a pipeline of two blocks.
+             *
+             * \param[in] first The first block.
+             * \param[in] second The second block.
+             * \param[in] batch The number of items sent between the blocks together.
+             */
+            pipeline(const block<IN, MID> &first, const block<MID, OUT> &second, size_t batch = 1) noexcept
+            : block<IN, OUT>(std::make_shared<pipeline_internal>(first, second, batch))
+            {
+            }
+        };
+
+        /*!
+         * \brief Chains two blocks into a pipeline.
+         *
+         * \tparam IN The input type into the first block.
+         * \tparam MID The type passed between the blocks.
+         * \tparam OUT The output type from the second block.
+         *
+         * \param[in] first The first block.
+         * \param[in] second The second block.
+         *
+         * \return The pipeline.
+         */
+        template<typename IN, typename MID, typename OUT>
+        pipeline<IN, MID, OUT> operator|(const block<IN, MID> &first, const block<MID, OUT> &second) noexcept
+        {
+            return pipeline<IN, MID, OUT>(first, second);
+        }
+    }
+}
+
+#endif //CPP_CSP_PIPELINE_H
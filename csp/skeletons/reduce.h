@@ -0,0 +1,76 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_REDUCE_H
+#define CPP_CSP_REDUCE_H
+
+#include <functional>
+#include <vector>
+#include "../patterns.h"
+#include "block.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class reduce
+         * \brief A block that reduces each collection it reads to a single value with par_reduce.
+         *
+         * \tparam T The element type of the collections, and the type of the results.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class reduce : public block<std::vector<T>, T>
+        {
+        protected:
+            /*! \class reduce_internal
+             * \brief Internal representation of a reduce.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class reduce_internal : public block<std::vector<T>, T>::block_internal
+            {
+            private:
+                T _init; //!< The value each reduction starts from.
+
+                std::function<T(const T&, const T&)> _op; //!< The reduction.
+
+            public:
+                reduce_internal(T init, std::function<T(const T&, const T&)> op) noexcept
+                : _init(std::move(init)), _op(std::move(op))
+                {
+                }
+
+                void run(connector_in<std::vector<T>> in, connector_out<T> out) noexcept override final
+                {
+                    while (!in.finished())
+                    {
+                        auto values = in();
+                        out(par_reduce(values.begin(), values.end(), _init, _op));
+                    }
+                    out.close();
+                }
+            };
+
+        public:
+            /*!
+             * \brief Creates a reduce.
+             *
+             * \param[in] init The value each reduction starts from.
+             * \param[in] op The reduction.  Must be associative.
+             */
+            reduce(T init, std::function<T(const T&, const T&)> op) noexcept
+            : block<std::vector<T>, T>(std::make_shared<reduce_internal>(std::move(init), std::move(op)))
+            {
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_REDUCE_H
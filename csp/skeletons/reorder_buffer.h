@@ -0,0 +1,144 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_REORDER_BUFFER_H
+#define CPP_CSP_REORDER_BUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../chan_waiter.h"
+
+namespace csp
+{
+    namespace skeletons
+    {
+        /*! \class reorder_buffer
+         * \brief Puts results that arrive out of order back into the order their items were sent.
+         *
+         * The process sending items to a group of workers, usually over a one2any channel, tags
+         * each with a sequence number from next.  The process collecting the results, usually over
+         * an any2one channel, hands each to put with its tag, and put passes on every result that
+         * is now in order.
+         *
+         * Results wait in a sliding window of slots, one per tag not yet passed on.  The sender
+         * waits in next while the window is full, so a stalled worker holds back the sender rather
+         * than filling memory with the results that follow its item.  Every tag the sender waits
+         * on has been sent, so the wait ends once the workers finish them.
+         *
+         * One process sends and one collects.
+         *
+         * \tparam T The type of the results.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        template<typename T>
+        class reorder_buffer
+        {
+        private:
+            /*! \class reorder_buffer_internal
+             * \brief Internal representation of a reorder buffer.
+             *
+             * \author Kevin Chalmers
+             *
+             * \date 16/10/2026
+             */
+            class reorder_buffer_internal
+            {
+            public:
+                size_t _window; //!< Number of tags that may be sent and not yet passed on.
+
+                std::vector<std::unique_ptr<T>> _slots; //!< Results waiting for those ahead of them.  Indexed by tag modulo the window.
+
+                size_t _sent = 0; //!< Next tag to give out.  Only used by the sender.
+
+                std::atomic<size_t> _released; //!< Next tag to pass on.  Written by the collector.
+
+                chan_waiter _waiter; //!< Used by the sender to wait for room in the window.
+
+                reorder_buffer_internal(size_t window) noexcept
+                : _window(window > 0 ? window : 1), _slots(_window), _released(0)
+                {
+                }
+            };
+
+            std::shared_ptr<reorder_buffer_internal> _internal = nullptr; //!< Pointer to the internal representation.
+
+        public:
+            /*!
+             * \brief Creates a new reorder buffer.
+             *
+             * \param[in] window The number of items that may be sent and not yet passed on.
+             */
+            reorder_buffer(size_t window) noexcept
+            : _internal(std::make_shared<reorder_buffer_internal>(window))
+            {
+            }
+
+            /*!
+             * \brief Gets the tag for the next item sent.  Waits while the window is full.
+             *
+             * \return The tag.
+             */
+            size_t next() const noexcept
+            {
+                auto internal = _internal.get();
+                auto seq = internal->_sent++;
+                internal->_waiter.await([internal, seq]() { return seq < internal->_released.load() + internal->_window; });
+                return seq;
+            }
+
+            /*!
+             * \brief Takes a result, and passes on it and every held result that follows it in order.
+             *
+             * \tparam F The type of the action.
+             *
+             * \param[in] seq The tag of the item the result is for.
+             * \param[in] value The result.
+             * \param[in] pass The action taken on each result in order.
+             */
+            template<typename F>
+            void put(size_t seq, T value, F pass) const noexcept
+            {
+                auto internal = _internal.get();
+                auto released = internal->_released.load(std::memory_order_relaxed);
+                if (seq != released)
+                {
+                    // Hold until the results ahead of it arrive
+                    internal->_slots[seq % internal->_window].reset(new T(std::move(value)));
+                    return;
+                }
+                pass(std::move(value));
+                ++released;
+                for (auto *slot = &internal->_slots[released % internal->_window]; *slot; slot = &internal->_slots[released % internal->_window])
+                {
+                    pass(std::move(**slot));
+                    slot->reset();
+                    ++released;
+                }
+                // Make room in the window
+                internal->_released.store(released);
+                internal->_waiter.wake();
+            }
+
+            /*!
+             * \brief Gets the number of results held waiting for those ahead of them.
+             *
+             * \return The number of results held.  Only valid from the collecting process.
+             */
+            size_t held() const noexcept
+            {
+                size_t count = 0;
+                for (auto &slot : _internal->_slots)
+                    if (slot)
+                        ++count;
+                return count;
+            }
+        };
+    }
+}
+
+#endif //CPP_CSP_REORDER_BUFFER_H
@@ -8,6 +8,7 @@
 #include <thread>
 #include "process.h"
 #include "guard.h"
+#include "fiber_scheduler.h"
 
 namespace csp
 {
@@ -41,8 +42,8 @@ namespace csp
              */
             bool enable(const alt &a) noexcept override final
             {
-                std::this_thread::yield();
-                return false;
+                fiber_scheduler::yield();
+                return true;
             }
 
             /*!
@@ -52,7 +53,7 @@ namespace csp
              */
             bool disable() noexcept override final
             {
-                return false;
+                return true;
             }
         };
 
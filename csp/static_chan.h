@@ -0,0 +1,647 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_STATIC_CHAN_H
+#define CPP_CSP_STATIC_CHAN_H
+
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include "chan.h"
+
+namespace csp
+{
+    /*!
+     * \brief Kinds of statically dispatched channel.  A kind states whether several processes may
+     * read or write, and picks the channel implementation for a buffered or unbuffered channel.
+     */
+    namespace chan_kind
+    {
+        /*! \struct one2one
+         * \brief One writer and one reader.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct one2one
+        {
+            static constexpr bool SHARED_READER = false; //!< Flag to indicate several processes may read.
+
+            static constexpr bool SHARED_WRITER = false; //!< Flag to indicate several processes may write.
+
+            template<typename T, bool BUFFERED, bool POISONABLE>
+            using type = typename std::conditional<BUFFERED, one2one_buffered_chan<T, POISONABLE>, one2one_basic_chan<T, POISONABLE>>::type;
+        };
+
+        /*! \struct one2any
+         * \brief One writer and any number of readers.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct one2any
+        {
+            static constexpr bool SHARED_READER = true; //!< Flag to indicate several processes may read.
+
+            static constexpr bool SHARED_WRITER = false; //!< Flag to indicate several processes may write.
+
+            template<typename T, bool BUFFERED, bool POISONABLE>
+            using type = typename std::conditional<BUFFERED, any2any_buffered_chan<T, POISONABLE>, any2any_basic_chan<T, POISONABLE>>::type;
+        };
+
+        /*! \struct any2one
+         * \brief Any number of writers and one reader.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct any2one
+        {
+            static constexpr bool SHARED_READER = false; //!< Flag to indicate several processes may read.
+
+            static constexpr bool SHARED_WRITER = true; //!< Flag to indicate several processes may write.
+
+            template<typename T, bool BUFFERED, bool POISONABLE>
+            using type = typename std::conditional<BUFFERED, any2any_buffered_chan<T, POISONABLE>, any2any_basic_chan<T, POISONABLE>>::type;
+        };
+
+        /*! \struct any2any
+         * \brief Any number of writers and readers.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        struct any2any
+        {
+            static constexpr bool SHARED_READER = true; //!< Flag to indicate several processes may read.
+
+            static constexpr bool SHARED_WRITER = true; //!< Flag to indicate several processes may write.
+
+            template<typename T, bool BUFFERED, bool POISONABLE>
+            using type = typename std::conditional<BUFFERED, any2any_buffered_chan<T, POISONABLE>, any2any_basic_chan<T, POISONABLE>>::type;
+        };
+    }
+
+    /*! \class static_chan_in
+     * \brief Input end of a statically dispatched channel.  Calls the channel implementation
+     * directly, so a read compiles to a single non-virtual call.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam KIND The kind of channel.  One of the chan_kind types.
+     * \tparam BUFFERED Flag to indicate the channel is buffered.
+     * \tparam POISONABLE Flag to indicate the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, typename KIND = chan_kind::one2one, bool BUFFERED = false, bool POISONABLE = false>
+    class static_chan_in
+    {
+        // Friend declarations
+        friend class static_chan<T, KIND, BUFFERED, POISONABLE>;
+    private:
+        // Type declarations used by the end
+        using IMPL = typename static_chan<T, KIND, BUFFERED, POISONABLE>::IMPL;
+        using INPUT = typename static_chan<T, KIND, BUFFERED, POISONABLE>::INPUT;
+
+        chan<T, POISONABLE> _chan; //!< The channel.  Keeps the implementation alive, and is the guard used in an alt.
+
+        IMPL *_impl; //!< The channel implementation, called directly.
+
+        INPUT _erased; //!< Type-erased input end of the same channel.
+
+        process_mutex *_mut; //!< Lock held by batched and extended reads when several processes read.  nullptr otherwise.
+
+        /*!
+         * \brief Creates a new input end.  Used by static_chan.
+         *
+         * \param[in] chan The channel.
+         * \param[in] impl The channel implementation.
+         * \param[in] erased The type-erased input end of the channel.
+         * \param[in] mut Lock shared with the type-erased end, or nullptr if only one process reads.
+         */
+        static_chan_in(const chan<T, POISONABLE> &chan, IMPL *impl, const INPUT &erased, process_mutex *mut) noexcept
+        : _chan(chan), _impl(impl), _erased(erased), _mut(mut)
+        {
+        }
+
+    public:
+        static_chan_in(const static_chan_in &other) noexcept = default;
+
+        static_chan_in(static_chan_in &&rhs) noexcept = default;
+
+        static_chan_in& operator=(const static_chan_in &other) noexcept = default;
+
+        static_chan_in& operator=(static_chan_in &&rhs) noexcept = default;
+
+        /*!
+         * \brief Reads a value from the channel.
+         *
+         * \return Value read from the channel.
+         */
+        T read() const noexcept(false) { return _impl->read(); }
+
+        /*!
+         * \brief Operator overload to read a value from the channel.
+         *
+         * \return Value read from the channel.
+         */
+        T operator()() const noexcept(false) { return _impl->read(); }
+
+        /*!
+         * \brief Begins an extended read operation.  Other readers are locked out until the read ends.
+         *
+         * \return Value read from the channel.
+         */
+        T start_read() const noexcept(false)
+        {
+            // Lock out other readers
+            if (_mut)
+                _mut->lock();
+            try
+            {
+                return _impl->start_read();
+            }
+            catch (...)
+            {
+                if (_mut)
+                    _mut->unlock();
+                throw;
+            }
+        }
+
+        /*!
+         * \brief Ends an extended read operation.
+         */
+        void end_read() const noexcept(false)
+        {
+            // End the read, then let other readers in
+            try
+            {
+                _impl->end_read();
+            }
+            catch (...)
+            {
+                if (_mut)
+                    _mut->unlock();
+                throw;
+            }
+            if (_mut)
+                _mut->unlock();
+        }
+
+        /*!
+         * \brief Reads a number of values from the channel.  Other readers are locked out for the whole batch.
+         *
+         * \param[out] values Where to put the values read.
+         * \param[in] n The number of values to read.
+         */
+        void read_n(T *values, size_t n) const noexcept(false)
+        {
+            if (!_mut)
+            {
+                _impl->read_n(values, n);
+                return;
+            }
+            std::unique_lock<process_mutex> lock(*_mut);
+            _impl->read_n(values, n);
+        }
+
+        /*!
+         * \brief Reads a value from the channel only if one is available without waiting.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         *
+         * \return True if a value was read, false otherwise.
+         */
+        bool try_read(T &value) const noexcept(false) { return _impl->try_read(value); }
+
+        /*!
+         * \brief Reads a value from the channel, giving up if none is available by the given time.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         * \param[in] time The time to give up the read.
+         *
+         * \return True if a value was read, false if the time was reached first.
+         */
+        bool read_until(T &value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _impl->read_until(value, time); }
+
+        /*!
+         * \brief Reads a value from the channel, giving up if none is available within the given duration.
+         *
+         * \param[out] value Set to the value read if the read succeeds.
+         * \param[in] duration The time to wait for a value.
+         *
+         * \return True if a value was read, false if the duration passed first.
+         */
+        template<typename Rep, typename Period>
+        bool read_for(T &value, const std::chrono::duration<Rep, Period> &duration) const noexcept(false)
+        {
+            return _impl->read_until(value, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+        }
+
+        /*!
+         * \brief Checks if a message is pending on the channel.
+         *
+         * \return True if a message is ready on the channel, false otherwise.
+         */
+        bool pending() const noexcept { return _impl->pending(); }
+
+#if defined(__cpp_impl_coroutine)
+        /*! \class read_op
+         * \brief Awaitable read operation.  The result of the co_await is the value read.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class read_op : public co_op
+        {
+        private:
+            static_chan_in _in; //!< The channel end being read from.
+
+            T _value = T(); //!< The value read.
+
+        protected:
+            bool step() noexcept(false) override final { return _in._impl->read_async(*this, _value); }
+
+        public:
+            read_op(const static_chan_in &in) noexcept
+            : _in(in)
+            {
+            }
+
+            T await_resume() noexcept(false)
+            {
+                this->rethrow();
+                return std::move(_value);
+            }
+        };
+
+        /*!
+         * \brief Reads a value from the channel within a coroutine.  Use as co_await in.co_read().
+         *
+         * \return The awaitable read operation.
+         */
+        read_op co_read() const noexcept { return read_op(*this); }
+#endif
+
+        /*!
+         * \brief Poisons the channel.
+         *
+         * \param[in] strength The strength of the poison to use on the channel.
+         */
+        void poison(unsigned int strength) const noexcept
+        {
+            static_assert(POISONABLE, "channel is not poisonable");
+            _impl->reader_poison(strength);
+        }
+
+        /*!
+         * \brief Gets the channel as a guard for use in an alt.
+         *
+         * \return The guard.
+         */
+        operator guard() const noexcept
+        {
+            static_assert(!KIND::SHARED_READER, "only a channel with one reader can be used in an alt");
+            return _chan;
+        }
+
+        /*!
+         * \brief Gets the type-erased input end of the channel, for code that needs runtime polymorphism.
+         *
+         * \return The type-erased input end.
+         */
+        operator INPUT() const noexcept { return _erased; }
+    };
+
+    /*! \class static_chan_out
+     * \brief Output end of a statically dispatched channel.  Calls the channel implementation
+     * directly, so a write compiles to a single non-virtual call.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam KIND The kind of channel.  One of the chan_kind types.
+     * \tparam BUFFERED Flag to indicate the channel is buffered.
+     * \tparam POISONABLE Flag to indicate the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, typename KIND = chan_kind::one2one, bool BUFFERED = false, bool POISONABLE = false>
+    class static_chan_out
+    {
+        // Friend declarations
+        friend class static_chan<T, KIND, BUFFERED, POISONABLE>;
+    private:
+        // Type declarations used by the end
+        using IMPL = typename static_chan<T, KIND, BUFFERED, POISONABLE>::IMPL;
+        using OUTPUT = typename static_chan<T, KIND, BUFFERED, POISONABLE>::OUTPUT;
+
+        chan<T, POISONABLE> _chan; //!< The channel.  Keeps the implementation alive.
+
+        IMPL *_impl; //!< The channel implementation, called directly.
+
+        OUTPUT _erased; //!< Type-erased output end of the same channel.
+
+        process_mutex *_mut; //!< Lock held by batched writes when several processes write.  nullptr otherwise.
+
+        /*!
+         * \brief Creates a new output end.  Used by static_chan.
+         *
+         * \param[in] chan The channel.
+         * \param[in] impl The channel implementation.
+         * \param[in] erased The type-erased output end of the channel.
+         * \param[in] mut Lock shared with the type-erased end, or nullptr if only one process writes.
+         */
+        static_chan_out(const chan<T, POISONABLE> &chan, IMPL *impl, const OUTPUT &erased, process_mutex *mut) noexcept
+        : _chan(chan), _impl(impl), _erased(erased), _mut(mut)
+        {
+        }
+
+    public:
+        static_chan_out(const static_chan_out &other) noexcept = default;
+
+        static_chan_out(static_chan_out &&rhs) noexcept = default;
+
+        static_chan_out& operator=(const static_chan_out &other) noexcept = default;
+
+        static_chan_out& operator=(static_chan_out &&rhs) noexcept = default;
+
+        /*!
+         * \brief Writes a value to the channel.
+         *
+         * \param[in] value The value to write.
+         */
+        void write(T value) const noexcept(false) { _impl->write(std::move(value)); }
+
+        /*!
+         * \brief Operator overload to write a value to the channel.
+         *
+         * \param[in] value The value to write.
+         */
+        void operator()(T value) const noexcept(false) { _impl->write(std::move(value)); }
+
+        /*!
+         * \brief Writes a number of values to the channel.  Other writers are locked out for the
+         * whole batch, so the values are read in order.
+         *
+         * \param[in] values The values to write.
+         * \param[in] n The number of values to write.
+         */
+        void write_n(const T *values, size_t n) const noexcept(false)
+        {
+            if (!_mut)
+            {
+                _impl->write_n(values, n);
+                return;
+            }
+            std::unique_lock<process_mutex> lock(*_mut);
+            _impl->write_n(values, n);
+        }
+
+        /*!
+         * \brief Writes a value only if it can complete without waiting.
+         *
+         * \param[in] value The value to write.
+         *
+         * \return True if the value was written, false otherwise.
+         */
+        bool try_write(T value) const noexcept(false) { return _impl->try_write(value); }
+
+        /*!
+         * \brief Writes a value, giving up if it has not been accepted by the given time.
+         *
+         * \param[in] value The value to write.
+         * \param[in] time The time to give up the write.
+         *
+         * \return True if the value was written, false if the time was reached first.
+         */
+        bool write_until(T value, const std::chrono::steady_clock::time_point &time) const noexcept(false) { return _impl->write_until(value, time); }
+
+        /*!
+         * \brief Writes a value, giving up if it has not been accepted within the given duration.
+         *
+         * \param[in] value The value to write.
+         * \param[in] duration The time to wait for the write to be accepted.
+         *
+         * \return True if the value was written, false if the duration passed first.
+         */
+        template<typename Rep, typename Period>
+        bool write_for(T value, const std::chrono::duration<Rep, Period> &duration) const noexcept(false)
+        {
+            return _impl->write_until(value, std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+        }
+
+#if defined(__cpp_impl_coroutine)
+        /*! \class write_op
+         * \brief Awaitable write operation.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class write_op : public co_op
+        {
+        private:
+            static_chan_out _out; //!< The channel end being written to.
+
+            T _value; //!< The value to write.
+
+        protected:
+            bool step() noexcept(false) override final { return _out._impl->write_async(*this, _value); }
+
+        public:
+            write_op(const static_chan_out &out, T value) noexcept
+            : _out(out), _value(std::move(value))
+            {
+            }
+
+            void await_resume() const noexcept(false) { this->rethrow(); }
+        };
+
+        /*!
+         * \brief Writes a value to the channel within a coroutine.  Use as co_await out.co_write(value).
+         *
+         * \param[in] value The value to write.
+         *
+         * \return The awaitable write operation.
+         */
+        write_op co_write(T value) const noexcept { return write_op(*this, std::move(value)); }
+#endif
+
+        /*!
+         * \brief Poisons the channel.
+         *
+         * \param[in] strength The strength of the poison to use on the channel.
+         */
+        void poison(unsigned int strength) const noexcept
+        {
+            static_assert(POISONABLE, "channel is not poisonable");
+            _impl->writer_poison(strength);
+        }
+
+        /*!
+         * \brief Gets the type-erased output end of the channel, for code that needs runtime polymorphism.
+         *
+         * \return The type-erased output end.
+         */
+        operator OUTPUT() const noexcept { return _erased; }
+    };
+
+    /*! \class static_chan
+     * \brief A channel whose kind is fixed at compile time.
+     *
+     * The type-erased channels reach the implementation through a virtual end and a virtual
+     * channel.  A static_chan picks the implementation from its template parameters, and its ends
+     * call it directly, so the whole of a read or write can be inlined.  Each end converts to the
+     * type-erased end of the same channel for code that needs runtime polymorphism.
+     *
+     * \tparam T The type that the channel operates on.
+     * \tparam KIND The kind of channel.  One of the chan_kind types.
+     * \tparam BUFFERED Flag to indicate the channel is buffered.
+     * \tparam POISONABLE Flag to indicate the channel can be poisoned.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    template<typename T, typename KIND = chan_kind::one2one, bool BUFFERED = false, bool POISONABLE = false>
+    class static_chan
+    {
+        // Friend declarations
+        friend class static_chan_in<T, KIND, BUFFERED, POISONABLE>;
+        friend class static_chan_out<T, KIND, BUFFERED, POISONABLE>;
+    private:
+        // Type declarations used by channel
+        using CHAN = typename KIND::template type<T, BUFFERED, POISONABLE>;
+        using IMPL = typename CHAN::internal_type;
+        using INPUT = typename std::conditional<KIND::SHARED_READER, shared_chan_in<T, POISONABLE>, alting_chan_in<T, POISONABLE>>::type;
+        using INPUT_IMPL = typename std::conditional<KIND::SHARED_READER, typename shared_chan_in<T, POISONABLE>::shared_chan_in_internal, typename alting_chan_in<T, POISONABLE>::alting_chan_in_internal>::type;
+        using OUTPUT = typename std::conditional<KIND::SHARED_WRITER, shared_chan_out<T, POISONABLE>, chan_out<T, POISONABLE>>::type;
+        using OUTPUT_IMPL = typename std::conditional<KIND::SHARED_WRITER, typename shared_chan_out<T, POISONABLE>::shared_chan_out_internal, typename chan_out<T, POISONABLE>::chan_out_internal>::type;
+
+        chan<T, POISONABLE> _chan; //!< The channel.
+
+        std::shared_ptr<INPUT_IMPL> _in_impl; //!< Type-erased input end.
+
+        std::shared_ptr<OUTPUT_IMPL> _out_impl; //!< Type-erased output end.
+
+        /*!
+         * \brief Gets the lock of a shared end.
+         *
+         * \param[in] end The type-erased shared end.
+         *
+         * \return The lock of the end.
+         */
+        static process_mutex* lock_of(typename shared_chan_in<T, POISONABLE>::shared_chan_in_internal *end) noexcept { return &end->_mut; }
+
+        static process_mutex* lock_of(typename shared_chan_out<T, POISONABLE>::shared_chan_out_internal *end) noexcept { return &end->_mut; }
+
+        /*!
+         * \brief An end that only one process uses has no lock.
+         *
+         * \return nullptr.
+         */
+        static process_mutex* lock_of(void*) noexcept { return nullptr; }
+
+        /*!
+         * \brief Gets the channel implementation.
+         *
+         * \return The channel implementation.
+         */
+        IMPL* impl() const noexcept { return static_cast<IMPL*>(_chan._internal.get()); }
+
+    public:
+        /*!
+         * \brief Creates a new unbuffered channel.
+         *
+         * \param[in] immunity The poison immunity level of the channel.
+         */
+        static_chan(unsigned int immunity = 0) noexcept
+        : _chan(CHAN()),
+          _in_impl(new INPUT_IMPL(_chan, immunity)),
+          _out_impl(new OUTPUT_IMPL(_chan, immunity))
+        {
+            static_assert(!BUFFERED, "a buffered channel needs a buffer");
+        }
+
+        /*!
+         * \brief Creates a new buffered channel.
+         *
+         * \param[in] buffer The buffer to use with the channel.
+         * \param[in] immunity The poison immunity level of the channel.
+         */
+        static_chan(buffer<T> &buffer, unsigned int immunity = 0) noexcept(false)
+        : _chan(CHAN(buffer.size())),
+          _in_impl(new INPUT_IMPL(_chan, immunity)),
+          _out_impl(new OUTPUT_IMPL(_chan, immunity))
+        {
+            static_assert(BUFFERED, "an unbuffered channel does not take a buffer");
+        }
+
+        /*!
+         * \brief Gets the input end of the channel.
+         *
+         * \return The input end.
+         */
+        static_chan_in<T, KIND, BUFFERED, POISONABLE> in() const noexcept
+        {
+            return static_chan_in<T, KIND, BUFFERED, POISONABLE>(_chan, impl(), INPUT(_in_impl), lock_of(_in_impl.get()));
+        }
+
+        /*!
+         * \brief Gets the output end of the channel.
+         *
+         * \return The output end.
+         */
+        static_chan_out<T, KIND, BUFFERED, POISONABLE> out() const noexcept
+        {
+            return static_chan_out<T, KIND, BUFFERED, POISONABLE>(_chan, impl(), OUTPUT(_out_impl), lock_of(_out_impl.get()));
+        }
+
+        /*!
+         * \brief Gets the input end of the channel.
+         *
+         * \return The input end.
+         */
+        operator static_chan_in<T, KIND, BUFFERED, POISONABLE>() const noexcept { return in(); }
+
+        /*!
+         * \brief Gets the output end of the channel.
+         *
+         * \return The output end.
+         */
+        operator static_chan_out<T, KIND, BUFFERED, POISONABLE>() const noexcept { return out(); }
+
+        /*!
+         * \brief Reads a value from the channel.
+         *
+         * \return Value read from the channel.
+         */
+        T operator()() const noexcept(false) { return impl()->read(); }
+
+        /*!
+         * \brief Writes a value to the channel.
+         *
+         * \param[in] value The value to write.
+         */
+        void operator()(T value) const noexcept(false) { impl()->write(std::move(value)); }
+
+        /*!
+         * \brief Sets how processes wait on the channel.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set_wait_strategy(wait_strategy strategy) const noexcept { _chan.set_wait_strategy(strategy); }
+    };
+}
+
+#endif //CPP_CSP_STATIC_CHAN_H
@@ -9,6 +9,7 @@
 #include <mutex>
 #include "process.h"
 #include "guard.h"
+#include "fiber_scheduler.h"
 
 namespace csp
 {
@@ -41,7 +42,7 @@ namespace csp
              */
             bool enable(const alt &a) noexcept override final
             {
-                std::this_thread::yield();
+                fiber_scheduler::yield();
                 return false;
             }
 
@@ -80,7 +81,7 @@ namespace csp
             // Create lock
             std::unique_lock<std::mutex> lock(mut);
             // Wait on the lock
-            std::condition_variable cond;
+            condition cond;
             cond.wait(lock);
         }
     };
@@ -8,6 +8,7 @@
 #include <thread>
 #include <chrono>
 #include "guard.h"
+#include "fiber_scheduler.h"
 
 namespace csp
 {
@@ -169,7 +170,7 @@ namespace csp
         void after(const std::chrono::steady_clock::time_point &timepoint) const noexcept
         {
             // Sleep until time point
-            std::this_thread::sleep_until(timepoint);
+            fiber_scheduler::sleep_until(timepoint);
         }
 
         /*!
@@ -189,7 +190,7 @@ namespace csp
             // Check that there is a duration
             if (duration > std::chrono::steady_clock::duration::zero())
                 // Sleep for time
-                std::this_thread::sleep_for(duration);
+                fiber_scheduler::sleep_for(duration);
         }
 
         /*!
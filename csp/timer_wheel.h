@@ -0,0 +1,351 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_TIMER_WHEEL_H
+#define CPP_CSP_TIMER_WHEEL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace csp
+{
+    /*! \class timer_wheel
+     * \brief A hierarchical timing wheel.  Holds the timeouts of waiting processes.
+     *
+     * Time is split into ticks of the wheel's slack.  Each level of the wheel has 64 slots, and
+     * each slot of a level spans 64 slots of the level below.  A timeout is placed in the lowest
+     * level that can hold it, and is moved down as its time gets near.  Adding and removing a
+     * timeout is O(1), and finding the next timeout to fire only looks at one word per level.
+     *
+     * Timeouts falling in the same tick fire together, and a timeout never fires early.  The wheel
+     * is not thread safe, so it is locked by whoever owns it.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class timer_wheel
+    {
+    public:
+        static constexpr unsigned int SLOT_BITS = 6; //!< Number of bits of the tick used to index a slot.
+
+        static constexpr unsigned int SLOTS = 1 << SLOT_BITS; //!< Number of slots on each level.
+
+        static constexpr unsigned int LEVELS = 6; //!< Number of levels.  Covers 2^36 ticks.
+
+        static constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max(); //!< Tick used when the wheel is empty.
+
+        /*! \class hook
+         * \brief The part of a timeout that links it into the wheel.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class hook
+        {
+            friend class timer_wheel;
+        private:
+            hook *_next = nullptr; //!< Next timeout in the slot.
+
+            hook **_pprev = nullptr; //!< Link that points at this timeout, or nullptr if not in the wheel.
+
+            std::uint64_t _expiry = 0; //!< Tick the timeout fires on.
+
+            unsigned char _level = 0; //!< Level of the slot the timeout is in.
+
+            unsigned char _slot = 0; //!< Index of the slot the timeout is in.
+
+        public:
+            /*!
+             * \brief Checks whether the timeout is in a wheel.
+             *
+             * \return True if the timeout has not fired or been removed, false otherwise.
+             */
+            bool linked() const noexcept { return _pprev != nullptr; }
+        };
+
+    private:
+        std::chrono::steady_clock::time_point _origin; //!< Time of tick zero.
+
+        std::chrono::steady_clock::duration _tick; //!< Length of a tick.  Timeouts within a tick are coalesced.
+
+        std::uint64_t _current = 0; //!< The next tick to process.
+
+        hook *_slots[LEVELS][SLOTS]; //!< Head of the list of timeouts in each slot.
+
+        std::uint64_t _occupied[LEVELS]; //!< Bit set for each slot that holds a timeout.
+
+        /*!
+         * \brief Gets the index of the first occupied slot of a level at or after the given slot,
+         * wrapping around.
+         *
+         * \param[in] level The level to look at.
+         * \param[in] from The slot to start from.
+         *
+         * \return The distance from the given slot to the first occupied slot, or SLOTS if there is none.
+         */
+        unsigned int distance(unsigned int level, unsigned int from) const noexcept
+        {
+            auto bits = _occupied[level];
+            if (bits == 0)
+                return SLOTS;
+            // Rotate so that the starting slot is bit zero
+            auto rotated = from == 0 ? bits : (bits >> from) | (bits << (SLOTS - from));
+            return static_cast<unsigned int>(__builtin_ctzll(rotated));
+        }
+
+        /*!
+         * \brief Adds a timeout to the slot it belongs in.
+         *
+         * \param[in] h The timeout to add.
+         */
+        void link(hook *h) noexcept
+        {
+            // Pick the lowest level whose span holds the timeout
+            auto delta = h->_expiry - _current;
+            unsigned int level = 0;
+            while (level < LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+                ++level;
+            // Anything beyond the top level waits in its last slot and is placed again when reached
+            auto expiry = h->_expiry;
+            if (level == LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * LEVELS)))
+                expiry = _current + (std::uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+            auto slot = static_cast<unsigned int>((expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+            h->_level = static_cast<unsigned char>(level);
+            h->_slot = static_cast<unsigned char>(slot);
+            // Push onto the front of the slot
+            auto &head = _slots[level][slot];
+            h->_next = head;
+            if (head)
+                head->_pprev = &h->_next;
+            head = h;
+            h->_pprev = &head;
+            _occupied[level] |= std::uint64_t(1) << slot;
+        }
+
+        /*!
+         * \brief Removes a timeout from its slot.
+         *
+         * \param[in] h The timeout to remove.
+         */
+        void unlink(hook *h) noexcept
+        {
+            *h->_pprev = h->_next;
+            if (h->_next)
+                h->_next->_pprev = h->_pprev;
+            h->_next = nullptr;
+            h->_pprev = nullptr;
+            if (!_slots[h->_level][h->_slot])
+                _occupied[h->_level] &= ~(std::uint64_t(1) << h->_slot);
+        }
+
+        /*!
+         * \brief Takes every timeout out of a slot.
+         *
+         * \param[in] level The level of the slot.
+         * \param[in] slot The index of the slot.
+         *
+         * \return The first timeout taken, linked to the rest through _next.
+         */
+        hook* take(unsigned int level, unsigned int slot) noexcept
+        {
+            auto h = _slots[level][slot];
+            _slots[level][slot] = nullptr;
+            _occupied[level] &= ~(std::uint64_t(1) << slot);
+            return h;
+        }
+
+        /*!
+         * \brief Gets the next tick at which there is work to do.  That is a tick on which a
+         * timeout fires, or on which a slot of a higher level moves down.
+         *
+         * \return The next tick with work, or NEVER if the wheel is empty.
+         */
+        std::uint64_t next_tick() const noexcept
+        {
+            auto next = NEVER;
+            // Timeouts on the lowest level fire on their own tick
+            auto d = distance(0, static_cast<unsigned int>(_current & (SLOTS - 1)));
+            if (d < SLOTS)
+                next = _current + d;
+            // Higher levels move down when the tick reaches the start of their slot.  Once the tick
+            // is past the start of the current slot of a level, that slot has moved down already.
+            for (unsigned int level = 1; level < LEVELS; ++level)
+            {
+                auto shift = SLOT_BITS * level;
+                auto start = _current >> shift;
+                if (_current & ((std::uint64_t(1) << shift) - 1))
+                    ++start;
+                d = distance(level, static_cast<unsigned int>(start & (SLOTS - 1)));
+                if (d < SLOTS)
+                {
+                    auto tick = (start + d) << shift;
+                    if (tick < next)
+                        next = tick;
+                }
+            }
+            return next;
+        }
+
+    public:
+        /*!
+         * \brief Creates an empty wheel.
+         *
+         * \param[in] slack The length of a tick.  Timeouts less than this apart may fire together.
+         */
+        explicit timer_wheel(const std::chrono::steady_clock::duration &slack) noexcept
+        : _origin(std::chrono::steady_clock::now()),
+          _tick(slack > std::chrono::steady_clock::duration::zero() ? slack : std::chrono::steady_clock::duration(1))
+        {
+            for (unsigned int level = 0; level < LEVELS; ++level)
+            {
+                _occupied[level] = 0;
+                for (unsigned int slot = 0; slot < SLOTS; ++slot)
+                    _slots[level][slot] = nullptr;
+            }
+        }
+
+        timer_wheel(const timer_wheel&) = delete;
+
+        timer_wheel& operator=(const timer_wheel&) = delete;
+
+        /*!
+         * \brief Adds a timeout to the wheel.
+         *
+         * \param[in] h The timeout to add.  Must not already be in a wheel.
+         * \param[in] time The time the timeout fires at.
+         *
+         * \return True if the timeout is now the next to fire, false otherwise.
+         */
+        bool insert(hook *h, const std::chrono::steady_clock::time_point &time) noexcept
+        {
+            // Round up to a whole tick so the timeout never fires early
+            auto next = next_tick();
+            auto offset = time - _origin;
+            std::uint64_t expiry = 0;
+            if (offset > std::chrono::steady_clock::duration::zero())
+                expiry = static_cast<std::uint64_t>((offset.count() + _tick.count() - 1) / _tick.count());
+            h->_expiry = expiry > _current ? expiry : _current;
+            link(h);
+            return h->_expiry < next;
+        }
+
+        /*!
+         * \brief Removes a timeout from the wheel if it has not fired.
+         *
+         * \param[in] h The timeout to remove.
+         */
+        void remove(hook *h) noexcept
+        {
+            if (h->linked())
+                unlink(h);
+        }
+
+        /*!
+         * \brief Gets the time at which the wheel next has work to do.
+         *
+         * \return The time to next advance the wheel, or time_point::max() if the wheel is empty.
+         */
+        std::chrono::steady_clock::time_point next_time() const noexcept
+        {
+            auto next = next_tick();
+            if (next == NEVER)
+                return std::chrono::steady_clock::time_point::max();
+            return _origin + _tick * static_cast<std::chrono::steady_clock::rep>(next);
+        }
+
+        /*!
+         * \brief Fires every timeout due by the given time.  Each is removed from the wheel before
+         * being passed to the action.
+         *
+         * \tparam F The type of the action.
+         *
+         * \param[in] now The current time.
+         * \param[in] fire The action to take on each timeout that fires.
+         */
+        template<typename F>
+        void advance(const std::chrono::steady_clock::time_point &now, F fire) noexcept
+        {
+            if (now < _origin)
+                return;
+            auto target = static_cast<std::uint64_t>((now - _origin).count() / _tick.count());
+            while (true)
+            {
+                // Skip straight to the next tick that has work
+                auto tick = next_tick();
+                if (tick > target)
+                {
+                    if (target + 1 > _current)
+                        _current = target + 1;
+                    return;
+                }
+                _current = tick;
+                // Move down the slots of higher levels that start on this tick, highest first
+                for (unsigned int level = LEVELS - 1; level > 0; --level)
+                {
+                    auto shift = SLOT_BITS * level;
+                    if (_current & ((std::uint64_t(1) << shift) - 1))
+                        continue;
+                    auto h = take(level, static_cast<unsigned int>((_current >> shift) & (SLOTS - 1)));
+                    while (h)
+                    {
+                        auto next = h->_next;
+                        link(h);
+                        h = next;
+                    }
+                }
+                // Fire the timeouts on this tick
+                auto h = take(0, static_cast<unsigned int>(_current & (SLOTS - 1)));
+                while (h)
+                {
+                    auto next = h->_next;
+                    h->_next = nullptr;
+                    h->_pprev = nullptr;
+                    fire(h);
+                    h = next;
+                }
+                ++_current;
+            }
+        }
+
+        /*!
+         * \brief Sets the slack given to wheels created from now on.  The timer service and the fiber
+         * scheduler create their wheels when first used and when started, so set this before then.
+         *
+         * \param[in] slack The slack.  Timeouts closer together than this may fire together.
+         */
+        static void set_default_slack(const std::chrono::steady_clock::duration &slack) noexcept
+        {
+            slack_setting().store(slack.count());
+        }
+
+        /*!
+         * \brief Gets the slack given to wheels created from now on.  Defaults to 50 microseconds.
+         *
+         * \return The slack.
+         */
+        static std::chrono::steady_clock::duration default_slack() noexcept
+        {
+            return std::chrono::steady_clock::duration(slack_setting().load());
+        }
+
+    private:
+        /*!
+         * \brief Gets the stored slack setting.
+         *
+         * \return Reference to the slack, in steady_clock ticks.
+         */
+        static std::atomic<std::chrono::steady_clock::rep>& slack_setting() noexcept
+        {
+            static std::atomic<std::chrono::steady_clock::rep> slack(
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(50)).count());
+            return slack;
+        }
+    };
+}
+
+#endif //CPP_CSP_TIMER_WHEEL_H
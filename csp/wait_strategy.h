@@ -0,0 +1,277 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_WAIT_STRATEGY_H
+#define CPP_CSP_WAIT_STRATEGY_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "fiber_scheduler.h"
+
+namespace csp
+{
+    /*! \enum wait_strategy
+     * \brief The ways a process can wait for a partner.
+     */
+    enum class wait_strategy : unsigned char
+    {
+        DEFAULT     = 0,    //!< Use the global strategy, or the primitive's own if no global strategy is set
+        BLOCK       = 1,    //!< Park straight away
+        SPIN        = 2,    //!< Busy spin until the partner arrives.  Never parks.
+        SPIN_YIELD  = 3,    //!< Spin for a short while, then yield until the partner arrives.  Never parks.
+        ADAPTIVE    = 4,    //!< Spin for as long as recent waits needed, yield a few times, then park
+    };
+
+    /*! \class wait_policy
+     * \brief Holds the wait strategy of a channel, barrier or alt and performs its waits.
+     *
+     * The adaptive strategy learns how long to spin from the waits it has done.  A wait met while
+     * spinning moves the spin limit towards twice the spins it took, and a wait that had to park
+     * cuts the limit by a quarter.  A partner that turns up quickly is caught before parking, and a
+     * partner that does not costs little spinning.
+     *
+     * Spinning is pointless on a single core, and in a fiber it stops the partner fiber running,
+     * so there the spinning strategies yield instead.  The strategies that never park suit
+     * processes that each have a core.  With more waiting processes than cores they only burn time.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class wait_policy
+    {
+    private:
+        static constexpr unsigned int MIN_SPINS = 4; //!< Lowest spin limit the adaptive strategy learns.
+
+        static constexpr unsigned int MAX_SPINS = 4096; //!< Highest spin limit the adaptive strategy learns.
+
+        static constexpr unsigned int INITIAL_SPINS = 32; //!< Spin limit the adaptive strategy starts with.
+
+        static constexpr unsigned int SHORT_SPINS = 64; //!< Number of spins before the spin-then-yield strategy yields.
+
+        static constexpr unsigned int YIELD_COUNT = 8; //!< Number of yields before the adaptive strategy parks.
+
+        static constexpr unsigned int FIBER_YIELD_COUNT = 2; //!< Number of yields before the adaptive strategy parks a fiber.
+
+        std::atomic<unsigned char> _strategy; //!< The strategy set for this object.
+
+        std::atomic<unsigned int> _spins; //!< Spin limit learnt by the adaptive strategy.
+
+        /*!
+         * \brief Checks whether spinning can help.
+         *
+         * \return True if the partner may be running while we spin, false otherwise.
+         */
+        static bool can_spin() noexcept
+        {
+            static const bool multicore = std::thread::hardware_concurrency() > 1;
+            return multicore && !fiber_scheduler::in_fiber();
+        }
+
+        /*!
+         * \brief Gets the stored global strategy.
+         *
+         * \return Reference to the global strategy.
+         */
+        static std::atomic<unsigned char>& default_setting() noexcept
+        {
+            static std::atomic<unsigned char> strategy(static_cast<unsigned char>(wait_strategy::DEFAULT));
+            return strategy;
+        }
+
+        /*!
+         * \brief Moves the adaptive spin limit after a wait.
+         *
+         * \param[in] spins The number of spins the wait took, or the spin limit if it gave up spinning.
+         * \param[in] met True if the wait was met while spinning, false otherwise.
+         */
+        void learn(unsigned int spins, bool met) noexcept
+        {
+            auto limit = static_cast<int>(_spins.load(std::memory_order_relaxed));
+            if (met)
+                limit += (2 * static_cast<int>(spins) - limit) / 8;
+            else
+                limit -= limit / 4;
+            if (limit < static_cast<int>(MIN_SPINS))
+                limit = MIN_SPINS;
+            else if (limit > static_cast<int>(MAX_SPINS))
+                limit = MAX_SPINS;
+            _spins.store(static_cast<unsigned int>(limit), std::memory_order_relaxed);
+        }
+
+    public:
+        /*!
+         * \brief Creates a policy that follows the global strategy.
+         */
+        wait_policy() noexcept
+        : _strategy(static_cast<unsigned char>(wait_strategy::DEFAULT)), _spins(INITIAL_SPINS)
+        {
+        }
+
+        wait_policy(const wait_policy&) = delete;
+
+        wait_policy& operator=(const wait_policy&) = delete;
+
+        /*!
+         * \brief Hints to the processor that we are in a spin loop.
+         */
+        static void relax() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#else
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+        }
+
+        /*!
+         * \brief Sets the strategy used by every channel, barrier and alt without a strategy of its
+         * own.
+         *
+         * \param[in] strategy The strategy.  DEFAULT lets each primitive use its own.
+         */
+        static void set_default(wait_strategy strategy) noexcept
+        {
+            default_setting().store(static_cast<unsigned char>(strategy));
+        }
+
+        /*!
+         * \brief Gets the global strategy.
+         *
+         * \return The global strategy.
+         */
+        static wait_strategy get_default() noexcept
+        {
+            return static_cast<wait_strategy>(default_setting().load());
+        }
+
+        /*!
+         * \brief Sets the strategy for this object.
+         *
+         * \param[in] strategy The strategy.  DEFAULT follows the global strategy.
+         */
+        void set(wait_strategy strategy) noexcept
+        {
+            _strategy.store(static_cast<unsigned char>(strategy));
+        }
+
+        /*!
+         * \brief Gets the strategy to use.  The object's strategy comes first, then the global one.
+         *
+         * \param[in] builtin The strategy to use if neither is set.
+         *
+         * \return The strategy to use.
+         */
+        wait_strategy get(wait_strategy builtin) const noexcept
+        {
+            auto strategy = static_cast<wait_strategy>(_strategy.load(std::memory_order_relaxed));
+            if (strategy == wait_strategy::DEFAULT)
+                strategy = get_default();
+            return strategy == wait_strategy::DEFAULT ? builtin : strategy;
+        }
+
+        /*!
+         * \brief Waits for the given condition without parking.
+         *
+         * \tparam Pred The type of the condition.
+         *
+         * \param[in] pred The condition to wait on.  Called until it returns true, and not again after.
+         * \param[in] builtin The strategy to use if none is set.
+         *
+         * \return True if the condition holds, false if the caller should park.
+         */
+        template<typename Pred>
+        bool spin(Pred pred, wait_strategy builtin) noexcept
+        {
+            auto strategy = get(builtin);
+            if (strategy == wait_strategy::BLOCK)
+                return pred();
+            auto spinning = can_spin();
+            // Spin, and spin-then-yield, never give up
+            if (strategy == wait_strategy::SPIN || strategy == wait_strategy::SPIN_YIELD)
+            {
+                auto spins = strategy == wait_strategy::SPIN ? ~0u : SHORT_SPINS;
+                auto fiber = fiber_scheduler::in_fiber();
+                for (unsigned int i = 0; !pred(); ++i)
+                {
+                    if (spinning && i < spins)
+                        relax();
+                    else
+                    {
+                        fiber_scheduler::yield();
+                        // A worker whose only fiber is waiting would otherwise hold its core from
+                        // the worker running the partner
+                        if (fiber)
+                            std::this_thread::yield();
+                    }
+                }
+                return true;
+            }
+            // Adaptive.  Spin up to the learnt limit.
+            if (spinning)
+            {
+                auto limit = _spins.load(std::memory_order_relaxed);
+                for (unsigned int i = 0; i < limit; ++i)
+                {
+                    if (pred())
+                    {
+                        learn(i, true);
+                        return true;
+                    }
+                    relax();
+                }
+                learn(limit, false);
+            }
+            // Give the partner a chance to run
+            auto yields = fiber_scheduler::in_fiber() ? FIBER_YIELD_COUNT : YIELD_COUNT;
+            for (unsigned int i = 0; i < yields; ++i)
+            {
+                if (pred())
+                    return true;
+                fiber_scheduler::yield();
+            }
+            return pred();
+        }
+
+        /*!
+         * \brief Waits on a condition variable until the given condition holds.  Spins first if the
+         * strategy says so, releasing the lock between checks.
+         *
+         * \tparam Pred The type of the condition.
+         *
+         * \param[in] lock The lock held.  Held again on return.
+         * \param[in] cond The condition variable to park on.
+         * \param[in] pred The condition to wait on.  Checked with the lock held.
+         * \param[in] builtin The strategy to use if none is set.
+         */
+        template<typename Pred>
+        void wait(std::unique_lock<std::mutex> &lock, condition &cond, Pred pred, wait_strategy builtin = wait_strategy::BLOCK) noexcept
+        {
+            if (pred())
+                return;
+            if (get(builtin) != wait_strategy::BLOCK)
+            {
+                // Check the condition with the lock held, returning with it held if met
+                lock.unlock();
+                auto met = spin([&]()
+                {
+                    lock.lock();
+                    if (pred())
+                        return true;
+                    lock.unlock();
+                    return false;
+                }, builtin);
+                if (met)
+                    return;
+                lock.lock();
+            }
+            // Park until the condition holds
+            while (!pred())
+                cond.wait(lock);
+        }
+    };
+}
+
+#endif //CPP_CSP_WAIT_STRATEGY_H
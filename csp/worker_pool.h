@@ -0,0 +1,264 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#ifndef CPP_CSP_WORKER_POOL_H
+#define CPP_CSP_WORKER_POOL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fiber_scheduler.h"
+#include "chan_waiter.h"
+
+namespace csp
+{
+    /*! \class worker_pool
+     * \brief A process-wide pool of worker threads that runs the iterations of a parallel loop.
+     *
+     * A fork hands out the iterations in chunks from a shared counter, and the caller runs chunks
+     * itself.  Each runner asks for one more helper before it starts a chunk while chunks are left,
+     * so workers are only woken when the work already running has not finished it.  A loop of quick
+     * iterations is run by the caller alone.  A chunk that blocks, such as a channel write whose
+     * reader has not arrived, still leaves a helper to take the next chunk, so every chunk gets a
+     * runner and iterations that talk to each other cannot deadlock.  The pool starts a new thread
+     * when no worker is idle, and workers stay parked for the next fork once done.  When the fiber
+     * scheduler is running, helpers are fibers instead.
+     *
+     * The caller waits on a fork-join latch counting the chunks not yet finished.  A loop that only
+     * computes can cap its helpers at one fewer than the cores, as more cannot make it faster.
+     *
+     * \author Kevin Chalmers
+     *
+     * \date 16/10/2026
+     */
+    class worker_pool
+    {
+    private:
+        /*! \class fork
+         * \brief The shared state of one parallel loop.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class fork
+        {
+        public:
+            size_t _size; //!< Number of iterations.
+
+            size_t _grain; //!< Number of iterations in a chunk.
+
+            size_t _chunks; //!< Number of chunks.
+
+            void (*_body)(void*, size_t, size_t); //!< Runs the iterations from the first index up to the second.
+
+            void *_context; //!< The loop body passed to _body.
+
+            std::atomic<size_t> _next; //!< Index of the next chunk to hand out.
+
+            std::atomic<size_t> _pending; //!< Number of chunks not yet finished.  The latch the caller waits on.
+
+            std::atomic<bool> _helping; //!< True while a helper has been asked for and has not yet started.
+
+            size_t _spare; //!< Number of helpers that may still be asked for.  Only changed by the runner that set _helping.
+
+            chan_waiter _waiter; //!< Used by the caller to wait on the latch.
+
+            fork(size_t size, size_t grain, size_t helpers, void (*body)(void*, size_t, size_t), void *context) noexcept
+            : _size(size), _grain(grain), _chunks((size + grain - 1) / grain), _body(body), _context(context),
+              _next(0), _pending(_chunks), _helping(false), _spare(helpers)
+            {
+            }
+        };
+
+        /*! \class worker
+         * \brief A thread of the pool, parked until given a fork to help with.
+         *
+         * \author Kevin Chalmers
+         *
+         * \date 16/10/2026
+         */
+        class worker
+        {
+        public:
+            std::mutex _mut; //!< Protects the fork handed to the worker.
+
+            condition _cond; //!< Used to wake the worker.
+
+            std::shared_ptr<fork> _fork; //!< Fork to help with, or nullptr while idle.
+        };
+
+        std::mutex _mut; //!< Protects the list of idle workers.
+
+        std::vector<worker*> _idle; //!< Workers waiting for a fork.
+
+        /*!
+         * \brief Gets the pool, creating it on first use.  The pool lives until the program ends.
+         *
+         * \return The pool.
+         */
+        static worker_pool& get() noexcept
+        {
+            static worker_pool *pool = new worker_pool();
+            return *pool;
+        }
+
+        /*!
+         * \brief Runs chunks of a fork until none are left.
+         *
+         * \param[in] f The fork to work on.
+         */
+        static void work(const std::shared_ptr<fork> &f) noexcept
+        {
+            while (true)
+            {
+                // Take the next chunk
+                auto chunk = f->_next.fetch_add(1);
+                if (chunk >= f->_chunks)
+                    return;
+                // Make sure someone takes the next chunk should this one block.  Once the helpers
+                // are used up _helping stays set.
+                if (chunk + 1 < f->_chunks && !f->_helping.exchange(true) && f->_spare > 0)
+                {
+                    --f->_spare;
+                    get().help(f);
+                }
+                auto first = chunk * f->_grain;
+                auto last = first + f->_grain < f->_size ? first + f->_grain : f->_size;
+                f->_body(f->_context, first, last);
+                // Count down the latch
+                if (f->_pending.fetch_sub(1) == 1)
+                    f->_waiter.wake();
+            }
+        }
+
+        /*!
+         * \brief Starts a helper working on a fork.
+         *
+         * \param[in] f The fork to help with.
+         */
+        void help(const std::shared_ptr<fork> &f) noexcept
+        {
+            // Fibers are cheap to start, and threads would take cores from the scheduler
+            if (fiber_scheduler::active())
+            {
+                fiber_scheduler::spawn([f]()
+                {
+                    f->_helping.store(false);
+                    work(f);
+                });
+                return;
+            }
+            // Take an idle worker, or add one
+            worker *w = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_mut);
+                if (!_idle.empty())
+                {
+                    w = _idle.back();
+                    _idle.pop_back();
+                }
+            }
+            if (!w)
+            {
+                w = new worker();
+                w->_fork = f;
+                std::thread(&worker_pool::serve, this, w).detach();
+                return;
+            }
+            // Hand over the fork
+            std::lock_guard<std::mutex> lock(w->_mut);
+            w->_fork = f;
+            w->_cond.notify_one();
+        }
+
+        /*!
+         * \brief Helps with forks as they are handed over.  Run by each worker thread.
+         *
+         * \param[in] w The worker.
+         */
+        void serve(worker *w) noexcept
+        {
+            while (true)
+            {
+                std::shared_ptr<fork> f;
+                {
+                    // Wait for a fork
+                    std::unique_lock<std::mutex> lock(w->_mut);
+                    while (!w->_fork)
+                        w->_cond.wait(lock);
+                    f = std::move(w->_fork);
+                }
+                f->_helping.store(false);
+                work(f);
+                f.reset();
+                // Back to the idle list
+                std::lock_guard<std::mutex> lock(_mut);
+                _idle.push_back(w);
+            }
+        }
+
+        worker_pool() noexcept = default;
+
+    public:
+        static constexpr size_t UNLIMITED = ~size_t(0); //!< Helper limit that lets every chunk run at once.
+
+        worker_pool(const worker_pool&) = delete;
+
+        worker_pool& operator=(const worker_pool&) = delete;
+
+        /*!
+         * \brief Runs a loop body over the indices [0, size) in parallel, and returns once every
+         * iteration has finished.
+         *
+         * \tparam Fun The type of the loop body.
+         *
+         * \param[in] size The number of iterations.
+         * \param[in] grain The number of iterations run together as one chunk.  Iterations of a
+         * chunk run one after the other, so use one if the iterations can block on each other.
+         * \param[in] fun The loop body, called with each index.
+         * \param[in] helpers The most helpers to ask for.  Leave unlimited if the iterations can
+         * block on each other.
+         */
+        template<typename Fun>
+        static void run(size_t size, size_t grain, Fun &&fun, size_t helpers = UNLIMITED) noexcept
+        {
+            if (grain == 0)
+                grain = 1;
+            // A single chunk needs no helpers
+            if (size <= grain)
+            {
+                for (size_t i = 0; i < size; ++i)
+                    fun(i);
+                return;
+            }
+            using body_type = typename std::remove_reference<Fun>::type;
+            auto body = [](void *context, size_t first, size_t last)
+            {
+                auto &fun = *static_cast<body_type*>(context);
+                for (size_t i = first; i < last; ++i)
+                    fun(i);
+            };
+            auto f = std::make_shared<fork>(size, grain, helpers, body, const_cast<void*>(static_cast<const void*>(&fun)));
+            // Work on the fork alongside the helpers, then wait for the chunks they took
+            work(f);
+            f->_waiter.await([&f]() { return f->_pending.load() == 0; });
+        }
+
+        /*!
+         * \brief Gets the number of helpers that keeps every core busy alongside the caller.
+         *
+         * \return One fewer than the number of cores.
+         */
+        static size_t core_helpers() noexcept
+        {
+            static const size_t helpers = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0;
+            return helpers;
+        }
+    };
+}
+
+#endif //CPP_CSP_WORKER_POOL_H
@@ -0,0 +1,72 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Independent groups of processes synchronise on alting barriers.  Each process is enrolled on
+// two barriers of its group.  Each round it chooses between the two with an alt, then syncs on
+// the first.  Groups share no barriers, so each has its own coordinator, and adding groups
+// should add work without adding contention.  Reports the time per round for each number of
+// groups, and checks every process saw the same choices as the rest of its group.
+
+unsigned int ROUNDS = 2000;
+
+unsigned int PROCESSES = 4;
+
+void run(unsigned int groups)
+{
+    vector<function<void()>> procs;
+    vector<vector<unsigned int>> chosen(groups * PROCESSES, vector<unsigned int>(ROUNDS));
+    for (unsigned int g = 0; g < groups; ++g)
+    {
+        auto first = alting_barrier::create(PROCESSES);
+        auto second = alting_barrier::create(PROCESSES);
+        for (unsigned int p = 0; p < PROCESSES; ++p)
+        {
+            auto a = first[p];
+            auto b = second[p];
+            auto &mine = chosen[g * PROCESSES + p];
+            procs.push_back([a, b, &mine]()
+            {
+                alt choice{a, b};
+                for (unsigned int i = 0; i < ROUNDS; ++i)
+                {
+                    mine[i] = choice.fair_select();
+                    a.sync();
+                }
+            });
+        }
+    }
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    bool agreed = true;
+    for (unsigned int g = 0; g < groups; ++g)
+        for (unsigned int p = 1; p < PROCESSES; ++p)
+            agreed = agreed && chosen[g * PROCESSES + p] == chosen[g * PROCESSES];
+    cout << groups << " group(s): " << total / 1000.0 / ROUNDS << "us per round, " << total / 1000.0 / ROUNDS / groups << "us per group round" << (agreed ? "" : ", CHOICES DIFFER") << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        ROUNDS = stoi(argv[1]);
+    if (argc >= 3)
+        PROCESSES = stoi(argv[2]);
+    cout << ROUNDS << " rounds, " << PROCESSES << " processes per group" << endl;
+    for (unsigned int groups = 1; groups <= 8; groups *= 2)
+        run(groups);
+    return 0;
+}
@@ -0,0 +1,55 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Runs a bulk-synchronous loop on each kind of barrier for a range of process counts, and
+// reports the time per phase.
+
+unsigned int PHASES = 1000;
+
+double phase_time(unsigned int processes, barrier_kind kind)
+{
+    barrier bar(processes, kind);
+    vector<function<void()>> procs;
+    for (unsigned int i = 0; i < processes; ++i)
+        procs.push_back([=]()
+        {
+            for (unsigned int j = 0; j < PHASES; ++j)
+                bar();
+        });
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / (1000.0 * PHASES);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        PHASES = stoi(argv[1]);
+    bool fibers = argc >= 3 && string(argv[2]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << PHASES << " phases, microseconds per phase" << endl;
+    cout << "processes,central,sense-reversing,combining tree,dissemination" << endl;
+    for (unsigned int processes : {4, 16, 64, 256})
+    {
+        cout << processes;
+        for (auto kind : {barrier_kind::CENTRAL, barrier_kind::SENSE_REVERSING, barrier_kind::COMBINING_TREE, barrier_kind::DISSEMINATION})
+            cout << "," << phase_time(processes, kind);
+        cout << endl;
+    }
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Streams doubles from a producer to a consumer one value at a time and in batches, over an
+// unbuffered and a buffered channel.
+
+unsigned int VALUES = 1000000;
+unsigned int BATCH = 256;
+
+double stream_single(one2one_chan<double> &c)
+{
+    auto start = steady_clock::now();
+    par
+    {
+        [&]()
+        {
+            for (unsigned int i = 0; i < VALUES; ++i)
+                c(static_cast<double>(i));
+        },
+        [&]()
+        {
+            double sum = 0.0;
+            for (unsigned int i = 0; i < VALUES; ++i)
+                sum += c();
+        }
+    }();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(VALUES);
+}
+
+double stream_batched(one2one_chan<double> &c)
+{
+    auto start = steady_clock::now();
+    par
+    {
+        [&]()
+        {
+            vector<double> values(BATCH);
+            for (unsigned int i = 0; i < VALUES; i += BATCH)
+            {
+                for (unsigned int j = 0; j < BATCH; ++j)
+                    values[j] = static_cast<double>(i + j);
+                c.out().write_n(values.data(), BATCH);
+            }
+        },
+        [&]()
+        {
+            vector<double> values(BATCH);
+            double sum = 0.0;
+            for (unsigned int i = 0; i < VALUES; i += BATCH)
+            {
+                c.in().read_n(values.data(), BATCH);
+                for (auto v : values)
+                    sum += v;
+            }
+        }
+    }();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(VALUES);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3)
+    {
+        VALUES = stoi(argv[1]);
+        BATCH = stoi(argv[2]);
+    }
+    VALUES -= VALUES % BATCH;
+    cout << VALUES << " values, batches of " << BATCH << endl;
+
+    one2one_chan<double> unbuffered;
+    buffer<double> buf(BATCH);
+    one2one_chan<double> buffered(buf);
+    cout << "unbuffered single:  " << stream_single(unbuffered) << "ns per value" << endl;
+    cout << "unbuffered batched: " << stream_batched(unbuffered) << "ns per value" << endl;
+    cout << "buffered single:    " << stream_single(buffered) << "ns per value" << endl;
+    cout << "buffered batched:   " << stream_batched(buffered) << "ns per value" << endl;
+    return 0;
+}
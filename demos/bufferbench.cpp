@@ -0,0 +1,86 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Compares a pipeline of buffered channels using a chan_data_store behind a mutex against the
+// same pipeline using the lock-free buffered channels, which a plain buffer selects.
+
+unsigned int STAGES = 8;
+unsigned int BUFFER = 64;
+unsigned int MESSAGES = 1000000;
+
+void producer(chan_out<unsigned int> out) noexcept
+{
+    for (unsigned int i = 0; i < MESSAGES; ++i)
+        out(i);
+}
+
+void stage(chan_in<unsigned int> in, chan_out<unsigned int> out) noexcept
+{
+    for (unsigned int i = 0; i < MESSAGES; ++i)
+        out(in() + 1);
+}
+
+void consumer(chan_in<unsigned int> in) noexcept
+{
+    for (unsigned int i = 0; i < MESSAGES; ++i)
+        in();
+}
+
+template<typename CHAN>
+double run_pipeline(vector<CHAN> &chans)
+{
+    vector<function<void()>> procs;
+    procs.push_back(make_proc(producer, chans[0]));
+    for (unsigned int i = 0; i < STAGES; ++i)
+        procs.push_back(make_proc(stage, chans[i], chans[i + 1]));
+    procs.push_back(make_proc(consumer, chans[STAGES]));
+
+    par p(procs);
+    auto start = steady_clock::now();
+    p();
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    return total / static_cast<double>(MESSAGES);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 4)
+    {
+        STAGES = stoi(argv[1]);
+        BUFFER = stoi(argv[2]);
+        MESSAGES = stoi(argv[3]);
+    }
+    cout << STAGES << " stages, buffer " << BUFFER << ", " << MESSAGES << " messages" << endl;
+
+    vector<one2one_chan<unsigned int>> locked_chans;
+    vector<one2one_chan<unsigned int>> spsc_chans;
+    vector<any2any_chan<unsigned int>> locked_shared_chans;
+    vector<any2any_chan<unsigned int>> mpmc_chans;
+    for (unsigned int i = 0; i <= STAGES; ++i)
+    {
+        // A chan_data_store is shared by the channels it is given to, so each needs its own
+        buffer<unsigned int> buf(BUFFER), shared_buf(BUFFER);
+        chan_data_store<unsigned int> &store = buf, &shared_store = shared_buf;
+        locked_chans.push_back(one2one_chan<unsigned int>(store));
+        spsc_chans.push_back(one2one_chan<unsigned int>(buf));
+        locked_shared_chans.push_back(any2any_chan<unsigned int>(shared_store));
+        mpmc_chans.push_back(any2any_chan<unsigned int>(buf));
+    }
+
+    cout << "one2one locked:    " << run_pipeline(locked_chans) << "ns per message" << endl;
+    cout << "one2one lock-free: " << run_pipeline(spsc_chans) << "ns per message" << endl;
+    cout << "any2any locked:    " << run_pipeline(locked_shared_chans) << "ns per message" << endl;
+    cout << "any2any lock-free: " << run_pipeline(mpmc_chans) << "ns per message" << endl;
+    return 0;
+}
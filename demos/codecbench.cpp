@@ -0,0 +1,156 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include "../csp/csp.h"
+#include "../csp/net/net_chan.h"
+#include "../csp/plugnplay/multiplex_packet.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::net;
+using namespace csp::plugnplay;
+
+// Sends the packets of the multiplexing processes and the Mandelbrot demos between two nodes
+// over a Unix-domain socket.  Each packet is sent with its codec, straight from its memory, and
+// then again by first copying it into a string, as a serialiser that builds a message would.
+// Reports the time per packet and the rate of payload sent.
+
+unsigned int PACKETS = 5000;
+
+unsigned int DIM = 256;
+
+unsigned int ROUNDS = 3;
+
+struct mandelbrot_packet
+{
+    int line = 0;
+    vector<double> data;
+};
+
+namespace csp
+{
+    namespace net
+    {
+        // The codecs a user provides for their own packets, encoding each field with its own codec
+        template<>
+        struct codec<mandelbrot_packet>
+        {
+            static void encode(const mandelbrot_packet &value, encoder &out) noexcept
+            {
+                codec<int>::encode(value.line, out);
+                codec<vector<double>>::encode(value.data, out);
+            }
+
+            static mandelbrot_packet decode(decoder &in) noexcept(false)
+            {
+                mandelbrot_packet value;
+                value.line = codec<int>::decode(in);
+                value.data = codec<vector<double>>::decode(in);
+                return value;
+            }
+        };
+
+        template<typename T>
+        struct codec<multiplex_packet<T>, typename enable_if<!is_trivially_copyable<multiplex_packet<T>>::value>::type>
+        {
+            static void encode(const multiplex_packet<T> &value, encoder &out) noexcept
+            {
+                codec<unsigned int>::encode(value.index, out);
+                codec<T>::encode(value.data, out);
+            }
+
+            static multiplex_packet<T> decode(decoder &in) noexcept(false)
+            {
+                auto index = codec<unsigned int>::decode(in);
+                return multiplex_packet<T>(index, codec<T>::decode(in));
+            }
+        };
+    }
+}
+
+// Copies a packet into a string, as a serialiser building a message would
+string to_string(const multiplex_packet<int> &packet)
+{
+    return string(reinterpret_cast<const char*>(&packet), sizeof(packet));
+}
+
+string to_string(const multiplex_packet<vector<double>> &packet)
+{
+    string bytes(reinterpret_cast<const char*>(&packet.index), sizeof(packet.index));
+    bytes.append(reinterpret_cast<const char*>(packet.data.data()), packet.data.size() * sizeof(double));
+    return bytes;
+}
+
+string to_string(const mandelbrot_packet &packet)
+{
+    string bytes(reinterpret_cast<const char*>(&packet.line), sizeof(packet.line));
+    bytes.append(reinterpret_cast<const char*>(packet.data.data()), packet.data.size() * sizeof(double));
+    return bytes;
+}
+
+template<typename T>
+void run(const string &label, link_manager &from, link_manager &to, const T &packet, size_t payload)
+{
+    static unsigned int count = 0;
+    auto name = "codec" + std::to_string(count++);
+    net_chan_in<T> in(to, name);
+    net_chan_out<T> out(from, to.get_address(), name);
+    net_chan_in<string> copied_in(to, name + "s");
+    net_chan_out<string> copied_out(from, to.get_address(), name + "s");
+
+    // Alternate the two, keeping the best of each
+    double gathered = 0.0, copied = 0.0;
+    for (unsigned int round = 0; round < ROUNDS; ++round)
+    {
+        // Sent with the codec
+        auto start = steady_clock::now();
+        par p
+        {
+            [=]() { for (unsigned int i = 0; i < PACKETS; ++i) out(packet); },
+            [=]() { for (unsigned int i = 0; i < PACKETS; ++i) in(); }
+        };
+        p();
+        auto time = duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(PACKETS);
+        gathered = round == 0 || time < gathered ? time : gathered;
+
+        // Copied into a string first
+        start = steady_clock::now();
+        par q
+        {
+            [=]() { for (unsigned int i = 0; i < PACKETS; ++i) copied_out(to_string(packet)); },
+            [=]() { for (unsigned int i = 0; i < PACKETS; ++i) copied_in(); }
+        };
+        q();
+        time = duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(PACKETS);
+        copied = round == 0 || time < copied ? time : copied;
+    }
+
+    cout << label << " (" << payload << " bytes): codec " << gathered << "ns, " << payload * 1000.0 / gathered << "MB/s; copied " << copied << "ns, " << payload * 1000.0 / copied << "MB/s" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        PACKETS = stoi(argv[1]);
+    if (argc >= 3)
+        DIM = stoi(argv[2]);
+    cout << PACKETS << " packets, lines of " << DIM << " points" << endl;
+    link_manager from(net_address::unix_domain("/tmp/codecbench_from.sock"));
+    link_manager to(net_address::unix_domain("/tmp/codecbench_to.sock"));
+    run("multiplex_packet<int>", from, to, multiplex_packet<int>(1, 42), sizeof(multiplex_packet<int>));
+    run("multiplex_packet<vector<double>>", from, to, multiplex_packet<vector<double>>(1, vector<double>(DIM, 1.0)), sizeof(unsigned int) + DIM * sizeof(double));
+    mandelbrot_packet packet;
+    packet.line = 1;
+    packet.data.assign(DIM, 1.0);
+    run("mandelbrot_packet", from, to, packet, sizeof(int) + DIM * sizeof(double));
+    packet.data.assign(DIM * 64, 1.0);
+    run("mandelbrot_packet x64", from, to, packet, sizeof(int) + DIM * 64 * sizeof(double));
+    return 0;
+}
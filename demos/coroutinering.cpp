@@ -0,0 +1,80 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// A ring of coroutine processes fed by a thread, with the results read by a thread.  Shows
+// coroutines and threads communicating over the same channels, and the memory a process costs.
+
+long resident_kb()
+{
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line))
+        if (line.compare(0, 6, "VmRSS:") == 0)
+            return stol(line.substr(6));
+    return 0;
+}
+
+co_proc co_identity(chan_in<unsigned long long> in, chan_out<unsigned long long> out, size_t loops)
+{
+    for (size_t i = 0; i < loops; ++i)
+        co_await out.co_write(co_await in.co_read());
+}
+
+co_proc co_successor(chan_in<unsigned long long> in, chan_out<unsigned long long> out, size_t loops)
+{
+    for (size_t i = 0; i < loops; ++i)
+        co_await out.co_write(co_await in.co_read() + 1);
+}
+
+int main(int argc, char **argv)
+{
+    // Number of coroutines in the ring, and the number of values sent around it
+    size_t n = argc > 1 ? stoul(argv[1]) : 100000;
+    size_t loops = argc > 2 ? stoul(argv[2]) : 20;
+    fiber_scheduler::start();
+    cout << "Running ring of " << n << " coroutines" << endl;
+
+    auto before = resident_kb();
+    vector<one2one_chan<unsigned long long>> chans(n + 1);
+    vector<co_proc> procs;
+    for (size_t i = 0; i < n - 1; ++i)
+        procs.push_back(co_identity(chans[i], chans[i + 1], loops));
+    procs.push_back(co_successor(chans[n - 1], chans[n], loops));
+    cout << "Memory per process and channel: " << (resident_kb() - before) * 1024.0 / n << " bytes" << endl;
+
+    // The writer and reader are threads
+    thread writer([&]()
+    {
+        for (size_t i = 0; i < loops; ++i)
+            chans[0](i);
+    });
+    thread reader([&]()
+    {
+        auto start = steady_clock::now();
+        unsigned long long x = 0;
+        for (size_t i = 0; i < loops; ++i)
+            x = chans[n]();
+        auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+        cout << "Last received: " << x << endl;
+        cout << "Time per communication: " << total / static_cast<double>(loops * n) << "ns" << endl;
+    });
+
+    co_par ring(move(procs));
+    ring();
+    writer.join();
+    reader.join();
+    fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,109 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Sends values through a delta to a number of consumers, writing the outputs in sequence and then
+// in parallel with par_for as the plugnplay delta does.  Then reads them back with par_read as
+// paraplex does.  Reports the time per value.
+
+unsigned int VALUES = 10000;
+
+double delta(unsigned int outputs, bool sequential)
+{
+    one2one_chan<int> in;
+    vector<one2one_chan<int>> chans(outputs);
+    vector<chan_out<int>> outs;
+    for (auto &c : chans)
+        outs.push_back(c);
+
+    vector<function<void()>> procs;
+    // Producer
+    procs.push_back([=]()
+    {
+        for (unsigned int i = 0; i < VALUES; ++i)
+            in(static_cast<int>(i));
+    });
+    // Delta
+    procs.push_back([=]() mutable
+    {
+        for (unsigned int i = 0; i < VALUES; ++i)
+        {
+            auto value = in();
+            if (sequential)
+                for (auto &c : outs)
+                    c(value);
+            else
+                par_for(outs.begin(), outs.end(), [&](chan_out<int> chan){ chan(value); });
+        }
+    });
+    // Consumers
+    for (auto &c : chans)
+        procs.push_back([=]()
+        {
+            for (unsigned int i = 0; i < VALUES; ++i)
+                c();
+        });
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / double(VALUES);
+}
+
+double paraplex(unsigned int inputs)
+{
+    vector<one2one_chan<int>> chans(inputs);
+    vector<chan_in<int>> ins;
+    for (auto &c : chans)
+        ins.push_back(c);
+
+    vector<function<void()>> procs;
+    // Producers
+    for (auto &c : chans)
+        procs.push_back([=]()
+        {
+            for (unsigned int i = 0; i < VALUES; ++i)
+                c(static_cast<int>(i));
+        });
+    // Paraplex
+    procs.push_back([=]() mutable
+    {
+        for (unsigned int i = 0; i < VALUES; ++i)
+            par_read(ins);
+    });
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / double(VALUES);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        VALUES = stoi(argv[1]);
+    bool fibers = argc >= 3 && string(argv[2]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << VALUES << " values" << endl;
+
+    for (unsigned int n : {2, 4, 8})
+    {
+        cout << n << " outputs: " << delta(n, true) << "ns per value sequential, ";
+        cout << delta(n, false) << "ns per value parallel, ";
+        cout << paraplex(n) << "ns per value paraplex" << endl;
+    }
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,74 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "../csp/csp.h"
+#include "../csp/plugnplay/plugnplay.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::plugnplay;
+
+class consumer : public process
+{
+private:
+
+    chan_in<unsigned long long> _in;
+
+    size_t _hops;
+
+public:
+    consumer(chan_in<unsigned long long> in, size_t hops) noexcept
+    : _in(in), _hops(hops)
+    {
+    }
+
+    void run() noexcept override final
+    {
+        unsigned long long x = 0;
+        size_t loops = 100;
+        cout << "warming up..." << endl;
+        for (size_t i = 0; i < 10; ++i)
+            x = _in();
+        cout << "Last received: " << x << endl;
+
+        auto start = steady_clock::now();
+        for (size_t i = 0; i < loops; ++i)
+            x = _in();
+        auto end = steady_clock::now();
+        auto total = duration_cast<nanoseconds>(end - start).count();
+        cout << "Time per communication: " << total / static_cast<double>(loops * _hops) << "ns" << endl;
+        exit(0);
+    }
+};
+
+int main(int argc, char **argv)
+{
+    // Number of processes in the ring, and whether to run them on the fiber scheduler
+    size_t n = argc > 1 ? stoul(argv[1]) : 4096;
+    bool fibers = argc > 2 ? string(argv[2]) != "threads" : true;
+    if (fibers)
+        fiber_scheduler::start();
+    cout << "Running ring of " << n << " processes on " << (fibers ? "fibers" : "threads") << endl;
+
+    vector<one2one_chan<unsigned long long>> chans(n);
+    one2one_chan<unsigned long long> succ;
+    one2one_chan<unsigned long long> ret;
+    one2one_chan<unsigned long long> out;
+
+    vector<function<void()>> procs;
+    procs.push_back(prefix<unsigned long long>(0, ret, chans[0]));
+    for (size_t i = 0; i < n - 1; ++i)
+        procs.push_back(identity<unsigned long long>(chans[i], chans[i + 1]));
+    procs.push_back(delta<unsigned long long, true>(chans[n - 1], {succ, out}));
+    procs.push_back(successor<unsigned long long>(succ, ret));
+    procs.push_back(consumer(out, n + 2));
+
+    par p(procs);
+    p();
+}
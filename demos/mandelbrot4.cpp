@@ -0,0 +1,88 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <cmath>
+#include <numeric>
+#include "../csp/csp.h"
+#include "../csp/skeletons/skeletons.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::skeletons;
+
+// The mandelbrot1 demo written as an ordered farm.  Each row is computed by a worker and the rows
+// come out in order, so the consumer needs no line numbers.
+
+constexpr unsigned int MAX_ITERATIONS = 255;
+
+unsigned int DIM = 256;
+
+constexpr double xmin = -2.1;
+constexpr double xmax = 1.0;
+constexpr double ymin = -1.3;
+constexpr double ymax = 1.3;
+
+double integral_x = (xmax - xmin) / static_cast<double>(DIM);
+double integral_y = (ymax - ymin) / static_cast<double>(DIM);
+
+unsigned int NUM_WORKERS = 1;
+
+vector<double> mandelbrot(int line) noexcept
+{
+    vector<double> data(DIM);
+    double y = ymin + (line * integral_y);
+    double x = xmin;
+    for (unsigned int x_coord = 0; x_coord < DIM; ++x_coord)
+    {
+        double x1 = 0.0, y1 = 0.0, xx = 0.0;
+        unsigned int loop_count = 0;
+        while (loop_count < MAX_ITERATIONS && sqrt(pow(x1, 2.0) + pow(y1, 2.0)) < 2.0)
+        {
+            ++loop_count;
+            xx = pow(x1, 2.0) - pow(y1, 2.0) + x;
+            y1 = 2 * x1 * y1 + y;
+            x1 = xx;
+        }
+        data[x_coord] = static_cast<double>(loop_count) / static_cast<double>(MAX_ITERATIONS);
+        x += integral_x;
+    }
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3)
+    {
+        DIM = stoi(argv[1]);
+        NUM_WORKERS = stoi(argv[2]);
+        integral_x = (xmax - xmin) / static_cast<double>(DIM);
+        integral_y = (ymax - ymin) / static_cast<double>(DIM);
+    }
+
+    vector<int> lines(DIM);
+    iota(lines.begin(), lines.end(), 0);
+    farm<int, vector<double>> rows(mandelbrot, NUM_WORKERS, 1, true);
+
+    array<unsigned long long, 100> res;
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+        auto start = system_clock::now();
+        auto results = apply(rows, lines.begin(), lines.end(), 16);
+        auto stop = system_clock::now();
+        res[i] = duration_cast<nanoseconds>(stop - start).count();
+        cout << i << ": " << res[i] << endl;
+    }
+    ofstream results("mandelbrot_farm_" + to_string(NUM_WORKERS) + "_" + to_string(DIM) + ".csv");
+    for (unsigned int i = 0; i < 100; ++i)
+        results << res[i] << ",";
+    results.close();
+    return 0;
+}
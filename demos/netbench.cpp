@@ -0,0 +1,74 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+#include "../csp/net/net_chan.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::net;
+
+// Two nodes in one process, linked over loopback.  A number of writers on one node each send
+// values to their own input on the other node, so every channel shares the one link.  Reports
+// the messages per second and the time per message, over TCP and over a Unix-domain socket.
+
+unsigned int MESSAGES = 20000;
+
+unsigned int CHANNELS = 4;
+
+void run(const string &label, const net_address &from_address, const net_address &to_address)
+{
+    link_manager from(from_address);
+    link_manager to(to_address);
+    vector<function<void()>> procs;
+    vector<long long> sums(CHANNELS, 0);
+    for (unsigned int c = 0; c < CHANNELS; ++c)
+    {
+        auto name = "bench" + to_string(c);
+        net_chan_in<unsigned int> in(to, name);
+        net_chan_out<unsigned int> out(from, to.get_address(), name);
+        procs.push_back([=]()
+        {
+            for (unsigned int i = 0; i < MESSAGES; ++i)
+                out(i);
+        });
+        procs.push_back([=, &sums]()
+        {
+            for (unsigned int i = 0; i < MESSAGES; ++i)
+                sums[c] += in();
+        });
+    }
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    bool correct = true;
+    for (auto s : sums)
+        correct = correct && s == static_cast<long long>(MESSAGES) * (MESSAGES - 1) / 2;
+    auto messages = static_cast<double>(MESSAGES) * CHANNELS;
+    cout << label << ": " << static_cast<long long>(messages * 1e9 / total) << " messages/s, " << total / messages << "ns per message" << (correct ? "" : ", WRONG SUMS") << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        MESSAGES = stoi(argv[1]);
+    if (argc >= 3)
+        CHANNELS = stoi(argv[2]);
+    bool fibers = argc >= 4 && string(argv[3]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << MESSAGES << " messages on each of " << CHANNELS << " channels over one link" << endl;
+    run("TCP", net_address::tcp("127.0.0.1", 0), net_address::tcp("127.0.0.1", 0));
+    run("Unix-domain", net_address::unix_domain("/tmp/netbench_from.sock"), net_address::unix_domain("/tmp/netbench_to.sock"));
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,117 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+#include "../csp/net/net_chan.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::net;
+
+// Commstime split over two nodes in one process, linked over loopback.  Prefix, delta and the
+// consumer run on one node and successor on the other, so each cycle sends a value each way.
+// A write waits for its ack, so each way costs a round trip unless the ack goes back with the
+// value sent next.  Reports the time per cycle against the time for one round trip, with acks
+// sent at once and with acks held back for the next frame.  The round trip is timed with acks
+// sent at once, as a lone writer has no frame going back for its acks to join.
+
+unsigned int CYCLES = 20000;
+
+long long round_trip(const batch_policy &policy)
+{
+    link_manager from(net_address::tcp("127.0.0.1", 0), policy);
+    link_manager to(net_address::tcp("127.0.0.1", 0), policy);
+    net_chan_in<unsigned long long> in(to, "ping");
+    net_chan_out<unsigned long long> out(from, to.get_address(), "ping");
+    auto start = steady_clock::now();
+    par
+    {
+        [=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                out(i);
+        },
+        [=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                in();
+        }
+    }();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / CYCLES;
+}
+
+long long commstime(const batch_policy &policy)
+{
+    link_manager node_a(net_address::tcp("127.0.0.1", 0), policy);
+    link_manager node_b(net_address::tcp("127.0.0.1", 0), policy);
+    one2one_chan<unsigned long long> a;
+    one2one_chan<unsigned long long> d;
+    net_chan_in<unsigned long long> b_in(node_b, "b");
+    net_chan_out<unsigned long long> b_out(node_a, node_b.get_address(), "b");
+    net_chan_in<unsigned long long> c_in(node_a, "c");
+    net_chan_out<unsigned long long> c_out(node_b, node_a.get_address(), "c");
+    long long total = 0;
+    par
+    {
+        // Prefix, on node A
+        [=]()
+        {
+            a(0);
+            for (unsigned int i = 1; i < CYCLES; ++i)
+                a(c_in());
+            c_in();
+        },
+        // Delta, on node A
+        [=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+            {
+                auto x = a();
+                b_out(x);
+                d(x);
+            }
+        },
+        // Successor, on node B
+        [=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                c_out(b_in() + 1);
+        },
+        // Consumer, on node A
+        [=, &total]()
+        {
+            auto start = steady_clock::now();
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                d();
+            total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+        }
+    }();
+    return total / CYCLES;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        CYCLES = stoi(argv[1]);
+    unsigned int delay = argc >= 3 ? stoi(argv[2]) : 200;
+    cout << CYCLES << " cycles over TCP loopback" << endl;
+    vector<pair<string, batch_policy>> policies =
+    {
+        {"Acks sent at once", batch_policy()},
+        {"Acks held up to " + to_string(delay) + "us", batch_policy(64 * 1024, microseconds(0), microseconds(delay))}
+    };
+    auto rtt = round_trip(batch_policy());
+    cout << "One round trip: " << rtt << "ns" << endl;
+    for (auto &p : policies)
+    {
+        auto cycle = commstime(p.second);
+        cout << p.first << ": " << cycle << "ns per cycle, " << static_cast<double>(cycle) / rtt << " round trips per cycle" << endl;
+    }
+    return 0;
+}
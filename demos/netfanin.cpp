@@ -0,0 +1,87 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+#include "../csp/net/net_chan.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::net;
+
+// Many nodes in one process each write to their own input on one server node, which selects
+// over every input with an alt.  Each node has its own link to the server, and every node
+// shares one I/O engine, so all the links are served by the engine's I/O threads rather than a
+// thread each, and the alt is woken by them.  Reports the messages per second with each engine.
+
+unsigned int NODES = 256;
+
+unsigned int MESSAGES = 200;
+
+unsigned int THREADS = 1;
+
+void run(const shared_ptr<io_engine> &engine)
+{
+    link_manager server(net_address::tcp("127.0.0.1", 0), batch_policy(), engine);
+    vector<unique_ptr<link_manager>> nodes;
+    vector<net_chan_in<unsigned int>> ins;
+    vector<guard> guards;
+    vector<function<void()>> procs;
+    for (unsigned int n = 0; n < NODES; ++n)
+    {
+        auto name = "fanin" + to_string(n);
+        nodes.emplace_back(new link_manager(net_address::tcp("127.0.0.1", 0), batch_policy(), engine));
+        ins.emplace_back(server, name);
+        guards.push_back(ins.back().in());
+        net_chan_out<unsigned int> out(*nodes.back(), server.get_address(), name);
+        procs.push_back([=]()
+        {
+            for (unsigned int i = 0; i < MESSAGES; ++i)
+                out(i);
+        });
+    }
+    long long sum = 0;
+    procs.push_back([&]()
+    {
+        alt a(guards);
+        for (unsigned int i = 0; i < NODES * MESSAGES; ++i)
+            sum += ins[a()]();
+    });
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    bool correct = sum == static_cast<long long>(NODES) * MESSAGES * (MESSAGES - 1) / 2;
+    auto messages = static_cast<double>(NODES) * MESSAGES;
+    cout << engine->name() << ": " << static_cast<long long>(messages * 1e9 / total) << " messages/s, " << total / messages << "ns per message" << (correct ? "" : ", WRONG SUM") << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        NODES = stoi(argv[1]);
+    if (argc >= 3)
+        MESSAGES = stoi(argv[2]);
+    if (argc >= 4)
+        THREADS = stoi(argv[3]);
+    bool fibers = argc >= 5 && string(argv[4]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << NODES << " links of " << MESSAGES << " messages, served by " << THREADS << " I/O thread(s)" << endl;
+    run(make_shared<epoll_engine>(THREADS));
+    auto best = make_io_engine(THREADS);
+    if (string(best->name()) != "epoll")
+        run(best);
+    else
+        cout << "io_uring not supported here" << endl;
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
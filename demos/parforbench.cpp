@@ -0,0 +1,88 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Computes the mandelbrot set a row at a time, first in sequence, then with par_for creating a
+// process per row, then with par_for_range at a number of grain sizes.  Reports the time taken.
+
+constexpr unsigned int MAX_ITERATIONS = 255;
+
+unsigned int DIM = 512;
+
+unsigned int RUNS = 10;
+
+constexpr double xmin = -2.1;
+constexpr double xmax = 1.0;
+constexpr double ymin = -1.3;
+constexpr double ymax = 1.3;
+
+vector<vector<double>> results;
+
+void row(unsigned int line) noexcept
+{
+    double integral_x = (xmax - xmin) / static_cast<double>(DIM);
+    double integral_y = (ymax - ymin) / static_cast<double>(DIM);
+    double y = ymin + (line * integral_y);
+    double x = xmin;
+    auto &data = results[line];
+    for (unsigned int x_coord = 0; x_coord < DIM; ++x_coord)
+    {
+        double x1 = 0.0, y1 = 0.0, xx;
+        unsigned int loop_count = 0;
+        while (loop_count < MAX_ITERATIONS && sqrt(x1 * x1 + y1 * y1) < 2.0)
+        {
+            ++loop_count;
+            xx = x1 * x1 - y1 * y1 + x;
+            y1 = 2 * x1 * y1 + y;
+            x1 = xx;
+        }
+        data[x_coord] = static_cast<double>(loop_count) / static_cast<double>(MAX_ITERATIONS);
+        x += integral_x;
+    }
+}
+
+template<typename F>
+double time_runs(F f)
+{
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < RUNS; ++i)
+        f();
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / (1000.0 * RUNS);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        DIM = stoi(argv[1]);
+    if (argc >= 3)
+        RUNS = stoi(argv[2]);
+    bool fibers = argc >= 4 && string(argv[3]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << DIM << "x" << DIM << " mandelbrot, " << thread::hardware_concurrency() << " cores" << endl;
+
+    results = vector<vector<double>>(DIM, vector<double>(DIM));
+    vector<unsigned int> lines(DIM);
+    for (unsigned int i = 0; i < DIM; ++i)
+        lines[i] = i;
+
+    cout << "sequential: " << time_runs([&]() { for (auto l : lines) row(l); }) << "ms" << endl;
+    cout << "par_for: " << time_runs([&]() { par_for(lines.begin(), lines.end(), row); }) << "ms" << endl;
+    for (size_t grain : {1, 4, 16, 0})
+        cout << "par_for_range grain " << (grain == 0 ? string("auto") : to_string(grain)) << ": "
+             << time_runs([&]() { par_for_range(0u, DIM, grain, row); }) << "ms" << endl;
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,92 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Compares the cost of polling an empty channel with an alt holding a skip guard against
+// try_read, and the cost of waiting a short time for a value with an alt holding a timer
+// against read_for.
+
+unsigned int POLLS = 1000000;
+unsigned int WAITS = 100;
+
+template<typename CHAN>
+double poll_alt(CHAN &c)
+{
+    skip s;
+    alt a{c.in(), s};
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < POLLS; ++i)
+        if (a.pri_select() == 0)
+            c.in()();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(POLLS);
+}
+
+template<typename CHAN>
+double poll_try(CHAN &c)
+{
+    int value;
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < POLLS; ++i)
+        c.in().try_read(value);
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(POLLS);
+}
+
+template<typename CHAN>
+double wait_alt(CHAN &c)
+{
+    timer t;
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < WAITS; ++i)
+    {
+        t.set_alarm(t.read() + microseconds(100));
+        alt a{c.in(), t};
+        if (a.pri_select() == 0)
+            c.in()();
+    }
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / static_cast<double>(WAITS);
+}
+
+template<typename CHAN>
+double wait_read_for(CHAN &c)
+{
+    int value;
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < WAITS; ++i)
+        c.in().read_for(value, microseconds(100));
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / static_cast<double>(WAITS);
+}
+
+template<typename CHAN>
+void run(CHAN &c, const string &name)
+{
+    cout << name << " alt and skip: " << poll_alt(c) << "ns per poll" << endl;
+    cout << name << " try_read:     " << poll_try(c) << "ns per poll" << endl;
+    cout << name << " alt and timer: " << wait_alt(c) << "us per 100us wait" << endl;
+    cout << name << " read_for:      " << wait_read_for(c) << "us per 100us wait" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2)
+        POLLS = stoi(argv[1]);
+    cout << POLLS << " polls of an empty channel" << endl;
+
+    one2one_chan<int> unbuffered;
+    any2one_chan<int> shared;
+    buffer<int> buf(16);
+    one2one_chan<int> buffered(buf);
+    run(unbuffered, "one2one");
+    run(shared, "any2one");
+    run(buffered, "buffered");
+    return 0;
+}
@@ -0,0 +1,64 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Compares the cost of a selection made by an alt, which enables and disables every guard each
+// time, against a ready_alt, which only looks at the guards that are ready.  Only a few of the
+// channels ever have a writer, so the ready set stays small as the number of guards grows.
+
+unsigned int MESSAGES = 100000;
+unsigned int ACTIVE = 2;
+
+void writer(chan_out<int> out, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; ++i)
+        out(i);
+}
+
+template<typename ALT>
+void reader(vector<alting_chan_in<int>> in, unsigned int n, double *result)
+{
+    ALT a(vector<guard>(in.begin(), in.end()));
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < n; ++i)
+        in[a.fair_select()]();
+    *result = duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(n);
+}
+
+template<typename ALT>
+double run(unsigned int channels)
+{
+    vector<one2one_chan<int>> c(channels);
+    vector<function<void()>> procs;
+    for (unsigned int i = 0; i < ACTIVE; ++i)
+        procs.push_back(make_proc(writer, c[i * (channels / ACTIVE)], MESSAGES));
+    double result;
+    procs.push_back(make_proc(reader<ALT>, vector<alting_chan_in<int>>(c.begin(), c.end()), MESSAGES * ACTIVE, &result));
+    par p(procs);
+    p();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 2)
+        MESSAGES = stoi(argv[1]);
+    cout << ACTIVE << " active writers, " << MESSAGES << " messages each" << endl;
+
+    for (unsigned int channels : {4, 16, 64, 256})
+    {
+        cout << channels << " channels alt:       " << run<alt>(channels) << "ns per select" << endl;
+        cout << channels << " channels ready_alt: " << run<ready_alt>(channels) << "ns per select" << endl;
+    }
+    return 0;
+}
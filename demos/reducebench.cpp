@@ -0,0 +1,96 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <numeric>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Estimates pi as montecarlopi does, first with worker processes sending their results to a
+// calculate process over a channel, then with par_transform_reduce.  Then times a sum and a scan
+// over a vector against their sequential forms.
+
+unsigned int WORKERS = 64;
+
+unsigned int ITERATIONS = 1 << 16;
+
+unsigned int SIZE = 1 << 22;
+
+double monte_carlo_pi(unsigned int seed) noexcept
+{
+    default_random_engine e(seed);
+    uniform_real_distribution<double> distribution(0.0, 1.0);
+    unsigned int in_circle = 0;
+    for (unsigned int i = 0; i < ITERATIONS; ++i)
+    {
+        auto x = distribution(e);
+        auto y = distribution(e);
+        if (x * x + y * y <= 1.0)
+            ++in_circle;
+    }
+    return (4.0 * in_circle) / static_cast<double>(ITERATIONS);
+}
+
+template<typename F>
+double time_ms(F f)
+{
+    auto start = steady_clock::now();
+    f();
+    return duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        WORKERS = stoi(argv[1]);
+    if (argc >= 3)
+        SIZE = stoi(argv[2]);
+    bool fibers = argc >= 4 && string(argv[3]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << thread::hardware_concurrency() << " cores" << endl;
+
+    double pi = 0.0;
+    cout << "pi over a channel, " << WORKERS << " workers: " << time_ms([&]()
+    {
+        any2one_chan<double> chan;
+        vector<function<void()>> procs;
+        for (unsigned int i = 0; i < WORKERS; ++i)
+            procs.push_back([=]() { chan(monte_carlo_pi(i)); });
+        procs.push_back([&]()
+        {
+            double sum = 0.0;
+            for (unsigned int i = 0; i < WORKERS; ++i)
+                sum += chan();
+            pi = sum / WORKERS;
+        });
+        par p(procs);
+        p();
+    }) << "ms, pi = " << pi << endl;
+
+    vector<unsigned int> seeds(WORKERS);
+    iota(seeds.begin(), seeds.end(), 0u);
+    cout << "pi with par_transform_reduce: " << time_ms([&]()
+    {
+        pi = par_transform_reduce(seeds.begin(), seeds.end(), 0.0, plus<double>(), monte_carlo_pi) / WORKERS;
+    }) << "ms, pi = " << pi << endl;
+
+    vector<long long> data(SIZE), out(SIZE);
+    iota(data.begin(), data.end(), 0ll);
+    long long sum = 0;
+    cout << "sum of " << SIZE << " sequential: " << time_ms([&]() { sum = accumulate(data.begin(), data.end(), 0ll); }) << "ms, ";
+    cout << "par_reduce: " << time_ms([&]() { sum -= par_reduce(data.begin(), data.end(), 0ll, plus<long long>()); }) << "ms" << (sum == 0 ? "" : " MISMATCH") << endl;
+    cout << "scan of " << SIZE << " sequential: " << time_ms([&]() { partial_sum(data.begin(), data.end(), out.begin()); }) << "ms, ";
+    cout << "par_inclusive_scan: " << time_ms([&]() { par_inclusive_scan(data.begin(), data.end(), out.begin(), plus<long long>()); }) << "ms" << endl;
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
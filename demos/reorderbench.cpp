@@ -0,0 +1,111 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include "../csp/csp.h"
+#include "../csp/skeletons/reorder_buffer.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::skeletons;
+
+// Sends items to workers over a one2any channel and collects the results over an any2one
+// channel, putting them back in order with a reorder buffer.  Every so often an item stalls its
+// worker.  Reports the time taken, the most results held at once, and checks the order.
+
+unsigned int ITEMS = 20000;
+
+unsigned int WORKERS = 4;
+
+unsigned int STALL_EVERY = 5000;
+
+struct packet
+{
+    size_t seq;
+    unsigned int value;
+};
+
+void run(size_t window)
+{
+    one2any_chan<packet> to_workers;
+    any2one_chan<packet> from_workers;
+    reorder_buffer<unsigned int> order(window);
+    size_t most_held = 0;
+    bool in_order = true;
+
+    vector<function<void()>> procs;
+    // Producer.  Waits for room in the window before sending.
+    procs.push_back([=]()
+    {
+        for (unsigned int i = 0; i < ITEMS; ++i)
+            to_workers(packet{order.next(), i});
+        for (unsigned int i = 0; i < WORKERS; ++i)
+            to_workers(packet{0, ITEMS});
+    });
+    // Workers
+    for (unsigned int w = 0; w < WORKERS; ++w)
+        procs.push_back([=]()
+        {
+            while (true)
+            {
+                auto p = to_workers();
+                if (p.value == ITEMS)
+                {
+                    from_workers(p);
+                    return;
+                }
+                if (p.value % STALL_EVERY == STALL_EVERY - 1)
+                    this_thread::sleep_for(milliseconds(5));
+                from_workers(p);
+            }
+        });
+    // Consumer
+    procs.push_back([&]()
+    {
+        unsigned int ended = 0, expected = 0;
+        while (ended < WORKERS)
+        {
+            auto p = from_workers();
+            if (p.value == ITEMS)
+            {
+                ++ended;
+                continue;
+            }
+            order.put(p.seq, p.value, [&](unsigned int value)
+            {
+                in_order = in_order && value == expected++;
+            });
+            if (order.held() > most_held)
+                most_held = order.held();
+        }
+    });
+
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    auto total = duration_cast<microseconds>(steady_clock::now() - start).count() / 1000.0;
+    cout << "window " << window << ": " << total << "ms, most held " << most_held << (in_order ? "" : ", OUT OF ORDER") << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        ITEMS = stoi(argv[1]);
+    if (argc >= 3)
+        WORKERS = stoi(argv[2]);
+    bool fibers = argc >= 4 && string(argv[3]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << ITEMS << " items, " << WORKERS << " workers, a 5ms stall every " << STALL_EVERY << " items" << endl;
+    for (size_t window : {4, 16, 64, 256})
+        run(window);
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,201 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <limits>
+#include <cmath>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Compares thread per process par against the work-stealing fiber scheduler on the
+// mandelbrot3 farm and the stressed_alt network.
+
+constexpr unsigned int MAX_ITERATIONS = 255;
+
+unsigned int DIM = 256;
+
+constexpr double xmin = -2.1;
+constexpr double xmax = 1.0;
+constexpr double ymin = -1.3;
+constexpr double ymax = 1.3;
+
+int NUM_WORKERS = 8;
+
+unsigned int CHANNELS = 8;
+unsigned int WRITERS_PER_CHANNEL = 8;
+
+constexpr unsigned int DONE = numeric_limits<unsigned int>::max();
+
+template<typename T>
+using mobile = unique_ptr<T>;
+
+struct mandelbrot_packet
+{
+    int line = 0;
+    vector<double> data;
+};
+
+void mandelbrot(chan_in<int> in, chan_out<mobile<mandelbrot_packet>> out) noexcept
+{
+    double integral_x = (xmax - xmin) / static_cast<double>(DIM);
+    double integral_y = (ymax - ymin) / static_cast<double>(DIM);
+    int line = in();
+
+    while (line != -1)
+    {
+        double x, y, x1, y1, xx = 0.0;
+        unsigned int loop_count = 0;
+
+        mobile<mandelbrot_packet> packet = mobile<mandelbrot_packet>(new mandelbrot_packet());
+        packet->line = line;
+        packet->data = vector<double>(DIM);
+
+        y = ymin + (line * integral_y);
+        x = xmin;
+        for (unsigned int x_coord = 0; x_coord < DIM; ++x_coord)
+        {
+            x1 = 0.0, y1 = 0.0;
+            loop_count = 0;
+            while (loop_count < MAX_ITERATIONS && sqrt(pow(x1, 2.0) + pow(y1, 2.0)) < 2.0)
+            {
+                ++loop_count;
+                xx = pow(x1, 2.0) - pow(y1, 2.0) + x;
+                y1 = 2 * x1 * y1 + y;
+                x1 = xx;
+            }
+            packet->data[x_coord] = static_cast<double>(loop_count) / static_cast<double>(MAX_ITERATIONS);
+            x += integral_x;
+        }
+        out(move(packet));
+        line = in();
+    }
+}
+
+void producer(chan_out<int> out, int lines, int num_workers) noexcept
+{
+    for (int i = 0; i < lines; ++i)
+        out(i);
+    for (int i = 0; i < num_workers; ++i)
+        out(-1);
+}
+
+void consumer(chan_in<mobile<mandelbrot_packet>> in, int lines) noexcept
+{
+    vector<vector<double>> results(lines);
+    for (int i = 0; i < lines; ++i)
+    {
+        auto packet = in();
+        results[packet->line] = std::move(packet->data);
+    }
+}
+
+double run_mandelbrot(unsigned int runs)
+{
+    one2any_chan<int> lines;
+    any2one_chan<mobile<mandelbrot_packet>> data;
+
+    vector<function<void()>> workers;
+    for (int i = 0; i < NUM_WORKERS; ++i)
+        workers.push_back(make_proc(mandelbrot, lines, data));
+
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < runs; ++i)
+    {
+        par
+        {
+            make_proc(producer, lines, DIM, NUM_WORKERS),
+            par(workers),
+            make_proc(consumer, data, DIM)
+        }();
+    }
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    return total / static_cast<double>(runs) / 1000000.0;
+}
+
+struct stressed_packet
+{
+    unsigned int writer;
+    unsigned int n;
+};
+
+void stressed_writer(chan_out<stressed_packet> out, unsigned int writer, atomic<bool> *running)
+{
+    unsigned int n = 0;
+    while (running->load())
+    {
+        out({ writer, n });
+        ++n;
+    }
+    out({ writer, DONE });
+}
+
+void stressed_reader(vector<alting_chan_in<stressed_packet>> c, unsigned int selects, atomic<bool> *running, double *result)
+{
+    alt a(vector<guard>(c.begin(), c.end()));
+    // Warm up
+    for (unsigned int i = 0; i < selects / 10; ++i)
+        c[a()]();
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < selects; ++i)
+        c[a()]();
+    *result = duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(selects);
+    // Stop the writers and drain the channels
+    running->store(false);
+    unsigned int done = 0;
+    while (done < c.size() * WRITERS_PER_CHANNEL)
+        if (c[a()]().n == DONE)
+            ++done;
+}
+
+double run_stressed_alt(unsigned int selects)
+{
+    atomic<bool> running(true);
+    double result = 0.0;
+    vector<any2one_chan<stressed_packet>> c(CHANNELS);
+    vector<function<void()>> procs;
+    for (unsigned int i = 0; i < CHANNELS; ++i)
+        for (unsigned int j = 0; j < WRITERS_PER_CHANNEL; ++j)
+            procs.push_back(make_proc(stressed_writer, c[i], j, &running));
+
+    par
+    {
+        par(procs),
+        make_proc(stressed_reader, vector<alting_chan_in<stressed_packet>>(c.begin(), c.end()), selects, &running, &result)
+    }();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 5)
+    {
+        DIM = stoi(argv[1]);
+        NUM_WORKERS = stoi(argv[2]);
+        CHANNELS = stoi(argv[3]);
+        WRITERS_PER_CHANNEL = stoi(argv[4]);
+    }
+    cout << "mandelbrot " << DIM << " x " << NUM_WORKERS << " workers, stressed alt " << CHANNELS << " : " << WRITERS_PER_CHANNEL << endl;
+    cout << "cores: " << thread::hardware_concurrency() << endl;
+
+    for (auto fibers : { false, true })
+    {
+        if (fibers)
+            fiber_scheduler::start();
+        auto mandel = run_mandelbrot(20);
+        auto stressed = run_stressed_alt(100000);
+        cout << (fibers ? "fibers:  " : "threads: ")
+             << "mandelbrot " << mandel << "ms per image, "
+             << "stressed alt " << stressed << "ns per select" << endl;
+        if (fibers)
+            fiber_scheduler::stop();
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../csp/csp.h"
+#include "../csp/net/shm_chan.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+using namespace csp::net;
+
+// A child process writes to a shared-memory channel read by the parent.  Reports the messages
+// per second and the time per message unbuffered, where each write waits for its read, and
+// buffered.  Then the child dies part way through, and the parent checks it is poisoned rather
+// than left waiting.
+
+unsigned int MESSAGES = 1000000;
+
+unsigned int BUFFER = 64;
+
+void run(const string &label, bool buffered)
+{
+    auto pid = fork();
+    if (pid == 0)
+    {
+        shm_chan_out<unsigned int> out("shmbench");
+        for (unsigned int i = 0; i < MESSAGES; ++i)
+            out(i);
+        _exit(0);
+    }
+    buffer<unsigned int> store(BUFFER);
+    auto in = buffered ? shm_chan_in<unsigned int>("shmbench", store) : shm_chan_in<unsigned int>("shmbench");
+    long long sum = 0;
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < MESSAGES; ++i)
+        sum += in();
+    auto total = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    waitpid(pid, nullptr, 0);
+    bool correct = sum == static_cast<long long>(MESSAGES) * (MESSAGES - 1) / 2;
+    auto messages = static_cast<double>(MESSAGES);
+    cout << label << ": " << static_cast<long long>(messages * 1e9 / total) << " messages/s, " << total / messages << "ns per message" << (correct ? "" : ", WRONG SUM") << endl;
+}
+
+void crash()
+{
+    auto pid = fork();
+    if (pid == 0)
+    {
+        shm_chan_out<unsigned int, true> out("shmbench");
+        for (unsigned int i = 0; i < 10; ++i)
+            out(i);
+        abort();
+    }
+    shm_chan_in<unsigned int, true> in("shmbench");
+    unsigned int read = 0;
+    try
+    {
+        while (true)
+        {
+            in();
+            ++read;
+        }
+    }
+    catch (poison_exception&)
+    {
+        cout << "Writer died after " << read << " messages: reader poisoned" << endl;
+    }
+    waitpid(pid, nullptr, 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        MESSAGES = stoi(argv[1]);
+    if (argc >= 3)
+        BUFFER = stoi(argv[2]);
+    cout << MESSAGES << " messages between two processes" << endl;
+    run("Unbuffered", false);
+    run("Buffered (" + to_string(BUFFER) + ")", true);
+    crash();
+    return 0;
+}
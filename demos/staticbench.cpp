@@ -0,0 +1,101 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Streams integers from a producer to a consumer over type-erased channels and over statically
+// dispatched channels of the same kind, and times a poll of an empty channel, where the call
+// overhead is all there is.  A stream is mostly the cost of waking the other process, which
+// drifts from run to run, so the two stacks take turns going first and the best of several
+// rounds is reported for each.
+
+unsigned int VALUES = 1000000;
+
+unsigned int ROUNDS = 5;
+
+template<typename IN, typename OUT>
+double stream(IN in, OUT out)
+{
+    auto start = steady_clock::now();
+    par
+    {
+        [&]()
+        {
+            for (unsigned int i = 0; i < VALUES; ++i)
+                out(i);
+        },
+        [&]()
+        {
+            unsigned long long sum = 0;
+            for (unsigned int i = 0; i < VALUES; ++i)
+                sum += in();
+        }
+    }();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(VALUES);
+}
+
+template<typename IN>
+double poll(IN in)
+{
+    unsigned int value;
+    auto start = steady_clock::now();
+    for (unsigned int i = 0; i < VALUES; ++i)
+        in.try_read(value);
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / static_cast<double>(VALUES);
+}
+
+template<typename ERASED, typename FIXED>
+void compare(const string &name, ERASED &erased, FIXED &fixed)
+{
+    double erased_stream = 1e12, fixed_stream = 1e12, erased_poll = 1e12, fixed_poll = 1e12;
+    for (unsigned int r = 0; r < ROUNDS; ++r)
+    {
+        // Take turns going first
+        if (r % 2 == 0)
+        {
+            erased_stream = min(erased_stream, stream(erased.in(), erased.out()));
+            fixed_stream = min(fixed_stream, stream(fixed.in(), fixed.out()));
+        }
+        else
+        {
+            fixed_stream = min(fixed_stream, stream(fixed.in(), fixed.out()));
+            erased_stream = min(erased_stream, stream(erased.in(), erased.out()));
+        }
+        erased_poll = min(erased_poll, poll(erased.in()));
+        fixed_poll = min(fixed_poll, poll(fixed.in()));
+    }
+    cout << name << " type-erased: " << erased_stream << "ns per value, " << erased_poll << "ns per poll" << endl;
+    cout << name << " static:      " << fixed_stream << "ns per value, " << fixed_poll << "ns per poll" << endl;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        VALUES = stoi(argv[1]);
+    if (argc >= 3)
+        ROUNDS = stoi(argv[2]);
+    cout << VALUES << " values, best of " << ROUNDS << " rounds" << endl;
+
+    one2one_chan<unsigned int> erased;
+    static_chan<unsigned int> fixed;
+    compare("one2one", erased, fixed);
+
+    any2one_chan<unsigned int> shared_erased;
+    static_chan<unsigned int, chan_kind::any2one> shared_fixed;
+    compare("any2one", shared_erased, shared_fixed);
+
+    buffer<unsigned int> buf(256);
+    one2one_chan<unsigned int> buffered_erased(buf);
+    static_chan<unsigned int, chan_kind::one2one, true> buffered_fixed(buf);
+    compare("buffered", buffered_erased, buffered_fixed);
+    return 0;
+}
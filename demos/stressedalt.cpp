@@ -72,9 +72,15 @@ void stressed_reader(vector<alting_chan_in<stressed_packet>> c, unsigned int wri
         auto pckt = c[idx]();
         n[idx][pckt.writer] = pckt.n;
     }
+    unsigned long long sum = 0;
     for (unsigned int i = 0; i < 1000; ++i)
+    {
         res << results[i] << ",";
+        sum += results[i];
+    }
     res.close();
+    auto average = sum / 1000.0;
+    cout << "average " << average << "ns per message, " << static_cast<unsigned long long>(1e9 / average) << " messages per second" << endl;
 }
 
 int main(int argc, char** argv)
@@ -0,0 +1,79 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Runs many processes that each wake on a fixed period, half by sleeping on a timer and half by
+// selecting on a timer guard, as regulate and fixed_delay style processes do.  Reports how late
+// the processes wake on average.
+
+unsigned int PROCESSES = 1000;
+unsigned int TICKS = 100;
+const microseconds PERIOD(1000);
+
+atomic<long long> lateness(0);
+
+void sleeper()
+{
+    timer t;
+    auto next = t.read();
+    long long late = 0;
+    for (unsigned int i = 0; i < TICKS; ++i)
+    {
+        next += PERIOD;
+        t(next);
+        late += duration_cast<nanoseconds>(t.read() - next).count();
+    }
+    lateness += late;
+}
+
+void selector()
+{
+    timer t;
+    auto next = t.read();
+    long long late = 0;
+    for (unsigned int i = 0; i < TICKS; ++i)
+    {
+        next += PERIOD;
+        t.set_alarm(next);
+        alt a{t};
+        a.select();
+        late += duration_cast<nanoseconds>(t.read() - next).count();
+    }
+    lateness += late;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        PROCESSES = stoi(argv[1]);
+    if (argc >= 3)
+        TICKS = stoi(argv[2]);
+    bool fibers = argc >= 4 && string(argv[3]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << PROCESSES << " processes waking every " << PERIOD.count() << "us, " << TICKS << " times each" << endl;
+
+    vector<function<void()>> procs;
+    for (unsigned int i = 0; i < PROCESSES; ++i)
+        procs.push_back(i % 2 == 0 ? function<void()>(sleeper) : function<void()>(selector));
+    auto start = steady_clock::now();
+    par p(procs);
+    p();
+    auto total = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    cout << "Took " << total << "ms, expected " << TICKS * PERIOD.count() / 1000 << "ms" << endl;
+    cout << "Average lateness " << lateness.load() / (1000.0 * PROCESSES * TICKS) << "us" << endl;
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}
@@ -0,0 +1,92 @@
+//
+// Created by kevin on 16/10/26.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "../csp/csp.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace csp;
+
+// Runs commstime with each wait strategy set on its channels, and reports the time per cycle.
+
+unsigned int CYCLES = 100000;
+
+double commstime(wait_strategy strategy, bool buffered)
+{
+    vector<one2one_chan<unsigned long long>> chans;
+    buffer<unsigned long long> buf(1);
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        chans.push_back(buffered ? one2one_chan<unsigned long long>(buf) : one2one_chan<unsigned long long>());
+        chans.back().set_wait_strategy(strategy);
+    }
+    auto a = chans[0], b = chans[1], c = chans[2], d = chans[3];
+
+    auto start = steady_clock::now();
+    par p
+    {
+        // Prefix
+        make_proc([=]()
+        {
+            a(0);
+            for (unsigned int i = 1; i < CYCLES; ++i)
+                a(c());
+            c();
+        }),
+        // Delta
+        make_proc([=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+            {
+                auto x = a();
+                b(x);
+                d(x);
+            }
+        }),
+        // Successor
+        make_proc([=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                c(b() + 1);
+        }),
+        // Consumer
+        make_proc([=]()
+        {
+            for (unsigned int i = 0; i < CYCLES; ++i)
+                d();
+        })
+    };
+    p();
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / double(CYCLES);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 2)
+        CYCLES = stoi(argv[1]);
+    bool fibers = argc >= 3 && string(argv[2]) == "fibers";
+    if (fibers)
+        fiber_scheduler::start();
+    cout << (fibers ? "Fibers: " : "Threads: ") << CYCLES << " commstime cycles" << endl;
+
+    const vector<pair<wait_strategy, string>> strategies
+    {
+        {wait_strategy::BLOCK, "block"},
+        {wait_strategy::SPIN, "spin"},
+        {wait_strategy::SPIN_YIELD, "spin-then-yield"},
+        {wait_strategy::ADAPTIVE, "adaptive"}
+    };
+    for (auto &s : strategies)
+    {
+        cout << s.second << ": " << commstime(s.first, false) << "ns per cycle unbuffered, ";
+        cout << commstime(s.first, true) << "ns per cycle buffered" << endl;
+    }
+    if (fibers)
+        fiber_scheduler::stop();
+    return 0;
+}